@@ -0,0 +1,170 @@
+/**
+ * @file BirthdayIndex.cpp
+ * @brief 会员生日日历索引实现文件
+ * @details 实现生日到桶编号的换算、桶的增删以及按日期区间的查询
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "BirthdayIndex.h"
+#include <algorithm>
+
+namespace {
+
+/// 闰年日历中每月第一天的桶编号
+const short MONTH_START[13] = { 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366 };
+
+/// 将两位数字字符转换为整数，含非数字时返回 -1
+int twoDigits(const char* p) {
+    if (p[0] < '0' || p[0] > '9' || p[1] < '0' || p[1] > '9') {
+        return -1;
+    }
+    return (p[0] - '0') * 10 + (p[1] - '0');
+}
+
+} // namespace
+
+/**
+ * @brief 构造函数
+ */
+BirthdayIndex::BirthdayIndex() : buckets(DAY_COUNT) {
+}
+
+/**
+ * @brief 计算“月-日”对应的桶编号
+ * @param month 月（1-12）
+ * @param day 日（1-31）
+ * @return 桶编号 0-365，日期无效时返回 -1
+ */
+int BirthdayIndex::dayKey(int month, int day) {
+    if (month < 1 || month > 12 || day < 1 || day > MONTH_START[month] - MONTH_START[month - 1]) {
+        return -1;
+    }
+    return MONTH_START[month - 1] + day - 1;
+}
+
+/**
+ * @brief 计算生日字符串对应的桶编号
+ * @param birthday 生日（YYYY-MM-DD）
+ * @return 桶编号 0-365，无法解析时返回 -1
+ * @details 只取月、日两部分；年份与闰年的合法性由录入时的校验负责
+ */
+int BirthdayIndex::dayKey(std::string_view birthday) {
+    if (birthday.size() != 10 || birthday[4] != '-' || birthday[7] != '-') {
+        return -1;
+    }
+    return dayKey(twoDigits(birthday.data() + 5), twoDigits(birthday.data() + 8));
+}
+
+/**
+ * @brief 计算若干天之后的桶编号
+ * @param key 起始桶编号
+ * @param days 天数（可为负数）
+ * @return 循环推算的桶编号
+ * @details 按闰年日历推算，平年的区间若跨过 2月28日 会顺带包含 2月29日 出生的会员
+ */
+int BirthdayIndex::addDays(int key, int days) {
+    int result = (key + days) % DAY_COUNT;
+    return result < 0 ? result + DAY_COUNT : result;
+}
+
+/**
+ * @brief 加入一个会员
+ * @param birthday 生日
+ * @param id 会员ID
+ */
+void BirthdayIndex::insert(std::string_view birthday, int id) {
+    int key = dayKey(birthday);
+    if (key < 0) {
+        return;
+    }
+    buckets[key].push_back(id);
+    count += 1;
+}
+
+/**
+ * @brief 移除一个会员
+ * @param birthday 加入时使用的生日
+ * @param id 会员ID
+ * @return true 移除成功，false 记录不存在
+ * @details 桶内不保持顺序，用末尾元素填补被移除的位置
+ */
+bool BirthdayIndex::erase(std::string_view birthday, int id) {
+    int key = dayKey(birthday);
+    if (key < 0) {
+        return false;
+    }
+    std::vector<int>& ids = buckets[key];
+    auto it = std::find(ids.begin(), ids.end(), id);
+    if (it == ids.end()) {
+        return false;
+    }
+    *it = ids.back();
+    ids.pop_back();
+    count -= 1;
+    return true;
+}
+
+/**
+ * @brief 获取某一天过生日的会员
+ * @param key 桶编号
+ * @return 会员ID，编号无效时返回空列表
+ */
+const std::vector<int>& BirthdayIndex::bucket(int key) const {
+    static const std::vector<int> empty;
+    return (key < 0 || key >= DAY_COUNT) ? empty : buckets[key];
+}
+
+/**
+ * @brief 查询一段日期内过生日的会员
+ * @param fromKey 起始桶编号（含）
+ * @param toKey 结束桶编号（含），小于起始编号时表示跨年
+ * @param out 输出：会员ID（追加）
+ * @return 本次输出的数量
+ */
+size_t BirthdayIndex::range(int fromKey, int toKey, std::vector<int>& out) const {
+    if (fromKey < 0 || fromKey >= DAY_COUNT || toKey < 0 || toKey >= DAY_COUNT) {
+        return 0;
+    }
+    size_t before = out.size();
+    for (int key = fromKey;; key = addDays(key, 1)) {
+        out.insert(out.end(), buckets[key].begin(), buckets[key].end());
+        if (key == toKey) {
+            break;
+        }
+    }
+    return out.size() - before;
+}
+
+/**
+ * @brief 获取已索引的会员数量
+ * @return 会员数量
+ */
+size_t BirthdayIndex::size() const {
+    return count;
+}
+
+/**
+ * @brief 统计索引占用的内存
+ * @return 内存占用
+ */
+MemoryUsage BirthdayIndex::memoryUsage() const {
+    MemoryUsage usage;
+    usage.addVector(buckets);
+    for (const auto& ids : buckets) {
+        usage.addVector(ids);
+    }
+    usage.objects = count;
+    return usage;
+}
+
+/**
+ * @brief 清空索引
+ */
+void BirthdayIndex::clear() {
+    for (auto& ids : buckets) {
+        ids.clear();
+    }
+    count = 0;
+}
@@ -0,0 +1,315 @@
+/**
+ * @file ColdStore.cpp
+ * @brief 休眠会员磁盘存储实现文件
+ * @details 实现段文件的追加写入、按存根读取、电话号码布隆过滤以及空洞回收
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "ColdStore.h"
+#include <algorithm>
+#include <cstdio>
+
+/**
+ * @brief 析构函数，关闭并删除段文件
+ */
+ColdStore::~ColdStore() {
+    close();
+}
+
+/**
+ * @brief 计算电话号码的 64 位哈希
+ * @param phone 电话号码
+ * @return 哈希值（FNV-1a 后再做一次混合，使高低 32 位都足够分散）
+ */
+uint64_t ColdStore::phoneHash(std::string_view phone) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (char c : phone) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001B3ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/**
+ * @brief 创建（或清空）段文件
+ * @param segmentPath 段文件路径
+ * @return true 成功，false 无法创建文件
+ */
+bool ColdStore::open(const std::string& segmentPath) {
+    close();
+    file.open(segmentPath, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    path = segmentPath;
+    return true;
+}
+
+/**
+ * @brief 关闭并删除段文件，丢弃全部存根
+ */
+void ColdStore::close() {
+    if (file.is_open()) {
+        file.close();
+        std::remove(path.c_str());
+    }
+    path.clear();
+    fileSize = 0;
+    deadBytes = 0;
+    stubs.clear();
+    stubs.shrink_to_fit();
+    phoneOrder.clear();
+    phoneOrder.shrink_to_fit();
+    liveCount = 0;
+    phoneFilter.reset(0);
+    filterCapacity = 0;
+}
+
+/**
+ * @brief 转存一批会员
+ * @param batch 要转存的会员
+ * @return true 成功，false 写入失败
+ * @details 记录分块拼接后追加到文件末尾，新存根排序后与原有存根归并，再重建电话顺序
+ */
+bool ColdStore::put(const std::vector<const Member*>& batch) {
+    if (!file.is_open() || batch.empty()) {
+        return file.is_open();
+    }
+    const size_t FLUSH_BYTES = 1 << 20;  // 缓冲达到该大小即写出，避免大批量转存占用过多内存
+    std::string buffer;
+    size_t oldCount = stubs.size();
+    uint64_t written = 0;
+    file.clear();
+    file.seekp(static_cast<std::streamoff>(fileSize));
+    for (size_t i = 0; i < batch.size(); ++i) {
+        size_t start = buffer.size();
+        batch[i]->serialize(buffer);
+        stubs.push_back({ fileSize + written + start, phoneHash(batch[i]->getPhone()), batch[i]->getId(),
+                          static_cast<uint32_t>(buffer.size() - start) });
+        if (buffer.size() >= FLUSH_BYTES || i + 1 == batch.size()) {
+            file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            written += buffer.size();
+            buffer.clear();
+        }
+    }
+    file.flush();
+    if (!file) {
+        // 已写出的部分位于文件末尾之后，会被下一次写入覆盖
+        stubs.resize(oldCount);
+        file.clear();
+        return false;
+    }
+    fileSize += written;
+
+    auto byId = [](const Stub& a, const Stub& b) { return a.id < b.id; };
+    std::sort(stubs.begin() + oldCount, stubs.end(), byId);
+    std::inplace_merge(stubs.begin(), stubs.begin() + oldCount, stubs.end(), byId);
+    liveCount += batch.size();
+    rebuildPhoneOrder();
+
+    if (liveCount > filterCapacity) {
+        rebuildFilter();
+    } else {
+        for (const Member* member : batch) {
+            phoneFilter.add(phoneHash(member->getPhone()));
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 按会员ID查找存根
+ * @param id 会员ID
+ * @return 有效存根，不存在或已移除时返回nullptr
+ */
+const ColdStore::Stub* ColdStore::findStub(int id) const {
+    auto it = std::lower_bound(stubs.begin(), stubs.end(), id,
+                               [](const Stub& stub, int key) { return stub.id < key; });
+    // 同一会员可能先被移除又再次转存，跳过已移除的旧存根
+    for (; it != stubs.end() && it->id == id; ++it) {
+        if (it->offset != DEAD) {
+            return &*it;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief 读取一条记录
+ * @param stub 存根
+ * @param record 输出：记录内容
+ * @return true 成功
+ */
+bool ColdStore::readRecord(const Stub& stub, std::string& record) const {
+    record.resize(stub.length);
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(stub.offset));
+    file.read(record.data(), stub.length);
+    if (!file) {
+        file.clear();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 判断会员是否在磁盘上
+ * @param id 会员ID
+ */
+bool ColdStore::contains(int id) const {
+    return findStub(id) != nullptr;
+}
+
+/**
+ * @brief 读取会员（不移除）
+ * @param id 会员ID
+ * @param member 输出：会员完整状态
+ * @return true 成功，false 不在磁盘上或读取失败
+ */
+bool ColdStore::fetch(int id, Member& member) const {
+    const Stub* stub = findStub(id);
+    std::string record;
+    return stub && readRecord(*stub, record) && Member::deserialize(record, member);
+}
+
+/**
+ * @brief 移除会员
+ * @param id 会员ID
+ * @return true 成功，false 不在磁盘上
+ * @details 只把存根标记为已移除；空洞超过有效数据时重写段文件
+ */
+bool ColdStore::erase(int id) {
+    Stub* stub = const_cast<Stub*>(findStub(id));
+    if (!stub) {
+        return false;
+    }
+    deadBytes += stub->length;
+    stub->offset = DEAD;
+    liveCount -= 1;
+    if (deadBytes >= COMPACT_MIN_BYTES && deadBytes > fileSize - deadBytes) {
+        compact();
+    }
+    return true;
+}
+
+/**
+ * @brief 按电话号码查找会员
+ * @param phone 完整电话号码
+ * @return 电话相同的会员中ID最小的一个，不存在时返回 -1
+ * @details 布隆过滤器判定不存在时直接返回；否则在电话顺序中二分找到哈希相同的存根，读回记录核对
+ */
+int ColdStore::findByPhone(std::string_view phone) const {
+    uint64_t hash = phoneHash(phone);
+    if (!phoneFilter.mightContain(hash)) {
+        return -1;
+    }
+    auto it = std::lower_bound(phoneOrder.begin(), phoneOrder.end(), hash,
+                               [this](uint32_t index, uint64_t key) { return stubs[index].phoneHash < key; });
+    std::string record;
+    Member member(0, "", "", "");
+    for (; it != phoneOrder.end() && stubs[*it].phoneHash == hash; ++it) {
+        const Stub& stub = stubs[*it];
+        if (stub.offset != DEAD && readRecord(stub, record) &&
+            Member::deserialize(record, member) && member.getPhone() == phone) {
+            return stub.id;  // 哈希相同的存根按ID升序，第一个即最小
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 获取磁盘上全部会员的ID
+ * @param out 输出：会员ID，升序
+ */
+void ColdStore::ids(std::vector<int>& out) const {
+    out.clear();
+    out.reserve(liveCount);
+    for (const Stub& stub : stubs) {
+        if (stub.offset != DEAD) {
+            out.push_back(stub.id);
+        }
+    }
+}
+
+/**
+ * @brief 按当前有效会员数重建布隆过滤器
+ * @details 容量取有效会员数的两倍，避免每次转存都重建
+ */
+void ColdStore::rebuildFilter() {
+    filterCapacity = std::max<size_t>(liveCount * 2, 1024);
+    phoneFilter.reset(filterCapacity);
+    for (const Stub& stub : stubs) {
+        if (stub.offset != DEAD) {
+            phoneFilter.add(stub.phoneHash);
+        }
+    }
+}
+
+/**
+ * @brief 按（电话哈希, 会员ID）重建存根下标数组
+ * @details 存根只在转存和重写段文件时增删或移动；移除会员只改记录位置，下标仍然有效
+ */
+void ColdStore::rebuildPhoneOrder() {
+    phoneOrder.resize(stubs.size());
+    for (size_t i = 0; i < stubs.size(); ++i) {
+        phoneOrder[i] = static_cast<uint32_t>(i);
+    }
+    std::sort(phoneOrder.begin(), phoneOrder.end(), [this](uint32_t a, uint32_t b) {
+        return stubs[a].phoneHash != stubs[b].phoneHash ? stubs[a].phoneHash < stubs[b].phoneHash
+                                                        : stubs[a].id < stubs[b].id;
+    });
+}
+
+/**
+ * @brief 重写段文件，回收空洞
+ * @return true 成功，false 失败（保留原文件继续使用）
+ * @details 有效记录按存根顺序复制到临时文件，再替换原文件
+ */
+bool ColdStore::compact() {
+    std::string tempPath = path + ".tmp";
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    std::vector<Stub> live;
+    live.reserve(liveCount);
+    std::string record;
+    uint64_t offset = 0;
+    for (const Stub& stub : stubs) {
+        if (stub.offset == DEAD) {
+            continue;
+        }
+        if (!readRecord(stub, record)) {
+            out.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+        out.write(record.data(), static_cast<std::streamsize>(record.size()));
+        live.push_back({ offset, stub.phoneHash, stub.id, stub.length });
+        offset += stub.length;
+    }
+    out.close();
+    if (!out) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    file.close();
+    std::remove(path.c_str());
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        // 替换失败时只能以临时文件继续
+        path = tempPath;
+    }
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    stubs.swap(live);
+    stubs.shrink_to_fit();
+    fileSize = offset;
+    deadBytes = 0;
+    rebuildPhoneOrder();
+    rebuildFilter();
+    return static_cast<bool>(file);
+}
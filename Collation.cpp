@@ -0,0 +1,76 @@
+/**
+ * @file Collation.cpp
+ * @brief 会员姓名排序键实现文件
+ * @details 实现 GBK 排序权重表的生成和姓名排序键的计算
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "Collation.h"
+#include "TextEncoding.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief 获取 GBK 编码到排序权重的映射表
+ * @return 65536 项权重表，无效编码的权重为 0xFFFF
+ * @details 权重依次分配给：ASCII、GB2312 一级汉字（拼音序）、其余 GBK 双字节字符（编码序）
+ */
+const uint16_t* Collation::weights() {
+    static const std::vector<uint16_t> table = [] {
+        std::vector<uint16_t> result(0x10000, 0xFFFF);
+        uint16_t next = 1;
+        for (int c = 0; c < 0x80; ++c) {
+            result[c] = next++;
+        }
+        auto isLevelOne = [](int lead, int trail) {
+            return lead >= 0xB0 && lead <= 0xD7 && trail >= 0xA1 && trail <= 0xFE;
+        };
+        for (int lead = 0xB0; lead <= 0xD7; ++lead) {
+            for (int trail = 0xA1; trail <= 0xFE; ++trail) {
+                result[(lead << 8) | trail] = next++;
+            }
+        }
+        for (int lead = 0x81; lead <= 0xFE; ++lead) {
+            for (int trail = 0x40; trail <= 0xFE; ++trail) {
+                if (trail != 0x7F && !isLevelOne(lead, trail)) {
+                    result[(lead << 8) | trail] = next++;
+                }
+            }
+        }
+        return result;
+    }();
+    return table.data();
+}
+
+/**
+ * @brief 计算姓名的排序键
+ * @param name 姓名（本机编码）
+ * @return 64 位排序键
+ * @details UTF-8 姓名先转换为 GBK 再查权重表；常见姓名不超过 15 字节，转换不产生堆分配
+ */
+uint64_t Collation::nameKey(std::string_view name) {
+    std::string gbk;
+    if (TextEncoding::nativeEncoding() == TextEncoding::ENCODING_UTF8) {
+        TextEncoding::utf8ToGbk(name, gbk);
+        name = gbk;
+    }
+    const uint16_t* table = weights();
+    uint64_t key = 0;
+    int characters = 0;
+    size_t i = 0;
+    while (i < name.size() && characters < KEY_CHARACTERS) {
+        unsigned char lead = static_cast<unsigned char>(name[i]);
+        unsigned code = lead;
+        if (lead >= 0x81 && lead <= 0xFE && i + 1 < name.size()) {
+            code = (lead << 8) | static_cast<unsigned char>(name[i + 1]);
+            i += 2;
+        } else {
+            i += 1;
+        }
+        key |= static_cast<uint64_t>(table[code]) << (16 * (KEY_CHARACTERS - 1 - characters));
+        ++characters;
+    }
+    return key;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file HardwareCounters.cpp
+ * @brief CPU 硬件计数器实现文件
+ * @details Linux 上通过 perf_event_open 打开一组用户态硬件事件，分组读取并按复用比例折算；
+ *          其它平台不打开任何事件
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "HardwareCounters.h"
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char* const COUNTER_NAMES[HardwareCounters::COUNTER_COUNT] = {
+    "cycles",
+    "instructions",
+    "cache-misses",
+    "branch-misses",
+};
+
+#ifdef __linux__
+const uint64_t COUNTER_CONFIGS[HardwareCounters::COUNTER_COUNT] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+/**
+ * @brief 为调用线程打开一个用户态硬件事件
+ * @param config 事件
+ * @param group 组长的文件描述符，-1 表示打开的就是组长
+ * @return 文件描述符，失败返回 -1 并设置 errno
+ */
+int openCounter(uint64_t config, int group) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // 组长先停着，全组打开后一起启动，保证各事件覆盖同一段时间
+    attr.disabled = group < 0 ? 1 : 0;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, PERF_FLAG_FD_CLOEXEC));
+}
+#endif
+
+} // namespace
+
+/**
+ * @brief 为调用线程打开计数器
+ * @details 第一个打开成功的事件作为组长，其余事件加入同组；加入失败（如 PMU 容量不足）的事件跳过
+ */
+HardwareCounters::HardwareCounters() {
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        fds[i] = -1;
+        order[i] = -1;
+    }
+#ifdef __linux__
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        int fd = openCounter(COUNTER_CONFIGS[i], leader);
+        if (fd < 0) {
+            if (leader < 0) {
+                error = errno;
+            }
+            continue;
+        }
+        if (leader < 0) {
+            leader = fd;
+        }
+        fds[i] = fd;
+        order[opened++] = i;
+    }
+    if (leader >= 0) {
+        ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+}
+
+HardwareCounters::~HardwareCounters() {
+#ifdef __linux__
+    for (int fd : fds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief 读取当前累计值
+ * @param out 输出：读数
+ * @return true 读取成功
+ * @details 分组读取的格式为 { 事件数, 启用时间, 运行时间, 各事件值 }；
+ *          运行时间短于启用时间说明被分时复用，按比例折算为整段时间的估计值
+ */
+bool HardwareCounters::read(Reading& out) const {
+    out = Reading();
+#ifdef __linux__
+    if (leader < 0) {
+        return false;
+    }
+    uint64_t data[3 + COUNTER_COUNT];
+    ssize_t size = ::read(leader, data, sizeof(data));
+    if (size < static_cast<ssize_t>(3 * sizeof(uint64_t)) || data[0] != static_cast<uint64_t>(opened)) {
+        return false;
+    }
+    uint64_t enabled = data[1];
+    uint64_t running = data[2];
+    for (int i = 0; i < opened; ++i) {
+        uint64_t value = data[3 + i];
+        if (running > 0 && running < enabled) {
+            value = static_cast<uint64_t>(static_cast<long double>(value) * enabled / running);
+        }
+        out.values[order[i]] = value;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief 获取不可用的原因
+ */
+const char* HardwareCounters::unavailableReason() const {
+    if (leader >= 0) {
+        return "";
+    }
+#ifdef __linux__
+    switch (error) {
+    case EACCES:
+    case EPERM:
+        return "权限不足（见 /proc/sys/kernel/perf_event_paranoid）";
+    case ENOENT:
+    case EOPNOTSUPP:
+    case ENODEV:
+        return "CPU 或虚拟化环境不提供硬件事件";
+    case ENOSYS:
+        return "内核不支持 perf_event_open";
+    default:
+        return std::strerror(error);
+    }
+#else
+    return "当前平台不支持";
+#endif
+}
+
+/**
+ * @brief 获取事件名称
+ * @param counter 事件
+ */
+const char* HardwareCounters::counterName(Counter counter) {
+    return COUNTER_NAMES[counter];
+}
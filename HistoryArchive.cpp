@@ -0,0 +1,378 @@
+/**
+ * @file HistoryArchive.cpp
+ * @brief 消费历史年度归档实现文件
+ * @details 实现年度段文件的写入、文件头扫描、磁盘上的索引二分查找以及记录的压缩编解码
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "HistoryArchive.h"
+#include <algorithm>
+#include <filesystem>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+const char MAGIC[4] = { 'M', 'H', 'A', '1' };  ///< 段文件标识
+constexpr uint64_t HEADER_BYTES = 24;          ///< 文件头：标识、年度、索引项数、保留、索引位置
+constexpr uint64_t ENTRY_BYTES = 16;           ///< 索引项：会员ID、记录条数、记录块位置
+
+/// 折扣档位，与会员等级的折扣率一致；编码中的 RAW_TAG 表示按原始 double 保存
+const double RATES[] = { 1.0, 0.95, 0.9, 0.8 };
+constexpr uint64_t RAW_TAG = 7;
+
+template <typename T>
+void appendValue(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+T loadValue(const char* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+void appendVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+bool readVarint(const char*& p, const char* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        uint8_t byte = static_cast<uint8_t>(*p++);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 编码一条消费记录
+ * @param out 输出：编码追加到末尾
+ * @param record 消费记录
+ * @details 金额恰好是整数分、折扣率是标准档位时写成 (分 << 3) | 档位，否则写 RAW_TAG 加两个 double
+ */
+void encodeRecord(std::string& out, const HistoryArchive::Record& record) {
+    const double* rate = std::find(std::begin(RATES), std::end(RATES), record.second);
+    if (rate != std::end(RATES) && record.first >= 0 && record.first < 1e15) {
+        long long cents = std::llround(record.first * 100);
+        if (static_cast<double>(cents) / 100 == record.first) {
+            appendVarint(out, (static_cast<uint64_t>(cents) << 3) | static_cast<uint64_t>(rate - RATES));
+            return;
+        }
+    }
+    appendVarint(out, RAW_TAG);
+    appendValue(out, record.first);
+    appendValue(out, record.second);
+}
+
+/**
+ * @brief 解码一条消费记录
+ * @param p 读取位置，读取后前移
+ * @param end 数据末尾
+ * @param record 输出：消费记录
+ * @return true 成功，false 数据损坏
+ */
+bool decodeRecord(const char*& p, const char* end, HistoryArchive::Record& record) {
+    uint64_t value;
+    if (!readVarint(p, end, value)) {
+        return false;
+    }
+    uint64_t tag = value & 7;
+    if (tag == RAW_TAG) {
+        if (end - p < static_cast<std::ptrdiff_t>(2 * sizeof(double))) {
+            return false;
+        }
+        record.first = loadValue<double>(p);
+        record.second = loadValue<double>(p + sizeof(double));
+        p += 2 * sizeof(double);
+        return true;
+    }
+    if (tag >= std::size(RATES)) {
+        return false;
+    }
+    record.first = static_cast<double>(value >> 3) / 100;
+    record.second = RATES[tag];
+    return true;
+}
+
+} // namespace
+
+// ==================== 打开与关闭 ====================
+
+/**
+ * @brief 打开归档目录并读取已有段文件的文件头
+ * @param path 归档目录
+ * @return true 成功，false 路径不是目录或段文件损坏
+ */
+bool HistoryArchive::open(const std::string& path) {
+    close();
+    std::error_code error;
+    std::vector<Segment> found;
+    if (std::filesystem::exists(path, error)) {
+        if (!std::filesystem::is_directory(path, error)) {
+            return false;
+        }
+        for (const auto& entry : std::filesystem::directory_iterator(path, error)) {
+            std::string name = entry.path().filename().string();
+            // 只认 history-YYYY.seg，写入中途留下的 .tmp 文件忽略
+            if (name.size() != 16 || name.compare(0, 8, "history-") != 0 || name.compare(12, 4, ".seg") != 0) {
+                continue;
+            }
+            Segment segment;
+            if (!readHeader(entry.path().string(), segment) || name.compare(8, 4, std::to_string(segment.year)) != 0) {
+                return false;
+            }
+            found.push_back(std::move(segment));
+        }
+        if (error) {
+            return false;
+        }
+    }
+    std::sort(found.begin(), found.end(), [](const Segment& a, const Segment& b) { return a.year < b.year; });
+    directory = path;
+    segments = std::move(found);
+    opened = true;
+    return true;
+}
+
+/**
+ * @brief 关闭归档
+ */
+void HistoryArchive::close() {
+    directory.clear();
+    segments.clear();
+    opened = false;
+}
+
+/**
+ * @brief 读取并校验段文件头
+ * @param path 段文件路径
+ * @param segment 输出：文件头信息
+ * @return true 文件头有效且索引完整
+ */
+bool HistoryArchive::readHeader(const std::string& path, Segment& segment) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    uint64_t size = static_cast<uint64_t>(file.tellg());
+    char header[HEADER_BYTES];
+    if (size < HEADER_BYTES || !file.seekg(0) || !file.read(header, HEADER_BYTES) ||
+        std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+    segment.path = path;
+    segment.year = loadValue<int32_t>(header + 4);
+    segment.memberCount = loadValue<uint32_t>(header + 8);
+    segment.indexOffset = loadValue<uint64_t>(header + 16);
+    segment.fileSize = size;
+    if (segment.indexOffset < HEADER_BYTES || segment.indexOffset + segment.memberCount * ENTRY_BYTES != size) {
+        return false;
+    }
+    // 索引按会员ID升序，最后一项即最大ID
+    segment.maxId = 0;
+    if (segment.memberCount > 0) {
+        char last[sizeof(int32_t)];
+        if (!file.seekg(static_cast<std::streamoff>(size - ENTRY_BYTES)) || !file.read(last, sizeof(last))) {
+            return false;
+        }
+        segment.maxId = loadValue<int32_t>(last);
+    }
+    return true;
+}
+
+/**
+ * @brief 获取归档中出现过的最大会员ID
+ * @return 会员ID，没有任何归档记录时返回0
+ */
+int HistoryArchive::maxMemberId() const {
+    int maxId = 0;
+    for (const Segment& segment : segments) {
+        maxId = std::max(maxId, segment.maxId);
+    }
+    return maxId;
+}
+
+/**
+ * @brief 获取年度段文件路径
+ * @param year 年度
+ * @return 路径
+ */
+std::string HistoryArchive::segmentPath(int year) const {
+    return (std::filesystem::path(directory) / ("history-" + std::to_string(year) + ".seg")).string();
+}
+
+// ==================== 写入 ====================
+
+/**
+ * @brief 写入一个年度的段文件
+ * @param year 年度
+ * @param batches 各会员的记录，按会员ID严格升序
+ * @return true 成功，false 该年度已归档或写入失败
+ * @details 记录块边编码边写出，索引在内存中累积后写在文件末尾，最后回填文件头。
+ *          先写临时文件，完整写出后再改名，中途失败不会留下残缺的段文件
+ */
+bool HistoryArchive::writeYear(int year, const std::vector<Batch>& batches) {
+    if (!opened || year < 1000 || year > 9999 ||
+        std::any_of(segments.begin(), segments.end(), [year](const Segment& s) { return s.year == year; })) {
+        return false;
+    }
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    std::string path = segmentPath(year);
+    std::string tempPath = path + ".tmp";
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+
+    const size_t FLUSH_BYTES = 1 << 20;  // 缓冲达到该大小即写出
+    std::string buffer(HEADER_BYTES, '\0');  // 文件头占位，最后回填
+    std::string index;
+    index.reserve(batches.size() * ENTRY_BYTES);
+    uint64_t written = 0;
+    for (const Batch& batch : batches) {
+        appendValue(index, static_cast<int32_t>(batch.id));
+        appendValue(index, static_cast<uint32_t>(batch.count));
+        appendValue(index, static_cast<uint64_t>(written + buffer.size()));
+        for (size_t i = 0; i < batch.count; ++i) {
+            encodeRecord(buffer, batch.records[i]);
+        }
+        if (buffer.size() >= FLUSH_BYTES) {
+            file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            written += buffer.size();
+            buffer.clear();
+        }
+    }
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    written += buffer.size();
+    file.write(index.data(), static_cast<std::streamsize>(index.size()));
+
+    std::string header(MAGIC, sizeof(MAGIC));
+    appendValue(header, static_cast<int32_t>(year));
+    appendValue(header, static_cast<uint32_t>(batches.size()));
+    appendValue(header, uint32_t(0));
+    appendValue(header, written);
+    file.seekp(0);
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+    file.close();
+
+    Segment segment;
+    if (!file || std::rename(tempPath.c_str(), path.c_str()) != 0 || !readHeader(path, segment)) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    segments.push_back(std::move(segment));
+    std::sort(segments.begin(), segments.end(), [](const Segment& a, const Segment& b) { return a.year < b.year; });
+    return true;
+}
+
+// ==================== 读取 ====================
+
+/**
+ * @brief 在段文件的索引中二分查找会员
+ * @param segment 段文件
+ * @param file 已打开的段文件
+ * @param id 会员ID
+ * @param location 输出：记录块位置
+ * @return true 找到，false 没有该会员或读取失败
+ * @details 每次比较只读一个索引项，记录块长度由下一项的位置（或索引起点）得出
+ */
+bool HistoryArchive::locate(const Segment& segment, std::ifstream& file, int id, Location& location) const {
+    size_t low = 0, high = segment.memberCount;
+    char entry[2 * ENTRY_BYTES];
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        bool hasNext = middle + 1 < segment.memberCount;
+        std::streamsize length = static_cast<std::streamsize>(hasNext ? 2 * ENTRY_BYTES : ENTRY_BYTES);
+        if (!file.seekg(static_cast<std::streamoff>(segment.indexOffset + middle * ENTRY_BYTES)) ||
+            !file.read(entry, length)) {
+            return false;
+        }
+        int32_t entryId = loadValue<int32_t>(entry);
+        if (entryId < id) {
+            low = middle + 1;
+        } else if (entryId > id) {
+            high = middle;
+        } else {
+            location.count = loadValue<uint32_t>(entry + 4);
+            location.offset = loadValue<uint64_t>(entry + 8);
+            uint64_t next = hasNext ? loadValue<uint64_t>(entry + ENTRY_BYTES + 8) : segment.indexOffset;
+            if (location.offset < HEADER_BYTES || next < location.offset || next > segment.indexOffset) {
+                return false;
+            }
+            location.length = next - location.offset;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 获取会员在某年度归档中的记录条数
+ * @param segment 段序号
+ * @param id 会员ID
+ * @return 记录条数
+ */
+size_t HistoryArchive::recordCount(size_t segment, int id) const {
+    std::ifstream file(segments[segment].path, std::ios::binary);
+    Location location;
+    return (file && locate(segments[segment], file, id, location)) ? location.count : 0;
+}
+
+/**
+ * @brief 读取会员在某年度归档中的记录
+ * @param segment 段序号
+ * @param id 会员ID
+ * @param out 输出：记录
+ * @return true 成功，false 读取失败
+ */
+bool HistoryArchive::read(size_t segment, int id, std::vector<Record>& out) const {
+    out.clear();
+    std::ifstream file(segments[segment].path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    Location location;
+    if (!locate(segments[segment], file, id, location)) {
+        return !file.fail();
+    }
+    std::string block(location.length, '\0');
+    if (!file.seekg(static_cast<std::streamoff>(location.offset)) ||
+        !file.read(block.data(), static_cast<std::streamsize>(block.size()))) {
+        return false;
+    }
+    out.resize(location.count);
+    const char* p = block.data();
+    const char* end = p + block.size();
+    for (Record& record : out) {
+        if (!decodeRecord(p, end, record)) {
+            out.clear();
+            return false;
+        }
+    }
+    return p == end;
+}
+
+/**
+ * @brief 获取全部段文件的总大小
+ * @return 字节数
+ */
+uint64_t HistoryArchive::diskBytes() const {
+    uint64_t bytes = 0;
+    for (const Segment& segment : segments) {
+        bytes += segment.fileSize;
+    }
+    return bytes;
+}
@@ -0,0 +1,416 @@
+/**
+ * @file LatencyStats.cpp
+ * @brief 耗时直方图与操作耗时统计实现文件
+ * @details 实现对数-线性分桶、分位数计算、每线程计数器的分配与合并、硬件事件的累计以及 Prometheus 文本输出
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "LatencyStats.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <memory>
+#include <mutex>
+
+// ==================== LatencyHistogram ====================
+
+LatencyHistogram::LatencyHistogram() : counts(BUCKET_COUNT, 0) {}
+
+/**
+ * @brief 计算耗时所在的桶
+ * @param nanoseconds 耗时（纳秒）
+ * @return 桶下标
+ * @details 小于 2^SUB_BUCKET_BITS 的值直接作为下标；否则右移到只剩 SUB_BUCKET_BITS 位，
+ *          下标 = 右移位数 * HALF_BUCKETS + 剩余的值，相邻区间的下标首尾相接
+ */
+int LatencyHistogram::bucketOf(uint64_t nanoseconds) {
+    if (nanoseconds < 2 * HALF_BUCKETS) {
+        return static_cast<int>(nanoseconds);
+    }
+    int shift = std::bit_width(nanoseconds) - SUB_BUCKET_BITS;
+    if (shift > MAX_SHIFT) {
+        return BUCKET_COUNT - 1;
+    }
+    return shift * HALF_BUCKETS + static_cast<int>(nanoseconds >> shift);
+}
+
+/**
+ * @brief 获取桶的下界（纳秒，含）
+ * @param bucket 桶下标
+ */
+uint64_t LatencyHistogram::bucketLow(int bucket) {
+    if (bucket < 2 * HALF_BUCKETS) {
+        return static_cast<uint64_t>(bucket);
+    }
+    int shift = bucket / HALF_BUCKETS - 1;
+    return static_cast<uint64_t>(bucket - shift * HALF_BUCKETS) << shift;
+}
+
+/**
+ * @brief 获取桶的上界（纳秒，含）
+ * @param bucket 桶下标
+ */
+uint64_t LatencyHistogram::bucketHigh(int bucket) {
+    if (bucket < 2 * HALF_BUCKETS) {
+        return static_cast<uint64_t>(bucket);
+    }
+    int shift = bucket / HALF_BUCKETS - 1;
+    return (static_cast<uint64_t>(bucket - shift * HALF_BUCKETS + 1) << shift) - 1;
+}
+
+/**
+ * @brief 记录一次耗时
+ * @param nanoseconds 耗时（纳秒）
+ */
+void LatencyHistogram::record(uint64_t nanoseconds) {
+    add(bucketOf(nanoseconds), 1);
+    sumNs += nanoseconds;
+    maxNs = std::max(maxNs, nanoseconds);
+}
+
+/**
+ * @brief 清空
+ */
+void LatencyHistogram::clear() {
+    std::fill(counts.begin(), counts.end(), 0);
+    total = sumNs = maxNs = 0;
+}
+
+/**
+ * @brief 获取分位数
+ * @param quantile 分位（0-1）
+ * @return 耗时（纳秒）
+ */
+uint64_t LatencyHistogram::percentile(double quantile) const {
+    if (total == 0) {
+        return 0;
+    }
+    // 第 rank 次（从1计）记录所在的桶
+    uint64_t rank = static_cast<uint64_t>(std::ceil(std::clamp(quantile, 0.0, 1.0) * static_cast<double>(total)));
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        seen += counts[bucket];
+        if (seen >= rank) {
+            uint64_t low = bucketLow(bucket);
+            uint64_t middle = low + (bucketHigh(bucket) - low) / 2;
+            return std::min(middle, maxNs);
+        }
+    }
+    return maxNs;
+}
+
+// ==================== 每线程计数器 ====================
+
+namespace {
+
+/**
+ * @struct ThreadCounters
+ * @brief 一个线程的全部计数器
+ * @details 只有所属线程写入（先读后写，不需要原子读改写），读取线程可能同时读取，因此用原子变量避免数据竞争
+ */
+struct ThreadCounters {
+    std::atomic<uint64_t> counts[PerfStats::OP_COUNT][LatencyHistogram::BUCKET_COUNT] = {};
+    std::atomic<uint64_t> sums[PerfStats::OP_COUNT] = {};
+    std::atomic<uint64_t> maxima[PerfStats::OP_COUNT] = {};
+    std::atomic<uint64_t> hardwareSamples[PerfStats::OP_COUNT][HardwareCounters::COUNTER_COUNT] = {};
+    std::atomic<uint64_t> hardwareEvents[PerfStats::OP_COUNT][HardwareCounters::COUNTER_COUNT] = {};
+};
+
+/**
+ * @struct Registry
+ * @brief 全部线程计数器的登记处
+ */
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadCounters>> all;  ///< 所有分配过的计数器（不释放，保证读取时有效）
+    std::vector<ThreadCounters*> idle;                 ///< 线程已退出、可复用的计数器
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+/**
+ * @struct ThreadSlot
+ * @brief 线程持有的计数器，线程退出时交还登记处
+ */
+struct ThreadSlot {
+    ThreadCounters* counters = nullptr;
+    ~ThreadSlot() {
+        if (counters) {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            reg.idle.push_back(counters);
+        }
+    }
+};
+
+/**
+ * @brief 获取当前线程的计数器，第一次调用时分配或复用一组
+ */
+ThreadCounters& localCounters() {
+    thread_local ThreadSlot slot;
+    if (!slot.counters) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        if (!reg.idle.empty()) {
+            slot.counters = reg.idle.back();
+            reg.idle.pop_back();
+        } else {
+            reg.all.push_back(std::make_unique<ThreadCounters>());
+            slot.counters = reg.all.back().get();
+        }
+    }
+    return *slot.counters;
+}
+
+/**
+ * @brief 获取当前线程的硬件计数器，第一次调用时打开
+ * @details 计数器只统计打开它的线程，因此每个线程各打开一组，线程退出时关闭
+ */
+HardwareCounters& localHardware() {
+    thread_local HardwareCounters counters;
+    return counters;
+}
+
+/// 单写者递增：所属线程之外没有写入者，读后写即可
+inline void bump(std::atomic<uint64_t>& counter, uint64_t delta) {
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+const char* const OPERATION_NAMES[PerfStats::OP_COUNT] = {
+    "addMember",
+    "deleteMember",
+    "updateMemberPhone",
+    "getMemberById",
+    "getMemberByPhone",
+    "findMembersByPhonePrefix",
+    "findMembersByName",
+    "findMembersByBirthday",
+    "addSpending",
+    "redeemPoints",
+    "grantBirthdayBonus",
+    "saveToFile",
+    "loadFromFile",
+    "getTopMembers",
+    "getMemberRank",
+    "sortMembers",
+    "evictDormant",
+    "archiveHistory",
+};
+
+} // namespace
+
+// ==================== PerfStats ====================
+
+/**
+ * @brief 获取操作名称
+ * @param operation 操作
+ */
+const char* PerfStats::operationName(Operation operation) {
+    return OPERATION_NAMES[operation];
+}
+
+/**
+ * @brief 记录一次耗时
+ * @param operation 操作
+ * @param nanoseconds 耗时（纳秒）
+ */
+void PerfStats::record(Operation operation, uint64_t nanoseconds) {
+    ThreadCounters& counters = localCounters();
+    bump(counters.counts[operation][LatencyHistogram::bucketOf(nanoseconds)], 1);
+    bump(counters.sums[operation], nanoseconds);
+    if (nanoseconds > counters.maxima[operation].load(std::memory_order_relaxed)) {
+        counters.maxima[operation].store(nanoseconds, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief 合并所有线程的计数器
+ * @param operation 操作
+ * @param out 输出：合并后的直方图
+ */
+void PerfStats::snapshot(Operation operation, LatencyHistogram& out) {
+    out.clear();
+    uint64_t sum = 0, maximum = 0;
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& counters : reg.all) {
+        for (int bucket = 0; bucket < LatencyHistogram::BUCKET_COUNT; ++bucket) {
+            uint64_t count = counters->counts[operation][bucket].load(std::memory_order_relaxed);
+            if (count) {
+                out.add(bucket, count);
+            }
+        }
+        sum += counters->sums[operation].load(std::memory_order_relaxed);
+        maximum = std::max(maximum, counters->maxima[operation].load(std::memory_order_relaxed));
+    }
+    out.setSum(sum);
+    out.setMax(maximum);
+}
+
+/**
+ * @brief 清零全部计数器
+ */
+void PerfStats::reset() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& counters : reg.all) {
+        for (int operation = 0; operation < OP_COUNT; ++operation) {
+            for (auto& count : counters->counts[operation]) {
+                count.store(0, std::memory_order_relaxed);
+            }
+            counters->sums[operation].store(0, std::memory_order_relaxed);
+            counters->maxima[operation].store(0, std::memory_order_relaxed);
+            for (int counter = 0; counter < HardwareCounters::COUNTER_COUNT; ++counter) {
+                counters->hardwareSamples[operation][counter].store(0, std::memory_order_relaxed);
+                counters->hardwareEvents[operation][counter].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 以 Prometheus 文本格式输出全部操作的统计
+ * @param out 输出流
+ */
+void PerfStats::writePrometheus(std::ostream& out) {
+    const double QUANTILES[] = { 0.5, 0.99, 0.999 };
+    out << "# HELP member_operation_duration_seconds MemberManager operation latency.\n"
+        << "# TYPE member_operation_duration_seconds summary\n";
+    LatencyHistogram histogram;
+    for (int operation = 0; operation < OP_COUNT; ++operation) {
+        snapshot(static_cast<Operation>(operation), histogram);
+        const char* name = operationName(static_cast<Operation>(operation));
+        for (double quantile : QUANTILES) {
+            // 没有记录时按 Prometheus 的约定输出 NaN
+            out << "member_operation_duration_seconds{operation=\"" << name << "\",quantile=\"" << quantile << "\"} ";
+            if (histogram.count() == 0) {
+                out << "NaN\n";
+            } else {
+                out << static_cast<double>(histogram.percentile(quantile)) / 1e9 << "\n";
+            }
+        }
+        out << "member_operation_duration_seconds_sum{operation=\"" << name << "\"} "
+            << static_cast<double>(histogram.sum()) / 1e9 << "\n"
+            << "member_operation_duration_seconds_count{operation=\"" << name << "\"} "
+            << histogram.count() << "\n";
+    }
+    out << "# HELP member_operation_max_duration_seconds Longest observed MemberManager operation.\n"
+        << "# TYPE member_operation_max_duration_seconds gauge\n";
+    for (int operation = 0; operation < OP_COUNT; ++operation) {
+        snapshot(static_cast<Operation>(operation), histogram);
+        out << "member_operation_max_duration_seconds{operation=\"" << operationName(static_cast<Operation>(operation))
+            << "\"} " << static_cast<double>(histogram.max()) / 1e9 << "\n";
+    }
+
+    // 硬件事件只输出开启硬件计数期间有记录的操作
+    HardwareTotals totals[OP_COUNT];
+    bool anyHardware = false;
+    for (int operation = 0; operation < OP_COUNT; ++operation) {
+        hardwareSnapshot(static_cast<Operation>(operation), totals[operation]);
+        for (uint64_t samples : totals[operation].samples) {
+            anyHardware = anyHardware || samples > 0;
+        }
+    }
+    if (!anyHardware) {
+        return;
+    }
+    out << "# HELP member_operation_cpu_events_total CPU hardware events counted during MemberManager operations.\n"
+        << "# TYPE member_operation_cpu_events_total counter\n";
+    for (int operation = 0; operation < OP_COUNT; ++operation) {
+        for (int counter = 0; counter < HardwareCounters::COUNTER_COUNT; ++counter) {
+            if (totals[operation].samples[counter] > 0) {
+                out << "member_operation_cpu_events_total{operation=\"" << operationName(static_cast<Operation>(operation))
+                    << "\",event=\"" << HardwareCounters::counterName(static_cast<HardwareCounters::Counter>(counter))
+                    << "\"} " << totals[operation].events[counter] << "\n";
+            }
+        }
+    }
+    out << "# HELP member_operation_cpu_event_samples_total MemberManager operations measured with hardware counters.\n"
+        << "# TYPE member_operation_cpu_event_samples_total counter\n";
+    for (int operation = 0; operation < OP_COUNT; ++operation) {
+        for (int counter = 0; counter < HardwareCounters::COUNTER_COUNT; ++counter) {
+            if (totals[operation].samples[counter] > 0) {
+                out << "member_operation_cpu_event_samples_total{operation=\""
+                    << operationName(static_cast<Operation>(operation)) << "\",event=\""
+                    << HardwareCounters::counterName(static_cast<HardwareCounters::Counter>(counter)) << "\"} "
+                    << totals[operation].samples[counter] << "\n";
+            }
+        }
+    }
+}
+
+// ==================== 硬件计数 ====================
+
+/**
+ * @brief 开启或关闭各操作的硬件计数
+ * @param on true 开启
+ * @return 开启时返回当前线程能否打开硬件计数器；关闭时总是返回 true
+ */
+bool PerfStats::setHardwareCounting(bool on) {
+    if (on && !localHardware().available()) {
+        return false;
+    }
+    hardwareOn.store(on, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * @brief 获取当前线程的硬件计数器打不开的原因
+ */
+const char* PerfStats::hardwareUnavailableReason() {
+    return localHardware().unavailableReason();
+}
+
+/**
+ * @brief 读取当前线程的硬件计数器
+ * @param out 输出：读数
+ * @return true 读取成功
+ */
+bool PerfStats::readHardware(HardwareCounters::Reading& out) {
+    return localHardware().read(out);
+}
+
+/**
+ * @brief 记录一次操作期间的硬件事件
+ * @param operation 操作
+ * @param start 操作开始时的读数
+ */
+void PerfStats::recordHardware(Operation operation, const HardwareCounters::Reading& start) {
+    HardwareCounters& hardware = localHardware();
+    HardwareCounters::Reading reading;
+    if (!hardware.read(reading)) {
+        return;
+    }
+    reading -= start;
+    ThreadCounters& counters = localCounters();
+    for (int counter = 0; counter < HardwareCounters::COUNTER_COUNT; ++counter) {
+        if (hardware.has(static_cast<HardwareCounters::Counter>(counter))) {
+            bump(counters.hardwareSamples[operation][counter], 1);
+            bump(counters.hardwareEvents[operation][counter], reading.values[counter]);
+        }
+    }
+}
+
+/**
+ * @brief 合并所有线程的硬件事件
+ * @param operation 操作
+ * @param out 输出：合并后的事件数
+ */
+void PerfStats::hardwareSnapshot(Operation operation, HardwareTotals& out) {
+    out = HardwareTotals();
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& counters : reg.all) {
+        for (int counter = 0; counter < HardwareCounters::COUNTER_COUNT; ++counter) {
+            out.samples[counter] += counters->hardwareSamples[operation][counter].load(std::memory_order_relaxed);
+            out.events[counter] += counters->hardwareEvents[operation][counter].load(std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,251 @@
+/**
+ * @file LevelPredictor.cpp
+ * @brief 批量会员等级预测引擎实现文件
+ * @details 实现列式抽取、多线程预测内核、分桶统计以及CSV/二进制结果输出
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "LevelPredictor.h"
+#include "Parallel.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+/// 输出缓冲区大小，攒满后整块写出
+constexpr size_t OUTPUT_BUFFER_SIZE = 1 << 20;
+
+/// 二进制结果文件魔数与版本
+constexpr char BINARY_MAGIC[4] = { 'M', 'L', 'P', 'R' };
+constexpr uint32_t BINARY_VERSION = 1;
+
+/**
+ * @struct BinaryRecord
+ * @brief 二进制结果文件中的定长记录
+ */
+#pragma pack(push, 1)
+struct BinaryRecord {
+    int32_t id;
+    uint8_t currentLevel;
+    uint8_t predictedLevel;
+    uint8_t gapBucket;
+    uint8_t reserved;
+    double annualSpent;
+    double predictedSpent;
+    double gapToNext;
+};
+#pragma pack(pop)
+
+/**
+ * @brief 向缓冲区追加一个数值
+ * @param buffer 输出缓冲区
+ * @param value 数值
+ */
+template <typename T>
+void appendNumber(std::string& buffer, T value) {
+    char text[32];
+    std::to_chars_result result;
+    if constexpr (std::is_floating_point_v<T>) {
+        result = std::to_chars(text, text + sizeof(text), value, std::chars_format::fixed, 2);
+    } else {
+        result = std::to_chars(text, text + sizeof(text), value);
+    }
+    buffer.append(text, result.ptr);
+}
+
+}  // namespace
+
+/**
+ * @brief 构造函数
+ * @param currentMonth 当前月份（1-12），用于计算月均消费
+ * @param threads 工作线程数，0 表示使用硬件并发数
+ */
+LevelPredictor::LevelPredictor(int currentMonth, unsigned threads)
+    : currentMonth(currentMonth), threads(threads) {
+    if (this->currentMonth <= 0 || this->currentMonth > 12) {
+        this->currentMonth = 1;  // 如果月份无效，默认为1月
+    }
+    if (this->threads == 0) {
+        this->threads = defaultThreadCount();
+    }
+}
+
+/**
+ * @brief 对所有会员执行批量预测
+ * @param members 会员列表
+ * @return 预测汇总结果
+ */
+LevelPredictor::Summary LevelPredictor::predictAll(const std::vector<Member>& members) {
+    MEMBER_TRACE_SCOPE("predictAll");
+    size_t count = members.size();
+    ids.resize(count);
+    annualSpent.resize(count);
+    currentLevels.resize(count);
+    predictedSpent.resize(count);
+    predictedLevels.resize(count);
+    gapToNext.resize(count);
+    gapBuckets.resize(count);
+
+    std::vector<Summary> partial(threads);
+    parallelFor(count, threads, [&](unsigned t, size_t begin, size_t end) {
+        MEMBER_TRACE_SCOPE("predict.range");
+        // 抽取列数据（AoS -> SoA）
+        for (size_t i = begin; i < end; ++i) {
+            const Member& member = members[i];
+            ids[i] = member.getId();
+            annualSpent[i] = member.getAnnualSpent();
+            currentLevels[i] = static_cast<uint8_t>(member.getCurrentLevel());
+        }
+        predictRange(begin, end, partial[t]);
+    });
+
+    // 合并各线程的局部统计
+    Summary summary;
+    for (const auto& part : partial) {
+        summary.total += part.total;
+        summary.upgradeCount += part.upgradeCount;
+        summary.predictedTotal += part.predictedTotal;
+        for (int level = 0; level < LEVEL_COUNT; ++level) {
+            summary.levelCount[level] += part.levelCount[level];
+            for (int bucket = 0; bucket < GAP_BUCKET_COUNT; ++bucket) {
+                summary.bucketCount[level][bucket] += part.bucketCount[level][bucket];
+            }
+        }
+    }
+    return summary;
+}
+
+/**
+ * @brief 预测内核
+ * @param begin 起始行（含）
+ * @param end 结束行（不含）
+ * @param summary 本线程的局部汇总
+ * @details 年末预测消费 = 当前消费 + 月均消费 × 剩余月份 = 当前消费 × 12 / 当前月份
+ */
+void LevelPredictor::predictRange(size_t begin, size_t end, Summary& summary) {
+    const double factor = 12.0 / currentMonth;
+    const double* spent = annualSpent.data();
+    double* predicted = predictedSpent.data();
+    uint8_t* levels = predictedLevels.data();
+    double* gaps = gapToNext.data();
+    uint8_t* buckets = gapBuckets.data();
+
+    // 第一遍：纯算术，无分支，可向量化
+    for (size_t i = begin; i < end; ++i) {
+        double value = std::max(spent[i], 0.0) * factor;
+        int level = (value >= Member::SILVER_THRESHOLD)
+                  + (value >= Member::GOLD_THRESHOLD)
+                  + (value >= Member::DIAMOND_THRESHOLD);
+        double next = level == 0 ? Member::SILVER_THRESHOLD
+                    : level == 1 ? Member::GOLD_THRESHOLD
+                    : level == 2 ? Member::DIAMOND_THRESHOLD
+                    : value;
+        double gap = next - value;
+        int bucket = (gap > 2000.0) + (gap > 5000.0) + (gap > 10000.0);
+        predicted[i] = value;
+        levels[i] = static_cast<uint8_t>(level);
+        gaps[i] = gap;
+        buckets[i] = static_cast<uint8_t>(level == Member::DIAMOND ? GAP_TOP_LEVEL : bucket);
+    }
+
+    // 第二遍：分桶计数
+    for (size_t i = begin; i < end; ++i) {
+        summary.levelCount[levels[i]]++;
+        summary.bucketCount[levels[i]][buckets[i]]++;
+        summary.upgradeCount += levels[i] > currentLevels[i];
+        summary.predictedTotal += predicted[i];
+    }
+    summary.total += end - begin;
+}
+
+/**
+ * @brief 将最近一次预测结果写入文件
+ * @param filename 输出文件名
+ * @param format 输出格式
+ * @return true 写入成功，false 无法打开或写入失败
+ */
+bool LevelPredictor::writeResults(const std::string& filename, OutputFormat format) const {
+    MEMBER_TRACE_SCOPE("predict.write");
+    FILE* file = std::fopen(filename.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    bool ok = true;
+    size_t count = ids.size();
+    if (format == FORMAT_BINARY) {
+        uint32_t header[2] = { BINARY_VERSION, static_cast<uint32_t>(count) };
+        ok = std::fwrite(BINARY_MAGIC, sizeof(BINARY_MAGIC), 1, file) == 1
+          && std::fwrite(header, sizeof(header), 1, file) == 1;
+
+        std::vector<BinaryRecord> block(OUTPUT_BUFFER_SIZE / sizeof(BinaryRecord));
+        for (size_t start = 0; ok && start < count; start += block.size()) {
+            size_t n = std::min(block.size(), count - start);
+            for (size_t j = 0; j < n; ++j) {
+                size_t i = start + j;
+                block[j] = { ids[i], currentLevels[i], predictedLevels[i], gapBuckets[i], 0,
+                             annualSpent[i], predictedSpent[i], gapToNext[i] };
+            }
+            ok = std::fwrite(block.data(), sizeof(BinaryRecord), n, file) == n;
+        }
+    } else {
+        std::string buffer;
+        buffer.reserve(OUTPUT_BUFFER_SIZE + 256);
+        buffer += "id,annualSpent,predictedSpent,currentLevel,predictedLevel,gapToNext,gapBucket\n";
+        for (size_t i = 0; ok && i < count; ++i) {
+            appendNumber(buffer, ids[i]);
+            buffer += ',';
+            appendNumber(buffer, annualSpent[i]);
+            buffer += ',';
+            appendNumber(buffer, predictedSpent[i]);
+            buffer += ',';
+            appendNumber(buffer, static_cast<int>(currentLevels[i]));
+            buffer += ',';
+            appendNumber(buffer, static_cast<int>(predictedLevels[i]));
+            buffer += ',';
+            appendNumber(buffer, gapToNext[i]);
+            buffer += ',';
+            appendNumber(buffer, static_cast<int>(gapBuckets[i]));
+            buffer += '\n';
+            if (buffer.size() >= OUTPUT_BUFFER_SIZE) {
+                ok = std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+                buffer.clear();
+            }
+        }
+        if (ok && !buffer.empty()) {
+            ok = std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+        }
+    }
+
+    return std::fclose(file) == 0 && ok;
+}
+
+/**
+ * @brief 获取差额分桶的显示名称
+ * @param bucket 分桶编号
+ * @return 分桶名称
+ */
+const char* LevelPredictor::bucketName(GapBucket bucket) {
+    switch (bucket) {
+    case GAP_WITHIN_2000: return "差额<=2000元";
+    case GAP_WITHIN_5000: return "差额<=5000元";
+    case GAP_WITHIN_10000: return "差额<=10000元";
+    case GAP_OVER_10000: return "差额>10000元";
+    case GAP_TOP_LEVEL: return "已达最高等级";
+    default: return "未知";
+    }
+}
+
+/**
+ * @brief 获取最近一次预测的会员数量
+ * @return 预测结果行数
+ */
+size_t LevelPredictor::size() const {
+    return ids.size();
+}
@@ -8,9 +8,12 @@
  */
 
 #include "Member.h"
-#include <iostream>
 #include <ctime>
-#include <iomanip>
+#include <limits>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
 
 /**
  * @brief 构造函数
@@ -138,28 +141,54 @@ double Member::getAnnualSpent() const {
 /**
  * @brief 设置积分规则
  * @param rule 新的积分规则（1元=多少积分）
+ * @return true 设置成功，false 规则无效
  * @details 更新积分计算规则，影响后续消费的积分计算
  */
-void Member::setPointsRule(int rule) {
+bool Member::setPointsRule(int rule) {
     if (rule <= 0) {
-        std::cout << "积分规则必须大于 0！" << std::endl;
-        return;
+        return false;
     }
     pointsPerDollar = rule;
+    return true;
+}
+
+/**
+ * @brief 恢复数据文件中保存的累计数据
+ * @param totalSpent 总消费金额
+ * @param points 当前积分
+ * @param level 会员等级
+ */
+void Member::restoreTotals(double totalSpent, int points, Level level) {
+    this->totalSpent = totalSpent;
+    this->points = points;
+    currentLevel = level;
 }
 
 /**
  * @brief 积分兑换
  * @param pointsToRedeem 要兑换的积分数量
+ * @return true 兑换成功，false 积分不足或兑换数量无效
  * @details 使用积分进行兑换，减少当前积分余额
  */
-void Member::redeemPoints(int pointsToRedeem) {
+bool Member::redeemPoints(int pointsToRedeem) {
     if (pointsToRedeem <= 0 || pointsToRedeem > points) {
-        std::cout << "积分不足或兑换数量无效！" << std::endl;
-        return;
+        return false;
     }
     points -= pointsToRedeem;
-    std::cout << "成功兑换 " << pointsToRedeem << " 积分，剩余积分: " << points << std::endl;
+    return true;
+}
+
+/**
+ * @brief 赠送奖励积分
+ * @param bonus 奖励的积分数量
+ * @return true 赠送成功，false 数量无效或积分将溢出
+ */
+bool Member::addBonusPoints(int bonus) {
+    if (bonus <= 0 || bonus > std::numeric_limits<int>::max() - points) {
+        return false;
+    }
+    points += bonus;
+    return true;
 }
 
 /**
@@ -172,10 +201,20 @@ void Member::redeemPoints(int pointsToRedeem) {
  * - 普通会员：年度消费 < 5000元
  */
 void Member::determineLevel() {
-    if (annualSpent >= 20000) currentLevel = DIAMOND;
-    else if (annualSpent >= 10000) currentLevel = GOLD;
-    else if (annualSpent >= 5000) currentLevel = SILVER;
-    else currentLevel = NORMAL;
+    currentLevel = levelForAmount(annualSpent);
+}
+
+/**
+ * @brief 根据年度消费金额计算对应等级
+ * @param amount 年度消费金额
+ * @return 对应的会员等级
+ * @details 等级阈值见 determineLevel()，供等级预测等批量计算复用
+ */
+Member::Level Member::levelForAmount(double amount) {
+    if (amount >= DIAMOND_THRESHOLD) return DIAMOND;
+    if (amount >= GOLD_THRESHOLD) return GOLD;
+    if (amount >= SILVER_THRESHOLD) return SILVER;
+    return NORMAL;
 }
 
 /**
@@ -189,7 +228,16 @@ void Member::determineLevel() {
  * - 普通会员：无折扣
  */
 double Member::getDiscountRate() const {
-    switch (currentLevel) {
+    return discountRateFor(currentLevel);
+}
+
+/**
+ * @brief 获取指定等级的折扣率
+ * @param level 会员等级
+ * @return 折扣率
+ */
+double Member::discountRateFor(Level level) {
+    switch (level) {
     case DIAMOND: return 0.8;  // 钻石会员8折
     case GOLD: return 0.9;     // 黄金会员9折
     case SILVER: return 0.95;  // 白银会员95折
@@ -200,6 +248,7 @@ double Member::getDiscountRate() const {
 /**
  * @brief 添加消费记录并更新积分/等级
  * @param amount 消费金额
+ * @return 本次消费的结算结果
  * @details 记录消费并自动计算积分、更新等级、应用折扣优惠
  * 处理流程：
  * 1. 检查是否跨年，如果是则重置年度消费
@@ -210,18 +259,28 @@ double Member::getDiscountRate() const {
  * 6. 更新总消费和积分
  * 7. 记录消费历史
  */
-void Member::addSpending(double amount) {
-    // 获取当前时间信息
-    time_t now = time(0);
-    tm timeInfo;
+Member::SpendingReceipt Member::addSpending(double amount) {
+    return addSpending(amount, time(0));
+}
 
-    errno_t ltm = localtime_s(&timeInfo, &now);
-    int currentYear = 1900 + timeInfo.tm_year;
+/**
+ * @brief 按指定时间添加消费记录并更新积分/等级
+ * @param amount 消费金额
+ * @param when 消费发生的时间
+ * @return 本次消费的结算结果
+ * @details 处理流程同上，另外把消费计入按日、按月分桶的消费汇总
+ */
+Member::SpendingReceipt Member::addSpending(double amount, time_t when) {
+    // 获取消费日期信息
+    int32_t dayKey, monthKey;
+    rollupKeys(when, dayKey, monthKey);
+    int currentYear = monthKey / 12;
 
     // 检查是否跨年，如果是则重置年度消费
     if (lastYear != currentYear) {
         annualSpent = 0.0;
         lastYear = currentYear;
+        yearStart = consumptionHistory.size();
     }
 
     // 更新年度消费金额
@@ -245,43 +304,153 @@ void Member::addSpending(double amount) {
     
     // 记录消费历史（原价和折扣率）
     consumptionHistory.push_back({ amount, discountRate });
+    spendingRollup.add(amount, dayKey, monthKey);
+
+    // 返回消费详情，由调用方决定如何展示
+    SpendingReceipt receipt;
+    receipt.amount = amount;
+    receipt.discountRate = discountRate;
+    receipt.actualAmount = actualAmount;
+    receipt.earnedPoints = earnedPoints;
+    receipt.totalPoints = points;
+    receipt.level = currentLevel;
+    return receipt;
+}
+
+/**
+ * @brief 获取按日、按月分桶的消费汇总
+ * @return 消费汇总环形缓冲区
+ */
+const MemberSpendingRollup& Member::getSpendingRollup() const {
+    return spendingRollup;
+}
+
+// ==================== 序列化 ====================
+
+namespace {
+
+static_assert(std::is_trivially_copyable_v<MemberSpendingRollup>, "消费汇总需要能够按字节复制");
 
-    // 输出消费详情
-    std::cout << "消费 " << amount << " 元，享受 " << discountRate * 10 << " 折优惠，实际支付 " << actualAmount << " 元，累计积分: " << points << std::endl;
+/// 追加一个定长数值
+template <typename T>
+void appendValue(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
 }
 
+/// 追加一个带长度前缀的字符串
+void appendString(std::string& out, const std::string& text) {
+    appendValue(out, static_cast<uint32_t>(text.size()));
+    out.append(text);
+}
+
+/// 读取一个定长数值，数据不足时返回 false
+template <typename T>
+bool readValue(std::string_view& in, T& value) {
+    if (in.size() < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, in.data(), sizeof(T));
+    in.remove_prefix(sizeof(T));
+    return true;
+}
+
+/// 读取一个带长度前缀的字符串，数据不足时返回 false
+bool readString(std::string_view& in, std::string& text) {
+    uint32_t length;
+    if (!readValue(in, length) || in.size() < length) {
+        return false;
+    }
+    text.assign(in.data(), length);
+    in.remove_prefix(length);
+    return true;
+}
+
+} // namespace
+
 /**
- * @brief 显示消费记录
- * @param n 显示最近N次消费记录，-1表示显示全部
- * @details 显示会员的消费历史，包括原价、折扣和实际支付金额
+ * @brief 将会员的全部状态序列化为二进制记录
+ * @param out 输出：记录追加到末尾
  */
-void Member::showConsumptionHistory(int n) const {
-    if (consumptionHistory.empty()) {
-        std::cout << "暂无消费记录！" << std::endl;
-        return;
+void Member::serialize(std::string& out) const {
+    appendValue(out, static_cast<int32_t>(id));
+    appendString(out, name);
+    appendString(out, phone);
+    appendString(out, birthday);
+    appendValue(out, totalSpent);
+    appendValue(out, static_cast<int32_t>(points));
+    appendValue(out, static_cast<int32_t>(pointsPerDollar));
+    appendValue(out, annualSpent);
+    appendValue(out, static_cast<int32_t>(currentLevel));
+    appendValue(out, static_cast<int32_t>(lastYear));
+    appendValue(out, static_cast<uint32_t>(yearStart));
+    appendValue(out, static_cast<uint32_t>(consumptionHistory.size()));
+    for (const auto& record : consumptionHistory) {
+        appendValue(out, record.first);
+        appendValue(out, record.second);
     }
-    
-    // 确定显示的起始位置
-    int startIndex = (n == -1) ? 0 : std::max(0, static_cast<int>(consumptionHistory.size()) - n);
-    int displayCount = consumptionHistory.size() - startIndex;
-    
-    std::cout << "\n消费记录 (" << displayCount << " 条):" << std::endl;
-    std::cout << "┌─────────────┬─────────────┬─────────────┬─────────────┐" << std::endl;
-    std::cout << "│    序号     │    原价     │    折扣     │  实际支付   │" << std::endl;
-    std::cout << "├─────────────┼─────────────┼─────────────┼─────────────┤" << std::endl;
-    
-    // 遍历并显示消费记录
-    for (int i = startIndex; i < consumptionHistory.size(); ++i) {
-        double original = consumptionHistory[i].first;    // 原价
-        double rate = consumptionHistory[i].second;       // 折扣率
-        double actual = original * rate;                  // 实际支付金额
-        int recordNum = i - startIndex + 1;               // 显示序号
-        
-        std::cout << "│ " << std::left << std::setw(11) << recordNum
-                  << " │ " << std::left << std::setw(5) << std::fixed << std::setprecision(2) << original << "元"
-                  << " │ " << std::left << std::setw(5) << std::fixed << std::setprecision(1) << (rate * 10) << "折"
-                  << " │ " << std::left << std::setw(5) << std::fixed << std::setprecision(2) << actual << "元"
-                  << " │" << std::endl;
+    appendValue(out, spendingRollup);
+}
+
+/**
+ * @brief 从二进制记录恢复会员
+ * @param record 由 serialize 生成的记录
+ * @param member 输出：恢复的会员
+ * @return true 恢复成功，false 记录不完整
+ */
+bool Member::deserialize(std::string_view record, Member& member) {
+    int32_t id, points, rule, level, lastYear;
+    uint32_t yearStart, historyCount;
+    Member result(0, "", "", "");
+    if (!readValue(record, id) || !readString(record, result.name) || !readString(record, result.phone) ||
+        !readString(record, result.birthday) || !readValue(record, result.totalSpent) ||
+        !readValue(record, points) || !readValue(record, rule) || !readValue(record, result.annualSpent) ||
+        !readValue(record, level) || !readValue(record, lastYear) || !readValue(record, yearStart) ||
+        !readValue(record, historyCount) || level < NORMAL || level > DIAMOND || yearStart > historyCount ||
+        record.size() != historyCount * 2 * sizeof(double) + sizeof(MemberSpendingRollup)) {
+        return false;
+    }
+    result.id = id;
+    result.points = points;
+    result.pointsPerDollar = rule;
+    result.currentLevel = static_cast<Level>(level);
+    result.lastYear = lastYear;
+    result.yearStart = yearStart;
+    result.consumptionHistory.resize(historyCount);
+    for (auto& entry : result.consumptionHistory) {
+        readValue(record, entry.first);
+        readValue(record, entry.second);
     }
-    std::cout << "└─────────────┴─────────────┴─────────────┴─────────────┘" << std::endl;
-}
\ No newline at end of file
+    readValue(record, result.spendingRollup);
+    member = std::move(result);
+    return true;
+}
+
+/**
+ * @brief 获取消费历史记录
+ * @return 消费历史 <原价, 折扣率> 列表
+ */
+const std::vector<std::pair<double, double>>& Member::getConsumptionHistory() const {
+    return consumptionHistory;
+}
+
+/**
+ * @brief 获取指定年份之前的消费记录条数
+ * @param year 年份
+ * @return 记录条数
+ * @details 上次消费早于 year 时全部记录都已结束，否则只有上次消费年度之前的部分
+ */
+size_t Member::closedHistoryCount(int year) const {
+    return (lastYear < year) ? consumptionHistory.size() : std::min(yearStart, consumptionHistory.size());
+}
+
+/**
+ * @brief 移除最早的若干条消费记录
+ * @param count 记录条数
+ * @details 释放多余容量，使内存中的消费历史只保留未归档的部分
+ */
+void Member::dropOldestHistory(size_t count) {
+    count = std::min(count, consumptionHistory.size());
+    consumptionHistory.erase(consumptionHistory.begin(), consumptionHistory.begin() + static_cast<std::ptrdiff_t>(count));
+    consumptionHistory.shrink_to_fit();
+    yearStart -= std::min(yearStart, count);
+}
@@ -0,0 +1,794 @@
+/**
+ * @file MemberBench.cpp
+ * @brief MemberManager 热点路径微基准测试
+ * @details 在 1K、100K、1M、10M 会员规模下分别测量添加会员、按ID/电话查询、添加消费、
+ *          积分兑换、删除会员以及数据文件的保存和加载。每个用例先预热一轮，再重复若干轮，
+ *          报告每次操作的耗时（中位数和最小值）、堆分配次数和字节数，以及每个会员占用的堆内存
+ *          和 MemberManager::getMemoryReport 给出的各子系统占用。
+ *          Linux 上能打开硬件计数器时，另外报告每次操作的 CPU 周期、指令数、IPC、缓存未命中和分支预测失败
+ *          （只统计主线程，加载时的并行建索引部分不计入）；打不开时（如容器内）只报告耗时。
+ *          结果以文本表格输出到控制台，可选同时写出 JSON 文件，便于比较不同提交的性能。
+ *          堆分配通过替换全局 operator new / delete 统计，不依赖任何外部库。
+ *          --check 模式加载给定的数据文件，运行固定的操作组合，把吞吐量和内存与基线文件比较，
+ *          超出容差时返回非零，作为 CTest 的性能回归测试。
+ *
+ *          用法：member_bench [--sizes 1000,100000] [--reps 5] [--json 结果文件]
+ *                member_bench --check 数据文件 --baseline 基线文件 [--reps 3] [--update-baseline]
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "MemberManager.h"
+#include "HardwareCounters.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ==================== 堆分配统计 ====================
+
+namespace {
+
+std::atomic<uint64_t> allocationCount{0};  ///< 累计分配次数
+std::atomic<uint64_t> allocatedBytes{0};   ///< 累计分配字节数
+std::atomic<uint64_t> freedBytes{0};       ///< 累计释放字节数
+
+/// 每块内存前保存其大小，释放时据此统计；保持 max_align_t 对齐
+constexpr size_t BLOCK_HEADER = alignof(std::max_align_t);
+
+void* countedAllocate(size_t size) {
+    void* block = std::malloc(size + BLOCK_HEADER);
+    if (!block) {
+        return nullptr;
+    }
+    *static_cast<size_t*>(block) = size;
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    return static_cast<char*>(block) + BLOCK_HEADER;
+}
+
+void countedFree(void* pointer) {
+    if (!pointer) {
+        return;
+    }
+    void* block = static_cast<char*>(pointer) - BLOCK_HEADER;
+    freedBytes.fetch_add(*static_cast<size_t*>(block), std::memory_order_relaxed);
+    std::free(block);
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    void* pointer = countedAllocate(size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    countedFree(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    countedFree(pointer);
+}
+
+namespace {
+
+// ==================== 测量 ====================
+
+/**
+ * @struct Result
+ * @brief 一个用例在一个规模下的测量结果
+ */
+struct Result {
+    std::string name;          ///< 用例名称
+    size_t members = 0;        ///< 会员规模
+    size_t ops = 0;            ///< 每轮操作次数
+    int repetitions = 0;       ///< 重复轮数（不含预热）
+    double nsPerOp = 0;        ///< 每次操作耗时（各轮中位数）
+    double minNsPerOp = 0;     ///< 每次操作耗时（各轮最小值）
+    double allocsPerOp = 0;    ///< 每次操作的堆分配次数
+    double bytesPerOp = 0;     ///< 每次操作分配的堆字节数
+    bool hasHardware = false;  ///< 是否测到了硬件事件
+    double hardwarePerOp[HardwareCounters::COUNTER_COUNT] = {};  ///< 每次操作的硬件事件数，未计数的事件为 -1
+};
+
+/**
+ * @struct Footprint
+ * @brief 一个规模下的内存占用
+ */
+struct Footprint {
+    size_t members = 0;         ///< 会员规模
+    double bytesPerMember = 0;  ///< 每个会员占用的堆字节数（含全部索引）
+    double buildSeconds = 0;    ///< 逐个添加全部会员的耗时
+    uint64_t measuredBytes = 0; ///< 建立过程中净增的堆字节数（分配统计得到）
+    MemberManager::MemoryReport memory;  ///< 建立完成时各子系统的内存占用
+};
+
+volatile long long sink = 0;  ///< 防止查询结果被优化掉
+HardwareCounters* hardware = nullptr;  ///< 主线程的硬件计数器，不可用时为空
+
+uint64_t liveBytes() {
+    return allocatedBytes.load(std::memory_order_relaxed) - freedBytes.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief 输出测量结果表头
+ */
+void printResultHeader() {
+    std::printf("%-10s %-16s %10s %14s %14s %12s %14s", "members", "case", "ops", "ns/op", "min ns/op", "allocs/op",
+                "bytes/op");
+    if (hardware) {
+        std::printf(" %12s %12s %6s %12s %12s", "cycles/op", "instr/op", "IPC", "cache-miss", "branch-miss");
+    }
+    std::printf("\n");
+}
+
+/**
+ * @brief 测量一个用例
+ * @param name 用例名称
+ * @param members 会员规模
+ * @param ops 每轮操作次数
+ * @param repetitions 重复轮数
+ * @param body 执行一轮：body(轮次, 操作次数)，轮次 -1 表示预热
+ * @return 测量结果
+ */
+template <typename Body>
+Result measure(const char* name, size_t members, size_t ops, int repetitions, Body&& body) {
+    body(-1, ops);
+
+    std::vector<double> samples;
+    uint64_t allocations = 0, bytes = 0;
+    HardwareCounters::Reading events;
+    for (int r = 0; r < repetitions; ++r) {
+        uint64_t countBefore = allocationCount.load(std::memory_order_relaxed);
+        uint64_t bytesBefore = allocatedBytes.load(std::memory_order_relaxed);
+        HardwareCounters::Reading hardwareBefore, hardwareAfter;
+        if (hardware) {
+            hardware->read(hardwareBefore);
+        }
+        auto start = std::chrono::steady_clock::now();
+        body(r, ops);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        if (hardware) {
+            hardware->read(hardwareAfter);
+            hardwareAfter -= hardwareBefore;
+            for (int c = 0; c < HardwareCounters::COUNTER_COUNT; ++c) {
+                events.values[c] += hardwareAfter.values[c];
+            }
+        }
+        allocations += allocationCount.load(std::memory_order_relaxed) - countBefore;
+        bytes += allocatedBytes.load(std::memory_order_relaxed) - bytesBefore;
+        samples.push_back(std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(ops));
+    }
+
+    Result result;
+    result.name = name;
+    result.members = members;
+    result.ops = ops;
+    result.repetitions = repetitions;
+    std::sort(samples.begin(), samples.end());
+    result.nsPerOp = samples[samples.size() / 2];
+    result.minNsPerOp = samples.front();
+    double total = static_cast<double>(ops) * repetitions;
+    result.allocsPerOp = static_cast<double>(allocations) / total;
+    result.bytesPerOp = static_cast<double>(bytes) / total;
+    std::printf("%-10zu %-16s %10zu %14.1f %14.1f %12.2f %14.1f", result.members, result.name.c_str(), result.ops,
+                result.nsPerOp, result.minNsPerOp, result.allocsPerOp, result.bytesPerOp);
+    if (hardware) {
+        result.hasHardware = true;
+        for (int c = 0; c < HardwareCounters::COUNTER_COUNT; ++c) {
+            result.hardwarePerOp[c] = hardware->has(static_cast<HardwareCounters::Counter>(c))
+                                          ? static_cast<double>(events.values[c]) / total
+                                          : -1.0;
+        }
+        const double* perOp = result.hardwarePerOp;
+        double ipc = perOp[HardwareCounters::CYCLES] > 0 && perOp[HardwareCounters::INSTRUCTIONS] >= 0
+                         ? perOp[HardwareCounters::INSTRUCTIONS] / perOp[HardwareCounters::CYCLES]
+                         : -1.0;
+        std::printf(" %12.1f %12.1f %6.2f %12.2f %12.2f", perOp[HardwareCounters::CYCLES],
+                    perOp[HardwareCounters::INSTRUCTIONS], ipc, perOp[HardwareCounters::CACHE_MISSES],
+                    perOp[HardwareCounters::BRANCH_MISSES]);
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+    return result;
+}
+
+// ==================== 测试数据 ====================
+
+const char* const SURNAMES[] = { "王", "李", "张", "刘", "陈", "杨", "黄", "赵", "吴", "周",
+                                 "徐", "孙", "马", "朱", "胡", "郭", "何", "高", "林", "罗" };
+const char* const GIVEN[] = { "伟", "芳", "娜", "敏", "静", "丽", "强", "磊", "军", "洋",
+                              "勇", "艳", "杰", "娟", "涛", "明", "超", "秀", "霞", "平",
+                              "刚", "桂", "英", "华", "玉", "萍", "红", "建", "文", "辉" };
+
+std::string memberName(size_t i) {
+    std::string name = SURNAMES[i % std::size(SURNAMES)];
+    name += GIVEN[(i / 7) % std::size(GIVEN)];
+    if (i % 3 != 0) {
+        name += GIVEN[(i / 211) % std::size(GIVEN)];
+    }
+    return name;
+}
+
+std::string memberPhone(size_t i) {
+    std::string digits = std::to_string(100000000 + i * 7919 % 900000000);
+    return "13" + digits;
+}
+
+std::string memberBirthday(size_t i) {
+    char text[16];
+    std::snprintf(text, sizeof(text), "%04d-%02d-%02d", 1950 + static_cast<int>(i % 50),
+                  1 + static_cast<int>(i / 50 % 12), 1 + static_cast<int>(i / 600 % 28));
+    return text;
+}
+
+// ==================== 用例 ====================
+
+/**
+ * @brief 在一个规模下运行全部用例
+ * @param size 会员规模
+ * @param repetitions 重复轮数
+ * @param results 输出：测量结果（追加）
+ * @param footprints 输出：内存占用（追加）
+ */
+void runSize(size_t size, int repetitions, std::vector<Result>& results, std::vector<Footprint>& footprints) {
+    std::mt19937_64 rng(size);
+    MemberManager manager;
+    const MemberManager& reader = manager;
+
+    uint64_t before = liveBytes();
+    auto buildStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < size; ++i) {
+        manager.addMember(memberName(i), memberPhone(i), memberBirthday(i));
+    }
+    Footprint footprint;
+    footprint.members = size;
+    footprint.buildSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - buildStart).count();
+    footprint.measuredBytes = liveBytes() - before;
+    footprint.bytesPerMember = static_cast<double>(footprint.measuredBytes) / static_cast<double>(size);
+    footprint.memory = reader.getMemoryReport();
+    footprints.push_back(footprint);
+
+    // 随机访问的会员ID和电话预先生成，不计入测量
+    const size_t LOOKUP_OPS = 100000;
+    std::vector<int> ids(LOOKUP_OPS);
+    std::vector<std::string> phones(LOOKUP_OPS);
+    for (size_t i = 0; i < LOOKUP_OPS; ++i) {
+        size_t index = rng() % size;
+        ids[i] = static_cast<int>(index + 1);
+        phones[i] = memberPhone(index);
+    }
+
+    results.push_back(measure("getMemberById", size, LOOKUP_OPS, repetitions, [&](int, size_t ops) {
+        long long sum = 0;
+        for (size_t i = 0; i < ops; ++i) {
+            sum += reader.getMemberById(ids[i])->getPoints();
+        }
+        sink = sink + sum;
+    }));
+
+    results.push_back(measure("getMemberByPhone", size, LOOKUP_OPS, repetitions, [&](int, size_t ops) {
+        long long sum = 0;
+        for (size_t i = 0; i < ops; ++i) {
+            sum += reader.getMemberByPhone(phones[i])->getId();
+        }
+        sink = sink + sum;
+    }));
+
+    results.push_back(measure("addSpending", size, LOOKUP_OPS, repetitions, [&](int, size_t ops) {
+        for (size_t i = 0; i < ops; ++i) {
+            manager.addSpending(ids[i], 10.0 + static_cast<double>(i % 5000) / 100);
+        }
+    }));
+
+    // 先给全体会员足够的积分，保证兑换走成功路径
+    manager.grantBirthdayBonus(0, 365, 1000000);
+    results.push_back(measure("redeemPoints", size, LOOKUP_OPS, repetitions, [&](int, size_t ops) {
+        for (size_t i = 0; i < ops; ++i) {
+            manager.redeemPoints(ids[i], 1);
+        }
+    }));
+
+    std::string path = (std::filesystem::temp_directory_path() / "member_bench.dat").string();
+    results.push_back(measure("saveToFile", size, 1, repetitions, [&](int, size_t) {
+        manager.saveToFile(path);
+    }));
+    results.push_back(measure("loadFromFile", size, 1, repetitions, [&](int, size_t) {
+        manager.loadFromFile(path);
+    }));
+    std::remove(path.c_str());
+
+    // 删除需要移动其后的全部会员，规模越大每轮删除越少（不超过规模的 1%）；每轮删除不同的会员
+    size_t deleteOps = std::max<size_t>(2, std::min<size_t>(size / 100, 2000000 / size));
+    std::vector<int> victims(size);
+    for (size_t i = 0; i < size; ++i) {
+        victims[i] = static_cast<int>(i + 1);
+    }
+    std::shuffle(victims.begin(), victims.end(), rng);
+    results.push_back(measure("deleteMember", size, deleteOps, repetitions, [&](int round, size_t ops) {
+        size_t base = static_cast<size_t>(round + 1) * ops;
+        for (size_t i = 0; i < ops; ++i) {
+            manager.deleteMember(victims[(base + i) % size]);
+        }
+    }));
+
+    // 最后测量添加会员，使前面各用例都在恰好 N 个会员上进行；每轮添加不超过规模的 1%
+    const size_t addOps = std::max<size_t>(10, std::min<size_t>(10000, size / 100));
+    size_t nextIndex = size;
+    results.push_back(measure("addMember", size, addOps, repetitions, [&](int, size_t ops) {
+        for (size_t i = 0; i < ops; ++i, ++nextIndex) {
+            manager.addMember(memberName(nextIndex), memberPhone(nextIndex), memberBirthday(nextIndex));
+        }
+    }));
+}
+
+/**
+ * @brief 把结果写成 JSON
+ * @param path 文件路径
+ * @param results 测量结果
+ * @param footprints 内存占用
+ * @return true 写出成功
+ */
+bool writeJson(const std::string& path, const std::vector<Result>& results, const std::vector<Footprint>& footprints) {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    file << "{\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        file << "    {\"name\": \"" << r.name << "\", \"members\": " << r.members << ", \"ops\": " << r.ops
+             << ", \"repetitions\": " << r.repetitions << ", \"ns_per_op\": " << r.nsPerOp
+             << ", \"min_ns_per_op\": " << r.minNsPerOp << ", \"allocs_per_op\": " << r.allocsPerOp
+             << ", \"alloc_bytes_per_op\": " << r.bytesPerOp;
+        const char* const HARDWARE_KEYS[HardwareCounters::COUNTER_COUNT] = {
+            "cycles_per_op", "instructions_per_op", "cache_misses_per_op", "branch_misses_per_op"
+        };
+        for (int c = 0; r.hasHardware && c < HardwareCounters::COUNTER_COUNT; ++c) {
+            if (r.hardwarePerOp[c] >= 0) {
+                file << ", \"" << HARDWARE_KEYS[c] << "\": " << r.hardwarePerOp[c];
+            }
+        }
+        file << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ],\n  \"footprint\": [\n";
+    for (size_t i = 0; i < footprints.size(); ++i) {
+        const Footprint& f = footprints[i];
+        file << "    {\"members\": " << f.members << ", \"bytes_per_member\": " << f.bytesPerMember
+             << ", \"build_seconds\": " << f.buildSeconds << "}" << (i + 1 < footprints.size() ? "," : "") << "\n";
+    }
+    file << "  ],\n  \"memory\": [\n";
+    for (size_t i = 0; i < footprints.size(); ++i) {
+        const Footprint& f = footprints[i];
+        for (int s = 0; s < MemberManager::MEMORY_SUBSYSTEM_COUNT; ++s) {
+            auto subsystem = static_cast<MemberManager::MemorySubsystem>(s);
+            const MemoryUsage& usage = f.memory.subsystems[s];
+            bool last = i + 1 == footprints.size() && s + 1 == MemberManager::MEMORY_SUBSYSTEM_COUNT;
+            file << "    {\"members\": " << f.members << ", \"subsystem\": \""
+                 << MemberManager::MemoryReport::subsystemName(subsystem) << "\", \"bytes\": " << usage.bytes
+                 << ", \"used_bytes\": " << usage.usedBytes << ", \"objects\": " << usage.objects
+                 << ", \"allocations\": " << usage.allocations << "}" << (last ? "" : ",") << "\n";
+        }
+    }
+    file << "  ]\n}\n";
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief 解析逗号分隔的规模列表
+ * @param text 例如 "1000,100000"
+ * @param sizes 输出：规模
+ * @return true 解析成功
+ */
+bool parseSizes(const std::string& text, std::vector<size_t>& sizes) {
+    sizes.clear();
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = text.find(',', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        char* stop = nullptr;
+        std::string item = text.substr(start, end - start);
+        unsigned long long value = std::strtoull(item.c_str(), &stop, 10);
+        if (item.empty() || *stop != '\0' || value == 0) {
+            return false;
+        }
+        sizes.push_back(static_cast<size_t>(value));
+        start = end + 1;
+    }
+    return !sizes.empty();
+}
+
+// ==================== 回归检查 ====================
+
+/**
+ * @struct BaselineEntry
+ * @brief 基线文件中的一项指标
+ */
+struct BaselineEntry {
+    std::string name;        ///< 指标名称
+    double value = 0;        ///< 基线值
+    double tolerance = 0;    ///< 容差（相对值，0.3 表示 30%）
+};
+
+/**
+ * @struct CheckMetric
+ * @brief 回归检查的一项指标
+ */
+struct CheckMetric {
+    const char* name;        ///< 指标名称（与基线文件一致）
+    bool higherIsBetter;     ///< true 为吞吐量（低于下限失败），false 为内存（高于上限失败）
+    double defaultTolerance; ///< 基线文件中没有该项时使用的容差
+    double measured;         ///< 测量值
+};
+
+/**
+ * @brief 读取基线文件
+ * @param path 文件路径
+ * @param entries 输出：各项指标
+ * @return true 读取成功
+ * @details 每行“指标 基线值 容差”，# 开头的行为注释
+ */
+bool readBaseline(const std::string& path, std::vector<BaselineEntry>& entries) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    entries.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        BaselineEntry entry;
+        if (fields >> entry.name >> entry.value >> entry.tolerance) {
+            entries.push_back(entry);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 写出基线文件
+ * @param path 文件路径
+ * @param metrics 测量结果
+ * @param previous 原基线（沿用其中的容差）
+ * @param members 会员规模
+ * @return true 写出成功
+ */
+bool writeBaseline(const std::string& path, const std::vector<CheckMetric>& metrics,
+                   const std::vector<BaselineEntry>& previous, size_t members) {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    file << "# member_bench --check 的性能基线（由 --update-baseline 生成，" << members << " 会员，Release 构建）\n"
+         << "# 每行：指标 基线值 容差（相对值，0.30 表示 30%）\n"
+         << "# 吞吐量低于 基线×(1-容差)、内存高于 基线×(1+容差) 时检查失败\n";
+    for (const CheckMetric& metric : metrics) {
+        double tolerance = metric.defaultTolerance;
+        for (const BaselineEntry& entry : previous) {
+            if (entry.name == metric.name) {
+                tolerance = entry.tolerance;
+            }
+        }
+        char line[128];
+        std::snprintf(line, sizeof(line), "%-28s %14.1f %6.2f\n", metric.name, metric.measured, tolerance);
+        file << line;
+    }
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief 回归检查：加载数据文件，运行固定的操作组合，与基线比较
+ * @param dataPath 数据文件
+ * @param baselinePath 基线文件
+ * @param repetitions 吞吐量测量的重复轮数
+ * @param update true 时用测量值重写基线文件，不做比较
+ * @return 0 通过，2 读写文件失败，3 有指标超出容差
+ * @details 未开启编译优化时耗时没有参考价值，只检查内存
+ */
+int runCheck(const std::string& dataPath, const std::string& baselinePath, int repetitions, bool update) {
+#ifdef __OPTIMIZE__
+    const bool optimized = true;
+#else
+    const bool optimized = false;
+#endif
+    std::vector<BaselineEntry> baseline;
+    if (!readBaseline(baselinePath, baseline) && !update) {
+        std::fprintf(stderr, "无法读取基线文件 %s\n", baselinePath.c_str());
+        return 2;
+    }
+    if (update && !optimized) {
+        std::fprintf(stderr, "基线只能由开启优化的构建生成（请使用 -DCMAKE_BUILD_TYPE=Release 配置）\n");
+        return 2;
+    }
+
+    MemberManager manager;
+    if (manager.loadFromFile(dataPath) != MemberManager::STATUS_OK || manager.getMemberList().empty()) {
+        std::fprintf(stderr, "无法加载数据文件 %s\n", dataPath.c_str());
+        return 2;
+    }
+    const size_t members = manager.getMemberList().size();
+
+    // 固定的操作组合（种子固定），预先生成，不计入测量：
+    // 按ID查询 40%、按电话查询 20%、消费 25%、积分兑换 5%、电话前缀搜索 5%、姓名搜索 3%、查询名次 2%
+    enum MixOp { MIX_GET_BY_ID, MIX_GET_BY_PHONE, MIX_ADD_SPENDING, MIX_REDEEM, MIX_PHONE_PREFIX, MIX_NAME, MIX_RANK };
+    const int MIX_WEIGHTS[] = { 40, 20, 25, 5, 5, 3, 2 };
+    struct MixStep {
+        MixOp op;
+        int id;
+        double amount;
+        std::string text;
+    };
+    const size_t MIX_OPS = 200000;
+    std::vector<MixStep> mix(MIX_OPS);
+    std::mt19937_64 rng(46);
+    for (MixStep& step : mix) {
+        const Member& member = manager.getMemberList()[rng() % members];
+        int pick = static_cast<int>(rng() % 100);
+        int op = 0;
+        while (pick >= MIX_WEIGHTS[op]) {
+            pick -= MIX_WEIGHTS[op++];
+        }
+        step.op = static_cast<MixOp>(op);
+        step.id = member.getId();
+        step.amount = 5.0 + static_cast<double>(rng() % 50000) / 100;
+        if (step.op == MIX_GET_BY_PHONE) {
+            step.text = member.getPhone();
+        } else if (step.op == MIX_PHONE_PREFIX) {
+            step.text = member.getPhone().substr(0, 7);
+        } else if (step.op == MIX_NAME) {
+            step.text = member.getName();
+        }
+    }
+
+    std::vector<CheckMetric> metrics = {
+        { "load_members_per_sec", true, 0.30, 0 },
+        { "mix_ops_per_sec", true, 0.30, 0 },
+        { "save_members_per_sec", true, 0.30, 0 },
+        { "heap_bytes_per_member", false, 0.10, 0 },
+        { "accounted_bytes_per_member", false, 0.10, 0 },
+    };
+
+    printResultHeader();
+    if (optimized) {
+        Result load = measure("loadFromFile", members, 1, repetitions, [&](int, size_t) {
+            manager.loadFromFile(dataPath);
+        });
+        metrics[0].measured = static_cast<double>(members) * 1e9 / load.nsPerOp;
+
+        std::vector<int> ids;
+        Result mixed = measure("mix", members, MIX_OPS, repetitions, [&](int, size_t ops) {
+            long long sum = 0;
+            for (size_t i = 0; i < ops; ++i) {
+                const MixStep& step = mix[i];
+                switch (step.op) {
+                case MIX_GET_BY_ID:
+                    sum += manager.getMemberById(step.id)->getPoints();
+                    break;
+                case MIX_GET_BY_PHONE:
+                    sum += manager.getMemberByPhone(step.text)->getId();
+                    break;
+                case MIX_ADD_SPENDING:
+                    sum += manager.addSpending(step.id, step.amount).receipt.earnedPoints;
+                    break;
+                case MIX_REDEEM:
+                    sum += manager.redeemPoints(step.id, 1).status;
+                    break;
+                case MIX_PHONE_PREFIX:
+                    sum += static_cast<long long>(manager.findMembersByPhonePrefix(step.text, 20, ids));
+                    break;
+                case MIX_NAME:
+                    sum += static_cast<long long>(manager.findMembersByName(step.text, 20, ids));
+                    break;
+                case MIX_RANK:
+                    sum += manager.getMemberRank(MemberManager::RANK_POINTS, step.id);
+                    break;
+                }
+            }
+            sink = sink + sum;
+        });
+        metrics[1].measured = 1e9 / mixed.nsPerOp;
+
+        std::string path = (std::filesystem::temp_directory_path() / "member_bench_check.dat").string();
+        Result save = measure("saveToFile", members, 1, repetitions, [&](int, size_t) {
+            manager.saveToFile(path);
+        });
+        std::remove(path.c_str());
+        metrics[2].measured = static_cast<double>(members) * 1e9 / save.nsPerOp;
+    } else {
+        std::printf("警告：未开启编译优化，跳过吞吐量测量，只检查内存（请使用 -DCMAKE_BUILD_TYPE=Release 配置）\n");
+    }
+
+    // 内存在新的管理器上测量：前面的加载已分配好各线程的统计缓冲区，不计入会员占用
+    {
+        uint64_t before = liveBytes();
+        MemberManager fresh;
+        fresh.loadFromFile(dataPath);
+        metrics[3].measured = static_cast<double>(liveBytes() - before) / static_cast<double>(members);
+        metrics[4].measured =
+            static_cast<double>(fresh.getMemoryReport().total().bytes) / static_cast<double>(members);
+    }
+
+    if (update) {
+        if (!writeBaseline(baselinePath, metrics, baseline, members)) {
+            std::fprintf(stderr, "无法写出基线文件 %s\n", baselinePath.c_str());
+            return 2;
+        }
+        std::printf("\n基线已更新：%s\n", baselinePath.c_str());
+        return 0;
+    }
+
+    std::printf("\n%-28s %14s %14s %14s  %s\n", "metric", "measured", "baseline", "limit", "result");
+    int failures = 0;
+    for (const CheckMetric& metric : metrics) {
+        const BaselineEntry* entry = nullptr;
+        for (const BaselineEntry& candidate : baseline) {
+            if (candidate.name == metric.name) {
+                entry = &candidate;
+            }
+        }
+        if (!entry) {
+            std::printf("%-28s %14.1f %14s %14s  FAIL（基线缺少该指标）\n", metric.name, metric.measured, "-", "-");
+            ++failures;
+            continue;
+        }
+        double limit = metric.higherIsBetter ? entry->value * (1 - entry->tolerance)
+                                             : entry->value * (1 + entry->tolerance);
+        const char* result = "ok";
+        if (metric.higherIsBetter && !optimized) {
+            result = "skip（未优化构建）";
+        } else if (metric.higherIsBetter ? metric.measured < limit : metric.measured > limit) {
+            result = "FAIL";
+            ++failures;
+        }
+        std::printf("%-28s %14.1f %14.1f %14.1f  %s\n", metric.name, metric.measured, entry->value, limit, result);
+    }
+    if (failures > 0) {
+        std::printf("\n%d 项指标超出容差\n", failures);
+        return 3;
+    }
+    return 0;
+}
+
+} // namespace
+
+/**
+ * @brief 基准测试入口
+ * @return 0 成功，1 参数错误，2 读写文件失败，3 回归检查未通过
+ */
+int main(int argc, char** argv) {
+    std::vector<size_t> sizes = { 1000, 100000, 1000000, 10000000 };
+    int repetitions = 0;
+    std::string jsonPath;
+    std::string checkPath;
+    std::string baselinePath;
+    bool updateBaseline = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--sizes" && i + 1 < argc && parseSizes(argv[i + 1], sizes)) {
+            ++i;
+        } else if (arg == "--reps" && i + 1 < argc && std::atoi(argv[i + 1]) > 0) {
+            repetitions = std::atoi(argv[++i]);
+        } else if (arg == "--json" && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (arg == "--check" && i + 1 < argc) {
+            checkPath = argv[++i];
+        } else if (arg == "--baseline" && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (arg == "--update-baseline") {
+            updateBaseline = true;
+        } else {
+            std::fprintf(stderr,
+                         "用法: %s [--sizes 1000,100000,1000000,10000000] [--reps 5] [--json 结果文件]\n"
+                         "       %s --check 数据文件 --baseline 基线文件 [--reps 3] [--update-baseline]\n",
+                         argv[0], argv[0]);
+            return 1;
+        }
+    }
+    HardwareCounters counters;
+    if (counters.available()) {
+        hardware = &counters;
+    } else {
+        std::printf("硬件计数器不可用（%s），只报告耗时\n", counters.unavailableReason());
+    }
+
+    if (!checkPath.empty() || !baselinePath.empty()) {
+        if (checkPath.empty() || baselinePath.empty()) {
+            std::fprintf(stderr, "--check 和 --baseline 需要同时给出\n");
+            return 1;
+        }
+        return runCheck(checkPath, baselinePath, repetitions > 0 ? repetitions : 3, updateBaseline);
+    }
+    if (repetitions == 0) {
+        repetitions = 5;
+    }
+
+#ifndef __OPTIMIZE__
+    std::printf("警告：未开启编译优化，结果不代表实际性能（请使用 -DCMAKE_BUILD_TYPE=Release 配置）\n");
+#endif
+    printResultHeader();
+
+    std::vector<Result> results;
+    std::vector<Footprint> footprints;
+    for (size_t size : sizes) {
+        runSize(size, repetitions, results, footprints);
+    }
+
+    std::printf("\n%-10s %16s %14s\n", "members", "bytes/member", "build s");
+    for (const Footprint& f : footprints) {
+        std::printf("%-10zu %16.1f %14.3f\n", f.members, f.bytesPerMember, f.buildSeconds);
+    }
+
+    // 各子系统的占用；合计与分配统计的净增量对照，差额是统计未覆盖的部分（含分配器开销的估算之外的部分）
+    std::printf("\n%-10s %-16s %14s %14s %12s %8s\n", "members", "subsystem", "bytes", "bytes/member", "objects",
+                "slack%");
+    for (const Footprint& f : footprints) {
+        auto print = [&](const char* name, const MemoryUsage& usage) {
+            double slack = usage.bytes == 0 ? 0.0 : 100.0 * static_cast<double>(usage.bytes - usage.usedBytes) /
+                                                        static_cast<double>(usage.bytes);
+            std::printf("%-10zu %-16s %14zu %14.1f %12zu %8.1f\n", f.members, name, usage.bytes,
+                        static_cast<double>(usage.bytes) / static_cast<double>(f.members), usage.objects, slack);
+        };
+        for (int s = 0; s < MemberManager::MEMORY_SUBSYSTEM_COUNT; ++s) {
+            auto subsystem = static_cast<MemberManager::MemorySubsystem>(s);
+            print(MemberManager::MemoryReport::subsystemName(subsystem), f.memory.subsystems[s]);
+        }
+        MemoryUsage total = f.memory.total();
+        print("total", total);
+        std::printf("%-10zu %-16s %14llu %13.1f%%  (avg history %.2f)\n", f.members, "measured",
+                    static_cast<unsigned long long>(f.measuredBytes),
+                    100.0 * static_cast<double>(total.bytes) / static_cast<double>(std::max<uint64_t>(f.measuredBytes, 1)),
+                    f.memory.averageHistoryLength());
+    }
+
+    if (!jsonPath.empty() && !writeJson(jsonPath, results, footprints)) {
+        std::fprintf(stderr, "无法写出 %s\n", jsonPath.c_str());
+        return 2;
+    }
+    return 0;
+}
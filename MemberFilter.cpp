@@ -0,0 +1,680 @@
+/**
+ * @file MemberFilter.cpp
+ * @brief 会员过滤表达式实现文件
+ * @details 实现表达式的词法分析、语法分析、计划编译以及基于选择向量的分块执行
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "MemberFilter.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <numeric>
+#include <sstream>
+#include <type_traits>
+
+// ==================== 语法树与执行计划 ====================
+
+/**
+ * @struct MemberFilter::Node
+ * @brief 过滤表达式语法树节点
+ */
+struct MemberFilter::Node {
+    enum Kind { COMPARE, AND, OR, NOT };
+
+    Kind kind = COMPARE;                          ///< 节点类型
+    Field field = FIELD_ID;                       ///< 比较字段（COMPARE）
+    Op op = OP_EQ;                                ///< 比较运算符（COMPARE）
+    double value = 0.0;                           ///< 比较常量（COMPARE）
+    std::vector<std::unique_ptr<Node>> children;  ///< 子节点（AND/OR/NOT）
+};
+
+namespace {
+
+/// 每次处理的行数，选择向量大小与之相同
+constexpr uint32_t BLOCK_SIZE = 4096;
+
+using Field = MemberFilter::Field;
+using Op = MemberFilter::Op;
+using Node = MemberFilter::Node;
+
+/**
+ * @struct Leaf
+ * @brief 编译后的比较条件
+ */
+struct Leaf;
+
+/// 稠密扫描内核：检查 [begin, end) 中的每一行
+using DenseKernel = size_t (*)(const void* column, const Leaf& leaf, uint32_t begin, uint32_t end, uint32_t* out);
+/// 选择向量内核：只检查 in 中列出的行
+using SelectKernel = size_t (*)(const void* column, const Leaf& leaf, const uint32_t* in, size_t n, uint32_t* out);
+
+struct Leaf {
+    Field field;          ///< 比较字段
+    int32_t intValue;     ///< 整数常量（整数列且常量为整数时使用）
+    double doubleValue;   ///< 浮点常量
+    DenseKernel dense;    ///< 稠密扫描内核
+    SelectKernel select;  ///< 选择向量内核
+};
+
+template <typename V>
+V leafValue(const Leaf& leaf) {
+    if constexpr (std::is_same_v<V, int32_t>) {
+        return leaf.intValue;
+    } else {
+        return leaf.doubleValue;
+    }
+}
+
+template <Op OP, typename T, typename V>
+inline bool compare(T x, V v) {
+    if constexpr (OP == MemberFilter::OP_EQ) return x == v;
+    else if constexpr (OP == MemberFilter::OP_NE) return x != v;
+    else if constexpr (OP == MemberFilter::OP_LT) return x < v;
+    else if constexpr (OP == MemberFilter::OP_LE) return x <= v;
+    else if constexpr (OP == MemberFilter::OP_GT) return x > v;
+    else return x >= v;
+}
+
+/**
+ * @brief 稠密扫描：无条件写入下标，再按比较结果推进，循环体无分支
+ */
+template <typename T, typename V, Op OP>
+size_t denseScan(const void* column, const Leaf& leaf, uint32_t begin, uint32_t end, uint32_t* out) {
+    const T* col = static_cast<const T*>(column);
+    const V value = leafValue<V>(leaf);
+    size_t n = 0;
+    for (uint32_t i = begin; i < end; ++i) {
+        out[n] = i;
+        n += compare<OP>(col[i], value);
+    }
+    return n;
+}
+
+/**
+ * @brief 选择向量扫描：可原地收窄（out 与 in 相同）
+ */
+template <typename T, typename V, Op OP>
+size_t selectScan(const void* column, const Leaf& leaf, const uint32_t* in, size_t count, uint32_t* out) {
+    const T* col = static_cast<const T*>(column);
+    const V value = leafValue<V>(leaf);
+    size_t n = 0;
+    for (size_t k = 0; k < count; ++k) {
+        uint32_t i = in[k];
+        out[n] = i;
+        n += compare<OP>(col[i], value);
+    }
+    return n;
+}
+
+template <typename T, typename V>
+void bindKernels(Leaf& leaf, Op op) {
+    switch (op) {
+    case MemberFilter::OP_EQ: leaf.dense = denseScan<T, V, MemberFilter::OP_EQ>; leaf.select = selectScan<T, V, MemberFilter::OP_EQ>; break;
+    case MemberFilter::OP_NE: leaf.dense = denseScan<T, V, MemberFilter::OP_NE>; leaf.select = selectScan<T, V, MemberFilter::OP_NE>; break;
+    case MemberFilter::OP_LT: leaf.dense = denseScan<T, V, MemberFilter::OP_LT>; leaf.select = selectScan<T, V, MemberFilter::OP_LT>; break;
+    case MemberFilter::OP_LE: leaf.dense = denseScan<T, V, MemberFilter::OP_LE>; leaf.select = selectScan<T, V, MemberFilter::OP_LE>; break;
+    case MemberFilter::OP_GT: leaf.dense = denseScan<T, V, MemberFilter::OP_GT>; leaf.select = selectScan<T, V, MemberFilter::OP_GT>; break;
+    case MemberFilter::OP_GE: leaf.dense = denseScan<T, V, MemberFilter::OP_GE>; leaf.select = selectScan<T, V, MemberFilter::OP_GE>; break;
+    }
+}
+
+/**
+ * @brief 判断字段是否为整数列
+ */
+bool isIntField(Field field) {
+    return field != MemberFilter::FIELD_ANNUAL_SPENT && field != MemberFilter::FIELD_TOTAL_SPENT;
+}
+
+/**
+ * @brief 获取字段对应的列数组
+ */
+const void* columnOf(const MemberColumns& columns, Field field) {
+    switch (field) {
+    case MemberFilter::FIELD_ID: return columns.id.data();
+    case MemberFilter::FIELD_LEVEL: return columns.level.data();
+    case MemberFilter::FIELD_ANNUAL_SPENT: return columns.annualSpent.data();
+    case MemberFilter::FIELD_TOTAL_SPENT: return columns.totalSpent.data();
+    case MemberFilter::FIELD_POINTS: return columns.points.data();
+    case MemberFilter::FIELD_LAST_YEAR: return columns.lastYear.data();
+    default: return columns.rule.data();
+    }
+}
+
+const char* fieldName(Field field) {
+    switch (field) {
+    case MemberFilter::FIELD_ID: return "id";
+    case MemberFilter::FIELD_LEVEL: return "level";
+    case MemberFilter::FIELD_ANNUAL_SPENT: return "annualSpent";
+    case MemberFilter::FIELD_TOTAL_SPENT: return "totalSpent";
+    case MemberFilter::FIELD_POINTS: return "points";
+    case MemberFilter::FIELD_LAST_YEAR: return "lastYear";
+    default: return "rule";
+    }
+}
+
+const char* opName(Op op) {
+    switch (op) {
+    case MemberFilter::OP_EQ: return "=";
+    case MemberFilter::OP_NE: return "!=";
+    case MemberFilter::OP_LT: return "<";
+    case MemberFilter::OP_LE: return "<=";
+    case MemberFilter::OP_GT: return ">";
+    default: return ">=";
+    }
+}
+
+std::string lower(const std::string& text) {
+    std::string result = text;
+    for (char& c : result) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return result;
+}
+
+// ==================== 词法与语法分析 ====================
+
+/**
+ * @class Parser
+ * @brief 递归下降解析器
+ */
+class Parser {
+public:
+    explicit Parser(const std::string& text) : text(text) {}
+
+    std::unique_ptr<Node> parse(std::string& error) {
+        std::unique_ptr<Node> node = parseOr();
+        if (node && peekKind() != END) {
+            fail("多余的内容");
+        }
+        if (!message.empty()) {
+            error = message;
+            return nullptr;
+        }
+        return node;
+    }
+
+private:
+    enum TokenKind { END, WORD, NUMBER, OPERATOR, LPAREN, RPAREN, AND, OR, NOT };
+
+    struct Token {
+        TokenKind kind = END;
+        std::string text;
+        size_t position = 0;
+    };
+
+    Token peek() {
+        size_t saved = pos;
+        Token token = next();
+        pos = saved;
+        return token;
+    }
+
+    TokenKind peekKind() { return peek().kind; }
+
+    Token next() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+        Token token;
+        token.position = pos;
+        if (pos >= text.size()) return token;
+
+        char c = text[pos];
+        auto two = [&](const char* s) { return text.compare(pos, 2, s) == 0; };
+        if (c == '(') { ++pos; token.kind = LPAREN; return token; }
+        if (c == ')') { ++pos; token.kind = RPAREN; return token; }
+        if (two("&&")) { pos += 2; token.kind = AND; return token; }
+        if (two("||")) { pos += 2; token.kind = OR; return token; }
+        if (two("<=") || two(">=") || two("!=") || two("<>") || two("==")) {
+            token.kind = OPERATOR;
+            token.text = text.substr(pos, 2);
+            pos += 2;
+            return token;
+        }
+        if (c == '<' || c == '>' || c == '=') {
+            token.kind = OPERATOR;
+            token.text = std::string(1, c);
+            ++pos;
+            return token;
+        }
+        if (c == '!') { ++pos; token.kind = NOT; return token; }
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.' || c == '-') {
+            size_t start = pos++;
+            while (pos < text.size() && (std::isdigit(static_cast<unsigned char>(text[pos])) || text[pos] == '.')) ++pos;
+            token.kind = NUMBER;
+            token.text = text.substr(start, pos - start);
+            return token;
+        }
+        if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            size_t start = pos;
+            while (pos < text.size() && (std::isalnum(static_cast<unsigned char>(text[pos])) || text[pos] == '_')) ++pos;
+            token.text = text.substr(start, pos - start);
+            std::string word = lower(token.text);
+            token.kind = (word == "and") ? AND : (word == "or") ? OR : (word == "not") ? NOT : WORD;
+            return token;
+        }
+        token.kind = WORD;
+        token.text = std::string(1, c);
+        ++pos;
+        fail("无法识别的字符 '" + token.text + "'");
+        return token;
+    }
+
+    void fail(const std::string& what) {
+        if (message.empty()) {
+            message = "第 " + std::to_string(pos + 1) + " 个字符附近：" + what;
+        }
+    }
+
+    std::unique_ptr<Node> parseOr() {
+        std::unique_ptr<Node> left = parseAnd();
+        while (left && peekKind() == OR) {
+            next();
+            std::unique_ptr<Node> right = parseAnd();
+            if (!right) return nullptr;
+            left = combine(Node::OR, std::move(left), std::move(right));
+        }
+        return left;
+    }
+
+    std::unique_ptr<Node> parseAnd() {
+        std::unique_ptr<Node> left = parseNot();
+        while (left && peekKind() == AND) {
+            next();
+            std::unique_ptr<Node> right = parseNot();
+            if (!right) return nullptr;
+            left = combine(Node::AND, std::move(left), std::move(right));
+        }
+        return left;
+    }
+
+    std::unique_ptr<Node> parseNot() {
+        Token token = peek();
+        if (token.kind == NOT) {
+            next();
+            std::unique_ptr<Node> child = parseNot();
+            if (!child) return nullptr;
+            auto node = std::make_unique<Node>();
+            node->kind = Node::NOT;
+            node->children.push_back(std::move(child));
+            return node;
+        }
+        if (token.kind == LPAREN) {
+            next();
+            std::unique_ptr<Node> inner = parseOr();
+            if (!inner) return nullptr;
+            if (next().kind != RPAREN) {
+                fail("缺少右括号");
+                return nullptr;
+            }
+            return inner;
+        }
+        return parseComparison();
+    }
+
+    std::unique_ptr<Node> parseComparison() {
+        Token fieldToken = next();
+        if (fieldToken.kind != WORD) {
+            fail("需要字段名（id/level/annualSpent/totalSpent/points/lastYear/rule）");
+            return nullptr;
+        }
+        auto node = std::make_unique<Node>();
+        std::string field = lower(fieldToken.text);
+        if (field == "id") node->field = MemberFilter::FIELD_ID;
+        else if (field == "level") node->field = MemberFilter::FIELD_LEVEL;
+        else if (field == "annualspent") node->field = MemberFilter::FIELD_ANNUAL_SPENT;
+        else if (field == "totalspent") node->field = MemberFilter::FIELD_TOTAL_SPENT;
+        else if (field == "points") node->field = MemberFilter::FIELD_POINTS;
+        else if (field == "lastyear") node->field = MemberFilter::FIELD_LAST_YEAR;
+        else if (field == "rule") node->field = MemberFilter::FIELD_RULE;
+        else {
+            fail("未知字段 '" + fieldToken.text + "'");
+            return nullptr;
+        }
+
+        Token opToken = next();
+        if (opToken.kind != OPERATOR) {
+            fail("需要比较运算符");
+            return nullptr;
+        }
+        const std::string& op = opToken.text;
+        node->op = (op == "=" || op == "==") ? MemberFilter::OP_EQ
+                 : (op == "!=" || op == "<>") ? MemberFilter::OP_NE
+                 : (op == "<") ? MemberFilter::OP_LT
+                 : (op == "<=") ? MemberFilter::OP_LE
+                 : (op == ">") ? MemberFilter::OP_GT
+                 : MemberFilter::OP_GE;
+
+        Token valueToken = next();
+        if (valueToken.kind == NUMBER) {
+            char* end = nullptr;
+            node->value = std::strtod(valueToken.text.c_str(), &end);
+            if (end != valueToken.text.c_str() + valueToken.text.size()) {
+                fail("无效的数字 '" + valueToken.text + "'");
+                return nullptr;
+            }
+        } else if (valueToken.kind == WORD && node->field == MemberFilter::FIELD_LEVEL) {
+            std::string level = lower(valueToken.text);
+            if (level == "normal") node->value = Member::NORMAL;
+            else if (level == "silver") node->value = Member::SILVER;
+            else if (level == "gold") node->value = Member::GOLD;
+            else if (level == "diamond") node->value = Member::DIAMOND;
+            else {
+                fail("未知等级 '" + valueToken.text + "'（NORMAL/SILVER/GOLD/DIAMOND）");
+                return nullptr;
+            }
+        } else {
+            fail("需要比较的数值");
+            return nullptr;
+        }
+        return node;
+    }
+
+    /**
+     * @brief 合并同类二元节点，使 a AND b AND c 成为一个三路节点
+     */
+    static std::unique_ptr<Node> combine(Node::Kind kind, std::unique_ptr<Node> left, std::unique_ptr<Node> right) {
+        if (left->kind != kind) {
+            auto node = std::make_unique<Node>();
+            node->kind = kind;
+            node->children.push_back(std::move(left));
+            left = std::move(node);
+        }
+        if (right->kind == kind) {
+            for (auto& child : right->children) left->children.push_back(std::move(child));
+        } else {
+            left->children.push_back(std::move(right));
+        }
+        return left;
+    }
+
+    const std::string& text;
+    size_t pos = 0;
+    std::string message;
+};
+
+void describeNode(const Node& node, std::ostringstream& out) {
+    if (node.kind == Node::COMPARE) {
+        out << fieldName(node.field) << ' ' << opName(node.op) << ' ' << node.value;
+        return;
+    }
+    if (node.kind == Node::NOT) {
+        out << "NOT ";
+        describeNode(*node.children[0], out);
+        return;
+    }
+    out << '(';
+    for (size_t i = 0; i < node.children.size(); ++i) {
+        if (i > 0) out << (node.kind == Node::AND ? " AND " : " OR ");
+        describeNode(*node.children[i], out);
+    }
+    out << ')';
+}
+
+}  // namespace
+
+/**
+ * @struct MemberFilter::Plan
+ * @brief 编译后的执行计划
+ * @details 语法树展平为节点数组，比较节点绑定到类型化扫描内核
+ */
+struct MemberFilter::Plan {
+    struct Step {
+        Node::Kind kind;           ///< 节点类型
+        Leaf leaf;                 ///< 比较条件（COMPARE）
+        std::vector<int> children; ///< 子步骤下标
+    };
+
+    std::vector<Step> steps;  ///< 执行步骤
+    int root = -1;            ///< 根步骤下标
+
+    /**
+     * @brief 把语法树编译为步骤
+     * @return 步骤下标
+     */
+    int compileNode(const Node& node) {
+        Step step{ node.kind, {}, {} };
+        if (node.kind == Node::COMPARE) {
+            Leaf& leaf = step.leaf;
+            leaf.field = node.field;
+            leaf.doubleValue = node.value;
+            bool integral = std::floor(node.value) == node.value && std::fabs(node.value) < 2147483647.0;
+            leaf.intValue = integral ? static_cast<int32_t>(node.value) : 0;
+            if (isIntField(node.field) && integral) {
+                bindKernels<int32_t, int32_t>(leaf, node.op);
+            } else if (isIntField(node.field)) {
+                bindKernels<int32_t, double>(leaf, node.op);
+            } else {
+                bindKernels<double, double>(leaf, node.op);
+            }
+        }
+        steps.push_back(step);
+        int index = static_cast<int>(steps.size() - 1);
+
+        // AND 中先执行比较条件（等值优先，通常更有选择性），再执行复合条件
+        std::vector<const Node*> ordered;
+        for (const auto& child : node.children) ordered.push_back(child.get());
+        if (node.kind == Node::AND) {
+            auto rank = [](const Node* n) {
+                if (n->kind != Node::COMPARE) return 2;
+                return n->op == OP_EQ ? 0 : 1;
+            };
+            std::stable_sort(ordered.begin(), ordered.end(),
+                             [&](const Node* a, const Node* b) { return rank(a) < rank(b); });
+        }
+        for (const Node* child : ordered) {
+            int childIndex = compileNode(*child);
+            steps[index].children.push_back(childIndex);
+        }
+        return index;
+    }
+};
+
+namespace {
+
+/**
+ * @class Evaluator
+ * @brief 单次查询的执行上下文
+ * @details 为每个步骤预分配三块选择向量缓冲区，整个查询期间复用
+ */
+class Evaluator {
+public:
+    Evaluator(const MemberFilter::Plan& plan, const MemberColumns& columns)
+        : plan(plan), scratch(plan.steps.size() * 3, std::vector<uint32_t>(BLOCK_SIZE)) {
+        for (const auto& step : plan.steps) {
+            columnPointers.push_back(step.kind == Node::COMPARE ? columnOf(columns, step.leaf.field) : nullptr);
+        }
+    }
+
+    /**
+     * @brief 对一个数据块求值
+     * @param stepIndex 步骤下标
+     * @param in 输入选择向量，nullptr 表示稠密范围 [begin, end)
+     * @param n 输入行数
+     * @param begin 块起始行
+     * @param end 块结束行
+     * @param out 输出选择向量（可与 in 相同）
+     * @return 命中行数
+     */
+    size_t eval(int stepIndex, const uint32_t* in, size_t n, uint32_t begin, uint32_t end, uint32_t* out) {
+        const auto& step = plan.steps[stepIndex];
+        switch (step.kind) {
+        case Node::COMPARE:
+            return in ? step.leaf.select(columnPointers[stepIndex], step.leaf, in, n, out)
+                      : step.leaf.dense(columnPointers[stepIndex], step.leaf, begin, end, out);
+
+        case Node::AND: {
+            size_t count = n;
+            const uint32_t* current = in;
+            for (int child : step.children) {
+                count = eval(child, current, count, begin, end, out);
+                if (count == 0) return 0;  // 提前结束
+                current = out;
+            }
+            return count;
+        }
+
+        case Node::OR: {
+            uint32_t* remaining = buffer(stepIndex, 0);
+            uint32_t* matched = buffer(stepIndex, 1);
+            uint32_t* result = buffer(stepIndex, 2);
+            size_t remainingCount = materialize(in, n, begin, end, remaining);
+            size_t resultCount = 0;
+            for (int child : step.children) {
+                size_t m = eval(child, remaining, remainingCount, begin, end, matched);
+                if (m == 0) continue;
+                // 合并命中结果，并从待测集合中剔除（两者均为升序）
+                std::copy(result, result + resultCount, out);
+                resultCount = std::merge(out, out + resultCount, matched, matched + m, result) - result;
+                remainingCount = std::set_difference(remaining, remaining + remainingCount,
+                                                     matched, matched + m, remaining) - remaining;
+                if (remainingCount == 0) break;  // 提前结束
+            }
+            std::copy(result, result + resultCount, out);
+            return resultCount;
+        }
+
+        default: {  // NOT
+            uint32_t* input = buffer(stepIndex, 0);
+            uint32_t* matched = buffer(stepIndex, 1);
+            size_t inputCount = materialize(in, n, begin, end, input);
+            size_t m = eval(step.children[0], input, inputCount, begin, end, matched);
+            return std::set_difference(input, input + inputCount, matched, matched + m, out) - out;
+        }
+        }
+    }
+
+private:
+    uint32_t* buffer(int stepIndex, int slot) {
+        return scratch[stepIndex * 3 + slot].data();
+    }
+
+    static size_t materialize(const uint32_t* in, size_t n, uint32_t begin, uint32_t end, uint32_t* out) {
+        if (in) {
+            std::copy(in, in + n, out);
+            return n;
+        }
+        std::iota(out, out + (end - begin), begin);
+        return end - begin;
+    }
+
+    const MemberFilter::Plan& plan;
+    std::vector<std::vector<uint32_t>> scratch;
+    std::vector<const void*> columnPointers;
+};
+
+}  // namespace
+
+// ==================== MemberColumns ====================
+
+/**
+ * @brief 从会员列表构建列式快照
+ * @param members 会员列表
+ */
+void MemberColumns::build(const std::vector<Member>& members) {
+    size_t n = members.size();
+    id.resize(n);
+    level.resize(n);
+    annualSpent.resize(n);
+    totalSpent.resize(n);
+    points.resize(n);
+    lastYear.resize(n);
+    rule.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        const Member& member = members[i];
+        id[i] = member.getId();
+        level[i] = static_cast<int32_t>(member.getCurrentLevel());
+        annualSpent[i] = member.getAnnualSpent();
+        totalSpent[i] = member.getTotalSpent();
+        points[i] = member.getPoints();
+        lastYear[i] = member.getLastYear();
+        rule[i] = member.getPointsPerDollar();
+    }
+}
+
+// ==================== MemberFilter ====================
+
+MemberFilter::MemberFilter() = default;
+MemberFilter::~MemberFilter() = default;
+MemberFilter::MemberFilter(MemberFilter&&) noexcept = default;
+MemberFilter& MemberFilter::operator=(MemberFilter&&) noexcept = default;
+
+/**
+ * @brief 解析并编译过滤表达式
+ * @param text 表达式文本
+ * @param error 输出：解析失败时的错误信息
+ * @return true 编译成功，false 表达式有误
+ */
+bool MemberFilter::compile(const std::string& text, std::string& error) {
+    Parser parser(text);
+    std::unique_ptr<Node> parsed = parser.parse(error);
+    if (!parsed) {
+        return false;
+    }
+    auto compiled = std::make_unique<Plan>();
+    compiled->root = compiled->compileNode(*parsed);
+    root = std::move(parsed);
+    plan = std::move(compiled);
+    return true;
+}
+
+/**
+ * @brief 在列式快照上执行过滤
+ * @param columns 会员列式快照
+ * @param limit 最多返回的行数，0 表示不限
+ * @return 命中行的下标（升序）
+ */
+std::vector<uint32_t> MemberFilter::select(const MemberColumns& columns, size_t limit) const {
+    std::vector<uint32_t> result;
+    if (!plan) {
+        return result;
+    }
+    Evaluator evaluator(*plan, columns);
+    std::vector<uint32_t> selection(BLOCK_SIZE);
+    uint32_t total = static_cast<uint32_t>(columns.size());
+    for (uint32_t begin = 0; begin < total; begin += BLOCK_SIZE) {
+        uint32_t end = std::min(total, begin + BLOCK_SIZE);
+        size_t n = evaluator.eval(plan->root, nullptr, 0, begin, end, selection.data());
+        result.insert(result.end(), selection.begin(), selection.begin() + n);
+        if (limit != 0 && result.size() >= limit) {
+            result.resize(limit);
+            break;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief 统计命中行数
+ * @param columns 会员列式快照
+ * @return 命中行数
+ */
+size_t MemberFilter::count(const MemberColumns& columns) const {
+    if (!plan) {
+        return 0;
+    }
+    Evaluator evaluator(*plan, columns);
+    std::vector<uint32_t> selection(BLOCK_SIZE);
+    size_t matched = 0;
+    uint32_t total = static_cast<uint32_t>(columns.size());
+    for (uint32_t begin = 0; begin < total; begin += BLOCK_SIZE) {
+        uint32_t end = std::min(total, begin + BLOCK_SIZE);
+        matched += evaluator.eval(plan->root, nullptr, 0, begin, end, selection.data());
+    }
+    return matched;
+}
+
+/**
+ * @brief 获取编译后的表达式（规范化形式）
+ * @return 表达式文本
+ */
+std::string MemberFilter::describe() const {
+    if (!root) {
+        return "";
+    }
+    std::ostringstream out;
+    describeNode(*root, out);
+    return out.str();
+}
@@ -0,0 +1,483 @@
+/**
+ * @file MemberGen.cpp
+ * @brief 合成会员数据与消费流生成器
+ * @details 为 N 个会员生成与 members.dat 格式兼容的数据文件，以及按时间排序的消费流文件：
+ *          - 姓名按常见姓氏频率抽取姓氏，再配一至两个常用名字用字；电话为真实号段的 11 位手机号且互不重复；
+ *            生日按 18-80 岁均匀分布并且都是合法日期
+ *          - 每笔消费的会员按 Zipf 分布抽取（少数会员贡献大部分消费），金额档位也服从 Zipf 分布
+ *          - 时间范围可以跨越年度，跨年后的年度消费、等级按会员类的规则重新累计
+ *          --split 之前的消费按会员类的结算规则折算进数据文件（总消费、积分、年度消费、等级、上次消费年份），
+ *          之后的消费写入消费流，每行“时间戳,会员ID,金额”。同一组参数和种子总是生成相同的文件。
+ *
+ *          用法：member_gen --members N [--transactions T] [--seed S] [--from 日期] [--to 日期]
+ *                           [--split 日期] [--zipf-members s] [--zipf-amounts s] [--encoding utf8|gbk]
+ *                           [--out members.dat] [--stream transactions.csv]
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "Member.h"
+#include "TextEncoding.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// ==================== 随机分布 ====================
+
+/**
+ * @class ZipfSampler
+ * @brief Zipf 分布抽样（拒绝-逆变换法）
+ * @details 在 1..n 上按 P(k) ∝ 1/k^s 抽样，期望 O(1) 次迭代，不需要预先计算 n 项的累积分布，
+ *          因此千万级会员也不占额外内存。算法见 Hörmann & Derflinger (1996)
+ */
+class ZipfSampler {
+public:
+    ZipfSampler(uint64_t n, double s) : n(n), s(s) {
+        hIntegralX1 = hIntegral(1.5) - 1.0;
+        hIntegralN = hIntegral(static_cast<double>(n) + 0.5);
+        threshold = 2.0 - hIntegralInverse(hIntegral(2.5) - h(2.0));
+    }
+
+    template <typename Engine>
+    uint64_t operator()(Engine& engine) {
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        while (true) {
+            double u = hIntegralN + uniform(engine) * (hIntegralX1 - hIntegralN);
+            double x = hIntegralInverse(u);
+            uint64_t k = static_cast<uint64_t>(std::clamp(x + 0.5, 1.0, static_cast<double>(n)));
+            if (static_cast<double>(k) - x <= threshold || u >= hIntegral(static_cast<double>(k) + 0.5) - h(static_cast<double>(k))) {
+                return k;
+            }
+        }
+    }
+
+private:
+    double h(double x) const { return std::exp(-s * std::log(x)); }
+    double hIntegral(double x) const {
+        double logX = std::log(x);
+        return helper2((1.0 - s) * logX) * logX;
+    }
+    double hIntegralInverse(double x) const {
+        double t = std::max(x * (1.0 - s), -1.0);
+        return std::exp(helper1(t) * x);
+    }
+    static double helper1(double x) {
+        return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+    }
+    static double helper2(double x) {
+        return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x));
+    }
+
+    uint64_t n;
+    double s;
+    double hIntegralX1;
+    double hIntegralN;
+    double threshold;
+};
+
+/**
+ * @brief SplitMix64 混合函数，用于由种子和会员ID派生独立的随机数
+ */
+uint64_t splitMix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// ==================== 会员基本信息 ====================
+
+/// 常见姓氏，大致按人口从多到少排列，按 Zipf(1) 抽取
+const char* const SURNAMES[] = {
+    "王", "李", "张", "刘", "陈", "杨", "黄", "赵", "吴", "周", "徐", "孙", "马", "朱", "胡", "郭", "何", "高", "林", "罗",
+    "郑", "梁", "谢", "宋", "唐", "许", "韩", "冯", "邓", "曹", "彭", "曾", "肖", "田", "董", "袁", "潘", "于", "蒋", "蔡",
+    "余", "杜", "叶", "程", "苏", "魏", "吕", "丁", "任", "沈", "姚", "卢", "姜", "崔", "钟", "谭", "陆", "汪", "范", "金",
+    "石", "廖", "贾", "夏", "韦", "付", "方", "白", "邹", "孟", "熊", "秦", "邱", "江", "尹", "薛", "闫", "段", "雷", "侯",
+    "龙", "史", "陶", "黎", "贺", "顾", "毛", "郝", "龚", "邵", "万", "钱", "严", "覃", "武", "戴", "莫", "孔", "向", "汤",
+    "欧阳", "司马", "诸葛", "上官"
+};
+
+/// 常用名字用字
+const char* const GIVEN[] = {
+    "伟", "芳", "娜", "敏", "静", "丽", "强", "磊", "军", "洋", "勇", "艳", "杰", "娟", "涛", "明", "超", "秀", "霞", "平",
+    "刚", "桂", "英", "华", "玉", "萍", "红", "建", "文", "辉", "力", "燕", "鹏", "飞", "宇", "婷", "浩", "凯", "佳", "欣",
+    "思", "雨", "子", "梓", "轩", "涵", "睿", "博", "晨", "阳", "琳", "颖", "倩", "雪", "慧", "淑", "兰", "凤", "春", "海",
+    "国", "志", "俊", "斌", "亮", "林", "峰", "波", "宁", "丹", "晶", "莉", "琴", "云", "嘉", "怡", "一", "可", "诗", "雅",
+    "天", "泽", "昊", "然", "悦", "鑫", "成", "东", "新", "荣", "瑞", "祥", "彬", "晓", "永", "德", "正", "安", "家", "晴"
+};
+
+/// 手机号段
+const char* const PHONE_PREFIXES[] = {
+    "130", "131", "132", "133", "134", "135", "136", "137", "138", "139", "150", "151", "152", "153", "155",
+    "156", "157", "158", "159", "166", "170", "173", "175", "176", "177", "178", "180", "181", "182", "183",
+    "184", "185", "186", "187", "188", "189", "191", "198", "199"
+};
+
+bool isLeapYear(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+int daysInMonth(int year, int month) {
+    static const int DAYS[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    return (month == 2 && isLeapYear(year)) ? 29 : DAYS[month - 1];
+}
+
+/**
+ * @brief 生成会员姓名、电话和生日
+ * @param seed 随机种子
+ * @param id 会员ID
+ * @param referenceYear 计算年龄的参考年份
+ * @param surnames 姓氏抽样器
+ * @param name 输出：姓名（UTF-8）
+ * @param phone 输出：电话
+ * @param birthday 输出：生日 YYYY-MM-DD
+ * @details 每个会员由 (种子, ID) 单独派生随机数，与消费流的抽样互不影响；
+ *          电话后八位是 ID 的双射，保证不重复
+ */
+void memberIdentity(uint64_t seed, int id, int referenceYear, ZipfSampler& surnames,
+                    std::string& name, std::string& phone, std::string& birthday) {
+    std::mt19937_64 engine(splitMix(seed ^ (static_cast<uint64_t>(id) * 0xD1B54A32D192ED03ULL)));
+    name = SURNAMES[surnames(engine) - 1];
+    size_t givenLength = (engine() % 10 < 7) ? 2 : 1;
+    for (size_t i = 0; i < givenLength; ++i) {
+        name += GIVEN[engine() % std::size(GIVEN)];
+    }
+
+    char digits[16];
+    std::snprintf(digits, sizeof(digits), "%08llu",
+                  static_cast<unsigned long long>((static_cast<uint64_t>(id) * 38273 + seed) % 100000000));
+    phone = PHONE_PREFIXES[engine() % std::size(PHONE_PREFIXES)];
+    phone += digits;
+
+    int year = referenceYear - 18 - static_cast<int>(engine() % 63);
+    int month = 1 + static_cast<int>(engine() % 12);
+    int day = 1 + static_cast<int>(engine() % static_cast<uint64_t>(daysInMonth(year, month)));
+    char text[32];
+    std::snprintf(text, sizeof(text), "%04d-%02d-%02d", year, month, day);
+    birthday = text;
+}
+
+// ==================== 消费结算 ====================
+
+/**
+ * @struct MemberState
+ * @brief 折算进数据文件的会员消费状态
+ */
+struct MemberState {
+    double totalSpent = 0.0;   ///< 总消费
+    double annualSpent = 0.0;  ///< 年度消费
+    int points = 0;            ///< 积分
+    int lastYear = 0;          ///< 上次消费年份
+};
+
+/**
+ * @brief 按会员类的结算规则记一笔消费
+ * @param state 会员状态
+ * @param amount 消费金额
+ * @param year 消费年份
+ * @param rule 积分规则
+ * @details 与 Member::addSpending 相同：跨年清零年度消费，按累计后的年度消费定级并打折，按实付金额计积分
+ */
+void applySpending(MemberState& state, double amount, int year, int rule) {
+    if (state.lastYear != year) {
+        state.annualSpent = 0.0;
+        state.lastYear = year;
+    }
+    state.annualSpent += amount;
+    double actualAmount = amount * Member::discountRateFor(Member::levelForAmount(state.annualSpent));
+    state.totalSpent += amount;
+    state.points += static_cast<int>(actualAmount * rule);
+}
+
+// ==================== 参数 ====================
+
+/**
+ * @struct Options
+ * @brief 命令行参数
+ */
+struct Options {
+    uint64_t members = 1000;           ///< 会员数
+    uint64_t transactions = 0;         ///< 消费笔数，0 表示会员数的 5 倍
+    uint64_t seed = 1;                 ///< 随机种子
+    std::string from;                  ///< 起始日期（含）
+    std::string to;                    ///< 结束日期（含）
+    std::string split;                 ///< 该日期之前的消费折算进数据文件，之后的写入消费流
+    double memberSkew = 0.8;           ///< 会员消费频次的 Zipf 指数
+    double amountSkew = 1.5;           ///< 消费金额档位的 Zipf 指数
+    int rule = 1;                      ///< 积分规则
+    TextEncoding::Encoding encoding = TextEncoding::nativeEncoding();  ///< 数据文件编码
+    std::string out = "members.dat";   ///< 数据文件
+    std::string stream;                ///< 消费流文件，为空时不输出消费流
+};
+
+/**
+ * @brief 解析 YYYY-MM-DD 为当地时间零点
+ * @param text 日期文本
+ * @param when 输出：时间戳
+ * @return true 日期合法
+ */
+bool parseDate(const std::string& text, std::time_t& when) {
+    int year, month, day;
+    char tail;
+    if (std::sscanf(text.c_str(), "%d-%d-%d%c", &year, &month, &day, &tail) != 3 ||
+        year < 1970 || year > 9999 || month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+        return false;
+    }
+    std::tm timeInfo = {};
+    timeInfo.tm_year = year - 1900;
+    timeInfo.tm_mon = month - 1;
+    timeInfo.tm_mday = day;
+    timeInfo.tm_isdst = -1;
+    when = std::mktime(&timeInfo);
+    return when != static_cast<std::time_t>(-1);
+}
+
+std::tm localTime(std::time_t when) {
+    std::tm timeInfo;
+#ifdef _WIN32
+    localtime_s(&timeInfo, &when);
+#else
+    localtime_r(&when, &timeInfo);
+#endif
+    return timeInfo;
+}
+
+void printUsage(const char* program) {
+    std::fprintf(stderr,
+                 "用法: %s --members N [--transactions T] [--seed S] [--from YYYY-MM-DD] [--to YYYY-MM-DD]\n"
+                 "       [--split YYYY-MM-DD] [--zipf-members s] [--zipf-amounts s] [--rule R]\n"
+                 "       [--encoding utf8|gbk] [--out members.dat] [--stream transactions.csv]\n"
+                 "  默认时间范围为今年1月1日至今天；范围可以跨年。\n"
+                 "  给出 --stream 时默认全部消费写入消费流，否则全部折算进数据文件；\n"
+                 "  --split 指定分界日期：之前的消费折算进数据文件，当天及之后的写入消费流。\n",
+                 program);
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        std::string value = argv[++i];
+        char* stop = nullptr;
+        if (arg == "--members") {
+            options.members = std::strtoull(value.c_str(), &stop, 10);
+        } else if (arg == "--transactions") {
+            options.transactions = std::strtoull(value.c_str(), &stop, 10);
+        } else if (arg == "--seed") {
+            options.seed = std::strtoull(value.c_str(), &stop, 10);
+        } else if (arg == "--zipf-members") {
+            options.memberSkew = std::strtod(value.c_str(), &stop);
+        } else if (arg == "--zipf-amounts") {
+            options.amountSkew = std::strtod(value.c_str(), &stop);
+        } else if (arg == "--rule") {
+            options.rule = static_cast<int>(std::strtol(value.c_str(), &stop, 10));
+        } else if (arg == "--from") {
+            options.from = value;
+        } else if (arg == "--to") {
+            options.to = value;
+        } else if (arg == "--split") {
+            options.split = value;
+        } else if (arg == "--out") {
+            options.out = value;
+        } else if (arg == "--stream") {
+            options.stream = value;
+        } else if (arg == "--encoding" && (value == "utf8" || value == "gbk")) {
+            options.encoding = (value == "gbk") ? TextEncoding::ENCODING_GBK : TextEncoding::ENCODING_UTF8;
+        } else {
+            return false;
+        }
+        if (stop && *stop != '\0') {
+            return false;
+        }
+    }
+    // 电话后八位由 ID 双射得到，会员数不能超过一亿
+    return options.members >= 1 && options.members <= 100000000 && options.rule >= 1 &&
+           options.memberSkew > 0 && options.amountSkew > 0;
+}
+
+/**
+ * @brief 把缓冲区按目标编码写出并清空
+ * @param file 输出文件
+ * @param buffer UTF-8 文本（只在行尾切分）
+ * @param encoding 目标编码
+ */
+void flushText(std::ofstream& file, std::string& buffer, TextEncoding::Encoding encoding) {
+    if (encoding == TextEncoding::ENCODING_GBK) {
+        std::string converted;
+        TextEncoding::utf8ToGbk(buffer, converted);
+        file.write(converted.data(), static_cast<std::streamsize>(converted.size()));
+    } else {
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+    buffer.clear();
+}
+
+} // namespace
+
+/**
+ * @brief 生成器入口
+ * @return 0 成功，1 参数错误，2 文件写出失败
+ */
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (options.transactions == 0) {
+        options.transactions = options.members * 5;
+    }
+
+    std::time_t now = std::time(nullptr);
+    std::tm today = localTime(now);
+    char text[32];
+    if (options.from.empty()) {
+        std::snprintf(text, sizeof(text), "%04d-01-01", today.tm_year + 1900);
+        options.from = text;
+    }
+    if (options.to.empty()) {
+        std::snprintf(text, sizeof(text), "%04d-%02d-%02d", today.tm_year + 1900, today.tm_mon + 1, today.tm_mday);
+        options.to = text;
+    }
+    std::time_t from, to, split;
+    if (!parseDate(options.from, from) || !parseDate(options.to, to) || to < from) {
+        std::fprintf(stderr, "日期范围无效: %s ~ %s\n", options.from.c_str(), options.to.c_str());
+        return 1;
+    }
+    to += 24 * 60 * 60;  // 结束日期当天也包含在内
+    if (!options.split.empty()) {
+        if (!parseDate(options.split, split)) {
+            std::fprintf(stderr, "分界日期无效: %s\n", options.split.c_str());
+            return 1;
+        }
+    } else {
+        split = options.stream.empty() ? to : from;
+    }
+
+    std::ofstream streamFile;
+    if (!options.stream.empty()) {
+        streamFile.open(options.stream, std::ios::binary | std::ios::trunc);
+        if (!streamFile) {
+            std::fprintf(stderr, "无法写出 %s\n", options.stream.c_str());
+            return 2;
+        }
+        streamFile << "timestamp,member_id,amount\n";
+    }
+
+    // 会员按随机排列对应 Zipf 名次，消费最多的会员不集中在小 ID 上
+    std::mt19937_64 engine(options.seed);
+    std::vector<uint32_t> rankToMember(options.members);
+    std::iota(rankToMember.begin(), rankToMember.end(), 0);
+    std::shuffle(rankToMember.begin(), rankToMember.end(), engine);
+
+    ZipfSampler pickMember(options.members, options.memberSkew);
+    ZipfSampler pickAmount(2000, options.amountSkew);
+    std::vector<MemberState> states(options.members);
+    std::vector<uint32_t> counts(options.members);
+    const size_t FLUSH_BYTES = 1 << 20;
+    std::string buffer;
+    uint64_t folded = 0, streamed = 0;
+    int yearBoundaries = 0, previousYear = 0;
+    double span = std::difftime(to, from);
+    std::uniform_real_distribution<double> jitter(0.0, 1.0);
+
+    // 时间戳随序号单调递增，消费流天然按时间排序，无需缓存全部消费
+    for (uint64_t i = 0; i < options.transactions; ++i) {
+        std::time_t when = from + static_cast<std::time_t>((static_cast<double>(i) + jitter(engine)) * span /
+                                                            static_cast<double>(options.transactions));
+        uint32_t member = rankToMember[pickMember(engine) - 1];
+        // 金额档位 k 对应 (k-1)*10 元到 k*10 元之间，精确到分
+        long long cents = static_cast<long long>(pickAmount(engine)) * 1000 - static_cast<long long>(engine() % 1000);
+        double amount = static_cast<double>(cents) / 100;
+        int year = localTime(when).tm_year + 1900;
+        if (previousYear != 0 && year != previousYear) {
+            ++yearBoundaries;
+        }
+        previousYear = year;
+        counts[member] += 1;
+
+        if (when < split) {
+            applySpending(states[member], amount, year, options.rule);
+            ++folded;
+        } else if (streamFile.is_open()) {
+            char line[64];
+            int length = std::snprintf(line, sizeof(line), "%lld,%u,%lld.%02lld\n", static_cast<long long>(when),
+                                       member + 1, cents / 100, cents % 100);
+            buffer.append(line, static_cast<size_t>(length));
+            if (buffer.size() >= FLUSH_BYTES) {
+                streamFile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                buffer.clear();
+            }
+            ++streamed;
+        }
+    }
+    if (streamFile.is_open()) {
+        streamFile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        streamFile.close();
+        buffer.clear();
+        if (!streamFile) {
+            std::fprintf(stderr, "无法写出 %s\n", options.stream.c_str());
+            return 2;
+        }
+    }
+
+    // 数据文件字段与 MemberManager::saveToFile 相同：ID,姓名,电话,生日,总消费,积分,积分规则,年度消费,等级,上次消费年份
+    std::ofstream file(options.out, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::fprintf(stderr, "无法写出 %s\n", options.out.c_str());
+        return 2;
+    }
+    ZipfSampler pickSurname(std::size(SURNAMES), 1.0);
+    int referenceYear = localTime(to - 1).tm_year + 1900;
+    long long levelCounts[4] = {};
+    std::string name, phone, birthday;
+    for (uint64_t m = 0; m < options.members; ++m) {
+        int id = static_cast<int>(m + 1);
+        memberIdentity(options.seed, id, referenceYear, pickSurname, name, phone, birthday);
+        const MemberState& state = states[m];
+        Member::Level level = Member::levelForAmount(state.annualSpent);
+        levelCounts[level] += 1;
+        char numbers[160];
+        std::snprintf(numbers, sizeof(numbers), ",%.2f,%d,%d,%.2f,%d,%d\n", state.totalSpent, state.points,
+                      options.rule, state.annualSpent, static_cast<int>(level), state.lastYear);
+        buffer += std::to_string(id);
+        buffer += ',';
+        buffer += name;
+        buffer += ',';
+        buffer += phone;
+        buffer += ',';
+        buffer += birthday;
+        buffer += numbers;
+        if (buffer.size() >= FLUSH_BYTES) {
+            flushText(file, buffer, options.encoding);
+        }
+    }
+    flushText(file, buffer, options.encoding);
+    file.close();
+    if (!file) {
+        std::fprintf(stderr, "无法写出 %s\n", options.out.c_str());
+        return 2;
+    }
+
+    uint32_t busiest = *std::max_element(counts.begin(), counts.end());
+    std::printf("会员 %llu 人 -> %s（%s）\n", static_cast<unsigned long long>(options.members), options.out.c_str(),
+                TextEncoding::name(options.encoding));
+    std::printf("消费 %llu 笔（%s ~ %s，跨年 %d 次）：折算进数据文件 %llu 笔，写入消费流 %llu 笔\n",
+                static_cast<unsigned long long>(options.transactions), options.from.c_str(), options.to.c_str(),
+                yearBoundaries, static_cast<unsigned long long>(folded), static_cast<unsigned long long>(streamed));
+    std::printf("消费最多的会员 %u 笔；等级分布 普通 %lld / 白银 %lld / 黄金 %lld / 钻石 %lld\n", busiest,
+                levelCounts[0], levelCounts[1], levelCounts[2], levelCounts[3]);
+    return 0;
+}
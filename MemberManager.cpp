@@ -9,11 +9,81 @@
 
 // MemberManager.cpp
 #include "MemberManager.h"
-#include <iostream>
+#include "TextEncoding.h"
+#include "Collation.h"
+#include "RadixSort.h"
+#include "Parallel.h"
+#include "LatencyStats.h"
+#include "TraceRecorder.h"
+#include <charconv>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
-#include <iomanip>
+#include <ctime>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief 获取当前年份
+ * @return 本地时间的年份
+ */
+int currentYear() {
+    time_t now = time(0);
+    tm timeInfo;
+#ifdef _WIN32
+    localtime_s(&timeInfo, &now);
+#else
+    localtime_r(&now, &timeInfo);
+#endif
+    return 1900 + timeInfo.tm_year;
+}
+
+/**
+ * @brief 将金额转换为以分为单位的整数
+ * @param amount 金额（元）
+ * @return 金额（分）
+ */
+long long toCents(double amount) {
+    return std::llround(amount * 100.0);
+}
+
+/**
+ * @brief 以能原样读回的最短形式追加浮点数
+ * @param content 输出流
+ * @param value 数值
+ * @details 流的默认格式只保留6位有效数字，大额消费保存后再加载会丢失分位
+ */
+void appendAmount(std::ostringstream& content, double value) {
+    char text[32];
+    auto result = std::to_chars(text, text + sizeof(text), value);
+    content.write(text, result.ptr - text);
+}
+
+/**
+ * @brief 按数据文件格式追加一行会员记录
+ * @param content 输出流
+ * @param member 会员对象
+ */
+void appendMemberLine(std::ostringstream& content, const Member& member) {
+    content << member.getId() << ","
+        << member.getName() << ","
+        << member.getPhone() << ","
+        << member.getBirthday() << ",";
+    appendAmount(content, member.getTotalSpent());
+    content << ","
+        << member.getPoints() << ","
+        << member.getPointsPerDollar() << ",";
+    appendAmount(content, member.getAnnualSpent());
+    content << ","
+        << static_cast<int>(member.getCurrentLevel()) << ","
+        << member.getLastYear() << "\n";
+}
+
+}  // namespace
 
 /**
  * @brief 获取所有会员列表
@@ -23,141 +93,117 @@ std::vector<Member> MemberManager::getMembers() const {
     return members;
 }
 
+/**
+ * @brief 获取所有会员列表的只读引用
+ * @return 会员向量常量引用
+ */
+const std::vector<Member>& MemberManager::getMemberList() const {
+    return members;
+}
+
 /**
  * @brief 添加新会员
  * @param name 会员姓名
  * @param phone 会员电话
  * @param birthday 会员生日
- * @details 创建新会员对象并添加到会员列表中，自动分配唯一ID
+ * @return 新会员的ID
+ * @details 创建新会员对象并添加到会员列表中，自动分配唯一ID。
+ *          启用复制且记录未能写入日志时会员仍已加入，getReplicationLog().failed() 为 true
  */
-void MemberManager::addMember(const std::string& name, const std::string& phone, const std::string& birthday) {
+int MemberManager::addMember(const std::string& name, const std::string& phone, const std::string& birthday) {
+    MEMBER_PERF_SCOPE(OP_ADD_MEMBER);
     Member newMember(nextId++, name, phone, birthday, pointsRule);
     members.push_back(newMember);
-    std::cout << "会员 " << name << " 添加成功！ID: " << newMember.getId() << std::endl;
+    nameKeys.push_back(Collation::nameKey(newMember.getName()));
+    idIndex[newMember.getId()] = members.size() - 1;
+    phoneIndex.insert(newMember.getPhone(), newMember.getId());
+    nameIndex.insert(newMember.getName(), newMember.getId());
+    birthdayIndex.insert(newMember.getBirthday(), newMember.getId());
+    indexMember(newMember);
+    if (replicationLog.isOpen()) {
+        ReplicationRecord record;
+        record.type = ReplicationRecord::ADD_MEMBER;
+        record.id = newMember.getId();
+        record.name = name;
+        record.phone = phone;
+        record.birthday = birthday;
+        replicationLog.append(record);  // 写入失败由 getReplicationLog().failed() 反映
+    }
+    return newMember.getId();
 }
 
 /**
  * @brief 删除指定会员
  * @param memberId 要删除的会员ID
- * @details 根据会员ID查找并删除会员，包含用户友好的提示信息
- */
-void MemberManager::deleteMember(int memberId) {
-    auto it = std::find_if(members.begin(), members.end(),
-                           [memberId](const Member& m) { return m.getId() == memberId; });
-    if (it != members.end()) {
-        std::string memberName = it->getName();
-        members.erase(it);
-        std::cout << "会员 " << memberName << " (ID: " << memberId << ") 已成功删除！" << std::endl;
-    } else {
-        std::cout << "未找到ID为 " << memberId << " 的会员！" << std::endl;
-    }
-}
-
-/**
- * @brief 显示所有会员列表
- * @details 遍历所有会员并显示其完整信息，包括基本信息、等级、积分、消费等
+ * @return STATUS_OK、STATUS_NOT_FOUND 或 STATUS_IO_ERROR
+ * @details 已转存到磁盘的会员直接从段文件中移除，无需调回；其姓名和生日索引项按读出的记录移除。
+ *          内存中的会员用列表末尾的会员填补空位，其余会员的下标不变
  */
-void MemberManager::listAllMembers() const {
-    if (members.empty()) {
-        std::cout << "当前没有会员记录！" << std::endl;
-        return;
-    }
-    
-    std::cout << "\n=== 会员列表 ===" << std::endl;
-    std::cout << "总会员数: " << members.size() << " 人\n" << std::endl;
-    
-    for (const auto& member : members) {
-        // 获取等级名称
-        std::string levelName;
-        switch (member.getCurrentLevel()) {
-        case Member::DIAMOND: levelName = "钻石会员"; break;
-        case Member::GOLD: levelName = "黄金会员"; break;
-        case Member::SILVER: levelName = "白银会员"; break;
-        default: levelName = "普通会员"; break;
+MemberManager::Status MemberManager::deleteMember(int memberId) {
+    MEMBER_PERF_SCOPE(OP_DELETE_MEMBER);
+    auto found = idIndex.find(memberId);
+    if (found == idIndex.end()) {
+        Member cold(0, "", "", "");
+        if (!coldStore.fetch(memberId, cold) || !coldStore.erase(memberId)) {
+            return STATUS_NOT_FOUND;
         }
-        
-        // 获取折扣率
-        double discountRate = member.getDiscountRate();
-        std::string discountText = (discountRate < 1.0) ? 
-            std::to_string(static_cast<int>(discountRate * 10)) + "折" : "无折扣";
-        
-        std::cout << "┌─────────────────────────────────────────────────────────────────┐" << std::endl;
-        std::cout << "│ 会员ID: " << std::left << std::setw(8) << member.getId() << std::endl;
-        std::cout << "│ 姓名: " << std::left << std::setw(15) << member.getName() << std::endl;
-        std::cout << "│ 电话: " << std::left << std::setw(15) << member.getPhone() << std::endl;
-        std::cout << "│ 生日: " << std::left << std::setw(15) << member.getBirthday() << std::endl;
-        std::cout << "│ 等级: " << std::left << std::setw(15) << levelName << std::endl;
-        std::cout << "│ 优惠: " << std::left << std::setw(15) << discountText << std::endl;
-        std::cout << "│ 总消费: " << std::left << std::setw(5) << std::fixed << std::setprecision(2) << member.getTotalSpent() << "元" << std::endl;
-        std::cout << "│ 年度消费: " << std::left << std::setw(5) << std::fixed << std::setprecision(2) << member.getAnnualSpent() << "元" << std::endl;
-        std::cout << "│ 积分: " << std::left << std::setw(15) << member.getPoints() << std::endl;
-        std::cout << "│ 积分规则: 1元=" << std::left << member.getPointsPerDollar() << "积分" << std::endl;
-        std::cout << "│ 上次消费年份: " << std::left << std::setw(15) << member.getLastYear() << std::endl;
-        std::cout << "└─────────────────────────────────────────────────────────────────┘" << std::endl;
-        std::cout << std::endl;
-    }
-}
-
-/**
- * @brief 根据电话号码查找会员
- * @param phone 要查找的电话号码
- * @details 遍历会员列表查找匹配的电话号码并显示会员完整信息
- */
-void MemberManager::findMemberByPhone(const std::string& phone) const {
-    bool found = false;
-    for (const auto& member : members) {
-        if (member.getPhone() == phone) {
-            // 获取等级名称
-            std::string levelName;
-            switch (member.getCurrentLevel()) {
-            case Member::DIAMOND: levelName = "钻石会员"; break;
-            case Member::GOLD: levelName = "黄金会员"; break;
-            case Member::SILVER: levelName = "白银会员"; break;
-            default: levelName = "普通会员"; break;
-            }
-            
-            // 获取折扣率
-            double discountRate = member.getDiscountRate();
-            std::string discountText = (discountRate < 1.0) ? 
-                std::to_string(static_cast<int>(discountRate * 10)) + "折" : "无折扣";
-            
-            std::cout << "┌─────────────────────────────────────────────────────────────────┐" << std::endl;
-            std::cout << "│ 会员ID: " << std::left << std::setw(8) << member.getId() << std::endl;
-            std::cout << "│ 姓名: " << std::left << std::setw(15) << member.getName() << std::endl;
-            std::cout << "│ 电话: " << std::left << std::setw(15) << member.getPhone() << std::endl;
-            std::cout << "│ 生日: " << std::left << std::setw(15) << member.getBirthday() << std::endl;
-            std::cout << "│ 等级: " << std::left << std::setw(15) << levelName << std::endl;
-            std::cout << "│ 优惠: " << std::left << std::setw(15) << discountText << std::endl;
-            std::cout << "│ 总消费: " << std::left << std::setw(5) << std::fixed << std::setprecision(2) << member.getTotalSpent() << "元" << std::endl;
-            std::cout << "│ 年度消费: " << std::left << std::setw(5) << std::fixed << std::setprecision(2) << member.getAnnualSpent() << "元" << std::endl;
-            std::cout << "│ 积分: " << std::left << std::setw(15) << member.getPoints() << std::endl;
-            std::cout << "│ 积分规则: 1元=" << std::left << member.getPointsPerDollar() << "积分" << std::endl;
-            std::cout << "│ 上次消费年份: " << std::left << std::setw(15) << member.getLastYear() << std::endl;
-            std::cout << "└─────────────────────────────────────────────────────────────────┘" << std::endl;
-            std::cout << std::endl;
-
-            found = true;
-            break;
+        nameIndex.erase(cold.getName(), memberId);
+        birthdayIndex.erase(cold.getBirthday(), memberId);
+    } else {
+        size_t pos = found->second;
+        unindexMember(members[pos]);
+        phoneIndex.erase(members[pos].getPhone(), memberId);
+        nameIndex.erase(members[pos].getName(), memberId);
+        birthdayIndex.erase(members[pos].getBirthday(), memberId);
+        idIndex.erase(found);
+        // 末尾的会员移到删除位置，只需改它一个下标；列表不要求按ID排列（见 idOrder）
+        if (pos + 1 < members.size()) {
+            members[pos] = std::move(members.back());
+            nameKeys[pos] = std::move(nameKeys.back());
+            idIndex[members[pos].getId()] = pos;
+        }
+        members.pop_back();
+        nameKeys.pop_back();
+    }
+    if (replicationLog.isOpen()) {
+        ReplicationRecord record;
+        record.type = ReplicationRecord::DELETE_MEMBER;
+        record.id = memberId;
+        if (!replicationLog.append(record)) {
+            return STATUS_IO_ERROR;
         }
     }
-    if (!found) std::cout << "未找到该电话的会员！" << std::endl;
+    return STATUS_OK;
 }
 
 /**
  * @brief 更新会员电话号码
  * @param id 会员ID
  * @param newPhone 新的电话号码
+ * @return STATUS_OK、STATUS_NOT_FOUND 或 STATUS_IO_ERROR
  * @details 根据会员ID查找会员并更新其电话号码
  */
-void MemberManager::updateMemberPhone(int id, const std::string& newPhone) {
-    for (auto& member : members) {
-        if (member.getId() == id) {
-            member = Member(id, member.getName(), newPhone, member.getBirthday(), member.getPointsPerDollar());
-            std::cout << "会员 " << id << " 电话已更新为: " << newPhone << std::endl;
-            return;
+MemberManager::Status MemberManager::updateMemberPhone(int id, const std::string& newPhone) {
+    MEMBER_PERF_SCOPE(OP_UPDATE_PHONE);
+    Member* member = findMember(id);
+    if (!member) {
+        return STATUS_NOT_FOUND;
+    }
+    unindexMember(*member);
+    phoneIndex.erase(member->getPhone(), id);
+    *member = Member(id, member->getName(), newPhone, member->getBirthday(), member->getPointsPerDollar());
+    phoneIndex.insert(newPhone, id);
+    indexMember(*member);
+    if (replicationLog.isOpen()) {
+        ReplicationRecord record;
+        record.type = ReplicationRecord::UPDATE_PHONE;
+        record.id = id;
+        record.phone = newPhone;
+        if (!replicationLog.append(record)) {
+            return STATUS_IO_ERROR;
         }
     }
-    std::cout << "未找到该ID的会员！" << std::endl;
+    return STATUS_OK;
 }
 
 /**
@@ -166,194 +212,1217 @@ void MemberManager::updateMemberPhone(int id, const std::string& newPhone) {
  * @return 会员ID，如果未找到则返回-1
  */
 int MemberManager::getMemberIdByPhone(const std::string& phone) const {
-    for (const auto& member : members) {
-        if (member.getPhone() == phone) {
-            return member.getId();
+    MEMBER_PERF_SCOPE(OP_GET_BY_PHONE);
+    const Member* member = getMemberByPhone(phone);
+    if (member) {
+        return member->getId();
+    }
+    return coldStore.isOpen() ? coldStore.findByPhone(phone) : -1;
+}
+
+/**
+ * @brief 根据会员ID获取会员
+ * @param id 会员ID
+ * @return 会员指针，如果未找到则返回nullptr
+ */
+const Member* MemberManager::getMemberById(int id) const {
+    auto it = idIndex.find(id);
+    return it == idIndex.end() ? nullptr : &members[it->second];
+}
+
+/**
+ * @brief 根据会员ID获取会员，必要时从磁盘调回
+ * @param id 会员ID
+ * @return 会员指针，如果未找到则返回nullptr
+ */
+const Member* MemberManager::getMemberById(int id) {
+    MEMBER_PERF_SCOPE(OP_GET_BY_ID);
+    return findMember(id);
+}
+
+/**
+ * @brief 根据电话号码获取会员
+ * @param phone 电话号码
+ * @return 会员指针，如果未找到则返回nullptr
+ */
+const Member* MemberManager::getMemberByPhone(const std::string& phone) const {
+    if (!PhoneIndex::indexable(phone)) {
+        // 不能进入索引的号码（含非数字等）只能逐个比较
+        for (const auto& member : members) {
+            if (member.getPhone() == phone) {
+                return &member;
+            }
+        }
+        return nullptr;
+    }
+
+    // 同一号码对应多个会员时，与原先的顺序查找一致返回列表中靠前的一个
+    std::vector<int> ids;
+    phoneIndex.exact(phone, ids);
+    const Member* first = nullptr;
+    size_t firstPos = members.size();
+    for (int id : ids) {
+        size_t pos = idIndex.at(id);
+        if (pos < firstPos) {
+            firstPos = pos;
+            first = &members[pos];
         }
     }
-    return -1;
+    return first;
+}
+
+/**
+ * @brief 根据电话号码获取会员，必要时从磁盘调回
+ * @param phone 电话号码
+ * @return 会员指针，如果未找到则返回nullptr
+ * @details 内存中找不到时再查磁盘，布隆过滤器使大多数查无此号的情况不必读盘
+ */
+const Member* MemberManager::getMemberByPhone(const std::string& phone) {
+    MEMBER_PERF_SCOPE(OP_GET_BY_PHONE);
+    const Member* member = std::as_const(*this).getMemberByPhone(phone);
+    if (member || !coldStore.isOpen()) {
+        return member;
+    }
+    int id = coldStore.findByPhone(phone);
+    return id < 0 ? nullptr : faultIn(id);
+}
+
+/**
+ * @brief 按电话号码前缀查找会员
+ * @param prefix 号码前缀（数字）
+ * @param limit 最多返回的数量，0 表示不限
+ * @param ids 输出：匹配的会员ID，按号码升序
+ * @return 匹配的会员总数（不受 limit 限制）
+ */
+size_t MemberManager::findMembersByPhonePrefix(const std::string& prefix, size_t limit, std::vector<int>& ids) const {
+    MEMBER_PERF_SCOPE(OP_FIND_BY_PHONE_PREFIX);
+    ids.clear();
+    return phoneIndex.prefix(prefix, limit, ids);
+}
+
+/**
+ * @brief 按电话号码后四位查找会员
+ * @param lastFour 号码后四位
+ * @return 后四位相同的会员ID
+ */
+const std::vector<int>& MemberManager::findMembersByPhoneSuffix(const std::string& lastFour) const {
+    return phoneIndex.suffix(lastFour);
+}
+
+/**
+ * @brief 按姓名片段查找会员
+ * @param query 姓名片段
+ * @param limit 最多返回的数量，0 表示不限
+ * @param ids 输出：姓名包含该片段的会员ID，按本年度消费降序，相同时按ID升序
+ * @return 匹配的会员总数（不受 limit 限制）
+ * @details 先由姓名索引取出候选，再逐个核对姓名确实包含该片段（多字查询的候选可能含误报）。
+ *          休眠在磁盘上的会员也在姓名索引中，核对时从段文件读出记录，不调回内存
+ */
+size_t MemberManager::findMembersByName(const std::string& query, size_t limit, std::vector<int>& ids) const {
+    MEMBER_PERF_SCOPE(OP_FIND_BY_NAME);
+    std::vector<int> candidates;
+    nameIndex.candidates(query, candidates);
+
+    std::vector<std::pair<double, int>> matches;
+    Member cold(0, "", "", "");
+    for (int id : candidates) {
+        const Member* member = getMemberById(id);
+        if (!member && coldStore.fetch(id, cold)) {
+            member = &cold;
+        }
+        if (member && NameIndex::contains(member->getName(), query)) {
+            matches.emplace_back(rankScore(*member, RANK_ANNUAL_SPENT), id);
+        }
+    }
+
+    auto byScore = [](const std::pair<double, int>& a, const std::pair<double, int>& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    };
+    size_t count = (limit == 0 || limit > matches.size()) ? matches.size() : limit;
+    std::partial_sort(matches.begin(), matches.begin() + count, matches.end(), byScore);
+
+    ids.clear();
+    for (size_t i = 0; i < count; ++i) {
+        ids.push_back(matches[i].second);
+    }
+    return matches.size();
+}
+
+/**
+ * @brief 按姓名片段查找会员，命中的休眠会员从磁盘调回
+ * @param query 姓名片段
+ * @param limit 最多返回的数量，0 表示不限
+ * @param ids 输出：姓名包含该片段的会员ID，按本年度消费降序，相同时按ID升序
+ * @return 匹配的会员总数（不受 limit 限制）
+ * @details 只调回返回的会员，之后可用常量接口取得这些会员
+ */
+size_t MemberManager::findMembersByName(const std::string& query, size_t limit, std::vector<int>& ids) {
+    size_t total = std::as_const(*this).findMembersByName(query, limit, ids);
+    if (coldStore.size() > 0) {
+        for (int id : ids) {
+            if (idIndex.find(id) == idIndex.end()) {
+                faultIn(id);
+            }
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief 查找一段日期内过生日的会员
+ * @param fromKey 起始日期的桶编号（含）
+ * @param toKey 结束日期的桶编号（含）
+ * @param ids 输出：会员ID，按日期先后排列（含休眠在磁盘上的会员）
+ * @return 会员数量
+ */
+size_t MemberManager::findMembersByBirthday(int fromKey, int toKey, std::vector<int>& ids) const {
+    MEMBER_PERF_SCOPE(OP_FIND_BY_BIRTHDAY);
+    ids.clear();
+    return birthdayIndex.range(fromKey, toKey, ids);
+}
+
+/**
+ * @brief 根据会员ID查找可修改的会员
+ * @param id 会员ID
+ * @return 会员指针，如果未找到则返回nullptr
+ */
+Member* MemberManager::findMember(int id) {
+    auto it = idIndex.find(id);
+    return it == idIndex.end() ? faultIn(id) : &members[it->second];
 }
 
 /**
  * @brief 添加消费记录并计算积分
  * @param id 会员ID
  * @param amount 消费金额
+ * @return 结果码及本次消费的结算结果
  * @details 为指定会员添加消费记录并自动计算积分
  */
-void MemberManager::addSpending(int id, double amount) {
-    for (auto& member : members) {
-        if (member.getId() == id) {
-            member.addSpending(amount);
-            return;
+MemberManager::SpendingResult MemberManager::addSpending(int id, double amount) {
+    return addSpendingAt(id, amount, time(0));
+}
+
+/**
+ * @brief 按指定时间添加消费记录
+ * @param id 会员ID
+ * @param amount 消费金额
+ * @param now 消费时间（备库重放时为主库的消费时间）
+ * @return 结果码及本次消费的结算结果
+ */
+MemberManager::SpendingResult MemberManager::addSpendingAt(int id, double amount, time_t now) {
+    MEMBER_PERF_SCOPE(OP_ADD_SPENDING);
+    SpendingResult result;
+    checkYearRollover();
+    Member* member = findMember(id);
+    if (!member) {
+        result.status = STATUS_NOT_FOUND;
+        return result;
+    }
+    if (!(amount > 0)) {
+        result.status = STATUS_INVALID_ARGUMENT;
+        return result;
+    }
+    unindexMember(*member);
+    result.receipt = member->addSpending(amount, now);
+    indexMember(*member);
+
+    int32_t dayKey, monthKey;
+    rollupKeys(now, dayKey, monthKey);
+    spendingRollup.add(amount, dayKey, monthKey);
+    if (replicationLog.isOpen()) {
+        ReplicationRecord record;
+        record.type = ReplicationRecord::ADD_SPENDING;
+        record.id = id;
+        record.amount = amount;
+        record.time = static_cast<int64_t>(now);
+        if (!replicationLog.append(record)) {
+            result.status = STATUS_IO_ERROR;
         }
     }
-    std::cout << "未找到该ID的会员！" << std::endl;
+    return result;
 }
 
 /**
  * @brief 积分兑换
  * @param id 会员ID
  * @param pointsToRedeem 要兑换的积分数量
+ * @return 结果码及兑换后的积分余额
  * @details 为指定会员进行积分兑换操作
  */
-void MemberManager::redeemPoints(int id, int pointsToRedeem) {
-    for (auto& member : members) {
-        if (member.getId() == id) {
-            member.redeemPoints(pointsToRedeem);
-            return;
+MemberManager::RedeemResult MemberManager::redeemPoints(int id, int pointsToRedeem) {
+    MEMBER_PERF_SCOPE(OP_REDEEM_POINTS);
+    RedeemResult result;
+    Member* member = findMember(id);
+    if (!member) {
+        result.status = STATUS_NOT_FOUND;
+        return result;
+    }
+    if (pointsToRedeem <= 0) {
+        result.status = STATUS_INVALID_ARGUMENT;
+    } else if (pointsToRedeem > member->getPoints()) {
+        result.status = STATUS_INSUFFICIENT_POINTS;
+    } else {
+        unindexMember(*member);
+        member->redeemPoints(pointsToRedeem);
+        indexMember(*member);
+        result.redeemed = pointsToRedeem;
+        if (replicationLog.isOpen()) {
+            ReplicationRecord record;
+            record.type = ReplicationRecord::REDEEM_POINTS;
+            record.id = id;
+            record.value = pointsToRedeem;
+            if (!replicationLog.append(record)) {
+                result.status = STATUS_IO_ERROR;
+            }
         }
     }
-    std::cout << "未找到该ID的会员！" << std::endl;
+    result.remaining = member->getPoints();
+    return result;
 }
 
 /**
- * @brief 显示会员消费历史
- * @param id 会员ID
- * @param n 显示最近N次消费记录，-1表示显示全部
- * @details 显示指定会员的消费历史记录，包含会员基本信息
+ * @brief 为一段日期内过生日的会员赠送奖励积分
+ * @param fromKey 起始日期的桶编号（含）
+ * @param toKey 结束日期的桶编号（含）
+ * @param bonus 每位会员奖励的积分
+ * @return 结果码、获得奖励的会员数及赠送的积分总数
+ * @details 逐桶处理，休眠在磁盘上的会员先调回内存；生日不会因赠送积分而改变，
+ *          调回也不改动生日索引，遍历过程中桶内容保持不变。
+ *          启用复制时每位获奖会员记一条 ADD_BONUS，整段范围的记录一次写入日志。
+ *          磁盘上读不出的会员跳过，结果码为 STATUS_IO_ERROR
  */
-void MemberManager::showMemberSpendingHistory(int id, int n) const {
-    for (const auto& member : members) {
-        if (member.getId() == id) {
-            // 获取等级名称
-            std::string levelName;
-            switch (member.getCurrentLevel()) {
-            case Member::DIAMOND: levelName = "钻石会员"; break;
-            case Member::GOLD: levelName = "黄金会员"; break;
-            case Member::SILVER: levelName = "白银会员"; break;
-            default: levelName = "普通会员"; break;
+MemberManager::BonusResult MemberManager::grantBirthdayBonus(int fromKey, int toKey, int bonus) {
+    MEMBER_PERF_SCOPE(OP_BIRTHDAY_BONUS);
+    MEMBER_TRACE_SCOPE("grantBirthdayBonus");
+    BonusResult result;
+    if (bonus <= 0 || fromKey < 0 || fromKey >= BirthdayIndex::DAY_COUNT ||
+        toKey < 0 || toKey >= BirthdayIndex::DAY_COUNT) {
+        result.status = STATUS_INVALID_ARGUMENT;
+        return result;
+    }
+    bool replicating = replicationLog.isOpen();
+    bool batched = replicationLog.isBatching();
+    if (replicating) {
+        replicationLog.setBatching(true);
+    }
+    for (int key = fromKey;; key = BirthdayIndex::addDays(key, 1)) {
+        for (int id : birthdayIndex.bucket(key)) {
+            Member* member = findMember(id);
+            if (!member) {
+                // 磁盘上的会员读不出来（段文件损坏或读取出错），跳过并报告
+                result.status = STATUS_IO_ERROR;
+                continue;
             }
-            
-            // 获取折扣率
-            double discountRate = member.getDiscountRate();
-            std::string discountText = (discountRate < 1.0) ? 
-                std::to_string(static_cast<int>(discountRate * 10)) + "折" : "无折扣";
-            
-            // 显示会员基本信息
-            std::cout << "\n=== 会员消费历史 ===" << std::endl;
-            std::cout << "┌─────────────────────────────────────────────────────────────────┐" << std::endl;
-            std::cout << "│ 会员ID: " << std::left << std::setw(8) << member.getId() << std::endl;
-            std::cout << "│ 姓名: " << std::left << std::setw(15) << member.getName() << std::endl;
-            std::cout << "│ 电话: " << std::left << std::setw(15) << member.getPhone() << std::endl;
-            std::cout << "│ 生日: " << std::left << std::setw(15) << member.getBirthday() << std::endl;
-            std::cout << "│ 等级: " << std::left << std::setw(15) << levelName << std::endl;
-            std::cout << "│ 优惠: " << std::left << std::setw(15) << discountText << std::endl;
-            std::cout << "│ 总消费: " << std::left << std::setw(15) << std::fixed << std::setprecision(2) << member.getTotalSpent() << "元" << std::endl;
-            std::cout << "│ 年度消费: " << std::left << std::setw(15) << std::fixed << std::setprecision(2) << member.getAnnualSpent() << "元" << std::endl;
-            std::cout << "│ 积分: " << std::left << std::setw(15) << member.getPoints() << std::endl;
-            std::cout << "│ 积分规则: 1元=" << std::left << std::setw(15) << member.getPointsPerDollar() << "积分" << std::endl;
-            std::cout << "│ 上次消费年份: " << std::left << std::setw(15) << member.getLastYear() << std::endl;
-            std::cout << "└─────────────────────────────────────────────────────────────────┘" << std::endl;
-            
-            // 显示消费历史
-            member.showConsumptionHistory(n);
-            return;
-        }
-    }
-    std::cout << "未找到该ID的会员！" << std::endl;
+            unindexMember(*member);
+            if (member->addBonusPoints(bonus)) {
+                result.members += 1;
+                result.pointsGranted += bonus;
+                if (replicating) {
+                    ReplicationRecord record;
+                    record.type = ReplicationRecord::ADD_BONUS;
+                    record.id = id;
+                    record.value = bonus;
+                    replicationLog.append(record);
+                }
+            }
+            indexMember(*member);
+        }
+        if (key == toKey) {
+            break;
+        }
+    }
+    if (replicating && !batched) {
+        replicationLog.setBatching(false);
+        if (replicationLog.failed()) {
+            result.status = STATUS_IO_ERROR;
+        }
+    }
+    return result;
 }
 
 /**
  * @brief 设置积分规则
  * @param rule 新的积分规则（1元=多少积分）
+ * @return STATUS_OK、STATUS_INVALID_ARGUMENT 或 STATUS_IO_ERROR
  * @details 更新系统积分规则并应用到所有现有会员
  */
-void MemberManager::setPointsRule(int rule) {
+MemberManager::Status MemberManager::setPointsRule(int rule) {
+    if (rule <= 0) {
+        return STATUS_INVALID_ARGUMENT;
+    }
     pointsRule = rule;
     for (auto& member : members) {
         member.setPointsRule(rule);
     }
-    std::cout << "积分规则已更新：1元=" << rule << "积分" << std::endl;
+    columnsStale = true;
+    if (replicationLog.isOpen()) {
+        ReplicationRecord record;
+        record.type = ReplicationRecord::SET_POINTS_RULE;
+        record.value = rule;
+        if (!replicationLog.append(record)) {
+            return STATUS_IO_ERROR;
+        }
+    }
+    return STATUS_OK;
 }
 
 /**
  * @brief 保存数据到文件
  * @param filename 文件名
+ * @param encoding 文件编码，姓名等文本在写出前由本机编码转换为该编码
+ * @return STATUS_OK 或 STATUS_IO_ERROR
  * @details 将所有会员数据以CSV格式保存到指定文件
  */
-void MemberManager::saveToFile(const std::string& filename) const {
-    std::ofstream file(filename);
+MemberManager::Status MemberManager::saveToFile(const std::string& filename, TextEncoding::Encoding encoding) const {
+    MEMBER_PERF_SCOPE(OP_SAVE);
+    MEMBER_TRACE_SCOPE("saveToFile");
+    std::ofstream file(filename, std::ios::binary);
     if (!file) {
-        std::cerr << "无法打开文件: " << filename << std::endl;
-        return;
+        return STATUS_IO_ERROR;
     }
     
-    // 保存每个会员的完整信息到CSV格式
-    for (const auto& member : members) {
-        file << member.getId() << ","
-            << member.getName() << ","
-            << member.getPhone() << ","
-            << member.getBirthday() << ","
-            << member.getTotalSpent() << ","
-            << member.getPoints() << ","
-            << member.getPointsPerDollar() << ","
-            << member.getAnnualSpent() << ","
-            << static_cast<int>(member.getCurrentLevel()) << ","
-            << member.getLastYear() << "\n";
+    // 保存每个会员的完整信息到CSV格式，内存中和磁盘上的会员按ID顺序合并写出
+    std::ostringstream content;
+    {
+        MEMBER_TRACE_SCOPE("save.format");
+        std::vector<int> coldIds;
+        coldStore.ids(coldIds);
+        size_t next = 0;
+        Member cold(0, "", "", "");
+        auto writeColdBefore = [&](long long limit) {
+            for (; next < coldIds.size() && coldIds[next] < limit; ++next) {
+                if (!coldStore.fetch(coldIds[next], cold)) {
+                    return false;
+                }
+                appendMemberLine(content, cold);
+            }
+            return true;
+        };
+        std::vector<size_t> order;
+        idOrder(order);
+        for (size_t pos : order) {
+            const Member& member = members[pos];
+            if (!writeColdBefore(member.getId())) {
+                return STATUS_IO_ERROR;
+            }
+            appendMemberLine(content, member);
+        }
+        if (!writeColdBefore(static_cast<long long>(INT32_MAX) + 1)) {
+            return STATUS_IO_ERROR;
+        }
     }
+
+    // 整个文件一次转换编码后写出
+    std::string text = content.str();
+    if (encoding != TextEncoding::nativeEncoding()) {
+        MEMBER_TRACE_SCOPE("save.encode");
+        std::string converted;
+        TextEncoding::convert(text, TextEncoding::nativeEncoding(), encoding, converted);
+        text.swap(converted);
+    }
+    MEMBER_TRACE_SCOPE("save.write");
+    file.write(text.data(), static_cast<std::streamsize>(text.size()));
     file.close();
-    std::cout << "数据已保存到文件: " << filename << std::endl;
+    return file ? STATUS_OK : STATUS_IO_ERROR;
 }
 
 /**
  * @brief 从文件加载数据
  * @param filename 文件名
- * @details 从指定CSV文件加载会员数据到系统
+ * @return STATUS_OK 或 STATUS_IO_ERROR
+ * @details 从指定CSV文件加载会员数据到系统。
+ *          先整体读入并检测编码（GBK 或 UTF-8），与本机编码不同时整体转换后再解析，
+ *          GBK 双字节的尾字节不会与逗号、换行冲突，因此可以安全地整块转换
  */
-void MemberManager::loadFromFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file) {
-        std::cerr << "无法打开文件: " << filename << std::endl;
-        return;
+MemberManager::Status MemberManager::loadFromFile(const std::string& filename) {
+    MEMBER_PERF_SCOPE(OP_LOAD);
+    MEMBER_TRACE_SCOPE("loadFromFile");
+    std::string text;
+    {
+        MEMBER_TRACE_SCOPE("load.read");
+        std::ifstream file(filename, std::ios::binary);
+        if (!file) {
+            return STATUS_IO_ERROR;
+        }
+        text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    {
+        MEMBER_TRACE_SCOPE("load.decode");
+        TextEncoding::Encoding encoding = TextEncoding::detect(text);
+        if (encoding != TextEncoding::nativeEncoding()) {
+            std::string converted;
+            TextEncoding::convert(text, encoding, TextEncoding::nativeEncoding(), converted);
+            text.swap(converted);
+        }
     }
     
-    // 清空现有数据并重置ID计数器
+    // 清空现有数据并重置ID计数器；启用冷热分层时休眠会员分批直接写入段文件
     members.clear();
     nextId = 1;
+    if (coldStore.isOpen() && !coldStore.open(coldPath)) {
+        dormantYears = 0;
+    }
+    const size_t COLD_BATCH = 4096;
+    const int year = currentYear();
+    std::vector<Member> dormant;
+    auto flushDormant = [&] {
+        MEMBER_TRACE_SCOPE("load.coldFlush");
+        std::vector<const Member*> batch;
+        for (const Member& member : dormant) {
+            batch.push_back(&member);
+        }
+        if (!coldStore.put(batch)) {
+            // 写盘失败的会员留在内存中
+            members.insert(members.end(), dormant.begin(), dormant.end());
+        }
+        dormant.clear();
+    };
     
-    std::string line;
-    while (std::getline(file, line)) {
-        std::istringstream iss(line);
-        std::string token;
-        std::vector<std::string> data;
+    // 解析与校验逐行交替进行，整体记为一个阶段
+    {
+        MEMBER_TRACE_SCOPE("load.parse");
+        std::istringstream input(text);
+        std::string line;
+        while (std::getline(input, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            std::istringstream iss(line);
+            std::string token;
+            std::vector<std::string> data;
         
-        // 解析CSV格式的数据
-        while (std::getline(iss, token, ',')) {
-            data.push_back(token);
-        }
+            // 解析CSV格式的数据
+            while (std::getline(iss, token, ',')) {
+                data.push_back(token);
+            }
         
-        // 验证数据完整性（应该有10个字段）
-        if (data.size() != 10) continue;
+            // 验证数据完整性（应该有10个字段）
+            if (data.size() != 10) continue;
         
-        // 解析各个字段并创建会员对象
-        int id = std::stoi(data[0]);
-        nextId = std::max(nextId, id + 1);  // 更新下一个可用ID
+            // 解析各个字段并创建会员对象
+            int id = std::stoi(data[0]);
+            nextId = std::max(nextId, id + 1);  // 更新下一个可用ID
         
-        // 确保数值字段有效
-        double totalSpent = std::stod(data[4]);
-        int points = std::stoi(data[5]);
-        int pointsRule = std::stoi(data[6]);
-        double annualSpent = std::stod(data[7]);
-        int level = std::stoi(data[8]);
-        int lastYear = std::stoi(data[9]);
+            // 确保数值字段有效
+            double totalSpent = std::stod(data[4]);
+            int points = std::stoi(data[5]);
+            int pointsRule = std::stoi(data[6]);
+            double annualSpent = std::stod(data[7]);
+            int level = std::stoi(data[8]);
+            int lastYear = std::stoi(data[9]);
         
-        // 验证数值的有效性
-        if (totalSpent < 0) totalSpent = 0.0;
-        if (points < 0) points = 0;
-        if (pointsRule < 1) pointsRule = 1;
-        if (annualSpent < 0) annualSpent = 0.0;
-        if (level < 0 || level > 3) level = 0;  // 0-3 对应 NORMAL-DIAMOND
-        if (lastYear < 0) lastYear = 0;
+            // 验证数值的有效性
+            if (totalSpent < 0) totalSpent = 0.0;
+            if (points < 0) points = 0;
+            if (pointsRule < 1) pointsRule = 1;
+            if (annualSpent < 0) annualSpent = 0.0;
+            if (level < 0 || level > 3) level = 0;  // 0-3 对应 NORMAL-DIAMOND
+            if (lastYear < 0) lastYear = 0;
         
-        Member member(id, data[1], data[2], data[3], pointsRule,
-                     annualSpent, static_cast<Member::Level>(level),
-                     lastYear);
+            Member member(id, data[1], data[2], data[3], pointsRule,
+                         annualSpent, static_cast<Member::Level>(level),
+                         lastYear);
         
-        // 恢复会员的积分规则
-        member.setPointsRule(pointsRule);
+            // 恢复会员的积分规则和累计数据（构造函数只按年度消费推算）
+            member.setPointsRule(pointsRule);
+            member.restoreTotals(totalSpent, points, static_cast<Member::Level>(level));
         
-        members.push_back(member);
+            if (coldStore.isOpen() && isDormant(member, year)) {
+                dormant.push_back(member);
+                if (dormant.size() >= COLD_BATCH) {
+                    flushDormant();
+                }
+                continue;
+            }
+            members.push_back(member);
+        }
     }
-    file.close();
-    std::cout << "数据已从文件加载: " << filename << std::endl;
+    if (!dormant.empty()) {
+        flushDormant();
+    }
+    if (historyArchive.isOpen()) {
+        // 最大ID的会员被删除后，数据文件中不再有它，但归档中仍有按该ID保存的历史
+        nextId = std::max(nextId, historyArchive.maxMemberId() + 1);
+    }
+    members.shrink_to_fit();
+    rebuildIndexes();
+    // 加载的数据不在当前纪元的快照中，备库需要从新快照重新开始
+    if (replicationLog.isOpen()) {
+        std::string directory = replicationLog.directory();
+        return enableReplication(directory);
+    }
+    return STATUS_OK;
+}
+
+// ==================== 会员排行榜 ====================
+
+/**
+ * @brief 获取排行榜前N名
+ * @param key 排序依据
+ * @param n 需要的名次数量
+ * @return 按名次排列的会员ID
+ */
+std::vector<int> MemberManager::getTopMembers(RankKey key, size_t n) {
+    MEMBER_PERF_SCOPE(OP_TOP_MEMBERS);
+    checkYearRollover();
+    std::vector<int> result;
+    rankIndexes[key].topK(n, result);
+    return result;
+}
+
+/**
+ * @brief 获取会员在排行榜中的名次
+ * @param key 排序依据
+ * @param id 会员ID
+ * @return 从1开始的名次，如果未找到会员则返回-1
+ */
+int MemberManager::getMemberRank(RankKey key, int id) {
+    MEMBER_PERF_SCOPE(OP_MEMBER_RANK);
+    checkYearRollover();
+    const Member* member = getMemberById(id);
+    if (!member) {
+        return -1;
+    }
+    return static_cast<int>(rankIndexes[key].rankOf(rankScore(*member, key), id));
+}
+
+/**
+ * @brief 执行年度切换
+ * @param year 当前年份
+ * @details 只有分值发生变化的会员才重新插入，每人 O(log N)
+ */
+void MemberManager::applyYearRollover(int year) {
+    if (year == rankYear) {
+        return;
+    }
+    MEMBER_TRACE_SCOPE("yearRollover");
+    RankIndex& annual = rankIndexes[RANK_ANNUAL_SPENT];
+    for (const auto& member : members) {
+        double oldScore = rankScore(member, RANK_ANNUAL_SPENT);
+        double newScore = (member.getLastYear() == year) ? member.getAnnualSpent() : 0.0;
+        if (oldScore != newScore) {
+            annual.erase(oldScore, member.getId());
+            annual.insert(newScore, member.getId());
+            levelStats.annualRevenueCents[member.getCurrentLevel()] += toCents(newScore) - toCents(oldScore);
+        }
+    }
+    rankYear = year;
+    if (historyArchive.isOpen() && year - 1 > archivedYear) {
+        archiveHistory(year - 1);
+    }
+}
+
+/**
+ * @brief 检查系统时间是否已进入新的年度
+ */
+void MemberManager::checkYearRollover() {
+    applyYearRollover(currentYear());
+}
+
+/**
+ * @brief 计算会员在指定排行中的分值
+ * @param member 会员对象
+ * @param key 排序依据
+ * @return 排名分值
+ */
+double MemberManager::rankScore(const Member& member, RankKey key) const {
+    switch (key) {
+    case RANK_ANNUAL_SPENT:
+        // 上一年度的消费不计入本年度排行
+        return (member.getLastYear() == rankYear) ? member.getAnnualSpent() : 0.0;
+    case RANK_TOTAL_SPENT:
+        return member.getTotalSpent();
+    default:
+        return member.getPoints();
+    }
+}
+
+/**
+ * @brief 将会员加入各项索引
+ * @param member 会员对象
+ */
+void MemberManager::indexMember(const Member& member) {
+    columnsStale = true;
+    for (int key = 0; key < RANK_KEY_COUNT; ++key) {
+        rankIndexes[key].insert(rankScore(member, static_cast<RankKey>(key)), member.getId());
+    }
+    int level = member.getCurrentLevel();
+    levelStats.memberCount[level] += 1;
+    levelStats.pointsOutstanding[level] += member.getPoints();
+    levelStats.annualRevenueCents[level] += toCents(rankScore(member, RANK_ANNUAL_SPENT));
+}
+
+/**
+ * @brief 将会员从各项索引中移除
+ * @param member 会员对象
+ */
+void MemberManager::unindexMember(const Member& member) {
+    columnsStale = true;
+    for (int key = 0; key < RANK_KEY_COUNT; ++key) {
+        rankIndexes[key].erase(rankScore(member, static_cast<RankKey>(key)), member.getId());
+    }
+    int level = member.getCurrentLevel();
+    levelStats.memberCount[level] -= 1;
+    levelStats.pointsOutstanding[level] -= member.getPoints();
+    levelStats.annualRevenueCents[level] -= toCents(rankScore(member, RANK_ANNUAL_SPENT));
+}
+
+/**
+ * @brief 重建全部索引
+ */
+void MemberManager::rebuildIndexes() {
+    MEMBER_TRACE_SCOPE("rebuildIndexes");
+    rankYear = currentYear();
+    columnsStale = true;
+    idIndex.clear();
+    idIndex.reserve(members.size());
+    phoneIndex.clear();
+    birthdayIndex.clear();
+    for (auto& index : rankIndexes) {
+        index.clear();
+    }
+    levelStats = LevelStats();
+    {
+        MEMBER_TRACE_SCOPE("index.members");
+        for (size_t i = 0; i < members.size(); ++i) {
+            idIndex[members[i].getId()] = i;
+            phoneIndex.insert(members[i].getPhone(), members[i].getId());
+            birthdayIndex.insert(members[i].getBirthday(), members[i].getId());
+            indexMember(members[i]);
+        }
+    }
+    // 休眠在磁盘上的会员仍可按姓名、生日查到：从段文件读出姓名和生日加入索引
+    std::vector<std::pair<std::string, int>> coldNames;
+    if (coldStore.size() > 0) {
+        MEMBER_TRACE_SCOPE("index.cold");
+        std::vector<int> coldIds;
+        coldStore.ids(coldIds);
+        coldNames.reserve(coldIds.size());
+        Member cold(0, "", "", "");
+        for (int id : coldIds) {
+            if (coldStore.fetch(id, cold)) {
+                coldNames.emplace_back(cold.getName(), id);
+                birthdayIndex.insert(cold.getBirthday(), id);
+            }
+        }
+    }
+    {
+        MEMBER_TRACE_SCOPE("index.names");
+        nameIndex.build(members, coldNames);
+    }
+    nameKeys.resize(members.size());
+    parallelFor(members.size(), defaultThreadCount(), [this](unsigned, size_t begin, size_t end) {
+        MEMBER_TRACE_SCOPE("index.collation");
+        for (size_t i = begin; i < end; ++i) {
+            nameKeys[i] = Collation::nameKey(members[i].getName());
+        }
+    });
+}
+
+// ==================== 排序 ====================
+
+/**
+ * @brief 按指定方式排序会员列表
+ * @param order 排序方式
+ * @param positions 输出：排序后的会员下标
+ * @param threads 工作线程数，0 表示使用硬件并发数
+ * @details 降序的依据取反后放入排序键；排序键按会员ID顺序生成，
+ *          基数排序是稳定的，因此排序键相同的会员自然按ID升序
+ */
+void MemberManager::sortMembers(SortOrder order, std::vector<size_t>& positions, unsigned threads) const {
+    MEMBER_PERF_SCOPE(OP_SORT_MEMBERS);
+    MEMBER_TRACE_SCOPE("sortMembers");
+    const size_t count = members.size();
+    std::vector<size_t> byId;
+    idOrder(byId);
+    if (order == SORT_BY_ID) {
+        positions.swap(byId);
+        return;
+    }
+    positions.resize(count);
+    if (threads == 0) {
+        threads = defaultThreadCount();
+    }
+
+    // 金额以分为单位放在低 56 位，等级放在最高字节
+    const uint64_t AMOUNT_MASK = (uint64_t(1) << 56) - 1;
+    std::vector<RadixSort::Entry> entries(count);
+    parallelFor(count, threads, [&](unsigned, size_t begin, size_t end) {
+        MEMBER_TRACE_SCOPE("sort.keys");
+        for (size_t i = begin; i < end; ++i) {
+            size_t pos = byId[i];
+            uint64_t key = 0;
+            if (order == SORT_BY_NAME) {
+                key = nameKeys[pos];
+            } else {
+                uint64_t cents = static_cast<uint64_t>(std::max(0LL, toCents(rankScore(members[pos], RANK_ANNUAL_SPENT))));
+                key = AMOUNT_MASK - std::min(cents, AMOUNT_MASK);
+                if (order == SORT_BY_LEVEL_SPENT) {
+                    key |= static_cast<uint64_t>(LEVEL_COUNT - 1 - members[pos].getCurrentLevel()) << 56;
+                }
+            }
+            entries[i] = { key, static_cast<uint32_t>(pos) };
+        }
+    });
+    RadixSort::sort(entries, threads);
+    for (size_t i = 0; i < count; ++i) {
+        positions[i] = entries[i].position;
+    }
+}
+
+/**
+ * @brief 获取按会员ID升序的会员下标
+ * @param positions 输出：会员下标
+ * @details 新会员追加在末尾，列表通常已按ID排列，直接返回；
+ *          从磁盘调回的会员追加在末尾、删除时末尾的会员移到空位，此时按ID做一次基数排序
+ */
+void MemberManager::idOrder(std::vector<size_t>& positions) const {
+    const size_t count = members.size();
+    positions.resize(count);
+    bool sorted = true;
+    for (size_t i = 0; i < count; ++i) {
+        positions[i] = i;
+        sorted = sorted && (i == 0 || members[i - 1].getId() < members[i].getId());
+    }
+    if (sorted) {
+        return;
+    }
+    std::vector<RadixSort::Entry> entries(count);
+    for (size_t i = 0; i < count; ++i) {
+        entries[i] = { static_cast<uint32_t>(members[i].getId()), static_cast<uint32_t>(i) };
+    }
+    RadixSort::sort(entries);
+    for (size_t i = 0; i < count; ++i) {
+        positions[i] = entries[i].position;
+    }
+}
+
+// ==================== 冷热分层 ====================
+
+/**
+ * @brief 启用冷热分层
+ * @param segmentPath 段文件路径
+ * @param inactiveYears 休眠阈值（年）
+ * @return STATUS_OK、STATUS_INVALID_ARGUMENT 或 STATUS_IO_ERROR
+ * @details 已启用时只更新阈值，磁盘上已有的会员保持不变
+ */
+MemberManager::Status MemberManager::enableTiering(const std::string& segmentPath, int inactiveYears) {
+    if (inactiveYears <= 0 || segmentPath.empty()) {
+        return STATUS_INVALID_ARGUMENT;
+    }
+    if (!coldStore.isOpen()) {
+        if (!coldStore.open(segmentPath)) {
+            return STATUS_IO_ERROR;
+        }
+        coldPath = segmentPath;
+    }
+    dormantYears = inactiveYears;
+    return STATUS_OK;
+}
+
+/**
+ * @brief 判断会员是否休眠
+ * @param member 会员对象
+ * @param year 当前年份
+ * @return true 有过消费且最近一次消费距今达到休眠阈值
+ * @details 从未消费过的会员无法判断注册时间，始终留在内存中
+ */
+bool MemberManager::isDormant(const Member& member, int year) const {
+    return dormantYears > 0 && member.getLastYear() > 0 && year - member.getLastYear() >= dormantYears;
+}
+
+/**
+ * @brief 把内存中的休眠会员转存到磁盘
+ * @return 本次转存的会员数
+ * @details 先整批写入段文件，成功后再从会员列表中移除并重建索引
+ */
+size_t MemberManager::evictDormant() {
+    MEMBER_PERF_SCOPE(OP_EVICT_DORMANT);
+    MEMBER_TRACE_SCOPE("evictDormant");
+    if (!coldStore.isOpen()) {
+        return 0;
+    }
+    int year = currentYear();
+    std::vector<const Member*> batch;
+    for (const auto& member : members) {
+        if (isDormant(member, year)) {
+            batch.push_back(&member);
+        }
+    }
+    if (batch.empty()) {
+        return 0;
+    }
+    {
+        MEMBER_TRACE_SCOPE("evict.write");
+        if (!coldStore.put(batch)) {
+            return 0;
+        }
+    }
+    members.erase(std::remove_if(members.begin(), members.end(),
+                                 [&](const Member& member) { return isDormant(member, year); }),
+                  members.end());
+    members.shrink_to_fit();
+    rebuildIndexes();
+    return batch.size();
+}
+
+/**
+ * @brief 从磁盘调回一个休眠会员
+ * @param id 会员ID
+ * @return 调回后的会员指针，会员不在磁盘上时返回nullptr
+ * @details 追加到会员列表末尾，不移动其它会员；需要ID顺序的地方（保存、排序）另行排序。
+ *          姓名和生日索引本来就包含磁盘上的会员，无需再加入
+ */
+Member* MemberManager::faultIn(int id) {
+    Member member(0, "", "", "");
+    if (!coldStore.isOpen() || !coldStore.fetch(id, member)) {
+        return nullptr;
+    }
+    coldStore.erase(id);
+    members.push_back(std::move(member));
+    size_t pos = members.size() - 1;
+    const Member& restored = members[pos];
+    nameKeys.push_back(Collation::nameKey(restored.getName()));
+    idIndex[id] = pos;
+    phoneIndex.insert(restored.getPhone(), id);
+    indexMember(restored);
+    return &members[pos];
+}
+
+/**
+ * @brief 获取已转存到磁盘的会员数量
+ * @return 会员数量
+ */
+size_t MemberManager::getColdMemberCount() const {
+    return coldStore.size();
+}
+
+/**
+ * @brief 获取休眠会员磁盘存储（只读）
+ * @return 磁盘存储的常量引用
+ */
+const ColdStore& MemberManager::getColdStore() const {
+    return coldStore;
+}
+
+// ==================== 消费历史归档 ====================
+
+/**
+ * @brief 启用消费历史的年度归档
+ * @param directory 归档目录
+ * @return 结果码
+ */
+MemberManager::Status MemberManager::enableHistoryArchive(const std::string& directory) {
+    if (!historyArchive.open(directory)) {
+        return STATUS_IO_ERROR;
+    }
+    archivedYear = historyArchive.latestYear();
+    // 已归档的ID不再分配，即使对应会员已被删除、不在数据文件中
+    nextId = std::max(nextId, historyArchive.maxMemberId() + 1);
+    int closedYear = currentYear() - 1;
+    if (closedYear > archivedYear) {
+        return archiveHistory(closedYear).status;
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @brief 把指定年度及更早的消费记录写入该年度的归档
+ * @param closedYear 已结束的年度
+ * @return 结果码及归档数量
+ * @details 按会员ID顺序收集每人消费历史开头属于已结束年度的部分，整段写入后再从内存中移除；
+ *          没有任何记录时不写段文件，但同样视为该年度已归档
+ */
+MemberManager::ArchiveResult MemberManager::archiveHistory(int closedYear) {
+    MEMBER_PERF_SCOPE(OP_ARCHIVE_HISTORY);
+    MEMBER_TRACE_SCOPE("archiveHistory");
+    ArchiveResult result;
+    if (!historyArchive.isOpen() || closedYear <= archivedYear) {
+        result.status = STATUS_INVALID_ARGUMENT;
+        return result;
+    }
+    std::vector<size_t> order;
+    idOrder(order);
+    std::vector<HistoryArchive::Batch> batches;
+    std::vector<size_t> archived;
+    for (size_t pos : order) {
+        const Member& member = members[pos];
+        size_t count = member.closedHistoryCount(closedYear + 1);
+        if (count > 0) {
+            batches.push_back({ member.getId(), member.getConsumptionHistory().data(), count });
+            archived.push_back(pos);
+            result.records += count;
+        }
+    }
+    if (!batches.empty()) {
+        MEMBER_TRACE_SCOPE("archive.write");
+        if (!historyArchive.writeYear(closedYear, batches)) {
+            result.status = STATUS_IO_ERROR;
+            result.records = 0;
+            return result;
+        }
+    }
+    for (size_t i = 0; i < archived.size(); ++i) {
+        members[archived[i]].dropOldestHistory(batches[i].count);
+    }
+    result.members = archived.size();
+    archivedYear = closedYear;
+    return result;
+}
+
+/**
+ * @brief 获取消费历史归档（只读）
+ * @return 归档的常量引用
+ */
+const HistoryArchive& MemberManager::getHistoryArchive() const {
+    return historyArchive;
+}
+
+// ==================== 内存统计 ====================
+
+/**
+ * @brief 统计各子系统的内存占用
+ * @return 内存占用报告
+ */
+MemberManager::MemoryReport MemberManager::getMemoryReport() const {
+    MemoryReport report;
+    MemoryUsage* usage = report.subsystems;
+    usage[MEMORY_MEMBERS].addVector(members);
+    usage[MEMORY_MEMBERS].objects = members.size();
+    for (const Member& member : members) {
+        usage[MEMORY_STRINGS].addString(member.getName());
+        usage[MEMORY_STRINGS].addString(member.getPhone());
+        usage[MEMORY_STRINGS].addString(member.getBirthday());
+        const auto& history = member.getConsumptionHistory();
+        usage[MEMORY_HISTORY].addVector(history);
+        report.longestHistory = std::max(report.longestHistory, history.size());
+        report.historyRecords += history.size();
+    }
+    usage[MEMORY_STRINGS].objects = members.size() * 3;
+    usage[MEMORY_HISTORY].objects = report.historyRecords;
+    usage[MEMORY_ID_INDEX].addUnorderedMap(idIndex);
+    usage[MEMORY_ID_INDEX].objects = idIndex.size();
+    usage[MEMORY_PHONE_INDEX] = phoneIndex.memoryUsage();
+    usage[MEMORY_NAME_INDEX] = nameIndex.memoryUsage();
+    usage[MEMORY_BIRTHDAY_INDEX] = birthdayIndex.memoryUsage();
+    for (const RankIndex& index : rankIndexes) {
+        usage[MEMORY_RANK_INDEX] += index.memoryUsage();
+    }
+    usage[MEMORY_SORT_KEYS].addVector(nameKeys);
+    usage[MEMORY_SORT_KEYS].objects = nameKeys.size();
+    usage[MEMORY_COLD_STORE] = coldStore.memoryUsage();
+    usage[MEMORY_FILTER_COLUMNS].addVector(columns.id);
+    usage[MEMORY_FILTER_COLUMNS].addVector(columns.level);
+    usage[MEMORY_FILTER_COLUMNS].addVector(columns.annualSpent);
+    usage[MEMORY_FILTER_COLUMNS].addVector(columns.totalSpent);
+    usage[MEMORY_FILTER_COLUMNS].addVector(columns.points);
+    usage[MEMORY_FILTER_COLUMNS].addVector(columns.lastYear);
+    usage[MEMORY_FILTER_COLUMNS].addVector(columns.rule);
+    usage[MEMORY_FILTER_COLUMNS].objects = columns.size();
+
+    report.members = members.size();
+    report.coldDiskBytes = coldStore.isOpen() ? coldStore.segmentBytes() : 0;
+    report.archiveDiskBytes = historyArchive.diskBytes();
+    report.heap = HeapStats::read();
+    return report;
+}
+
+/**
+ * @brief 获取全部子系统的合计
+ * @return 合计占用
+ */
+MemoryUsage MemberManager::MemoryReport::total() const {
+    MemoryUsage sum;
+    for (const MemoryUsage& usage : subsystems) {
+        sum += usage;
+    }
+    return sum;
+}
+
+/**
+ * @brief 获取平均每位会员的消费记录条数
+ * @return 平均条数，没有会员时为0
+ */
+double MemberManager::MemoryReport::averageHistoryLength() const {
+    return members == 0 ? 0.0 : static_cast<double>(historyRecords) / static_cast<double>(members);
+}
+
+/**
+ * @brief 获取子系统的标识名
+ * @param subsystem 子系统
+ * @return 英文标识名
+ */
+const char* MemberManager::MemoryReport::subsystemName(MemorySubsystem subsystem) {
+    static const char* const NAMES[MEMORY_SUBSYSTEM_COUNT] = {
+        "members", "strings", "history", "id_index", "phone_index",
+        "name_index", "birthday_index", "rank_index", "sort_keys", "cold_store",
+        "filter_columns",
+    };
+    return NAMES[subsystem];
+}
+
+// ==================== 主备复制 ====================
+
+/**
+ * @brief 启用复制
+ * @param directory 复制目录
+ * @return 结果码
+ * @details 快照写完后才替换日志，备库看到新纪元时快照一定已完整
+ */
+MemberManager::Status MemberManager::enableReplication(const std::string& directory) {
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    ReplicationLog::Header header;
+    header.epoch = ReplicationLog::newEpoch();
+    header.nextId = nextId;
+    header.pointsRule = pointsRule;
+    if (saveToFile(ReplicationLog::snapshotPath(directory, header.epoch)) != STATUS_OK ||
+        !replicationLog.open(directory, header)) {
+        replicationLog.close();
+        return STATUS_IO_ERROR;
+    }
+    return STATUS_OK;
+}
+
+/**
+ * @brief 设置复制日志的批量模式
+ * @param batching true 时记录留在内存中
+ */
+void MemberManager::setReplicationBatching(bool batching) {
+    replicationLog.setBatching(batching);
+}
+
+/**
+ * @brief 把缓冲的复制记录写入日志文件
+ * @return true 成功或未启用复制
+ */
+bool MemberManager::flushReplication() {
+    return !replicationLog.isOpen() || replicationLog.flush();
+}
+
+/**
+ * @brief 获取复制日志
+ * @return 复制日志常量引用
+ */
+const ReplicationLog& MemberManager::getReplicationLog() const {
+    return replicationLog;
+}
+
+/**
+ * @brief 在备库上重放一条复制记录
+ * @param record 主库记录的变更
+ * @return 重放结果
+ */
+MemberManager::Status MemberManager::applyReplicationRecord(const ReplicationRecord& record) {
+    switch (record.type) {
+    case ReplicationRecord::ADD_MEMBER:
+        if (record.id != nextId) {
+            return STATUS_INVALID_ARGUMENT;
+        }
+        addMember(record.name, record.phone, record.birthday);
+        return STATUS_OK;
+    case ReplicationRecord::DELETE_MEMBER:
+        return deleteMember(record.id);
+    case ReplicationRecord::UPDATE_PHONE:
+        return updateMemberPhone(record.id, record.phone);
+    case ReplicationRecord::ADD_SPENDING:
+        return addSpendingAt(record.id, record.amount, static_cast<time_t>(record.time)).status;
+    case ReplicationRecord::REDEEM_POINTS:
+        return redeemPoints(record.id, record.value).status;
+    case ReplicationRecord::SET_POINTS_RULE:
+        return setPointsRule(record.value);
+    case ReplicationRecord::ADD_BONUS: {
+        Member* member = findMember(record.id);
+        if (!member) {
+            return STATUS_NOT_FOUND;
+        }
+        unindexMember(*member);
+        bool granted = member->addBonusPoints(record.value);
+        indexMember(*member);
+        return granted ? STATUS_OK : STATUS_INVALID_ARGUMENT;
+    }
+    }
+    return STATUS_INVALID_ARGUMENT;
+}
+
+/**
+ * @brief 恢复快照之外的状态
+ * @param nextIdValue 下一个会员ID
+ * @param rule 积分规则
+ */
+void MemberManager::restoreReplicationState(int nextIdValue, int rule) {
+    nextId = std::max(nextId, nextIdValue);
+    if (rule > 0) {
+        pointsRule = rule;
+    }
+}
+
+// ==================== 汇总统计 ====================
+
+/**
+ * @brief 获取按等级汇总的统计数据
+ * @return 物化统计的常量引用
+ */
+const MemberManager::LevelStats& MemberManager::getLevelStats() const {
+    return levelStats;
+}
+
+/**
+ * @brief 获取全体会员按日、按月分桶的消费汇总
+ * @return 消费汇总环形缓冲区
+ */
+const GlobalSpendingRollup& MemberManager::getSpendingRollup() const {
+    return spendingRollup;
+}
+
+/**
+ * @brief 获取会员列式快照
+ * @return 列式快照的常量引用
+ */
+const MemberColumns& MemberManager::getMemberColumns() {
+    if (columnsStale) {
+        columns.build(members);
+        columnsStale = false;
+    }
+    return columns;
+}
+
+/**
+ * @brief 获取全部会员人数
+ * @return 各等级人数之和
+ */
+long long MemberManager::LevelStats::totalMembers() const {
+    long long total = 0;
+    for (long long count : memberCount) total += count;
+    return total;
+}
+
+/**
+ * @brief 获取全部未兑换积分
+ * @return 各等级积分之和
+ */
+long long MemberManager::LevelStats::totalPoints() const {
+    long long total = 0;
+    for (long long points : pointsOutstanding) total += points;
+    return total;
+}
+
+/**
+ * @brief 获取本年度消费总额（元）
+ * @return 各等级本年度消费之和
+ */
+double MemberManager::LevelStats::totalAnnualRevenue() const {
+    long long total = 0;
+    for (long long cents : annualRevenueCents) total += cents;
+    return total / 100.0;
+}
+
+/**
+ * @brief 获取指定等级本年度消费总额（元）
+ * @param level 会员等级
+ * @return 本年度消费总额
+ */
+double MemberManager::LevelStats::annualRevenue(int level) const {
+    return annualRevenueCents[level] / 100.0;
 }
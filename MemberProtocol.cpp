@@ -0,0 +1,319 @@
+/**
+ * @file MemberProtocol.cpp
+ * @brief 会员服务二进制协议实现文件
+ * @details 实现帧的写入与读取、各请求的编码以及会员记录、ID 列表的编码和解码
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "MemberProtocol.h"
+#include <cstring>
+
+// ==================== ProtocolWriter ====================
+
+/**
+ * @brief 开始一帧：预留 4 字节长度
+ */
+void ProtocolWriter::beginFrame() {
+    frameStart = out.size();
+    out.append(4, '\0');
+}
+
+/**
+ * @brief 结束当前帧：回填长度
+ */
+void ProtocolWriter::endFrame() {
+    uint32_t size = static_cast<uint32_t>(out.size() - frameStart - 4);
+    for (int i = 0; i < 4; ++i) {
+        out[frameStart + i] = static_cast<char>(size >> (8 * i));
+    }
+}
+
+ProtocolWriter& ProtocolWriter::u8(uint8_t value) {
+    out.push_back(static_cast<char>(value));
+    return *this;
+}
+
+ProtocolWriter& ProtocolWriter::u16(uint16_t value) {
+    out.push_back(static_cast<char>(value));
+    out.push_back(static_cast<char>(value >> 8));
+    return *this;
+}
+
+ProtocolWriter& ProtocolWriter::u32(uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<char>(value >> (8 * i)));
+    }
+    return *this;
+}
+
+ProtocolWriter& ProtocolWriter::i32(int32_t value) {
+    return u32(static_cast<uint32_t>(value));
+}
+
+ProtocolWriter& ProtocolWriter::u64(uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<char>(value >> (8 * i)));
+    }
+    return *this;
+}
+
+ProtocolWriter& ProtocolWriter::i64(int64_t value) {
+    return u64(static_cast<uint64_t>(value));
+}
+
+ProtocolWriter& ProtocolWriter::f64(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return u64(bits);
+}
+
+ProtocolWriter& ProtocolWriter::str(std::string_view value) {
+    size_t size = value.size() > 0xFFFF ? 0xFFFF : value.size();
+    u16(static_cast<uint16_t>(size));
+    out.append(value.data(), size);
+    return *this;
+}
+
+// ==================== ProtocolReader ====================
+
+/**
+ * @brief 取出接下来的 size 个字节
+ * @param size 字节数
+ * @return 起始位置，越界时返回空指针并记为无效
+ */
+const unsigned char* ProtocolReader::take(size_t size) {
+    if (!valid || static_cast<size_t>(end - cursor) < size) {
+        valid = false;
+        return nullptr;
+    }
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(cursor);
+    cursor += size;
+    return data;
+}
+
+uint8_t ProtocolReader::u8() {
+    const unsigned char* data = take(1);
+    return data ? data[0] : 0;
+}
+
+uint16_t ProtocolReader::u16() {
+    const unsigned char* data = take(2);
+    return data ? static_cast<uint16_t>(data[0] | (data[1] << 8)) : 0;
+}
+
+uint32_t ProtocolReader::u32() {
+    const unsigned char* data = take(4);
+    if (!data) {
+        return 0;
+    }
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+           (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+int32_t ProtocolReader::i32() {
+    return static_cast<int32_t>(u32());
+}
+
+uint64_t ProtocolReader::u64() {
+    const unsigned char* data = take(8);
+    if (!data) {
+        return 0;
+    }
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(data[i]) << (8 * i);
+    }
+    return value;
+}
+
+int64_t ProtocolReader::i64() {
+    return static_cast<int64_t>(u64());
+}
+
+double ProtocolReader::f64() {
+    uint64_t bits = u64();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string_view ProtocolReader::str() {
+    uint16_t size = u16();
+    const unsigned char* data = take(size);
+    return data ? std::string_view(reinterpret_cast<const char*>(data), size) : std::string_view();
+}
+
+// ==================== MemberProtocol ====================
+
+/**
+ * @brief 检查缓冲区开头的帧
+ * @param data 缓冲区
+ * @param size 缓冲区字节数
+ * @param maxSize 负载的最大字节数
+ * @param payloadSize 输出：负载字节数
+ * @return 帧状态
+ */
+MemberProtocol::FrameState MemberProtocol::peekFrame(const char* data, size_t size, uint32_t maxSize,
+                                                     uint32_t& payloadSize) {
+    if (size < 4) {
+        return FRAME_INCOMPLETE;
+    }
+    ProtocolReader header(data, 4);
+    payloadSize = header.u32();
+    if (payloadSize > maxSize) {
+        return FRAME_TOO_LARGE;
+    }
+    return size - 4 >= payloadSize ? FRAME_READY : FRAME_INCOMPLETE;
+}
+
+namespace {
+
+/**
+ * @brief 开始一个请求帧并写出操作码和请求号
+ * @param writer 写入器
+ * @param opcode 操作码
+ * @param requestId 请求号
+ */
+void beginRequest(ProtocolWriter& writer, MemberProtocol::Opcode opcode, uint32_t requestId) {
+    writer.beginFrame();
+    writer.u8(opcode).u32(requestId);
+}
+
+} // namespace
+
+void MemberProtocol::requestPing(std::string& out, uint32_t requestId) {
+    ProtocolWriter writer(out);
+    beginRequest(writer, OP_PING, requestId);
+    writer.endFrame();
+}
+
+void MemberProtocol::requestGetById(std::string& out, uint32_t requestId, int memberId) {
+    ProtocolWriter writer(out);
+    beginRequest(writer, OP_GET_BY_ID, requestId);
+    writer.i32(memberId);
+    writer.endFrame();
+}
+
+void MemberProtocol::requestGetByPhone(std::string& out, uint32_t requestId, std::string_view phone) {
+    ProtocolWriter writer(out);
+    beginRequest(writer, OP_GET_BY_PHONE, requestId);
+    writer.str(phone);
+    writer.endFrame();
+}
+
+void MemberProtocol::requestAddSpending(std::string& out, uint32_t requestId, int memberId, double amount) {
+    ProtocolWriter writer(out);
+    beginRequest(writer, OP_ADD_SPENDING, requestId);
+    writer.i32(memberId).f64(amount);
+    writer.endFrame();
+}
+
+void MemberProtocol::requestRedeemPoints(std::string& out, uint32_t requestId, int memberId, int points) {
+    ProtocolWriter writer(out);
+    beginRequest(writer, OP_REDEEM_POINTS, requestId);
+    writer.i32(memberId).i32(points);
+    writer.endFrame();
+}
+
+void MemberProtocol::requestFindByPhonePrefix(std::string& out, uint32_t requestId, std::string_view prefix,
+                                              uint16_t limit) {
+    ProtocolWriter writer(out);
+    beginRequest(writer, OP_FIND_BY_PHONE_PREFIX, requestId);
+    writer.u16(limit).str(prefix);
+    writer.endFrame();
+}
+
+void MemberProtocol::requestFindByName(std::string& out, uint32_t requestId, std::string_view query, uint16_t limit) {
+    ProtocolWriter writer(out);
+    beginRequest(writer, OP_FIND_BY_NAME, requestId);
+    writer.u16(limit).str(query);
+    writer.endFrame();
+}
+
+void MemberProtocol::requestMemberRank(std::string& out, uint32_t requestId, uint8_t key, int memberId) {
+    ProtocolWriter writer(out);
+    beginRequest(writer, OP_MEMBER_RANK, requestId);
+    writer.u8(key).i32(memberId);
+    writer.endFrame();
+}
+
+void MemberProtocol::requestTopMembers(std::string& out, uint32_t requestId, uint8_t key, uint16_t n) {
+    ProtocolWriter writer(out);
+    beginRequest(writer, OP_TOP_MEMBERS, requestId);
+    writer.u8(key).u16(n);
+    writer.endFrame();
+}
+
+/**
+ * @brief 写出响应头部
+ */
+void MemberProtocol::writeResponseHeader(ProtocolWriter& writer, uint8_t opcode, uint32_t requestId, uint8_t status) {
+    writer.u8(opcode).u32(requestId).u8(status);
+}
+
+/**
+ * @brief 写出会员记录
+ */
+void MemberProtocol::writeMember(ProtocolWriter& writer, const Member& member) {
+    writer.i32(member.getId())
+        .str(member.getName())
+        .str(member.getPhone())
+        .str(member.getBirthday())
+        .f64(member.getTotalSpent())
+        .i32(member.getPoints())
+        .i32(member.getPointsPerDollar())
+        .f64(member.getAnnualSpent())
+        .u8(static_cast<uint8_t>(member.getCurrentLevel()))
+        .i32(member.getLastYear());
+}
+
+/**
+ * @brief 写出会员ID列表
+ */
+void MemberProtocol::writeIds(ProtocolWriter& writer, const std::vector<int>& ids) {
+    writer.u32(static_cast<uint32_t>(ids.size()));
+    for (int id : ids) {
+        writer.i32(id);
+    }
+}
+
+/**
+ * @brief 读取响应头部
+ */
+bool MemberProtocol::readResponseHeader(ProtocolReader& reader, ResponseHeader& header) {
+    header.opcode = reader.u8();
+    header.requestId = reader.u32();
+    header.status = reader.u8();
+    return reader.ok();
+}
+
+/**
+ * @brief 读取会员记录
+ */
+bool MemberProtocol::readMember(ProtocolReader& reader, MemberRecord& record) {
+    record.id = reader.i32();
+    record.name = reader.str();
+    record.phone = reader.str();
+    record.birthday = reader.str();
+    record.totalSpent = reader.f64();
+    record.points = reader.i32();
+    record.pointsPerDollar = reader.i32();
+    record.annualSpent = reader.f64();
+    record.level = reader.u8();
+    record.lastYear = reader.i32();
+    return reader.ok();
+}
+
+/**
+ * @brief 读取会员ID列表
+ */
+bool MemberProtocol::readIds(ProtocolReader& reader, std::vector<int>& ids) {
+    uint32_t count = reader.u32();
+    ids.clear();
+    for (uint32_t i = 0; i < count && reader.ok(); ++i) {
+        ids.push_back(reader.i32());
+    }
+    return reader.ok();
+}
@@ -0,0 +1,870 @@
+/**
+ * @file MemberServer.cpp
+ * @brief Unix 域套接字服务端实现文件
+ * @details 实现监听、epoll 事件循环、按轮批量执行请求、响应的合并写出、背压、共享内存客户端的轮询以及自动保存
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "MemberServer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#ifdef __linux__
+#include <cerrno>
+#include <sys/epoll.h>
+#include <csignal>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const size_t READ_CHUNK = 64 * 1024;          ///< 每次 read 的缓冲大小
+const size_t OUTPUT_LIMIT = 4 * 1024 * 1024;  ///< 积压的响应超过此值时暂停处理该连接的请求
+const int MAX_EVENTS = 256;                   ///< 每轮最多取出的就绪事件
+/// 处理过共享内存请求后继续轮询请求环的时长，连续请求之间不必经过 futex 门铃
+const std::chrono::microseconds SHARED_SPIN(50);
+const std::chrono::seconds REAP_INTERVAL(1);  ///< 检查共享内存客户端进程是否存活的间隔
+
+/// epoll 事件中用于区分监听套接字和 eventfd 的标记（连接使用 Connection 指针）
+char listenTag;
+char wakeTag;
+char doorbellTag;
+
+} // namespace
+
+MemberServer::MemberServer(MemberManager& manager) : manager(manager), readBuffer(READ_CHUNK) {}
+
+MemberServer::~MemberServer() {
+#ifdef __linux__
+    if (doorbellThread.joinable()) {
+        doorbellStop.store(true, std::memory_order_release);
+        region->control().doorbell.fetch_add(1, std::memory_order_release);
+        SharedRing::futexWake(region->control().doorbell);
+        doorbellThread.join();
+    }
+    if (region) {
+        region->close();
+    }
+    if (doorbellFd >= 0) {
+        close(doorbellFd);
+    }
+    for (auto& entry : connections) {
+        close(entry.first);
+    }
+    if (listenFd >= 0) {
+        close(listenFd);
+        unlink(socketPath.c_str());
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+    }
+    if (wakeFd >= 0) {
+        close(wakeFd);
+    }
+#endif
+}
+
+/**
+ * @brief 在指定路径上监听
+ * @param path 套接字路径
+ * @return true 成功
+ */
+bool MemberServer::listen(const std::string& path) {
+#ifdef __linux__
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        lastError = "套接字路径为空或过长";
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    // 上次运行遗留的套接字文件会导致 bind 失败；只删除套接字，不误删普通文件
+    struct stat info;
+    if (lstat(path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) {
+        unlink(path.c_str());
+    }
+
+    if (!openLoop()) {
+        return false;
+    }
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        lastError = std::strerror(errno);
+        return false;
+    }
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(listenFd, SOMAXCONN) < 0) {
+        lastError = std::strerror(errno);
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    socketPath = path;
+
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = &listenTag;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    return true;
+#else
+    (void)path;
+    lastError = "当前平台不支持服务模式";
+    return false;
+#endif
+}
+
+/**
+ * @brief 创建共享内存区，接受同机客户端
+ * @param name shm_open 名称
+ * @return true 成功
+ */
+bool MemberServer::listenSharedMemory(const std::string& name) {
+#ifdef __linux__
+    if (!openLoop()) {
+        return false;
+    }
+    auto created = std::make_unique<SharedMemoryRegion>();
+    if (!created->create(name)) {
+        lastError = created->error();
+        return false;
+    }
+    doorbellFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (doorbellFd < 0) {
+        lastError = std::strerror(errno);
+        return false;
+    }
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = &doorbellTag;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, doorbellFd, &event);
+
+    region = std::move(created);
+    sharedClients.resize(region->slotCount());
+    lastReap = std::chrono::steady_clock::now();
+    doorbellThread = std::thread(&MemberServer::doorbellLoop, this);
+    return true;
+#else
+    (void)name;
+    lastError = "当前平台不支持共享内存传输";
+    return false;
+#endif
+}
+
+/**
+ * @brief 创建 epoll 实例和用于 stop() 的 eventfd（已创建则直接返回）
+ * @return true 成功
+ */
+bool MemberServer::openLoop() {
+#ifdef __linux__
+    if (epollFd >= 0) {
+        return true;
+    }
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0) {
+        lastError = std::strerror(errno);
+        return false;
+    }
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = &wakeTag;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief 设置自动保存
+ * @param filename 数据文件
+ * @param intervalSeconds 保存间隔（秒）
+ */
+void MemberServer::setAutosave(const std::string& filename, int intervalSeconds) {
+    autosaveFile = filename;
+    autosaveSeconds = intervalSeconds;
+    lastSave = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief 请求停止事件循环
+ */
+void MemberServer::stop() {
+#ifdef __linux__
+    if (wakeFd >= 0) {
+        uint64_t one = 1;
+        ssize_t ignored = write(wakeFd, &one, sizeof(one));
+        (void)ignored;
+    }
+#endif
+}
+
+/**
+ * @brief 运行事件循环
+ * @details 每轮：读完所有就绪连接 → 执行本轮收到的全部完整请求（含各共享内存请求环中的请求）
+ *          → 写出各连接的响应 → 关闭需要关闭的连接。
+ *          这样同一轮里多个客户端的请求连续交给 MemberManager，响应也按连接合并成尽量少的写操作。
+ *          启用了复制时一轮的修改记录在写出响应前一次写入复制日志（组提交），客户端收到响应时修改已进入日志；
+ *          写入失败时不发出本轮的响应，关闭全部连接后返回，原因见 error()
+ */
+void MemberServer::run() {
+#ifdef __linux__
+    if (epollFd < 0) {
+        return;
+    }
+    manager.setReplicationBatching(true);
+    epoll_event events[MAX_EVENTS];
+    bool stopping = false;
+    while (!stopping) {
+        int timeout = -1;
+        if (autosaveSeconds > 0 && dirty) {
+            auto due = lastSave + std::chrono::seconds(autosaveSeconds);
+            auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(due - std::chrono::steady_clock::now());
+            timeout = wait.count() > 0 ? static_cast<int>(wait.count()) : 0;
+        }
+        if (region) {
+            if (spinForSharedWork()) {
+                timeout = 0;
+            } else {
+                // 有客户端接入时至少每个回收间隔醒来一次，发现异常退出的客户端
+                if (activeSharedClients > 0) {
+                    int reap = static_cast<int>(std::chrono::milliseconds(REAP_INTERVAL).count());
+                    timeout = timeout < 0 ? reap : std::min(timeout, reap);
+                }
+                // 先登记等待再复查请求环，与客户端的 ringDoorbell 配对，避免漏掉门铃
+                region->control().serverWaiting.store(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (sharedWorkAvailable()) {
+                    timeout = 0;
+                }
+            }
+        }
+        int ready = epoll_wait(epollFd, events, MAX_EVENTS, timeout);
+        if (region) {
+            region->control().serverWaiting.store(0, std::memory_order_relaxed);
+        }
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            lastError = std::strerror(errno);
+            break;
+        }
+
+        pendingConnections.clear();
+        for (int i = 0; i < ready; ++i) {
+            void* tag = events[i].data.ptr;
+            if (tag == &listenTag) {
+                acceptConnections();
+            } else if (tag == &wakeTag) {
+                stopping = true;
+            } else if (tag == &doorbellTag) {
+                uint64_t rings;
+                ssize_t ignored = read(doorbellFd, &rings, sizeof(rings));
+                (void)ignored;
+            } else {
+                Connection& connection = *static_cast<Connection*>(tag);
+                if (events[i].events & EPOLLOUT) {
+                    flushConnection(connection);
+                }
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                    readConnection(connection);
+                }
+                // 背压解除后，之前暂缓的请求也在本轮处理；写出出错或已写完的连接在本轮结束时关闭
+                if (!connection.input.empty() || connection.closing || connection.peerClosed) {
+                    markPending(connection);
+                }
+            }
+        }
+
+        size_t batch = 0;
+        for (Connection* connection : pendingConnections) {
+            batch += processRequests(*connection);
+        }
+        if (region) {
+            batch += processSharedClients();
+        }
+        if (batch > 0) {
+            ++counters.batches;
+            counters.requests += batch;
+            counters.largestBatch = std::max<uint64_t>(counters.largestBatch, batch);
+            if (!commitReplication()) {
+                break;
+            }
+        }
+        for (Connection* connection : pendingConnections) {
+            connection->pending = false;
+            flushConnection(*connection);
+        }
+        for (Connection* connection : pendingConnections) {
+            if (finished(*connection)) {
+                closeConnection(*connection);
+            }
+        }
+        autosave();
+        if (region) {
+            reapSharedClients();
+        }
+    }
+    if (replicationFailed) {
+        // 本轮的响应还在各连接的输出缓冲中，直接关闭连接，客户端收不到确认
+        while (!connections.empty()) {
+            closeConnection(*connections.begin()->second);
+        }
+    }
+    manager.setReplicationBatching(false);
+#endif
+}
+
+/**
+ * @brief 把本轮的修改记录写入复制日志（组提交）
+ * @return true 成功或未启用复制
+ * @details 失败后不再发出任何响应：记录原因，事件循环在本轮结束前退出
+ */
+bool MemberServer::commitReplication() {
+    if (!replicationFailed && !manager.flushReplication()) {
+        replicationFailed = true;
+        lastError = "复制日志写入失败，已停止服务，未确认的修改没有进入日志";
+    }
+    return !replicationFailed;
+}
+
+/**
+ * @brief 接受全部等待中的连接
+ */
+void MemberServer::acceptConnections() {
+#ifdef __linux__
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        connection->events = EPOLLIN;
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = connection.get();
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            close(fd);
+            continue;
+        }
+        connections.emplace(fd, std::move(connection));
+        ++counters.connections;
+    }
+#endif
+}
+
+/**
+ * @brief 读取连接上的全部可读数据
+ * @param connection 连接
+ * @details 对端关闭写方向后，已收到的完整请求照常处理，响应写完再关闭；出错时本轮结束即关闭
+ */
+void MemberServer::readConnection(Connection& connection) {
+#ifdef __linux__
+    while (!connection.closing && !connection.peerClosed) {
+        ssize_t received = read(connection.fd, readBuffer.data(), readBuffer.size());
+        if (received > 0) {
+            connection.input.append(readBuffer.data(), static_cast<size_t>(received));
+        } else if (received == 0) {
+            connection.peerClosed = true;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else if (errno != EINTR) {
+            connection.closing = true;
+        }
+    }
+    markPending(connection);
+#else
+    (void)connection;
+#endif
+}
+
+/**
+ * @brief 把连接加入本轮的待处理列表（已在列表中则忽略）
+ * @param connection 连接
+ */
+void MemberServer::markPending(Connection& connection) {
+    if (!connection.pending) {
+        connection.pending = true;
+        pendingConnections.push_back(&connection);
+    }
+}
+
+/**
+ * @brief 连接是否应当关闭
+ * @param connection 连接
+ * @return true 出错，或对端已关闭且响应已写完、没有可处理的完整请求
+ */
+bool MemberServer::finished(const Connection& connection) const {
+    if (connection.closing) {
+        return true;
+    }
+    if (!connection.peerClosed || !connection.output.empty()) {
+        return false;
+    }
+    uint32_t size = 0;
+    return MemberProtocol::peekFrame(connection.input.data(), connection.input.size(),
+                                     MemberProtocol::MAX_REQUEST_SIZE, size) != MemberProtocol::FRAME_READY;
+}
+
+/**
+ * @brief 执行连接上已收到的完整请求
+ * @param connection 连接
+ * @return 执行的请求数
+ * @details 响应积压超过 OUTPUT_LIMIT 时暂停，剩余请求留在缓冲区等响应写出后再处理
+ */
+size_t MemberServer::processRequests(Connection& connection) {
+    size_t offset = 0;
+    size_t executed = 0;
+    while (connection.output.size() - connection.outputSent < OUTPUT_LIMIT) {
+        uint32_t size = 0;
+        MemberProtocol::FrameState state = MemberProtocol::peekFrame(
+            connection.input.data() + offset, connection.input.size() - offset, MemberProtocol::MAX_REQUEST_SIZE, size);
+        if (state == MemberProtocol::FRAME_INCOMPLETE) {
+            break;
+        }
+        if (state == MemberProtocol::FRAME_TOO_LARGE || size < 5) {
+            // 无法确定下一帧的边界，只能断开
+            connection.closing = true;
+            break;
+        }
+        ProtocolReader request(connection.input.data() + offset + 4, size);
+        uint8_t opcode = request.u8();
+        uint32_t requestId = request.u32();
+        execute(request, opcode, requestId, connection.output);
+        offset += 4 + size;
+        ++executed;
+    }
+    connection.input.erase(0, offset);
+    return executed;
+}
+
+/**
+ * @brief 执行一个请求并追加响应帧
+ * @param request 读取器（位于参数开头）
+ * @param opcode 操作码
+ * @param requestId 请求号
+ * @param out 响应缓冲区
+ * @details 参数必须恰好读完，否则按无法解析处理，不调用 MemberManager
+ */
+void MemberServer::execute(ProtocolReader& request, uint8_t opcode, uint32_t requestId, std::string& out) {
+    ProtocolWriter writer(out);
+    writer.beginFrame();
+    switch (opcode) {
+    case MemberProtocol::OP_PING: {
+        if (!request.atEnd()) {
+            break;
+        }
+        MemberProtocol::writeResponseHeader(writer, opcode, requestId, MemberManager::STATUS_OK);
+        writer.endFrame();
+        return;
+    }
+    case MemberProtocol::OP_GET_BY_ID:
+    case MemberProtocol::OP_GET_BY_PHONE: {
+        int id = 0;
+        std::string phone;
+        if (opcode == MemberProtocol::OP_GET_BY_ID) {
+            id = request.i32();
+        } else {
+            phone = request.str();
+        }
+        if (!request.atEnd()) {
+            break;
+        }
+        const Member* member =
+            opcode == MemberProtocol::OP_GET_BY_ID ? manager.getMemberById(id) : manager.getMemberByPhone(phone);
+        MemberProtocol::writeResponseHeader(writer, opcode, requestId,
+                                            member ? MemberManager::STATUS_OK : MemberManager::STATUS_NOT_FOUND);
+        if (member) {
+            MemberProtocol::writeMember(writer, *member);
+        }
+        writer.endFrame();
+        return;
+    }
+    case MemberProtocol::OP_ADD_SPENDING: {
+        int id = request.i32();
+        double amount = request.f64();
+        if (!request.atEnd()) {
+            break;
+        }
+        MemberManager::SpendingResult result;
+        if (std::isfinite(amount)) {
+            result = manager.addSpending(id, amount);
+        } else {
+            result.status = MemberManager::STATUS_INVALID_ARGUMENT;
+        }
+        MemberProtocol::writeResponseHeader(writer, opcode, requestId, static_cast<uint8_t>(result.status));
+        if (result.status == MemberManager::STATUS_OK) {
+            dirty = true;
+            writer.f64(result.receipt.actualAmount)
+                .f64(result.receipt.discountRate)
+                .i32(result.receipt.earnedPoints)
+                .i32(result.receipt.totalPoints)
+                .u8(static_cast<uint8_t>(result.receipt.level));
+        }
+        writer.endFrame();
+        return;
+    }
+    case MemberProtocol::OP_REDEEM_POINTS: {
+        int id = request.i32();
+        int points = request.i32();
+        if (!request.atEnd()) {
+            break;
+        }
+        MemberManager::RedeemResult result = manager.redeemPoints(id, points);
+        MemberProtocol::writeResponseHeader(writer, opcode, requestId, static_cast<uint8_t>(result.status));
+        if (result.status == MemberManager::STATUS_OK) {
+            dirty = true;
+            writer.i32(result.redeemed).i32(result.remaining);
+        }
+        writer.endFrame();
+        return;
+    }
+    case MemberProtocol::OP_FIND_BY_PHONE_PREFIX:
+    case MemberProtocol::OP_FIND_BY_NAME: {
+        uint16_t limit = MemberProtocol::resultLimit(request.u16());
+        std::string query(request.str());
+        if (!request.atEnd()) {
+            break;
+        }
+        if (opcode == MemberProtocol::OP_FIND_BY_PHONE_PREFIX) {
+            manager.findMembersByPhonePrefix(query, limit, ids);
+        } else {
+            manager.findMembersByName(query, limit, ids);
+        }
+        MemberProtocol::writeResponseHeader(writer, opcode, requestId, MemberManager::STATUS_OK);
+        MemberProtocol::writeIds(writer, ids);
+        writer.endFrame();
+        return;
+    }
+    case MemberProtocol::OP_MEMBER_RANK: {
+        uint8_t key = request.u8();
+        int id = request.i32();
+        if (!request.atEnd() || key >= MemberManager::RANK_KEY_COUNT) {
+            break;
+        }
+        int rank = manager.getMemberRank(static_cast<MemberManager::RankKey>(key), id);
+        MemberProtocol::writeResponseHeader(writer, opcode, requestId,
+                                            rank > 0 ? MemberManager::STATUS_OK : MemberManager::STATUS_NOT_FOUND);
+        if (rank > 0) {
+            writer.i32(rank);
+        }
+        writer.endFrame();
+        return;
+    }
+    case MemberProtocol::OP_TOP_MEMBERS: {
+        uint8_t key = request.u8();
+        uint16_t n = MemberProtocol::resultLimit(request.u16());
+        if (!request.atEnd() || key >= MemberManager::RANK_KEY_COUNT) {
+            break;
+        }
+        ids = manager.getTopMembers(static_cast<MemberManager::RankKey>(key), n);
+        MemberProtocol::writeResponseHeader(writer, opcode, requestId, MemberManager::STATUS_OK);
+        MemberProtocol::writeIds(writer, ids);
+        writer.endFrame();
+        return;
+    }
+    default:
+        break;
+    }
+    // 未知操作码或参数无法解析
+    MemberProtocol::writeResponseHeader(writer, opcode, requestId, MemberProtocol::STATUS_BAD_REQUEST);
+    writer.endFrame();
+}
+
+/**
+ * @brief 尽量写出连接积压的响应
+ * @param connection 连接
+ * @details 写不完时登记 EPOLLOUT，写完后注销；积压超过上限时同时暂停读取
+ */
+void MemberServer::flushConnection(Connection& connection) {
+#ifdef __linux__
+    while (connection.outputSent < connection.output.size()) {
+        ssize_t sent = send(connection.fd, connection.output.data() + connection.outputSent,
+                            connection.output.size() - connection.outputSent, MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection.outputSent += static_cast<size_t>(sent);
+        } else if (sent < 0 && errno == EINTR) {
+            continue;
+        } else {
+            if (sent < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                connection.closing = true;
+            }
+            break;
+        }
+    }
+    if (connection.outputSent == connection.output.size()) {
+        connection.output.clear();
+        connection.outputSent = 0;
+    }
+    updateEvents(connection);
+#else
+    (void)connection;
+#endif
+}
+
+/**
+ * @brief 按积压情况调整连接登记的事件
+ * @param connection 连接
+ */
+void MemberServer::updateEvents(Connection& connection) {
+#ifdef __linux__
+    size_t backlog = connection.output.size() - connection.outputSent;
+    uint32_t wanted = (backlog > 0 ? uint32_t(EPOLLOUT) : 0) |
+                      (backlog < OUTPUT_LIMIT && !connection.peerClosed ? uint32_t(EPOLLIN) : 0);
+    if (wanted != connection.events && !connection.closing) {
+        epoll_event event;
+        event.events = wanted;
+        event.data.ptr = &connection;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.events = wanted;
+    }
+#else
+    (void)connection;
+#endif
+}
+
+/**
+ * @brief 关闭连接并释放
+ * @param connection 连接
+ */
+void MemberServer::closeConnection(Connection& connection) {
+#ifdef __linux__
+    int fd = connection.fd;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections.erase(fd);
+#else
+    (void)connection;
+#endif
+}
+
+/**
+ * @brief 到达保存间隔且有修改时保存数据文件
+ * @details 保存失败时保留修改标记，下个间隔重试
+ */
+void MemberServer::autosave() {
+    if (autosaveSeconds <= 0 || !dirty || autosaveFile.empty()) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastSave < std::chrono::seconds(autosaveSeconds)) {
+        return;
+    }
+    lastSave = now;
+    if (manager.saveToFile(autosaveFile) == MemberManager::STATUS_OK) {
+        dirty = false;
+        ++counters.saves;
+    }
+}
+
+// ==================== 共享内存客户端 ====================
+
+/**
+ * @brief 处理各共享内存槽位：接入新客户端、执行请求、回收已退出的客户端
+ * @return 执行的请求数
+ */
+size_t MemberServer::processSharedClients() {
+    size_t executed = 0;
+    for (uint32_t i = 0; i < sharedClients.size(); ++i) {
+        SharedClient& client = sharedClients[i];
+        uint32_t state = region->slot(i).state.load(std::memory_order_acquire);
+        if (state == SharedMemoryRegion::SLOT_CLOSING) {
+            releaseSharedClient(i);
+            continue;
+        }
+        if (state != SharedMemoryRegion::SLOT_ACTIVE) {
+            continue;
+        }
+        if (!client.active) {
+            // 客户端认领时已清空两个环，这里重新绑定视图，丢弃上一个客户端留下的读取状态
+            client.requests = region->requestRing(i);
+            client.responses = region->responseRing(i);
+            client.active = true;
+            ++activeSharedClients;
+            ++counters.sharedClients;
+        }
+        executed += processSharedClient(i);
+    }
+    if (executed > 0) {
+        lastSharedActivity = std::chrono::steady_clock::now();
+    }
+    return executed;
+}
+
+/**
+ * @brief 执行一个共享内存客户端的请求
+ * @param index 槽位
+ * @return 执行的请求数
+ * @details 请求直接在请求环内解析；每个响应写完立即放入响应环，响应环满时暂停，
+ *          剩余请求留在环中，客户端读出响应后按门铃继续
+ */
+size_t MemberServer::processSharedClient(uint32_t index) {
+    SharedClient& client = sharedClients[index];
+    size_t executed = 0;
+    while (!client.broken && flushSharedClient(index)) {
+        uint32_t size = 0;
+        const char* payload = client.requests.front(size);
+        if (!payload) {
+            client.broken = client.requests.corrupt();
+            break;
+        }
+        if (size < 5) {
+            client.broken = true;
+            break;
+        }
+        ProtocolReader request(payload, size);
+        uint8_t opcode = request.u8();
+        uint32_t requestId = request.u32();
+        execute(request, opcode, requestId, client.output);
+        client.requests.pop();
+        ++executed;
+    }
+    if (executed > 0) {
+        client.responses.wakeConsumer();
+    }
+    return executed;
+}
+
+/**
+ * @brief 把暂存的响应帧写入响应环
+ * @param index 槽位
+ * @return true 已全部写入
+ * @details 写不下时先标记响应环已满再重试一次，与客户端 release 中“先读出、再检查标记”配对，
+ *          保证客户端读出响应后一定会按门铃
+ */
+bool MemberServer::flushSharedClient(uint32_t index) {
+    SharedClient& client = sharedClients[index];
+    if (client.output.empty()) {
+        return !replicationFailed;
+    }
+    // 响应一放入环客户端就能读到，修改记录必须先写入复制日志（没有缓冲的记录时不做任何事）
+    if (!commitReplication()) {
+        return false;
+    }
+    if (!client.responses.push(client.output)) {
+        std::atomic<uint32_t>& full = region->slot(index).responsesFull;
+        full.store(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!client.responses.push(client.output)) {
+            return false;
+        }
+    }
+    client.output.clear();
+    return true;
+}
+
+/**
+ * @brief 是否有共享内存客户端需要处理
+ * @return true 有请求、有客户端退出，或暂停的响应可以继续写入
+ */
+bool MemberServer::sharedWorkAvailable() const {
+    for (uint32_t i = 0; i < sharedClients.size(); ++i) {
+        const SharedClient& client = sharedClients[i];
+        const SharedMemoryRegion::Slot& slot = region->slot(i);
+        uint32_t state = slot.state.load(std::memory_order_acquire);
+        if (state == SharedMemoryRegion::SLOT_CLOSING) {
+            return true;
+        }
+        if (state != SharedMemoryRegion::SLOT_ACTIVE || client.broken) {
+            continue;
+        }
+        if (!client.active) {
+            return true;
+        }
+        if (client.output.empty() ? !client.requests.empty() : !slot.responsesFull.load(std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 刚处理过共享内存请求时，在 SHARED_SPIN 内轮询请求环
+ * @return true 轮询期间有新工作
+ * @details 只读共享内存和时钟（vDSO），不进入内核；空闲的服务端和单 CPU 机器上不自旋
+ */
+bool MemberServer::spinForSharedWork() const {
+    if (!SharedRing::spinUseful()) {
+        return false;
+    }
+    auto until = lastSharedActivity + SHARED_SPIN;
+    while (std::chrono::steady_clock::now() < until) {
+        if (sharedWorkAvailable()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 回收进程已退出但没有正常关闭的客户端槽位
+ */
+void MemberServer::reapSharedClients() {
+#ifdef __linux__
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastReap < REAP_INTERVAL) {
+        return;
+    }
+    lastReap = now;
+    for (uint32_t i = 0; i < sharedClients.size(); ++i) {
+        SharedMemoryRegion::Slot& slot = region->slot(i);
+        uint32_t state = slot.state.load(std::memory_order_acquire);
+        if (state != SharedMemoryRegion::SLOT_ACTIVE && state != SharedMemoryRegion::SLOT_CLAIMING) {
+            continue;
+        }
+        pid_t owner = slot.ownerPid.load(std::memory_order_relaxed);
+        if (owner > 0 && kill(owner, 0) < 0 && errno == ESRCH) {
+            releaseSharedClient(i);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief 丢弃槽位上未送达的响应，把槽位标记为空闲
+ * @param index 槽位
+ */
+void MemberServer::releaseSharedClient(uint32_t index) {
+    SharedClient& client = sharedClients[index];
+    if (client.active) {
+        --activeSharedClients;
+    }
+    client.output.clear();
+    client.active = false;
+    client.broken = false;
+    SharedMemoryRegion::Slot& slot = region->slot(index);
+    slot.ownerPid.store(0, std::memory_order_relaxed);
+    slot.responsesFull.store(0, std::memory_order_relaxed);
+    slot.state.store(SharedMemoryRegion::SLOT_FREE, std::memory_order_release);
+}
+
+/**
+ * @brief 门铃线程：在 futex 门铃上等待，被客户端按响后写 eventfd 唤醒事件循环
+ * @details 门铃值变化即视为按响，唤醒与等待之间的竞争由 futex 的值比较消除；本线程不访问 MemberManager
+ */
+void MemberServer::doorbellLoop() {
+#ifdef __linux__
+    std::atomic<uint32_t>& doorbell = region->control().doorbell;
+    uint32_t seen = doorbell.load(std::memory_order_acquire);
+    while (!doorbellStop.load(std::memory_order_acquire)) {
+        SharedRing::futexWait(doorbell, seen, -1);
+        uint32_t now = doorbell.load(std::memory_order_acquire);
+        if (now != seen) {
+            seen = now;
+            uint64_t one = 1;
+            ssize_t ignored = write(doorbellFd, &one, sizeof(one));
+            (void)ignored;
+        }
+    }
+#endif
+}
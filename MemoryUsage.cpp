@@ -0,0 +1,31 @@
+/**
+ * @file MemoryUsage.cpp
+ * @brief 内存占用统计实现文件
+ * @details 实现进程堆状态的读取（glibc 平台使用 mallinfo2）
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "MemoryUsage.h"
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define MEMBER_HAVE_MALLINFO2 1
+#endif
+
+/**
+ * @brief 读取当前进程的堆状态
+ * @return 堆状态
+ */
+HeapStats HeapStats::read() {
+    HeapStats stats;
+#ifdef MEMBER_HAVE_MALLINFO2
+    struct mallinfo2 info = mallinfo2();
+    stats.available = true;
+    stats.heapBytes = info.arena;
+    stats.mmapBytes = info.hblkhd;
+    stats.inUseBytes = info.uordblks + info.hblkhd;
+    stats.freeBytes = info.fordblks;
+#endif
+    return stats;
+}
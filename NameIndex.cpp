@@ -0,0 +1,454 @@
+/**
+ * @file NameIndex.cpp
+ * @brief 会员姓名倒排索引实现文件
+ * @details 实现按本机编码拆字、词项抽取、差值变长编码的倒排列表维护、
+ *          候选求交以及加载时的分片并行构建
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "NameIndex.h"
+#include "Parallel.h"
+#include "TextEncoding.h"
+#include <algorithm>
+
+// ==================== 拆字与词项 ====================
+
+/**
+ * @brief 把文本按本机编码拆分为字
+ * @param text 文本
+ * @param out 输出：每个字的原始字节（至多4字节）打包成的整数
+ * @details UTF-8 按首字节判断字长，GBK 首字节 0x81-0xFE 为双字节字
+ */
+void NameIndex::splitCharacters(std::string_view text, std::vector<uint32_t>& out) {
+    out.clear();
+    bool gbk = TextEncoding::nativeEncoding() == TextEncoding::ENCODING_GBK;
+    size_t i = 0;
+    while (i < text.size()) {
+        unsigned char lead = static_cast<unsigned char>(text[i]);
+        size_t length = 1;
+        if (gbk) {
+            length = (lead >= 0x81 && lead <= 0xFE) ? 2 : 1;
+        } else if (lead >= 0xF0) {
+            length = 4;
+        } else if (lead >= 0xE0) {
+            length = 3;
+        } else if (lead >= 0xC0) {
+            length = 2;
+        }
+        length = std::min(length, text.size() - i);
+        uint32_t character = 0;
+        for (size_t k = 0; k < length; ++k) {
+            character = (character << 8) | static_cast<unsigned char>(text[i + k]);
+        }
+        out.push_back(character);
+        i += length;
+    }
+}
+
+/**
+ * @brief 抽取姓名的全部词项（去重）
+ * @param name 姓名
+ * @param characters 临时缓冲：拆分出的字
+ * @param terms 输出：单字词项为字本身，双字词项为 (前一字 << 32) | 后一字
+ */
+void NameIndex::collectTerms(std::string_view name, std::vector<uint32_t>& characters, std::vector<uint64_t>& terms) {
+    splitCharacters(name, characters);
+    terms.clear();
+    for (size_t i = 0; i < characters.size(); ++i) {
+        terms.push_back(characters[i]);
+        if (i + 1 < characters.size()) {
+            terms.push_back((static_cast<uint64_t>(characters[i]) << 32) | characters[i + 1]);
+        }
+    }
+    std::sort(terms.begin(), terms.end());
+    terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+}
+
+/**
+ * @brief 判断姓名是否包含查询串（按字比较）
+ * @param name 姓名
+ * @param query 查询串
+ * @return true 包含
+ * @details 按字比较可避免 GBK 下跨字节边界的误匹配
+ */
+bool NameIndex::contains(std::string_view name, std::string_view query) {
+    std::vector<uint32_t> nameCharacters, queryCharacters;
+    splitCharacters(name, nameCharacters);
+    splitCharacters(query, queryCharacters);
+    return std::search(nameCharacters.begin(), nameCharacters.end(),
+                       queryCharacters.begin(), queryCharacters.end()) != nameCharacters.end();
+}
+
+// ==================== 倒排列表编码 ====================
+
+/**
+ * @brief 在列表末尾追加一个更大的会员ID
+ * @param posting 倒排列表
+ * @param id 会员ID（须大于 lastId）
+ */
+void NameIndex::append(Posting& posting, int id) {
+    uint32_t delta = static_cast<uint32_t>(id - posting.lastId);
+    while (delta >= 0x80) {
+        posting.bytes.push_back(static_cast<uint8_t>(delta | 0x80));
+        delta >>= 7;
+    }
+    posting.bytes.push_back(static_cast<uint8_t>(delta));
+    posting.lastId = id;
+    posting.count += 1;
+}
+
+/**
+ * @brief 用升序会员ID重新编码整个列表
+ * @param posting 倒排列表
+ * @param ids 升序会员ID
+ */
+void NameIndex::encode(Posting& posting, const std::vector<int>& ids) {
+    posting.bytes.clear();
+    posting.count = 0;
+    posting.lastId = 0;
+    for (int id : ids) {
+        append(posting, id);
+    }
+    posting.bytes.shrink_to_fit();
+}
+
+/**
+ * @brief 解码倒排列表
+ * @param posting 倒排列表
+ * @param out 输出：升序会员ID
+ */
+void NameIndex::decode(const Posting& posting, std::vector<int>& out) {
+    out.clear();
+    out.reserve(posting.count);
+    int id = 0;
+    const uint8_t* p = posting.bytes.data();
+    const uint8_t* end = p + posting.bytes.size();
+    while (p < end) {
+        uint32_t delta = 0;
+        int shift = 0;
+        while (*p & 0x80) {
+            delta |= static_cast<uint32_t>(*p++ & 0x7F) << shift;
+            shift += 7;
+        }
+        delta |= static_cast<uint32_t>(*p++) << shift;
+        id += static_cast<int>(delta);
+        out.push_back(id);
+    }
+}
+
+/**
+ * @brief 写入一个变长整数
+ * @param value 数值
+ * @param out 输出缓冲（至少5字节）
+ * @return 写入的字节数
+ */
+size_t NameIndex::putVarint(uint32_t value, uint8_t* out) {
+    size_t length = 0;
+    while (value >= 0x80) {
+        out[length++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    out[length++] = static_cast<uint8_t>(value);
+    return length;
+}
+
+namespace {
+
+/**
+ * @brief 读取一个变长整数
+ * @param p 读取位置，读取后前移
+ * @return 数值
+ */
+uint32_t readVarint(const uint8_t*& p) {
+    uint32_t value = 0;
+    int shift = 0;
+    while (*p & 0x80) {
+        value |= static_cast<uint32_t>(*p++ & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= static_cast<uint32_t>(*p++) << shift;
+    return value;
+}
+
+} // namespace
+
+/**
+ * @brief 把会员ID插入列表中间
+ * @param posting 倒排列表
+ * @param id 会员ID（不大于 lastId）
+ * @return true 已插入，false 已存在
+ * @details 扫描到第一个不小于 id 的元素，把它的差值拆成两段差值后原地替换，
+ *          只移动其后的字节，不需要解码整个列表
+ */
+bool NameIndex::insertId(Posting& posting, int id) {
+    const uint8_t* begin = posting.bytes.data();
+    const uint8_t* p = begin;
+    int previous = 0;
+    for (;;) {
+        const uint8_t* start = p;
+        int current = previous + static_cast<int>(readVarint(p));
+        if (current == id) {
+            return false;
+        }
+        if (current > id) {
+            uint8_t buffer[10];
+            size_t length = putVarint(static_cast<uint32_t>(id - previous), buffer);
+            length += putVarint(static_cast<uint32_t>(current - id), buffer + length);
+            size_t offset = static_cast<size_t>(start - begin);
+            size_t oldLength = static_cast<size_t>(p - start);
+            posting.bytes.insert(posting.bytes.begin() + static_cast<std::ptrdiff_t>(offset + oldLength),
+                                 length - oldLength, 0);
+            std::copy(buffer, buffer + length, posting.bytes.begin() + static_cast<std::ptrdiff_t>(offset));
+            posting.count += 1;
+            return true;
+        }
+        previous = current;
+    }
+}
+
+/**
+ * @brief 从列表中移除会员ID
+ * @param posting 倒排列表
+ * @param id 会员ID
+ * @return true 已移除，false 不存在
+ * @details 把被删元素与下一个元素的差值合并为一段后原地替换
+ */
+bool NameIndex::eraseId(Posting& posting, int id) {
+    if (id > posting.lastId) {
+        return false;
+    }
+    const uint8_t* begin = posting.bytes.data();
+    const uint8_t* end = begin + posting.bytes.size();
+    const uint8_t* p = begin;
+    int previous = 0;
+    while (p < end) {
+        const uint8_t* start = p;
+        int current = previous + static_cast<int>(readVarint(p));
+        if (current > id) {
+            return false;
+        }
+        if (current < id) {
+            previous = current;
+            continue;
+        }
+        size_t offset = static_cast<size_t>(start - begin);
+        if (p == end) {
+            posting.bytes.resize(offset);
+            posting.lastId = previous;
+        } else {
+            const uint8_t* next = p;
+            int following = current + static_cast<int>(readVarint(next));
+            uint8_t buffer[5];
+            size_t length = putVarint(static_cast<uint32_t>(following - previous), buffer);
+            size_t oldLength = static_cast<size_t>(next - start);
+            std::copy(buffer, buffer + length, posting.bytes.begin() + static_cast<std::ptrdiff_t>(offset));
+            posting.bytes.erase(posting.bytes.begin() + static_cast<std::ptrdiff_t>(offset + length),
+                                posting.bytes.begin() + static_cast<std::ptrdiff_t>(offset + oldLength));
+        }
+        posting.count -= 1;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 查找词项的倒排列表
+ * @param term 词项
+ * @return 倒排列表指针，不存在时返回nullptr
+ */
+const NameIndex::Posting* NameIndex::find(uint64_t term) const {
+    const Shard& shard = shards[shardOf(term)];
+    auto it = shard.find(term);
+    return it == shard.end() ? nullptr : &it->second;
+}
+
+// ==================== 索引维护 ====================
+
+/**
+ * @brief 从会员列表和另外一组姓名整体构建索引
+ * @param members 会员列表
+ * @param extra 不在会员列表中的（姓名, 会员ID）
+ * @param threads 工作线程数，0 表示使用硬件并发数
+ * @details 第一阶段各线程处理一段会员（extra 接在会员列表之后），把 (词项, ID) 按分片放入线程私有的桶；
+ *          第二阶段各线程负责一部分分片，合并所有线程的桶、排序后编码。两个阶段都无需加锁
+ */
+void NameIndex::build(const std::vector<Member>& members, const std::vector<std::pair<std::string, int>>& extra,
+                      unsigned threads) {
+    clear();
+    if (threads == 0) {
+        threads = defaultThreadCount();
+    }
+    using Entry = std::pair<uint64_t, int>;
+    std::vector<std::vector<std::vector<Entry>>> buckets(threads, std::vector<std::vector<Entry>>(SHARD_COUNT));
+
+    parallelFor(members.size() + extra.size(), threads, [&](unsigned t, size_t begin, size_t end) {
+        std::vector<uint32_t> characters;
+        std::vector<uint64_t> terms;
+        for (size_t i = begin; i < end; ++i) {
+            bool member = i < members.size();
+            collectTerms(member ? std::string_view(members[i].getName()) : extra[i - members.size()].first,
+                         characters, terms);
+            int id = member ? members[i].getId() : extra[i - members.size()].second;
+            for (uint64_t term : terms) {
+                buckets[t][shardOf(term)].emplace_back(term, id);
+            }
+        }
+    });
+
+    parallelFor(SHARD_COUNT, threads, [&](unsigned, size_t begin, size_t end) {
+        std::unordered_map<uint64_t, std::vector<int>> lists;
+        for (size_t s = begin; s < end; ++s) {
+            // 各线程的桶按线程顺序合并，会员列表按ID递增时每个词项的ID自然有序
+            lists.clear();
+            for (auto& local : buckets) {
+                for (const Entry& entry : local[s]) {
+                    lists[entry.first].push_back(entry.second);
+                }
+                std::vector<Entry>().swap(local[s]);
+            }
+            Shard& shard = shards[s];
+            for (auto& list : lists) {
+                if (!std::is_sorted(list.second.begin(), list.second.end())) {
+                    std::sort(list.second.begin(), list.second.end());
+                }
+                encode(shard[list.first], list.second);
+            }
+        }
+    }, 2);
+}
+
+/**
+ * @brief 加入一个会员姓名
+ * @param name 姓名
+ * @param id 会员ID
+ * @details ID 大于列表末尾时直接追加，否则在字节流中原地拼接
+ */
+void NameIndex::insert(std::string_view name, int id) {
+    std::vector<uint32_t> characters;
+    std::vector<uint64_t> terms;
+    collectTerms(name, characters, terms);
+    for (uint64_t term : terms) {
+        Posting& posting = shards[shardOf(term)][term];
+        if (id > posting.lastId) {
+            append(posting, id);
+            continue;
+        }
+        insertId(posting, id);
+    }
+}
+
+/**
+ * @brief 移除一个会员姓名
+ * @param name 加入时使用的姓名
+ * @param id 会员ID
+ * @details 列表变空时删除该词项
+ */
+void NameIndex::erase(std::string_view name, int id) {
+    std::vector<uint32_t> characters;
+    std::vector<uint64_t> terms;
+    collectTerms(name, characters, terms);
+    for (uint64_t term : terms) {
+        Shard& shard = shards[shardOf(term)];
+        auto it = shard.find(term);
+        if (it == shard.end()) {
+            continue;
+        }
+        if (eraseId(it->second, id) && it->second.count == 0) {
+            shard.erase(it);
+        }
+    }
+}
+
+/**
+ * @brief 查询候选会员
+ * @param query 查询串
+ * @param out 输出：候选会员ID（升序）
+ * @details 从最短的列表开始依次求交，中途为空即结束
+ */
+void NameIndex::candidates(std::string_view query, std::vector<int>& out) const {
+    out.clear();
+    std::vector<uint32_t> characters;
+    splitCharacters(query, characters);
+    if (characters.empty()) {
+        return;
+    }
+
+    std::vector<const Posting*> postings;
+    if (characters.size() == 1) {
+        postings.push_back(find(characters[0]));
+    } else {
+        for (size_t i = 0; i + 1 < characters.size(); ++i) {
+            postings.push_back(find((static_cast<uint64_t>(characters[i]) << 32) | characters[i + 1]));
+        }
+    }
+    for (const Posting* posting : postings) {
+        if (!posting) {
+            return;
+        }
+    }
+    std::sort(postings.begin(), postings.end(),
+              [](const Posting* a, const Posting* b) { return a->count < b->count; });
+    postings.erase(std::unique(postings.begin(), postings.end()), postings.end());
+
+    decode(*postings[0], out);
+    std::vector<int> other, merged;
+    for (size_t i = 1; i < postings.size() && !out.empty(); ++i) {
+        decode(*postings[i], other);
+        merged.clear();
+        std::set_intersection(out.begin(), out.end(), other.begin(), other.end(), std::back_inserter(merged));
+        out.swap(merged);
+    }
+}
+
+/**
+ * @brief 获取词项数量
+ * @return 词项数量
+ */
+size_t NameIndex::termCount() const {
+    size_t count = 0;
+    for (const Shard& shard : shards) {
+        count += shard.size();
+    }
+    return count;
+}
+
+/**
+ * @brief 获取压缩后的倒排列表总字节数
+ * @return 字节数
+ */
+size_t NameIndex::postingBytes() const {
+    size_t bytes = 0;
+    for (const Shard& shard : shards) {
+        for (const auto& entry : shard) {
+            bytes += entry.second.bytes.size();
+        }
+    }
+    return bytes;
+}
+
+/**
+ * @brief 统计索引占用的内存
+ * @return 内存占用
+ */
+MemoryUsage NameIndex::memoryUsage() const {
+    MemoryUsage usage;
+    for (const Shard& shard : shards) {
+        usage.addUnorderedMap(shard);
+        for (const auto& entry : shard) {
+            usage.addVector(entry.second.bytes);
+        }
+    }
+    usage.objects = termCount();
+    return usage;
+}
+
+/**
+ * @brief 清空索引
+ */
+void NameIndex::clear() {
+    for (Shard& shard : shards) {
+        shard.clear();
+    }
+}
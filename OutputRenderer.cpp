@@ -0,0 +1,334 @@
+/**
+ * @file OutputRenderer.cpp
+ * @brief 带缓冲的流式输出渲染器实现文件
+ * @details 实现缓冲区管理、数值格式化以及会员信息、消费历史的表格/CSV/JSON Lines 渲染
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "OutputRenderer.h"
+#include <algorithm>
+#include <charconv>
+
+namespace {
+
+const char* const CARD_TOP = "┌─────────────────────────────────────────────────────────────────┐";
+const char* const CARD_BOTTOM = "└─────────────────────────────────────────────────────────────────┘";
+
+}  // namespace
+
+/**
+ * @brief 构造函数
+ * @param out 输出流
+ * @param format 输出格式
+ * @param bufferSize 缓冲区大小
+ */
+OutputRenderer::OutputRenderer(std::ostream& out, Format format, size_t bufferSize)
+    : out(out), format(format), bufferSize(bufferSize) {
+    buffer.reserve(bufferSize + 1024);
+}
+
+/**
+ * @brief 析构函数，写出剩余内容
+ */
+OutputRenderer::~OutputRenderer() {
+    flush();
+}
+
+// ==================== 基础写入 ====================
+
+/**
+ * @brief 追加文本
+ * @param text 文本内容
+ * @return 渲染器自身
+ */
+OutputRenderer& OutputRenderer::text(std::string_view text) {
+    buffer.append(text);
+    return *this;
+}
+
+/**
+ * @brief 追加整数
+ * @param value 整数值
+ * @return 渲染器自身
+ */
+OutputRenderer& OutputRenderer::number(long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+    return *this;
+}
+
+/**
+ * @brief 追加定点小数
+ * @param value 数值
+ * @param precision 小数位数
+ * @return 渲染器自身
+ */
+OutputRenderer& OutputRenderer::number(double value, int precision) {
+    char digits[64];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, precision);
+    buffer.append(digits, result.ptr);
+    return *this;
+}
+
+/**
+ * @brief 把自某位置起追加的内容左对齐补齐到指定字节宽度
+ * @param start 起始位置
+ * @param width 字节宽度
+ * @return 渲染器自身
+ */
+OutputRenderer& OutputRenderer::padFrom(size_t start, size_t width) {
+    size_t written = buffer.size() - start;
+    if (written < width) {
+        buffer.append(width - written, ' ');
+    }
+    return *this;
+}
+
+/**
+ * @brief 获取当前缓冲区写入位置
+ * @return 写入位置
+ */
+size_t OutputRenderer::mark() const {
+    return buffer.size();
+}
+
+/**
+ * @brief 结束一行
+ * @return 渲染器自身
+ */
+OutputRenderer& OutputRenderer::endLine() {
+    buffer.push_back('\n');
+    maybeFlush();
+    return *this;
+}
+
+/**
+ * @brief 写出缓冲区内容并刷新输出流
+ */
+void OutputRenderer::flush() {
+    if (!buffer.empty()) {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+    out.flush();
+}
+
+/**
+ * @brief 缓冲区超过阈值时整块写出（不刷新底层流）
+ */
+void OutputRenderer::maybeFlush() {
+    if (buffer.size() >= bufferSize) {
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+    }
+}
+
+/**
+ * @brief 追加 JSON 字符串（含引号与转义）
+ * @param value 字符串内容
+ */
+void OutputRenderer::jsonString(std::string_view value) {
+    static const char HEX[] = "0123456789abcdef";
+    buffer.push_back('"');
+    for (char c : value) {
+        unsigned char u = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            buffer.push_back('\\');
+            buffer.push_back(c);
+        } else if (u < 0x20) {
+            buffer.append("\\u00");
+            buffer.push_back(HEX[u >> 4]);
+            buffer.push_back(HEX[u & 0xF]);
+        } else {
+            buffer.push_back(c);
+        }
+    }
+    buffer.push_back('"');
+}
+
+// ==================== 会员渲染 ====================
+
+/**
+ * @brief 获取等级名称
+ * @param level 会员等级
+ * @return 等级中文名称
+ */
+const char* OutputRenderer::levelName(Member::Level level) {
+    switch (level) {
+    case Member::DIAMOND: return "钻石会员";
+    case Member::GOLD: return "黄金会员";
+    case Member::SILVER: return "白银会员";
+    default: return "普通会员";
+    }
+}
+
+/**
+ * @brief 输出表头（仅 CSV 格式有表头）
+ */
+void OutputRenderer::memberHeader() {
+    if (format == FORMAT_CSV) {
+        text("id,name,phone,birthday,level,discountRate,totalSpent,annualSpent,points,pointsPerDollar,lastYear").endLine();
+    }
+}
+
+/**
+ * @brief 输出一个会员的完整信息
+ * @param m 会员对象
+ */
+void OutputRenderer::member(const Member& m) {
+    double discountRate = m.getDiscountRate();
+
+    if (format == FORMAT_CSV) {
+        number(static_cast<long long>(m.getId())).text(",")
+            .text(m.getName()).text(",")
+            .text(m.getPhone()).text(",")
+            .text(m.getBirthday()).text(",")
+            .number(static_cast<long long>(m.getCurrentLevel())).text(",")
+            .number(discountRate, 2).text(",")
+            .number(m.getTotalSpent(), 2).text(",")
+            .number(m.getAnnualSpent(), 2).text(",")
+            .number(static_cast<long long>(m.getPoints())).text(",")
+            .number(static_cast<long long>(m.getPointsPerDollar())).text(",")
+            .number(static_cast<long long>(m.getLastYear())).endLine();
+        return;
+    }
+
+    if (format == FORMAT_JSONL) {
+        text("{\"id\":").number(static_cast<long long>(m.getId()));
+        text(",\"name\":"); jsonString(m.getName());
+        text(",\"phone\":"); jsonString(m.getPhone());
+        text(",\"birthday\":"); jsonString(m.getBirthday());
+        text(",\"level\":").number(static_cast<long long>(m.getCurrentLevel()));
+        text(",\"discountRate\":").number(discountRate, 2);
+        text(",\"totalSpent\":").number(m.getTotalSpent(), 2);
+        text(",\"annualSpent\":").number(m.getAnnualSpent(), 2);
+        text(",\"points\":").number(static_cast<long long>(m.getPoints()));
+        text(",\"pointsPerDollar\":").number(static_cast<long long>(m.getPointsPerDollar()));
+        text(",\"lastYear\":").number(static_cast<long long>(m.getLastYear()));
+        text("}").endLine();
+        return;
+    }
+
+    size_t start;
+    text(CARD_TOP).endLine();
+    text("│ 会员ID: "); start = mark(); number(static_cast<long long>(m.getId())).padFrom(start, 8).endLine();
+    text("│ 姓名: "); start = mark(); text(m.getName()).padFrom(start, 15).endLine();
+    text("│ 电话: "); start = mark(); text(m.getPhone()).padFrom(start, 15).endLine();
+    text("│ 生日: "); start = mark(); text(m.getBirthday()).padFrom(start, 15).endLine();
+    text("│ 等级: "); start = mark(); text(levelName(m.getCurrentLevel())).padFrom(start, 15).endLine();
+    text("│ 优惠: "); start = mark();
+    if (discountRate < 1.0) {
+        number(static_cast<long long>(discountRate * 10)).text("折");
+    } else {
+        text("无折扣");
+    }
+    padFrom(start, 15).endLine();
+    text("│ 总消费: ").number(m.getTotalSpent(), 2).text("元").endLine();
+    text("│ 年度消费: ").number(m.getAnnualSpent(), 2).text("元").endLine();
+    text("│ 积分: "); start = mark(); number(static_cast<long long>(m.getPoints())).padFrom(start, 15).endLine();
+    text("│ 积分规则: 1元=").number(static_cast<long long>(m.getPointsPerDollar())).text("积分").endLine();
+    text("│ 上次消费年份: "); start = mark(); number(static_cast<long long>(m.getLastYear())).padFrom(start, 15).endLine();
+    text(CARD_BOTTOM).endLine();
+}
+
+/**
+ * @brief 按游标分页输出会员列表
+ * @param list 会员列表
+ * @param cursor 分页游标
+ * @param order 输出顺序（会员下标），为空指针时按列表原有顺序
+ * @return 本页输出的会员数量
+ */
+size_t OutputRenderer::members(const std::vector<Member>& list, Cursor& cursor, const std::vector<size_t>* order) {
+    size_t begin = std::min(cursor.offset, list.size());
+    size_t end = (cursor.pageSize == 0) ? list.size() : std::min(list.size(), begin + cursor.pageSize);
+    for (size_t i = begin; i < end; ++i) {
+        member(list[order ? (*order)[i] : i]);
+        if (format == FORMAT_TABLE) {
+            endLine();
+        }
+    }
+    cursor.offset = end;
+    cursor.done = (end >= list.size());
+    return end - begin;
+}
+
+/**
+ * @brief 输出会员的消费历史
+ * @param m 会员对象
+ * @param n 显示最近N次消费记录，-1表示显示全部
+ */
+void OutputRenderer::consumptionHistory(const Member& m, int n) {
+    const auto& history = m.getConsumptionHistory();
+    size_t startIndex = (n == -1) ? 0 : history.size() - std::min(history.size(), static_cast<size_t>(std::max(n, 0)));
+    historyBegin(history.size() - startIndex);
+    historyRows(history, startIndex, 1);
+    historyEnd(history.size() - startIndex);
+}
+
+/**
+ * @brief 输出消费记录的表头
+ * @param count 将要输出的记录总条数
+ */
+void OutputRenderer::historyBegin(size_t count) {
+    if (format == FORMAT_CSV) {
+        text("index,original,discountRate,actual").endLine();
+    }
+    if (format != FORMAT_TABLE) {
+        return;
+    }
+    if (count == 0) {
+        text("暂无消费记录！").endLine();
+        return;
+    }
+    endLine().text("消费记录 (").number(static_cast<long long>(count)).text(" 条):").endLine();
+    text("┌─────────────┬─────────────┬─────────────┬─────────────┐").endLine();
+    text("│    序号     │    原价     │    折扣     │  实际支付   │").endLine();
+    text("├─────────────┼─────────────┼─────────────┼─────────────┤").endLine();
+}
+
+/**
+ * @brief 输出一段消费记录
+ * @param records 消费记录 <原价, 折扣率>
+ * @param begin 从第几条开始输出
+ * @param firstNumber 第一条输出记录的序号
+ * @details 归档的各年度和内存中的记录分段调用，序号连续
+ */
+void OutputRenderer::historyRows(const std::vector<std::pair<double, double>>& records, size_t begin,
+                                 size_t firstNumber) {
+    for (size_t i = begin; i < records.size(); ++i) {
+        double original = records[i].first;    // 原价
+        double rate = records[i].second;       // 折扣率
+        double actual = original * rate;       // 实际支付金额
+        long long recordNum = static_cast<long long>(firstNumber + i - begin);
+        if (format == FORMAT_CSV) {
+            number(recordNum).text(",").number(original, 2).text(",")
+                .number(rate, 2).text(",").number(actual, 2).endLine();
+        } else if (format == FORMAT_JSONL) {
+            text("{\"index\":").number(recordNum)
+                .text(",\"original\":").number(original, 2)
+                .text(",\"discountRate\":").number(rate, 2)
+                .text(",\"actual\":").number(actual, 2)
+                .text("}").endLine();
+        } else {
+            size_t start;
+            text("│ "); start = mark(); number(recordNum).padFrom(start, 11);
+            text(" │ "); start = mark(); number(original, 2).padFrom(start, 5).text("元");
+            text(" │ "); start = mark(); number(rate * 10, 1).padFrom(start, 5).text("折");
+            text(" │ "); start = mark(); number(actual, 2).padFrom(start, 5).text("元");
+            text(" │").endLine();
+        }
+    }
+}
+
+/**
+ * @brief 输出消费记录的表尾
+ * @param count 已输出的记录总条数
+ */
+void OutputRenderer::historyEnd(size_t count) {
+    if (format == FORMAT_TABLE && count > 0) {
+        text("└─────────────┴─────────────┴─────────────┴─────────────┘").endLine();
+    }
+}
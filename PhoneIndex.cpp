@@ -0,0 +1,436 @@
+/**
+ * @file PhoneIndex.cpp
+ * @brief 电话号码索引实现文件
+ * @details 路径压缩基数树的插入（必要时分裂边）、删除（回收空节点并合并单链）、
+ *          前缀遍历以及后四位分桶的维护
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "PhoneIndex.h"
+
+/**
+ * @brief 构造函数，创建根节点和后四位桶
+ */
+PhoneIndex::PhoneIndex() : suffixBuckets(SUFFIX_BUCKETS) {
+    nodes.push_back(Node{ 0, 0, -1, -1, -1, 0 });
+}
+
+/**
+ * @brief 判断号码能否被索引
+ * @param phone 电话号码
+ * @return true 由 1-16 位数字组成
+ */
+bool PhoneIndex::indexable(std::string_view phone) {
+    if (phone.empty() || phone.size() > MAX_DIGITS) {
+        return false;
+    }
+    for (char c : phone) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 把数字串压缩为每位4比特的整数
+ * @param digits 数字串（不超过16位）
+ * @return 压缩结果，第 i 位数字位于第 4i 位起
+ */
+uint64_t PhoneIndex::pack(std::string_view digits) {
+    uint64_t label = 0;
+    for (size_t i = 0; i < digits.size(); ++i) {
+        label |= static_cast<uint64_t>(digits[i] - '0') << (4 * i);
+    }
+    return label;
+}
+
+/**
+ * @brief 计算后四位桶下标
+ * @param phone 电话号码
+ * @return 桶下标，号码不足4位或含非数字时返回-1
+ */
+int PhoneIndex::suffixKey(std::string_view phone) {
+    if (phone.size() < 4) {
+        return -1;
+    }
+    int key = 0;
+    for (size_t i = phone.size() - 4; i < phone.size(); ++i) {
+        if (phone[i] < '0' || phone[i] > '9') {
+            return -1;
+        }
+        key = key * 10 + (phone[i] - '0');
+    }
+    return key;
+}
+
+/**
+ * @brief 分配一个节点，优先复用空闲槽位
+ * @param label 边上的数字
+ * @param length 数字个数
+ * @return 节点下标
+ */
+int32_t PhoneIndex::allocateNode(uint64_t label, uint8_t length) {
+    Node node{ label, length, -1, -1, -1, 0 };
+    if (!freeNodes.empty()) {
+        int32_t slot = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[slot] = node;
+        return slot;
+    }
+    nodes.push_back(node);
+    return static_cast<int32_t>(nodes.size() - 1);
+}
+
+/**
+ * @brief 回收节点
+ * @param node 节点下标
+ */
+void PhoneIndex::freeNode(int32_t node) {
+    freeNodes.push_back(node);
+}
+
+/**
+ * @brief 查找首位为指定数字的子节点
+ * @param node 父节点
+ * @param digit 首位数字
+ * @param previous 输出（可为空）：排在该数字之前的最后一个兄弟节点，-1 表示应作为第一个子节点
+ * @return 子节点下标，不存在时返回-1
+ */
+int32_t PhoneIndex::findChild(int32_t node, int digit, int32_t* previous) const {
+    int32_t before = -1;
+    for (int32_t child = nodes[node].firstChild; child >= 0; child = nodes[child].nextSibling) {
+        int first = digitAt(nodes[child].label, 0);
+        if (first == digit) {
+            if (previous) *previous = before;
+            return child;
+        }
+        if (first > digit) {
+            break;
+        }
+        before = child;
+    }
+    if (previous) *previous = before;
+    return -1;
+}
+
+/**
+ * @brief 沿数字串查找节点
+ * @param digits 数字串
+ * @param exactNode true 要求数字串恰好在节点处结束；false 允许结束在边的中间
+ * @return 节点下标，不存在时返回-1
+ */
+int32_t PhoneIndex::locate(std::string_view digits, bool exactNode) const {
+    int32_t node = 0;
+    size_t pos = 0;
+    while (pos < digits.size()) {
+        int32_t child = findChild(node, digits[pos] - '0', nullptr);
+        if (child < 0) {
+            return -1;
+        }
+        const Node& edge = nodes[child];
+        size_t remaining = digits.size() - pos;
+        size_t compare = edge.length < remaining ? edge.length : remaining;
+        for (size_t i = 1; i < compare; ++i) {
+            if (digitAt(edge.label, i) != digits[pos + i] - '0') {
+                return -1;
+            }
+        }
+        if (edge.length > remaining) {
+            return exactNode ? -1 : child;
+        }
+        node = child;
+        pos += edge.length;
+    }
+    return node;
+}
+
+/**
+ * @brief 加入一个号码
+ * @param phone 电话号码
+ * @param id 会员ID
+ * @details 号码与已有边部分相同时在分叉处把边一分为二
+ */
+void PhoneIndex::insert(std::string_view phone, int id) {
+    if (!indexable(phone)) {
+        return;
+    }
+    nodes[0].count += 1;
+    int32_t node = 0;
+    size_t pos = 0;
+    while (pos < phone.size()) {
+        int32_t previous;
+        int32_t child = findChild(node, phone[pos] - '0', &previous);
+        if (child < 0) {
+            // 没有相同首位的子节点：剩余数字整体作为一条新边
+            std::string_view rest = phone.substr(pos);
+            int32_t leaf = allocateNode(pack(rest), static_cast<uint8_t>(rest.size()));
+            nodes[leaf].count = 1;
+            if (previous < 0) {
+                nodes[leaf].nextSibling = nodes[node].firstChild;
+                nodes[node].firstChild = leaf;
+            } else {
+                nodes[leaf].nextSibling = nodes[previous].nextSibling;
+                nodes[previous].nextSibling = leaf;
+            }
+            node = leaf;
+            break;
+        }
+
+        size_t length = nodes[child].length;
+        size_t common = 1;
+        while (common < length && pos + common < phone.size() &&
+               digitAt(nodes[child].label, common) == phone[pos + common] - '0') {
+            ++common;
+        }
+        if (common == length) {
+            nodes[child].count += 1;
+            node = child;
+            pos += length;
+            continue;
+        }
+
+        // 在分叉处分裂：新节点承接公共部分，原节点保留剩余部分
+        uint64_t mask = (uint64_t(1) << (4 * common)) - 1;
+        int32_t middle = allocateNode(nodes[child].label & mask, static_cast<uint8_t>(common));
+        nodes[middle].count = nodes[child].count + 1;
+        nodes[middle].firstChild = child;
+        nodes[middle].nextSibling = nodes[child].nextSibling;
+        nodes[child].nextSibling = -1;
+        nodes[child].label >>= 4 * common;
+        nodes[child].length = static_cast<uint8_t>(length - common);
+        if (previous < 0) {
+            nodes[node].firstChild = middle;
+        } else {
+            nodes[previous].nextSibling = middle;
+        }
+        node = middle;
+        pos += common;
+    }
+
+    IdEntry entry{ id, nodes[node].ids };
+    int32_t slot;
+    if (!freeEntries.empty()) {
+        slot = freeEntries.back();
+        freeEntries.pop_back();
+        entries[slot] = entry;
+    } else {
+        entries.push_back(entry);
+        slot = static_cast<int32_t>(entries.size() - 1);
+    }
+    nodes[node].ids = slot;
+
+    int key = suffixKey(phone);
+    if (key >= 0) {
+        suffixBuckets[key].push_back(id);
+    }
+}
+
+/**
+ * @brief 把没有会员ID且只有一个子节点的节点与子节点合并
+ * @param node 节点下标
+ */
+void PhoneIndex::mergeWithChild(int32_t node) {
+    Node& parent = nodes[node];
+    if (node == 0 || parent.ids >= 0) {
+        return;
+    }
+    int32_t child = parent.firstChild;
+    if (child < 0 || nodes[child].nextSibling >= 0 || parent.length + nodes[child].length > MAX_DIGITS) {
+        return;
+    }
+    const Node& only = nodes[child];
+    parent.label |= only.label << (4 * parent.length);
+    parent.length = static_cast<uint8_t>(parent.length + only.length);
+    parent.firstChild = only.firstChild;
+    parent.ids = only.ids;
+    freeNode(child);
+}
+
+/**
+ * @brief 移除一个号码
+ * @param phone 加入时使用的电话号码
+ * @param id 会员ID
+ * @return true 移除成功，false 记录不存在
+ * @details 子树为空的节点被回收，剩下的单链节点重新合并，保持树的紧凑
+ */
+bool PhoneIndex::erase(std::string_view phone, int id) {
+    if (!indexable(phone)) {
+        return false;
+    }
+
+    // 记录路径：节点及其前一个兄弟节点，用于回收时摘链
+    int32_t path[MAX_DIGITS + 1];
+    int32_t previousOf[MAX_DIGITS + 1];
+    size_t depth = 0;
+    path[0] = 0;
+    previousOf[0] = -1;
+    size_t pos = 0;
+    while (pos < phone.size()) {
+        int32_t previous;
+        int32_t child = findChild(path[depth], phone[pos] - '0', &previous);
+        if (child < 0 || nodes[child].length > phone.size() - pos ||
+            nodes[child].label != (pack(phone.substr(pos, nodes[child].length)))) {
+            return false;
+        }
+        pos += nodes[child].length;
+        ++depth;
+        path[depth] = child;
+        previousOf[depth] = previous;
+    }
+
+    // 从终点节点的链表中摘除该会员
+    int32_t terminal = path[depth];
+    int32_t* link = &nodes[terminal].ids;
+    while (*link >= 0 && entries[*link].id != id) {
+        link = &entries[*link].next;
+    }
+    if (*link < 0) {
+        return false;
+    }
+    int32_t removed = *link;
+    *link = entries[removed].next;
+    freeEntries.push_back(removed);
+
+    for (size_t i = 0; i <= depth; ++i) {
+        nodes[path[i]].count -= 1;
+    }
+
+    // 自底向上回收空节点，并合并最低的存活节点
+    size_t level = depth;
+    while (level > 0 && nodes[path[level]].count == 0) {
+        int32_t node = path[level];
+        int32_t parent = path[level - 1];
+        if (previousOf[level] < 0) {
+            nodes[parent].firstChild = nodes[node].nextSibling;
+        } else {
+            nodes[previousOf[level]].nextSibling = nodes[node].nextSibling;
+        }
+        freeNode(node);
+        --level;
+    }
+    mergeWithChild(path[level]);
+
+    int key = suffixKey(phone);
+    if (key >= 0) {
+        std::vector<int>& bucket = suffixBuckets[key];
+        for (size_t i = 0; i < bucket.size(); ++i) {
+            if (bucket[i] == id) {
+                bucket[i] = bucket.back();
+                bucket.pop_back();
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 精确查询
+ * @param phone 完整电话号码
+ * @param out 输出：号码完全相同的会员ID
+ */
+void PhoneIndex::exact(std::string_view phone, std::vector<int>& out) const {
+    if (!indexable(phone)) {
+        return;
+    }
+    int32_t node = locate(phone, true);
+    if (node < 0) {
+        return;
+    }
+    for (int32_t entry = nodes[node].ids; entry >= 0; entry = entries[entry].next) {
+        out.push_back(entries[entry].id);
+    }
+}
+
+/**
+ * @brief 前缀查询
+ * @param prefix 号码前缀
+ * @param limit 最多输出的数量，0 表示不限
+ * @param out 输出：匹配的会员ID，按号码升序
+ * @return 匹配的会员总数
+ */
+size_t PhoneIndex::prefix(std::string_view prefix, size_t limit, std::vector<int>& out) const {
+    if (!prefix.empty() && !indexable(prefix)) {
+        return 0;
+    }
+    int32_t target = locate(prefix, false);
+    if (target < 0) {
+        return 0;
+    }
+
+    // 深度优先遍历：先输出本节点结束的号码，再按数字升序访问子节点
+    size_t emitted = 0;
+    std::vector<int32_t> stack{ target };
+    while (!stack.empty() && (limit == 0 || emitted < limit)) {
+        int32_t node = stack.back();
+        stack.pop_back();
+        for (int32_t entry = nodes[node].ids; entry >= 0 && (limit == 0 || emitted < limit);
+             entry = entries[entry].next) {
+            out.push_back(entries[entry].id);
+            ++emitted;
+        }
+        int32_t children[10];
+        int count = 0;
+        for (int32_t child = nodes[node].firstChild; child >= 0; child = nodes[child].nextSibling) {
+            children[count++] = child;
+        }
+        while (count > 0) {
+            stack.push_back(children[--count]);
+        }
+    }
+    return nodes[target].count;
+}
+
+/**
+ * @brief 后四位查询
+ * @param lastFour 号码后四位
+ * @return 后四位相同的会员ID
+ */
+const std::vector<int>& PhoneIndex::suffix(std::string_view lastFour) const {
+    static const std::vector<int> none;
+    int key = (lastFour.size() == 4) ? suffixKey(lastFour) : -1;
+    return key < 0 ? none : suffixBuckets[key];
+}
+
+/**
+ * @brief 获取已索引的号码数量
+ * @return 号码数量
+ */
+size_t PhoneIndex::size() const {
+    return nodes[0].count;
+}
+
+/**
+ * @brief 统计索引占用的内存
+ * @return 内存占用
+ */
+MemoryUsage PhoneIndex::memoryUsage() const {
+    MemoryUsage usage;
+    usage.addVector(nodes);
+    usage.addVector(freeNodes);
+    usage.addVector(entries);
+    usage.addVector(freeEntries);
+    usage.addVector(suffixBuckets);
+    for (const auto& bucket : suffixBuckets) {
+        usage.addVector(bucket);
+    }
+    usage.objects = size();
+    return usage;
+}
+
+/**
+ * @brief 清空索引
+ */
+void PhoneIndex::clear() {
+    nodes.clear();
+    nodes.push_back(Node{ 0, 0, -1, -1, -1, 0 });
+    freeNodes.clear();
+    entries.clear();
+    freeEntries.clear();
+    for (auto& bucket : suffixBuckets) {
+        bucket.clear();
+    }
+}
@@ -0,0 +1,666 @@
+/**
+ * @file Presenter.cpp
+ * @brief 控制台展示层实现文件
+ * @details 实现各项操作结果的提示信息以及会员列表、会员信息、消费历史的展示
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "Presenter.h"
+#include "LatencyStats.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @brief 构造函数
+ * @param out 输出流
+ */
+Presenter::Presenter(std::ostream& out) : out(out) {
+}
+
+// ==================== 操作结果提示 ====================
+
+/**
+ * @brief 获取结果码对应的通用提示
+ * @param status 结果码
+ * @return 中文提示信息
+ */
+const char* Presenter::statusMessage(MemberManager::Status status) {
+    switch (status) {
+    case MemberManager::STATUS_OK: return "操作成功！";
+    case MemberManager::STATUS_NOT_FOUND: return "未找到该ID的会员！";
+    case MemberManager::STATUS_INVALID_ARGUMENT: return "参数无效！";
+    case MemberManager::STATUS_INSUFFICIENT_POINTS: return "积分不足或兑换数量无效！";
+    default: return "文件读写失败！";
+    }
+}
+
+/**
+ * @brief 获取修改操作失败时的提示
+ * @param status 结果码
+ * @return 中文提示信息
+ */
+const char* Presenter::mutationMessage(MemberManager::Status status) {
+    if (status == MemberManager::STATUS_IO_ERROR) {
+        return "修改已在本机生效，但复制日志写入失败，备库不会收到！";
+    }
+    return statusMessage(status);
+}
+
+/**
+ * @brief 提示会员添加结果
+ * @param status 结果码
+ * @param name 会员姓名
+ * @param id 新会员ID
+ */
+void Presenter::memberAdded(MemberManager::Status status, const std::string& name, int id) {
+    if (status == MemberManager::STATUS_OK) {
+        out << "会员 " << name << " 添加成功！ID: " << id << std::endl;
+    } else {
+        out << "会员 " << name << " (ID: " << id << ") " << mutationMessage(status) << std::endl;
+    }
+}
+
+/**
+ * @brief 提示会员删除结果
+ * @param status 结果码
+ * @param name 会员姓名
+ * @param id 会员ID
+ */
+void Presenter::memberDeleted(MemberManager::Status status, const std::string& name, int id) {
+    if (status == MemberManager::STATUS_OK) {
+        out << "会员 " << name << " (ID: " << id << ") 已成功删除！" << std::endl;
+    } else if (status == MemberManager::STATUS_NOT_FOUND) {
+        out << "未找到ID为 " << id << " 的会员！" << std::endl;
+    } else {
+        out << mutationMessage(status) << std::endl;
+    }
+}
+
+/**
+ * @brief 提示电话修改结果
+ * @param status 结果码
+ * @param id 会员ID
+ * @param newPhone 新的电话号码
+ */
+void Presenter::phoneUpdated(MemberManager::Status status, int id, const std::string& newPhone) {
+    if (status == MemberManager::STATUS_OK) {
+        out << "会员 " << id << " 电话已更新为: " << newPhone << std::endl;
+    } else {
+        out << mutationMessage(status) << std::endl;
+    }
+}
+
+/**
+ * @brief 提示消费结算结果
+ * @param result 添加消费的结果
+ */
+void Presenter::spendingAdded(const MemberManager::SpendingResult& result) {
+    if (result.status != MemberManager::STATUS_OK) {
+        out << mutationMessage(result.status) << std::endl;
+        return;
+    }
+    const Member::SpendingReceipt& receipt = result.receipt;
+    out << "消费 " << receipt.amount << " 元，享受 " << receipt.discountRate * 10 << " 折优惠，实际支付 "
+        << receipt.actualAmount << " 元，累计积分: " << receipt.totalPoints << std::endl;
+}
+
+/**
+ * @brief 提示积分兑换结果
+ * @param result 积分兑换的结果
+ */
+void Presenter::pointsRedeemed(const MemberManager::RedeemResult& result) {
+    if (result.status == MemberManager::STATUS_OK) {
+        out << "成功兑换 " << result.redeemed << " 积分，剩余积分: " << result.remaining << std::endl;
+    } else {
+        out << mutationMessage(result.status) << std::endl;
+    }
+}
+
+/**
+ * @brief 提示休眠会员转存结果
+ * @param status 启用冷热分层的结果码
+ * @param evicted 本次转存的会员数
+ * @param coldTotal 磁盘上的会员总数
+ */
+void Presenter::dormantEvicted(MemberManager::Status status, size_t evicted, size_t coldTotal) {
+    if (status != MemberManager::STATUS_OK) {
+        out << statusMessage(status) << std::endl;
+        return;
+    }
+    out << "本次转存 " << evicted << " 位休眠会员，磁盘上共 " << coldTotal
+        << " 位。按ID或电话访问这些会员时会自动调回内存。" << std::endl;
+}
+
+/**
+ * @brief 提示生日积分奖励的发放结果
+ * @param result 批量赠送的结果
+ */
+void Presenter::birthdayBonusGranted(const MemberManager::BonusResult& result) {
+    if (result.status == MemberManager::STATUS_IO_ERROR) {
+        // 已发放的部分不回滚：磁盘上读不出的会员被跳过，或发放记录未能写入复制日志
+        out << "已为 " << result.members << " 位会员发放生日积分，但有休眠会员读取失败或复制日志写入失败！" << std::endl;
+    } else if (result.status != MemberManager::STATUS_OK) {
+        out << statusMessage(result.status) << std::endl;
+    } else if (result.members == 0) {
+        out << "该时间段内没有过生日的会员。" << std::endl;
+    } else {
+        out << "已为 " << result.members << " 位会员发放生日积分，共 " << result.pointsGranted << " 积分" << std::endl;
+    }
+}
+
+/**
+ * @brief 提示积分规则设置结果
+ * @param status 结果码
+ * @param rule 新的积分规则
+ */
+void Presenter::pointsRuleChanged(MemberManager::Status status, int rule) {
+    if (status == MemberManager::STATUS_OK) {
+        out << "积分规则已更新：1元=" << rule << "积分" << std::endl;
+    } else if (status == MemberManager::STATUS_INVALID_ARGUMENT) {
+        out << "积分规则必须大于 0！" << std::endl;
+    } else {
+        out << mutationMessage(status) << std::endl;
+    }
+}
+
+/**
+ * @brief 提示数据保存结果
+ * @param status 结果码
+ * @param filename 文件名
+ */
+void Presenter::dataSaved(MemberManager::Status status, const std::string& filename) {
+    if (status == MemberManager::STATUS_OK) {
+        out << "数据已保存到文件: " << filename << std::endl;
+    } else {
+        out << "无法打开文件: " << filename << std::endl;
+    }
+}
+
+/**
+ * @brief 提示数据加载结果
+ * @param status 结果码
+ * @param filename 文件名
+ */
+void Presenter::dataLoaded(MemberManager::Status status, const std::string& filename) {
+    if (status == MemberManager::STATUS_OK) {
+        out << "数据已从文件加载: " << filename << std::endl;
+    } else {
+        out << "无法打开文件: " << filename << std::endl;
+    }
+}
+
+// ==================== 会员信息展示 ====================
+
+/**
+ * @brief 按游标分页输出会员列表
+ * @param manager 会员管理器
+ * @param renderer 输出渲染器
+ * @param cursor 分页游标，输出后前移
+ * @param order 输出顺序，为空指针时按会员ID
+ */
+void Presenter::memberList(const MemberManager& manager, OutputRenderer& renderer, OutputRenderer::Cursor& cursor,
+                           const std::vector<size_t>* order) {
+    const std::vector<Member>& members = manager.getMemberList();
+    if (cursor.offset == 0) {
+        if (renderer.isTable()) {
+            if (members.empty()) {
+                renderer.text("当前没有会员记录！").endLine();
+                cursor.done = true;
+                return;
+            }
+            renderer.endLine().text("=== 会员列表 ===").endLine();
+            renderer.text("总会员数: ").number(static_cast<long long>(members.size())).text(" 人").endLine();
+            if (manager.getColdMemberCount() > 0) {
+                renderer.text("（另有 ").number(static_cast<long long>(manager.getColdMemberCount()))
+                    .text(" 位休眠会员已转存到磁盘，未列出）").endLine();
+            }
+            renderer.endLine();
+        } else {
+            renderer.memberHeader();
+        }
+    }
+    renderer.members(members, cursor, order);
+}
+
+/**
+ * @brief 显示会员完整信息
+ * @param member 会员指针，为空时提示未找到
+ */
+void Presenter::memberCard(const Member* member) {
+    OutputRenderer renderer(out);
+    if (!member) {
+        renderer.text("未找到该电话的会员！").endLine();
+        return;
+    }
+    renderer.member(*member);
+    renderer.endLine();
+}
+
+/**
+ * @brief 显示电话号码或姓名查询的候选会员
+ * @param manager 会员管理器
+ * @param ids 要显示的候选会员ID
+ * @param total 候选总数
+ * @param notFoundMessage 没有候选时的提示
+ */
+void Presenter::memberCandidates(const MemberManager& manager, const std::vector<int>& ids, size_t total,
+                                 const char* notFoundMessage) {
+    if (total == 1 && ids.size() == 1) {
+        memberCard(manager.getMemberById(ids[0]));
+        return;
+    }
+    OutputRenderer renderer(out);
+    if (total == 0) {
+        renderer.text(notFoundMessage).endLine();
+        return;
+    }
+    renderer.text("找到 ").number(static_cast<long long>(total)).text(" 位候选会员：").endLine();
+    renderer.text("┌──────────┬──────────────────┬─────────────────┬──────────┐").endLine();
+    renderer.text("│ 会员ID   │ 姓名             │ 电话            │ 等级     │").endLine();
+    renderer.text("├──────────┼──────────────────┼─────────────────┼──────────┤").endLine();
+    for (int id : ids) {
+        const Member* member = manager.getMemberById(id);
+        if (!member) {
+            continue;
+        }
+        size_t start;
+        renderer.text("│ "); start = renderer.mark(); renderer.number(static_cast<long long>(id)).padFrom(start, 8);
+        renderer.text(" │ "); start = renderer.mark(); renderer.text(member->getName()).padFrom(start, 16);
+        renderer.text(" │ "); start = renderer.mark(); renderer.text(member->getPhone()).padFrom(start, 15);
+        renderer.text(" │ ").text(OutputRenderer::levelName(member->getCurrentLevel())).text(" │").endLine();
+    }
+    renderer.text("└──────────┴──────────────────┴─────────────────┴──────────┘").endLine();
+    if (total > ids.size()) {
+        renderer.text("（仅显示前 ").number(static_cast<long long>(ids.size())).text(" 位，请输入更多内容缩小范围）").endLine();
+    }
+}
+
+/**
+ * @brief 显示会员消费历史
+ * @param manager 会员管理器
+ * @param member 会员指针，为空时提示未找到
+ * @param n 显示最近N次消费记录，-1表示显示全部
+ * @details 先只读各年度索引得到记录条数，确定需要哪些年度，再按年份从旧到新逐年读出并输出，
+ *          任何时候内存中只有一个年度的记录
+ */
+void Presenter::spendingHistory(const MemberManager& manager, const Member* member, int n) {
+    OutputRenderer renderer(out);
+    if (!member) {
+        renderer.text(statusMessage(MemberManager::STATUS_NOT_FOUND)).endLine();
+        return;
+    }
+    renderer.endLine().text("=== 会员消费历史 ===").endLine();
+    renderer.member(*member);
+
+    const auto& recent = member->getConsumptionHistory();
+    const HistoryArchive& archive = manager.getHistoryArchive();
+    size_t wanted = (n == -1) ? SIZE_MAX : static_cast<size_t>(std::max(n, 0));
+    size_t recentShown = std::min(recent.size(), wanted);
+    size_t archivedShown = 0;
+    size_t firstSegment = archive.yearCount();
+    for (size_t s = archive.yearCount(); s-- > 0 && recentShown + archivedShown < wanted;) {
+        archivedShown += archive.recordCount(s, member->getId());
+        firstSegment = s;
+    }
+    // 最早的一个年度可能只需要其中最近的几条
+    size_t skip = 0;
+    if (recentShown + archivedShown > wanted) {
+        skip = recentShown + archivedShown - wanted;
+        archivedShown -= skip;
+    }
+
+    renderer.historyBegin(recentShown + archivedShown);
+    size_t number = 1;
+    std::vector<HistoryArchive::Record> records;
+    for (size_t s = firstSegment; s < archive.yearCount(); ++s) {
+        if (!archive.read(s, member->getId(), records)) {
+            continue;
+        }
+        size_t begin = std::min(skip, records.size());
+        skip -= begin;
+        renderer.historyRows(records, begin, number);
+        number += records.size() - begin;
+    }
+    renderer.historyRows(recent, recent.size() - recentShown, number);
+    renderer.historyEnd(recentShown + archivedShown);
+}
+
+// ==================== 性能统计 ====================
+
+namespace {
+
+/**
+ * @brief 输出一个耗时，按大小选用 ns、us、ms 或 s
+ * @param renderer 输出渲染器
+ * @param nanoseconds 耗时（纳秒）
+ */
+void renderDuration(OutputRenderer& renderer, uint64_t nanoseconds) {
+    double value = static_cast<double>(nanoseconds);
+    if (nanoseconds < 1000) {
+        renderer.number(static_cast<long long>(nanoseconds)).text(" ns");
+    } else if (nanoseconds < 1000000) {
+        renderer.number(value / 1e3, 2).text(" us");
+    } else if (nanoseconds < 1000000000) {
+        renderer.number(value / 1e6, 2).text(" ms");
+    } else {
+        renderer.number(value / 1e9, 2).text(" s");
+    }
+}
+
+/**
+ * @brief 输出一个字节数，按大小选用 B、KB、MB 或 GB
+ * @param renderer 输出渲染器
+ * @param bytes 字节数
+ */
+void renderBytes(OutputRenderer& renderer, uint64_t bytes) {
+    double value = static_cast<double>(bytes);
+    if (bytes < 1024) {
+        renderer.number(static_cast<long long>(bytes)).text(" B");
+    } else if (bytes < 1024 * 1024) {
+        renderer.number(value / 1024, 1).text(" KB");
+    } else if (bytes < 1024ull * 1024 * 1024) {
+        renderer.number(value / (1024 * 1024), 1).text(" MB");
+    } else {
+        renderer.number(value / (1024.0 * 1024 * 1024), 2).text(" GB");
+    }
+}
+
+} // namespace
+
+/**
+ * @brief 显示各操作的耗时统计
+ */
+void Presenter::perfStats() {
+    OutputRenderer renderer(out);
+    LatencyHistogram histogram;
+    bool any = false;
+    for (int op = 0; op < PerfStats::OP_COUNT; ++op) {
+        PerfStats::Operation operation = static_cast<PerfStats::Operation>(op);
+        PerfStats::snapshot(operation, histogram);
+        if (histogram.count() == 0) {
+            continue;
+        }
+        if (!any) {
+            renderer.text("┌──────────────────────────┬────────────┬────────────┬────────────┬────────────┬────────────┐").endLine();
+            renderer.text("│ 操作                     │ 次数       │ p50        │ p99        │ p99.9      │ 最大       │").endLine();
+            renderer.text("├──────────────────────────┼────────────┼────────────┼────────────┼────────────┼────────────┤").endLine();
+            any = true;
+        }
+        size_t start;
+        renderer.text("│ "); start = renderer.mark(); renderer.text(PerfStats::operationName(operation)).padFrom(start, 24);
+        renderer.text(" │ "); start = renderer.mark();
+        renderer.number(static_cast<long long>(histogram.count())).padFrom(start, 10);
+        for (uint64_t value : { histogram.percentile(0.5), histogram.percentile(0.99), histogram.percentile(0.999),
+                                histogram.max() }) {
+            renderer.text(" │ "); start = renderer.mark(); renderDuration(renderer, value); renderer.padFrom(start, 10);
+        }
+        renderer.text(" │").endLine();
+    }
+    if (!any) {
+        renderer.text("暂无统计数据。").endLine();
+        return;
+    }
+    renderer.text("└──────────────────────────┴────────────┴────────────┴────────────┴────────────┴────────────┘").endLine();
+    renderer.text("分位数按对数分桶估算，相对误差约 1.6%。").endLine();
+
+    // 开启过硬件计数的操作另列每次操作的平均事件数
+    bool anyHardware = false;
+    PerfStats::HardwareTotals totals;
+    for (int op = 0; op < PerfStats::OP_COUNT; ++op) {
+        PerfStats::Operation operation = static_cast<PerfStats::Operation>(op);
+        PerfStats::hardwareSnapshot(operation, totals);
+        uint64_t samples = 0;
+        for (uint64_t count : totals.samples) {
+            samples = std::max(samples, count);
+        }
+        if (samples == 0) {
+            continue;
+        }
+        if (!anyHardware) {
+            renderer.endLine().text("硬件计数器（每次操作平均，只统计操作所在线程）：").endLine();
+            renderer.text("┌──────────────────────────┬────────────┬────────────┬────────┬────────────┬────────────┐").endLine();
+            renderer.text("│ 操作                     │ 周期/次    │ 指令/次    │ IPC    │ 缓存未命中 │ 分支误预测 │").endLine();
+            renderer.text("├──────────────────────────┼────────────┼────────────┼────────┼────────────┼────────────┤").endLine();
+            anyHardware = true;
+        }
+        auto average = [&](HardwareCounters::Counter counter) {
+            return totals.samples[counter] == 0 ? -1.0
+                                                : static_cast<double>(totals.events[counter]) /
+                                                      static_cast<double>(totals.samples[counter]);
+        };
+        double cycles = average(HardwareCounters::CYCLES);
+        double instructions = average(HardwareCounters::INSTRUCTIONS);
+        size_t start;
+        renderer.text("│ "); start = renderer.mark(); renderer.text(PerfStats::operationName(operation)).padFrom(start, 24);
+        auto cell = [&](double value, size_t width, int precision) {
+            renderer.text(" │ ");
+            size_t cellStart = renderer.mark();
+            if (value < 0) {
+                renderer.text("-");
+            } else if (precision == 0) {
+                renderer.number(std::llround(value));
+            } else {
+                renderer.number(value, precision);
+            }
+            renderer.padFrom(cellStart, width);
+        };
+        cell(cycles, 10, 0);
+        cell(instructions, 10, 0);
+        cell(cycles > 0 && instructions >= 0 ? instructions / cycles : -1.0, 6, 2);
+        cell(average(HardwareCounters::CACHE_MISSES), 10, 0);
+        cell(average(HardwareCounters::BRANCH_MISSES), 10, 0);
+        renderer.text(" │").endLine();
+    }
+    if (anyHardware) {
+        renderer.text("└──────────────────────────┴────────────┴────────────┴────────┴────────────┴────────────┘").endLine();
+    }
+}
+
+/**
+ * @brief 显示硬件计数的开启状态
+ * @param on 是否开启
+ */
+void Presenter::hardwareCounting(bool on) {
+    if (on) {
+        out << "硬件计数器：已开启（每次操作额外读取两次计数器）" << std::endl;
+    } else {
+        out << "硬件计数器：未开启" << std::endl;
+    }
+}
+
+/**
+ * @brief 提示硬件计数器不可用
+ * @param reason 不可用的原因
+ */
+void Presenter::hardwareCountersUnavailable(const char* reason) {
+    out << "无法打开硬件计数器：" << reason << "。性能统计只记录耗时。" << std::endl;
+}
+
+/**
+ * @brief 提示性能统计导出结果
+ * @param success 是否写入成功
+ * @param filename 文件名
+ */
+void Presenter::perfStatsExported(bool success, const std::string& filename) {
+    if (success) {
+        out << "性能统计已按 Prometheus 文本格式导出到 " << filename << std::endl;
+    } else {
+        out << "无法写入文件 " << filename << std::endl;
+    }
+}
+
+/**
+ * @brief 提示时间线导出结果
+ * @param success 是否写入成功
+ * @param events 导出的阶段数
+ * @param filename 文件名
+ */
+void Presenter::traceExported(bool success, size_t events, const std::string& filename) {
+    if (!success) {
+        out << "无法写入文件 " << filename << std::endl;
+    } else if (events == 0) {
+        out << "暂无记录的阶段（加载、保存、排序等操作执行后才有记录），已写出空的时间线文件 " << filename << std::endl;
+    } else {
+        out << "已导出 " << events << " 个阶段到 " << filename
+            << "，可在 chrome://tracing 或 ui.perfetto.dev 中打开。" << std::endl;
+    }
+}
+
+// ==================== 内存统计 ====================
+
+/**
+ * @brief 显示内存占用报告
+ * @param report 内存占用报告
+ */
+void Presenter::memoryReport(const MemberManager::MemoryReport& report) {
+    // 标签按显示宽度预先补齐到20列（中文占两列）
+    static const char* const LABELS[MemberManager::MEMORY_SUBSYSTEM_COUNT] = {
+        "会员对象            ",
+        "姓名/电话/生日      ",
+        "消费历史            ",
+        "ID索引              ",
+        "电话索引            ",
+        "姓名索引            ",
+        "生日索引            ",
+        "排行榜索引          ",
+        "姓名排序键          ",
+        "休眠会员存根        ",
+        "筛选列快照          ",
+    };
+    OutputRenderer renderer(out);
+    const double members = static_cast<double>(std::max<size_t>(report.members, 1));
+    auto row = [&](const char* label, const MemoryUsage& usage) {
+        size_t start;
+        renderer.text("│ ").text(label);
+        renderer.text(" │ "); start = renderer.mark(); renderBytes(renderer, usage.bytes); renderer.padFrom(start, 10);
+        renderer.text(" │ "); start = renderer.mark();
+        renderer.number(static_cast<double>(usage.bytes) / members, 1).padFrom(start, 10);
+        renderer.text(" │ "); start = renderer.mark();
+        renderer.number(static_cast<long long>(usage.objects)).padFrom(start, 10);
+        renderer.text(" │ "); start = renderer.mark();
+        double slack = usage.bytes == 0 ? 0.0 : 100.0 * static_cast<double>(usage.bytes - usage.usedBytes) /
+                                                    static_cast<double>(usage.bytes);
+        renderer.number(slack, 1).text("%").padFrom(start, 8);
+        renderer.text(" │").endLine();
+    };
+
+    renderer.text("内存中会员 ").number(static_cast<long long>(report.members)).text(" 位").endLine();
+    renderer.text("┌──────────────────────┬────────────┬────────────┬────────────┬──────────┐").endLine();
+    renderer.text("│ 子系统               │ 占用       │ 每会员字节 │ 对象数     │ 预留未用 │").endLine();
+    renderer.text("├──────────────────────┼────────────┼────────────┼────────────┼──────────┤").endLine();
+    for (int s = 0; s < MemberManager::MEMORY_SUBSYSTEM_COUNT; ++s) {
+        row(LABELS[s], report.subsystems[s]);
+    }
+    renderer.text("├──────────────────────┼────────────┼────────────┼────────────┼──────────┤").endLine();
+    MemoryUsage total = report.total();
+    row("合计                ", total);
+    renderer.text("└──────────────────────┴────────────┴────────────┴────────────┴──────────┘").endLine();
+
+    renderer.text("消费历史：平均每位会员 ").number(report.averageHistoryLength(), 2)
+            .text(" 条，最长 ").number(static_cast<long long>(report.longestHistory)).text(" 条").endLine();
+    renderer.text("磁盘占用：休眠会员段文件 "); renderBytes(renderer, report.coldDiskBytes);
+    renderer.text("，消费历史归档 "); renderBytes(renderer, report.archiveDiskBytes);
+    renderer.endLine();
+    renderer.text("堆分配块数：").number(static_cast<long long>(total.allocations))
+            .text("（按每块约 16 字节分配器开销估算另占 ");
+    renderBytes(renderer, total.allocations * 16);
+    renderer.text("）").endLine();
+    if (report.heap.available) {
+        const HeapStats& heap = report.heap;
+        renderer.text("进程堆：在用 "); renderBytes(renderer, heap.inUseBytes);
+        renderer.text("，空闲 "); renderBytes(renderer, heap.freeBytes);
+        double fragmentation = heap.heapBytes == 0 ? 0.0 : 100.0 * static_cast<double>(heap.freeBytes) /
+                                                               static_cast<double>(heap.heapBytes);
+        renderer.text("（外部碎片约 ").number(fragmentation, 1).text("%）");
+        if (heap.inUseBytes > 0) {
+            renderer.text("，以上统计覆盖在用堆内存的 ")
+                    .number(100.0 * static_cast<double>(total.bytes) / static_cast<double>(heap.inUseBytes), 1).text("%");
+        }
+        renderer.endLine();
+    }
+}
+
+// ==================== 服务模式 ====================
+
+/**
+ * @brief 提示服务已启动
+ * @param socketPath 套接字路径
+ * @param shmName 共享内存区名称
+ * @param members 已加载的会员数
+ */
+void Presenter::serverStarted(const std::string& socketPath, const std::string& shmName, size_t members) {
+    out << "会员服务已启动：";
+    if (!socketPath.empty()) {
+        out << "套接字 " << socketPath << (shmName.empty() ? "" : "，");
+    }
+    if (!shmName.empty()) {
+        out << "共享内存 " << shmName;
+    }
+    out << "（" << members << " 名会员），按 Ctrl+C 停止" << std::endl;
+}
+
+/**
+ * @brief 提示服务无法启动
+ * @param reason 原因
+ */
+void Presenter::serverFailed(const std::string& reason) {
+    out << "会员服务无法启动：" << reason << std::endl;
+}
+
+/**
+ * @brief 提示服务因错误停止
+ * @param reason 原因
+ */
+void Presenter::serverAborted(const std::string& reason) {
+    out << "会员服务因错误停止：" << reason << std::endl;
+}
+
+/**
+ * @brief 提示服务已停止
+ * @param stats 运行统计
+ * @param dataFile 数据文件
+ * @param saved 退出时的保存是否成功
+ */
+void Presenter::serverStopped(const MemberServer::Stats& stats, const std::string& dataFile, bool saved) {
+    out << "会员服务已停止：连接 " << stats.connections << " 个，请求 " << stats.requests << " 个，"
+        << "批次 " << stats.batches << " 个（最大 " << stats.largestBatch << " 个请求），自动保存 " << stats.saves
+        << " 次，共享内存客户端 " << stats.sharedClients << " 个" << std::endl;
+    if (!dataFile.empty()) {
+        if (saved) {
+            out << "数据已保存到 " << dataFile << std::endl;
+        } else {
+            out << "无法写入文件 " << dataFile << "，最近的修改未保存" << std::endl;
+        }
+    }
+}
+
+/**
+ * @brief 提示备库已开始跟随主库
+ * @param directory 复制目录
+ * @param members 快照中的会员数
+ */
+void Presenter::standbyStarted(const std::string& directory, size_t members) {
+    out << "备库已启动：跟随复制目录 " << directory << "（快照 " << members
+        << " 名会员），发送 SIGUSR1 提升为主库，按 Ctrl+C 停止" << std::endl;
+}
+
+/**
+ * @brief 提示备库已提升为主库
+ * @param sequence 已重放的最后一条记录的序号
+ * @param members 会员数
+ */
+void Presenter::standbyPromoted(uint32_t sequence, size_t members) {
+    out << "备库已提升为主库：重放至第 " << sequence << " 条记录（" << members << " 名会员）" << std::endl;
+}
+
+/**
+ * @brief 提示备库已停止
+ * @param sequence 已重放的最后一条记录的序号
+ * @param reloads 重新加载快照的次数
+ */
+void Presenter::standbyStopped(uint32_t sequence, uint64_t reloads) {
+    out << "备库已停止：重放至第 " << sequence << " 条记录，重新加载快照 " << reloads << " 次" << std::endl;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file RadixSort.cpp
+ * @brief 并行基数排序实现文件
+ * @details 实现按 11 位数位的并行 LSD 基数排序
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "RadixSort.h"
+#include "Parallel.h"
+#include "TraceRecorder.h"
+#include <array>
+#include <cstddef>
+
+namespace {
+
+const int RADIX_BITS = 11;                          ///< 每趟处理的位数，64 位排序键共 6 趟
+const size_t RADIX_SIZE = size_t(1) << RADIX_BITS;  ///< 每趟的桶数量
+const uint64_t RADIX_MASK = RADIX_SIZE - 1;
+
+} // namespace
+
+/**
+ * @brief 按排序键升序排序（稳定）
+ * @param entries 待排序元素
+ * @param threads 工作线程数，0 表示使用硬件并发数
+ */
+void RadixSort::sort(std::vector<Entry>& entries, unsigned threads) {
+    const size_t count = entries.size();
+    if (count < 2) {
+        return;
+    }
+    if (threads == 0) {
+        threads = defaultThreadCount();
+    }
+    using Histogram = std::array<size_t, RADIX_SIZE>;
+
+    // 一次遍历找出全部元素都相同的数位，这些数位不需要排序
+    uint64_t orBits = 0, andBits = ~uint64_t(0);
+    for (const Entry& entry : entries) {
+        orBits |= entry.key;
+        andBits &= entry.key;
+    }
+    uint64_t varying = orBits ^ andBits;
+
+    std::vector<Entry> buffer(count);
+    std::vector<Histogram> histograms(threads);
+    std::vector<Entry>* from = &entries;
+    std::vector<Entry>* to = &buffer;
+    for (int shift = 0; shift < 64; shift += RADIX_BITS) {
+        if (((varying >> shift) & RADIX_MASK) == 0) {
+            continue;
+        }
+        for (Histogram& histogram : histograms) {
+            histogram.fill(0);
+        }
+        const Entry* source = from->data();
+        Entry* target = to->data();
+
+        parallelFor(count, threads, [&](unsigned t, size_t begin, size_t end) {
+            MEMBER_TRACE_SCOPE("radix.count");
+            Histogram& histogram = histograms[t];
+            for (size_t i = begin; i < end; ++i) {
+                ++histogram[(source[i].key >> shift) & RADIX_MASK];
+            }
+        });
+
+        // 数位值小的在前；同一数位值内，线程序号小（原位置靠前）的在前，保证稳定
+        size_t offset = 0;
+        for (size_t digit = 0; digit < RADIX_SIZE; ++digit) {
+            for (Histogram& histogram : histograms) {
+                size_t n = histogram[digit];
+                histogram[digit] = offset;
+                offset += n;
+            }
+        }
+
+        parallelFor(count, threads, [&](unsigned t, size_t begin, size_t end) {
+            MEMBER_TRACE_SCOPE("radix.scatter");
+            Histogram& next = histograms[t];
+            for (size_t i = begin; i < end; ++i) {
+                target[next[(source[i].key >> shift) & RADIX_MASK]++] = source[i];
+            }
+        });
+        std::swap(from, to);
+    }
+    if (from != &entries) {
+        entries.swap(buffer);
+    }
+}
@@ -0,0 +1,200 @@
+/**
+ * @file RankIndex.cpp
+ * @brief 顺序统计索引实现文件
+ * @details 基于 split/merge 的 Treap 实现，子树规模用于名次计算
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "RankIndex.h"
+
+/**
+ * @brief 生成下一个堆优先级
+ * @return 伪随机优先级（xorshift32）
+ */
+uint32_t RankIndex::nextPriority() {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+/**
+ * @brief 分配一个新节点，优先复用空闲槽位
+ * @param score 排名分值
+ * @param id 会员ID
+ * @return 新节点下标
+ */
+int32_t RankIndex::allocate(double score, int id) {
+    Node node{ score, id, nextPriority(), -1, -1, 1 };
+    if (!freeSlots.empty()) {
+        int32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        nodes[slot] = node;
+        return slot;
+    }
+    nodes.push_back(node);
+    return static_cast<int32_t>(nodes.size() - 1);
+}
+
+/**
+ * @brief 按键拆分子树
+ * @param t 子树根
+ * @param score 拆分键分值
+ * @param id 拆分键ID
+ * @param l 输出：排在键之前的部分
+ * @param r 输出：键本身及之后的部分
+ */
+void RankIndex::split(int32_t t, double score, int id, int32_t& l, int32_t& r) {
+    if (t < 0) {
+        l = r = -1;
+        return;
+    }
+    if (before(nodes[t].score, nodes[t].id, score, id)) {
+        split(nodes[t].right, score, id, nodes[t].right, r);
+        l = t;
+    } else {
+        split(nodes[t].left, score, id, l, nodes[t].left);
+        r = t;
+    }
+    update(t);
+}
+
+/**
+ * @brief 合并两棵子树（l 中所有键均排在 r 之前）
+ * @param l 左子树
+ * @param r 右子树
+ * @return 合并后的根
+ */
+int32_t RankIndex::merge(int32_t l, int32_t r) {
+    if (l < 0) return r;
+    if (r < 0) return l;
+    if (nodes[l].priority > nodes[r].priority) {
+        nodes[l].right = merge(nodes[l].right, r);
+        update(l);
+        return l;
+    }
+    nodes[r].left = merge(l, nodes[r].left);
+    update(r);
+    return r;
+}
+
+/**
+ * @brief 插入一条记录
+ * @param score 排名分值
+ * @param id 会员ID
+ */
+void RankIndex::insert(double score, int id) {
+    int32_t l, r;
+    split(root, score, id, l, r);
+    root = merge(merge(l, allocate(score, id)), r);
+}
+
+/**
+ * @brief 删除一条记录
+ * @param score 插入时使用的分值
+ * @param id 会员ID
+ * @return true 删除成功，false 记录不存在
+ */
+bool RankIndex::erase(double score, int id) {
+    // 先查找节点及其父节点，找到后用左右子树合并结果替换该节点
+    int32_t parent = -1;
+    int32_t t = root;
+    while (t >= 0 && (nodes[t].score != score || nodes[t].id != id)) {
+        parent = t;
+        t = before(score, id, nodes[t].score, nodes[t].id) ? nodes[t].left : nodes[t].right;
+    }
+    if (t < 0) {
+        return false;
+    }
+
+    // 路径上每个祖先的子树恰好少一个节点：再走一遍路径减一，不必记录路径（热路径上不分配内存）
+    for (int32_t p = root; p != t; p = before(score, id, nodes[p].score, nodes[p].id) ? nodes[p].left : nodes[p].right) {
+        nodes[p].size -= 1;
+    }
+    int32_t replacement = merge(nodes[t].left, nodes[t].right);
+    if (parent < 0) {
+        root = replacement;
+    } else if (nodes[parent].left == t) {
+        nodes[parent].left = replacement;
+    } else {
+        nodes[parent].right = replacement;
+    }
+    freeSlots.push_back(t);
+    return true;
+}
+
+/**
+ * @brief 查询记录的名次
+ * @param score 记录的分值
+ * @param id 会员ID
+ * @return 从1开始的名次，记录不存在时返回0
+ */
+size_t RankIndex::rankOf(double score, int id) const {
+    size_t preceding = 0;
+    int32_t t = root;
+    while (t >= 0) {
+        const Node& node = nodes[t];
+        if (node.score == score && node.id == id) {
+            return preceding + sizeOf(node.left) + 1;
+        }
+        if (before(score, id, node.score, node.id)) {
+            t = node.left;
+        } else {
+            preceding += sizeOf(node.left) + 1;
+            t = node.right;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 获取前K名
+ * @param k 需要的数量
+ * @param out 输出的会员ID（按名次排列）
+ */
+void RankIndex::topK(size_t k, std::vector<int>& out) const {
+    out.clear();
+    std::vector<int32_t> stack;
+    int32_t t = root;
+    while ((t >= 0 || !stack.empty()) && out.size() < k) {
+        while (t >= 0) {
+            stack.push_back(t);
+            t = nodes[t].left;
+        }
+        t = stack.back();
+        stack.pop_back();
+        out.push_back(nodes[t].id);
+        t = nodes[t].right;
+    }
+}
+
+/**
+ * @brief 获取记录总数
+ * @return 记录数量
+ */
+size_t RankIndex::size() const {
+    return sizeOf(root);
+}
+
+/**
+ * @brief 统计索引占用的内存
+ * @return 内存占用
+ */
+MemoryUsage RankIndex::memoryUsage() const {
+    MemoryUsage usage;
+    usage.addVector(nodes);
+    usage.addVector(freeSlots);
+    usage.objects = size();
+    return usage;
+}
+
+/**
+ * @brief 清空索引
+ */
+void RankIndex::clear() {
+    nodes.clear();
+    freeSlots.clear();
+    root = -1;
+}
@@ -0,0 +1,420 @@
+/**
+ * @file ReplicationLog.cpp
+ * @brief 复制日志实现文件
+ * @details 实现主库日志的创建、追加与批量写入，记录和文件头的编码与解码，
+ *          以及备库的快照加载、增量重放和纪元切换
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "ReplicationLog.h"
+#include "MemberManager.h"
+#include "MemberProtocol.h"
+#include <filesystem>
+#include <random>
+
+namespace {
+
+const char* const SNAPSHOT_PREFIX = "snapshot-";  ///< 快照文件名前缀
+const char* const SNAPSHOT_SUFFIX = ".dat";       ///< 快照文件名后缀
+
+/**
+ * @brief 从快照文件名解析纪元
+ * @param fileName 文件名（不含目录）
+ * @param epoch 输出：纪元
+ * @return true 是快照文件
+ */
+bool parseSnapshotName(const std::string& fileName, uint64_t& epoch) {
+    const std::string prefix = SNAPSHOT_PREFIX;
+    const std::string suffix = SNAPSHOT_SUFFIX;
+    if (fileName.size() <= prefix.size() + suffix.size() ||
+        fileName.compare(0, prefix.size(), prefix) != 0 ||
+        fileName.compare(fileName.size() - suffix.size(), suffix.size(), suffix) != 0) {
+        return false;
+    }
+    std::string digits = fileName.substr(prefix.size(), fileName.size() - prefix.size() - suffix.size());
+    if (digits.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    epoch = std::stoull(digits);
+    return true;
+}
+
+/**
+ * @brief 读取日志文件开头的文件头
+ * @param path 日志文件路径
+ * @param header 输出：文件头
+ * @return true 文件存在且文件头有效
+ */
+bool readHeader(const std::string& path, ReplicationLog::Header& header) {
+    std::ifstream file(path, std::ios::binary);
+    char data[64];
+    file.read(data, sizeof(data));
+    uint32_t size = 0;
+    if (MemberProtocol::peekFrame(data, static_cast<size_t>(file.gcount()), sizeof(data) - 4, size) !=
+        MemberProtocol::FRAME_READY) {
+        return false;
+    }
+    return ReplicationLog::decodeHeader(data + 4, size, header);
+}
+
+}  // namespace
+
+// ==================== ReplicationLog ====================
+
+/**
+ * @brief 开始新的日志
+ * @param directory 复制目录
+ * @param header 文件头
+ * @return true 成功
+ * @details 先写临时文件再改名，备库任何时候读到的都是完整的文件头
+ */
+bool ReplicationLog::open(const std::string& directory, const Header& header) {
+    close();
+    Header previous;
+    bool hasPrevious = readHeader(logPath(directory), previous);
+
+    std::string tmpPath = logPath(directory) + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        std::string data;
+        encodeHeader(header, data);
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+        out.close();
+        if (!out) {
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, logPath(directory), ec);
+    if (ec) {
+        return false;
+    }
+    file.open(logPath(directory), std::ios::binary | std::ios::app);
+    if (!file) {
+        return false;
+    }
+    dir = directory;
+    buffer.clear();
+    sequence = 0;
+
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        uint64_t epoch = 0;
+        if (!parseSnapshotName(entry.path().filename().string(), epoch) ||
+            epoch == header.epoch || (hasPrevious && epoch == previous.epoch)) {
+            continue;
+        }
+        std::filesystem::remove(entry.path(), ec);
+    }
+    return true;
+}
+
+/**
+ * @brief 停止记录
+ */
+void ReplicationLog::close() {
+    if (file.is_open()) {
+        flush();
+        file.close();
+    }
+    buffer.clear();
+}
+
+/**
+ * @brief 追加一条记录
+ * @param record 变更记录
+ * @return false 非批量模式下写入失败
+ */
+bool ReplicationLog::append(ReplicationRecord record) {
+    record.sequence = ++sequence;
+    encode(record, buffer);
+    return batching || flush();
+}
+
+/**
+ * @brief 把缓冲的记录写入文件
+ * @return true 成功
+ */
+bool ReplicationLog::flush() {
+    // 出错后不再写入：备库按序号重放，跳过一段记录只会让它停在缺口处
+    if (!buffer.empty() && file) {
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        file.flush();
+    }
+    buffer.clear();
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief 设置批量模式
+ * @param enabled true 时记录留在缓冲区，直到 flush
+ * @details 关闭批量模式时立即写出缓冲的记录
+ */
+void ReplicationLog::setBatching(bool enabled) {
+    batching = enabled;
+    if (!batching && file.is_open()) {
+        flush();
+    }
+}
+
+/**
+ * @brief 生成新的纪元
+ * @details 纳秒时间戳的高位加随机低位，同一目录中先后两次开始记录不会重复
+ */
+uint64_t ReplicationLog::newEpoch() {
+    uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    std::random_device random;
+    return (now & ~uint64_t{0xFFFF}) | (random() & 0xFFFF);
+}
+
+/**
+ * @brief 获取日志文件路径
+ */
+std::string ReplicationLog::logPath(const std::string& directory) {
+    return (std::filesystem::path(directory) / "mutations.log").string();
+}
+
+/**
+ * @brief 获取指定纪元的快照路径
+ */
+std::string ReplicationLog::snapshotPath(const std::string& directory, uint64_t epoch) {
+    std::string fileName = SNAPSHOT_PREFIX + std::to_string(epoch) + SNAPSHOT_SUFFIX;
+    return (std::filesystem::path(directory) / fileName).string();
+}
+
+/**
+ * @brief 编码一条记录
+ * @details 负载：序号(u32) 类型(u8) 参数（按类型）
+ */
+void ReplicationLog::encode(const ReplicationRecord& record, std::string& out) {
+    ProtocolWriter writer(out);
+    writer.beginFrame();
+    writer.u32(record.sequence).u8(record.type);
+    switch (record.type) {
+    case ReplicationRecord::ADD_MEMBER:
+        writer.i32(record.id).str(record.name).str(record.phone).str(record.birthday);
+        break;
+    case ReplicationRecord::DELETE_MEMBER:
+        writer.i32(record.id);
+        break;
+    case ReplicationRecord::UPDATE_PHONE:
+        writer.i32(record.id).str(record.phone);
+        break;
+    case ReplicationRecord::ADD_SPENDING:
+        writer.i32(record.id).f64(record.amount).i64(record.time);
+        break;
+    case ReplicationRecord::REDEEM_POINTS:
+        writer.i32(record.id).i32(record.value);
+        break;
+    case ReplicationRecord::SET_POINTS_RULE:
+        writer.i32(record.value);
+        break;
+    case ReplicationRecord::ADD_BONUS:
+        writer.i32(record.id).i32(record.value);
+        break;
+    }
+    writer.endFrame();
+}
+
+/**
+ * @brief 解码一条记录的负载
+ * @return true 格式正确
+ */
+bool ReplicationLog::decode(const char* payload, size_t size, ReplicationRecord& record) {
+    ProtocolReader reader(payload, size);
+    record = ReplicationRecord();
+    record.sequence = reader.u32();
+    uint8_t type = reader.u8();
+    switch (type) {
+    case ReplicationRecord::ADD_MEMBER:
+        record.id = reader.i32();
+        record.name = std::string(reader.str());
+        record.phone = std::string(reader.str());
+        record.birthday = std::string(reader.str());
+        break;
+    case ReplicationRecord::DELETE_MEMBER:
+        record.id = reader.i32();
+        break;
+    case ReplicationRecord::UPDATE_PHONE:
+        record.id = reader.i32();
+        record.phone = std::string(reader.str());
+        break;
+    case ReplicationRecord::ADD_SPENDING:
+        record.id = reader.i32();
+        record.amount = reader.f64();
+        record.time = reader.i64();
+        break;
+    case ReplicationRecord::REDEEM_POINTS:
+        record.id = reader.i32();
+        record.value = reader.i32();
+        break;
+    case ReplicationRecord::SET_POINTS_RULE:
+        record.value = reader.i32();
+        break;
+    case ReplicationRecord::ADD_BONUS:
+        record.id = reader.i32();
+        record.value = reader.i32();
+        break;
+    default:
+        return false;
+    }
+    record.type = static_cast<ReplicationRecord::Type>(type);
+    return reader.atEnd();
+}
+
+/**
+ * @brief 编码文件头
+ * @details 负载：标识(u32) 版本(u32) 纪元(u64) 下一个会员ID(i32) 积分规则(i32)
+ */
+void ReplicationLog::encodeHeader(const Header& header, std::string& out) {
+    ProtocolWriter writer(out);
+    writer.beginFrame();
+    writer.u32(MAGIC).u32(VERSION).u64(header.epoch).i32(header.nextId).i32(header.pointsRule);
+    writer.endFrame();
+}
+
+/**
+ * @brief 解码文件头的负载
+ * @return true 标识、版本正确且恰好读完
+ */
+bool ReplicationLog::decodeHeader(const char* payload, size_t size, Header& header) {
+    ProtocolReader reader(payload, size);
+    uint32_t magic = reader.u32();
+    uint32_t version = reader.u32();
+    header.epoch = reader.u64();
+    header.nextId = reader.i32();
+    header.pointsRule = reader.i32();
+    return reader.atEnd() && magic == MAGIC && version == VERSION;
+}
+
+// ==================== ReplicationFollower ====================
+
+/**
+ * @brief 打开复制目录
+ * @param directory 复制目录
+ * @return true 成功
+ * @details 文件头之后的记录留给 poll 重放
+ */
+bool ReplicationFollower::open(const std::string& directory) {
+    dir = directory;
+    lastError.clear();
+    buffer.clear();
+    sequence = 0;
+    lastEpochCheck = std::chrono::steady_clock::now();
+    if (file.is_open()) {
+        file.close();
+    }
+    file.clear();
+    file.open(ReplicationLog::logPath(directory), std::ios::binary);
+    if (!file) {
+        lastError = "无法打开复制日志 " + ReplicationLog::logPath(directory);
+        return false;
+    }
+    readAvailable();
+    uint32_t size = 0;
+    if (MemberProtocol::peekFrame(buffer.data(), buffer.size(), ReplicationLog::MAX_RECORD_SIZE, size) !=
+            MemberProtocol::FRAME_READY ||
+        !ReplicationLog::decodeHeader(buffer.data() + 4, size, header)) {
+        lastError = "复制日志文件头无效";
+        return false;
+    }
+    buffer.erase(0, 4 + size);
+
+    std::string snapshot = ReplicationLog::snapshotPath(directory, header.epoch);
+    if (manager.loadFromFile(snapshot) != MemberManager::STATUS_OK) {
+        lastError = "无法加载快照 " + snapshot;
+        return false;
+    }
+    manager.restoreReplicationState(header.nextId, header.pointsRule);
+    return true;
+}
+
+/**
+ * @brief 把日志文件中新增的数据读入缓冲区
+ * @return 读到的字节数
+ * @details 读到文件末尾后清除流状态，下次从同一位置继续读取主库追加的数据
+ */
+size_t ReplicationFollower::readAvailable() {
+    size_t before = buffer.size();
+    char chunk[64 * 1024];
+    while (true) {
+        file.read(chunk, sizeof(chunk));
+        std::streamsize count = file.gcount();
+        buffer.append(chunk, static_cast<size_t>(count));
+        if (!file) {
+            break;
+        }
+    }
+    file.clear();
+    return buffer.size() - before;
+}
+
+/**
+ * @brief 重放日志新增的记录
+ * @return 本次重放的记录数
+ */
+size_t ReplicationFollower::poll() {
+    if (failed()) {
+        return 0;
+    }
+    // 没有新数据、缓冲区中也没有完整的记录（open 读入的记录留给这里重放）时才检查纪元
+    uint32_t pendingSize = 0;
+    if (readAvailable() == 0 &&
+        MemberProtocol::peekFrame(buffer.data(), buffer.size(), ReplicationLog::MAX_RECORD_SIZE, pendingSize) ==
+            MemberProtocol::FRAME_INCOMPLETE) {
+        checkNewEpoch();
+        return 0;
+    }
+
+    size_t applied = 0;
+    size_t offset = 0;
+    while (true) {
+        uint32_t size = 0;
+        MemberProtocol::FrameState state = MemberProtocol::peekFrame(
+            buffer.data() + offset, buffer.size() - offset, ReplicationLog::MAX_RECORD_SIZE, size);
+        if (state == MemberProtocol::FRAME_INCOMPLETE) {
+            break;
+        }
+        ReplicationRecord record;
+        if (state == MemberProtocol::FRAME_TOO_LARGE ||
+            !ReplicationLog::decode(buffer.data() + offset + 4, size, record)) {
+            lastError = "复制日志第 " + std::to_string(sequence + 1) + " 条记录已损坏";
+            break;
+        }
+        if (record.sequence != sequence + 1) {
+            lastError = "复制日志序号不连续：期望 " + std::to_string(sequence + 1) +
+                "，实际 " + std::to_string(record.sequence);
+            break;
+        }
+        if (manager.applyReplicationRecord(record) != MemberManager::STATUS_OK) {
+            lastError = "重放第 " + std::to_string(record.sequence) + " 条记录失败，备库与主库已不一致";
+            break;
+        }
+        sequence = record.sequence;
+        offset += 4 + size;
+        ++applied;
+    }
+    buffer.erase(0, offset);
+    return applied;
+}
+
+/**
+ * @brief 检查日志是否已换成新纪元
+ * @return true 已重新加载
+ * @details 每 200 毫秒至多检查一次；新快照已包含旧日志中的全部记录，无需先读完旧日志
+ */
+bool ReplicationFollower::checkNewEpoch() {
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastEpochCheck < std::chrono::milliseconds(200)) {
+        return false;
+    }
+    lastEpochCheck = now;
+    ReplicationLog::Header current;
+    if (!readHeader(ReplicationLog::logPath(dir), current) || current.epoch == header.epoch) {
+        return false;
+    }
+    ++reloadCount;
+    return open(dir);
+}
@@ -0,0 +1,508 @@
+/**
+ * @file SharedMemoryTransport.cpp
+ * @brief 共享内存传输实现文件
+ * @details 实现共享内存中的单生产者单消费者帧环、futex 等待与唤醒、共享内存区的创建与映射，
+ *          以及同机客户端的槽位认领、请求发送和响应读取
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "SharedMemoryTransport.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <thread>
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const uint32_t WRAP_MARKER = 0xFFFFFFFF;  ///< 长度字段取此值表示环尾剩余部分作废，下一帧从头开始
+const int SPIN_ITERATIONS = 2000;         ///< 消费者睡眠前自旋检查的次数
+const int WAIT_SLICE_MS = 100;            ///< 客户端等待响应时每次睡眠的上限
+const int CLAIM_ATTEMPTS = 100;           ///< 认领槽位的尝试次数（每次间隔 1 毫秒）
+
+/**
+ * @brief 按 4 字节向上对齐
+ */
+uint32_t align4(uint32_t size) {
+    return (size + 3) & ~3u;
+}
+
+/**
+ * @brief 按 alignment（2 的幂）向上对齐
+ */
+size_t alignUp(size_t size, size_t alignment) {
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * @brief 自旋等待时提示 CPU 降低功耗、让出流水线
+ */
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * @struct Layout
+ * @brief 共享内存区各部分的偏移
+ */
+struct Layout {
+    size_t slotsOffset;  ///< 槽位控制字段
+    size_t ringsOffset;  ///< 环数据区（按页对齐）
+    size_t totalSize;    ///< 总字节数
+
+    Layout(uint32_t slotCount, uint32_t ringCapacity) {
+        slotsOffset = alignUp(sizeof(SharedMemoryRegion::Header), 64);
+        ringsOffset = alignUp(slotsOffset + slotCount * sizeof(SharedMemoryRegion::Slot), 4096);
+        totalSize = ringsOffset + static_cast<size_t>(slotCount) * 2 * ringCapacity;
+    }
+};
+
+} // namespace
+
+// ==================== SharedRing ====================
+
+/**
+ * @brief 清空
+ */
+void SharedRing::reset() {
+    header->head.store(0, std::memory_order_relaxed);
+    header->tail.store(0, std::memory_order_relaxed);
+    header->waiting.store(0, std::memory_order_relaxed);
+    frontSize = 0;
+    corrupted = false;
+}
+
+/**
+ * @brief 写入一帧
+ * @param frame 完整的帧
+ * @return false 剩余空间不足
+ * @details 帧在环尾放不下时先写回绕标记；容量和每条记录都是 4 字节的倍数，环尾剩余总能放下标记
+ */
+bool SharedRing::push(std::string_view frame) {
+    uint32_t head = header->head.load(std::memory_order_relaxed);
+    uint32_t tail = header->tail.load(std::memory_order_acquire);
+    uint32_t needed = align4(static_cast<uint32_t>(frame.size()));
+    uint32_t position = head & (capacity - 1);
+    uint32_t skip = needed > capacity - position ? capacity - position : 0;
+    if (frame.size() < 4 || frame.size() > capacity || needed + skip > capacity - (head - tail)) {
+        return false;
+    }
+    if (skip > 0) {
+        std::memcpy(data + position, &WRAP_MARKER, sizeof(WRAP_MARKER));
+        head += skip;
+        position = 0;
+    }
+    std::memcpy(data + position, frame.data(), frame.size());
+    header->head.store(head + needed, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief 查看下一帧
+ * @param size 输出：负载字节数
+ * @return 负载起始位置，没有数据或环已损坏时返回空指针
+ */
+const char* SharedRing::front(uint32_t& size) {
+    uint32_t tail = header->tail.load(std::memory_order_relaxed);
+    uint32_t head = header->head.load(std::memory_order_acquire);
+    while (tail != head) {
+        uint32_t position = tail & (capacity - 1);
+        uint32_t length;
+        std::memcpy(&length, data + position, sizeof(length));
+        if (length == WRAP_MARKER) {
+            tail += capacity - position;
+            header->tail.store(tail, std::memory_order_release);
+            continue;
+        }
+        // 长度字段来自另一个进程，越出环尾说明环已损坏，不能据此读取
+        if (length > capacity - position - 4 || length + 4 > head - tail) {
+            corrupted = true;
+            return nullptr;
+        }
+        size = length;
+        frontSize = align4(length + 4);
+        return data + position + 4;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief 释放 front 返回的帧
+ */
+void SharedRing::pop() {
+    uint32_t tail = header->tail.load(std::memory_order_relaxed);
+    header->tail.store(tail + frontSize, std::memory_order_release);
+    frontSize = 0;
+}
+
+/**
+ * @brief 是否没有可读的帧
+ */
+bool SharedRing::empty() const {
+    return header->head.load(std::memory_order_acquire) == header->tail.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief 消费者已登记等待时唤醒它
+ * @details 与 waitForData 中“先登记、再复查 head”配对：两边之间的全序屏障保证
+ *          要么消费者看到新数据不睡，要么生产者看到登记而唤醒
+ */
+void SharedRing::wakeConsumer() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (header->waiting.load(std::memory_order_relaxed)) {
+        futexWake(header->head);
+    }
+}
+
+/**
+ * @brief 等待可读的帧
+ * @param timeoutMs 超时（毫秒）
+ * @return true 有可读的帧
+ */
+bool SharedRing::waitForData(int timeoutMs) {
+    int spins = spinUseful() ? SPIN_ITERATIONS : 0;
+    for (int i = 0; i < spins; ++i) {
+        if (!empty()) {
+            return true;
+        }
+        cpuRelax();
+    }
+    uint32_t tail = header->tail.load(std::memory_order_relaxed);
+    header->waiting.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint32_t head = header->head.load(std::memory_order_relaxed);
+    if (head == tail) {
+        futexWait(header->head, head, timeoutMs);
+    }
+    header->waiting.store(0, std::memory_order_relaxed);
+    return !empty();
+}
+
+/**
+ * @brief 自旋等待对端是否有意义
+ * @details 只有一个 CPU 时对端在自旋期间根本得不到运行，自旋只会推迟它
+ */
+bool SharedRing::spinUseful() {
+    static const bool multiCore = std::thread::hardware_concurrency() > 1;
+    return multiCore;
+}
+
+/**
+ * @brief 在 futex 字上等待
+ * @details 使用跨进程的（非 PRIVATE）futex；被信号打断或值已变化时直接返回，由调用方复查条件
+ */
+void SharedRing::futexWait(std::atomic<uint32_t>& word, uint32_t expected, int timeoutMs) {
+#ifdef __linux__
+    timespec timeout;
+    timeout.tv_sec = timeoutMs / 1000;
+    timeout.tv_nsec = static_cast<long>(timeoutMs % 1000) * 1000000;
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, timeoutMs < 0 ? nullptr : &timeout,
+            nullptr, 0);
+#else
+    (void)word;
+    (void)expected;
+    (void)timeoutMs;
+#endif
+}
+
+/**
+ * @brief 唤醒在 futex 字上等待的全部线程
+ */
+void SharedRing::futexWake(std::atomic<uint32_t>& word) {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
+// ==================== SharedMemoryRegion ====================
+
+SharedMemoryRegion::~SharedMemoryRegion() {
+#ifdef __linux__
+    if (header) {
+        munmap(header, size);
+    }
+    if (!name.empty()) {
+        shm_unlink(name.c_str());
+    }
+#endif
+}
+
+/**
+ * @brief 映射共享内存对象
+ * @param fd 共享内存对象
+ * @param bytes 映射的字节数
+ * @return true 成功
+ */
+bool SharedMemoryRegion::map(int fd, size_t bytes) {
+#ifdef __linux__
+    void* address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+        lastError = std::strerror(errno);
+        return false;
+    }
+    header = static_cast<Header*>(address);
+    size = bytes;
+    return true;
+#else
+    (void)fd;
+    (void)bytes;
+    return false;
+#endif
+}
+
+/**
+ * @brief 创建共享内存区
+ * @param regionName shm_open 名称
+ * @param slotCount 槽位数
+ * @return true 成功
+ * @details ftruncate 得到的内存全为零，环数据区的页在首次使用时才分配
+ */
+bool SharedMemoryRegion::create(const std::string& regionName, uint32_t slotCount) {
+#ifdef __linux__
+    if (regionName.size() < 2 || regionName[0] != '/' || regionName.find('/', 1) != std::string::npos) {
+        lastError = "共享内存名称必须形如 /名称";
+        return false;
+    }
+    Layout layout(slotCount, RING_CAPACITY);
+    shm_unlink(regionName.c_str());
+    int fd = shm_open(regionName.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        lastError = std::strerror(errno);
+        return false;
+    }
+    name = regionName;
+    bool mappedOk = ftruncate(fd, static_cast<off_t>(layout.totalSize)) == 0 && map(fd, layout.totalSize);
+    if (!mappedOk && lastError.empty()) {
+        lastError = std::strerror(errno);
+    }
+    ::close(fd);
+    if (!mappedOk) {
+        return false;
+    }
+
+    new (header) Header();
+    header->version = VERSION;
+    header->slotCount = slotCount;
+    header->ringCapacity = RING_CAPACITY;
+    slots = reinterpret_cast<Slot*>(reinterpret_cast<char*>(header) + layout.slotsOffset);
+    for (uint32_t i = 0; i < slotCount; ++i) {
+        new (&slots[i]) Slot();
+    }
+    rings = reinterpret_cast<char*>(header) + layout.ringsOffset;
+    header->magic.store(MAGIC, std::memory_order_release);
+    return true;
+#else
+    (void)regionName;
+    (void)slotCount;
+    lastError = "当前平台不支持共享内存传输";
+    return false;
+#endif
+}
+
+/**
+ * @brief 映射已存在的共享内存区
+ * @param regionName shm_open 名称
+ * @return true 成功
+ */
+bool SharedMemoryRegion::open(const std::string& regionName) {
+#ifdef __linux__
+    int fd = shm_open(regionName.c_str(), O_RDWR | O_CLOEXEC, 0);
+    if (fd < 0) {
+        lastError = errno == ENOENT ? "服务端未启动共享内存传输" : std::strerror(errno);
+        return false;
+    }
+    struct stat info;
+    bool mappedOk = fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(Header) &&
+                    map(fd, static_cast<size_t>(info.st_size));
+    ::close(fd);
+    if (!mappedOk) {
+        if (lastError.empty()) {
+            lastError = "共享内存区无效";
+        }
+        return false;
+    }
+    uint32_t capacity = header->ringCapacity;
+    if (header->magic.load(std::memory_order_acquire) != MAGIC || header->version != VERSION || capacity < 4 ||
+        (capacity & (capacity - 1)) != 0 || Layout(header->slotCount, capacity).totalSize > size) {
+        lastError = "共享内存区版本不符或已损坏";
+        return false;
+    }
+    Layout layout(header->slotCount, capacity);
+    slots = reinterpret_cast<Slot*>(reinterpret_cast<char*>(header) + layout.slotsOffset);
+    rings = reinterpret_cast<char*>(header) + layout.ringsOffset;
+    return true;
+#else
+    (void)regionName;
+    lastError = "当前平台不支持共享内存传输";
+    return false;
+#endif
+}
+
+/**
+ * @brief 通知客户端服务端已退出
+ */
+void SharedMemoryRegion::close() {
+    if (!header) {
+        return;
+    }
+    header->serverClosed.store(1, std::memory_order_release);
+    for (uint32_t i = 0; i < header->slotCount; ++i) {
+        SharedRing::futexWake(slots[i].responses.head);
+    }
+}
+
+SharedRing SharedMemoryRegion::requestRing(uint32_t index) const {
+    return SharedRing(&slots[index].requests, rings + static_cast<size_t>(index) * 2 * header->ringCapacity,
+                      header->ringCapacity);
+}
+
+SharedRing SharedMemoryRegion::responseRing(uint32_t index) const {
+    return SharedRing(&slots[index].responses, rings + (static_cast<size_t>(index) * 2 + 1) * header->ringCapacity,
+                      header->ringCapacity);
+}
+
+/**
+ * @brief 服务端在等待时按门铃
+ * @details 与服务端“先登记等待、再检查各请求环”配对，服务端忙时不产生系统调用
+ */
+void SharedMemoryRegion::ringDoorbell() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (header->serverWaiting.load(std::memory_order_relaxed)) {
+        header->doorbell.fetch_add(1, std::memory_order_release);
+        SharedRing::futexWake(header->doorbell);
+    }
+}
+
+// ==================== SharedMemoryClient ====================
+
+SharedMemoryClient::~SharedMemoryClient() {
+    if (slotIndex >= 0) {
+        region.slot(static_cast<uint32_t>(slotIndex)).state.store(SharedMemoryRegion::SLOT_CLOSING,
+                                                                   std::memory_order_release);
+        region.ringDoorbell();
+    }
+}
+
+/**
+ * @brief 映射共享内存区并认领一个空闲槽位
+ * @param name shm_open 名称
+ * @return true 成功
+ * @details 认领后先清空两个环再标记为使用中，服务端只处理使用中的槽位。
+ *          没有空闲槽位但有等待回收的槽位时，稍等服务端回收后重试
+ */
+bool SharedMemoryClient::connect(const std::string& name) {
+#ifdef __linux__
+    if (!region.open(name)) {
+        lastError = region.error();
+        return false;
+    }
+    for (int attempt = 0; attempt < CLAIM_ATTEMPTS; ++attempt) {
+        bool closing = false;
+        for (uint32_t i = 0; i < region.slotCount(); ++i) {
+            SharedMemoryRegion::Slot& slot = region.slot(i);
+            uint32_t expected = SharedMemoryRegion::SLOT_FREE;
+            if (!slot.state.compare_exchange_strong(expected, SharedMemoryRegion::SLOT_CLAIMING,
+                                                    std::memory_order_acquire)) {
+                closing = closing || expected == SharedMemoryRegion::SLOT_CLOSING;
+                continue;
+            }
+            slot.ownerPid.store(static_cast<int32_t>(getpid()), std::memory_order_relaxed);
+            requests = region.requestRing(i);
+            responses = region.responseRing(i);
+            requests.reset();
+            responses.reset();
+            slot.responsesFull.store(0, std::memory_order_relaxed);
+            slot.state.store(SharedMemoryRegion::SLOT_ACTIVE, std::memory_order_release);
+            slotIndex = static_cast<int>(i);
+            region.ringDoorbell();
+            return true;
+        }
+        // 刚退出的客户端留下的槽位由服务端异步回收，稍等再试
+        if (!closing) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    lastError = "没有空闲的客户端槽位";
+    return false;
+#else
+    (void)name;
+    lastError = "当前平台不支持共享内存传输";
+    return false;
+#endif
+}
+
+/**
+ * @brief 发送一个请求帧
+ * @param frame 完整的请求帧
+ * @return false 请求环已满或服务端已退出
+ */
+bool SharedMemoryClient::send(std::string_view frame) {
+    if (slotIndex < 0 || region.control().serverClosed.load(std::memory_order_acquire) || !requests.push(frame)) {
+        return false;
+    }
+    region.ringDoorbell();
+    return true;
+}
+
+/**
+ * @brief 等待下一个响应
+ * @param size 输出：负载字节数
+ * @param timeoutMs 超时（毫秒）
+ * @return 负载起始位置，超时或服务端已退出时返回空指针
+ */
+const char* SharedMemoryClient::receive(uint32_t& size, int timeoutMs) {
+    if (slotIndex < 0) {
+        return nullptr;
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (true) {
+        if (const char* payload = responses.front(size)) {
+            return payload;
+        }
+        if (region.control().serverClosed.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        int slice = WAIT_SLICE_MS;
+        if (timeoutMs >= 0) {
+            auto remaining =
+                std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0 && responses.empty()) {
+                return nullptr;
+            }
+            slice = std::min<int>(slice, static_cast<int>(std::max<long long>(remaining.count(), 0)));
+        }
+        responses.waitForData(slice);
+    }
+}
+
+/**
+ * @brief 释放 receive 返回的响应
+ */
+void SharedMemoryClient::release() {
+    responses.pop();
+    // 与服务端“先标记已满、再重试写入”配对，两边至少有一边看到对方的更新
+    SharedMemoryRegion::Slot& slot = region.slot(static_cast<uint32_t>(slotIndex));
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (slot.responsesFull.load(std::memory_order_relaxed)) {
+        slot.responsesFull.store(0, std::memory_order_relaxed);
+        region.ringDoorbell();
+    }
+}
@@ -9,9 +9,151 @@
 
 #include "System.h"
 #include "Utils.h"
+#include "LevelPredictor.h"
+#include "MemberFilter.h"
+#include "LatencyStats.h"
+#include "TraceRecorder.h"
+#include "MemberServer.h"
+#include <csignal>
 #include <iostream>
 #include <limits>
 #include <iomanip>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <thread>
+
+namespace {
+
+MemberServer* activeServer = nullptr;  ///< 服务模式下正在运行的服务端，供信号处理函数使用
+volatile std::sig_atomic_t standbyRequest = 0;  ///< 备库收到的请求：0 无，1 提升，2 停止
+
+/**
+ * @brief SIGINT / SIGTERM 处理函数：请求服务端停止
+ */
+void stopActiveServer(int) {
+    if (activeServer) {
+        activeServer->stop();
+    }
+}
+
+/**
+ * @brief 备库的 SIGUSR1 处理函数：请求提升为主库
+ */
+void promoteStandby(int) {
+    standbyRequest = 1;
+}
+
+/**
+ * @brief 备库的 SIGINT / SIGTERM 处理函数：请求停止
+ */
+void stopStandby(int) {
+    standbyRequest = 2;
+}
+
+} // namespace
+
+/**
+ * @brief 以服务模式运行
+ * @param options 服务参数
+ * @return 进程退出码
+ */
+int System::serve(const ServeOptions& options) {
+    const std::string& dataFile = options.dataFile;
+    if (!options.standbyDir.empty()) {
+        StandbyResult result = followPrimary(options.standbyDir);
+        if (result != STANDBY_PROMOTED) {
+            return result == STANDBY_STOPPED ? 0 : 1;
+        }
+    } else if (!dataFile.empty() && manager.loadFromFile(dataFile) != MemberManager::STATUS_OK) {
+        presenter.serverFailed("无法加载数据文件 " + dataFile);
+        return 1;
+    }
+    if (!options.replicateDir.empty() && manager.enableReplication(options.replicateDir) != MemberManager::STATUS_OK) {
+        presenter.serverFailed("无法写入复制目录 " + options.replicateDir);
+        return 1;
+    }
+
+    const std::string& socketPath = options.socketPath;
+    const std::string& shmName = options.shmName;
+    MemberServer server(manager);
+    if ((!socketPath.empty() && !server.listen(socketPath)) ||
+        (!shmName.empty() && !server.listenSharedMemory(shmName))) {
+        presenter.serverFailed(server.error());
+        return 1;
+    }
+    if (!dataFile.empty()) {
+        server.setAutosave(dataFile, options.saveInterval);
+    }
+
+    activeServer = &server;
+    void (*previousInt)(int) = std::signal(SIGINT, stopActiveServer);
+    void (*previousTerm)(int) = std::signal(SIGTERM, stopActiveServer);
+    presenter.serverStarted(socketPath, shmName, manager.getMemberList().size());
+    server.run();
+    std::signal(SIGINT, previousInt);
+    std::signal(SIGTERM, previousTerm);
+    activeServer = nullptr;
+    bool failed = !server.error().empty();
+    if (failed) {
+        presenter.serverAborted(server.error());
+    }
+
+    // 自动保存之后的修改在退出时写回
+    bool saved = true;
+    if (!dataFile.empty() && server.modified()) {
+        saved = manager.saveToFile(dataFile) == MemberManager::STATUS_OK;
+    }
+    presenter.serverStopped(server.stats(), dataFile, saved);
+    return saved && !failed ? 0 : 1;
+}
+
+/**
+ * @brief 作为备库跟随主库的复制目录
+ * @param directory 复制目录
+ * @return 结束的原因
+ * @details 提升时先重放完日志中已有的记录，内存中的会员即为主库最后写入日志时的状态
+ */
+System::StandbyResult System::followPrimary(const std::string& directory) {
+    ReplicationFollower follower(manager);
+    if (!follower.open(directory)) {
+        presenter.serverFailed(follower.error());
+        return STANDBY_FAILED;
+    }
+    presenter.standbyStarted(directory, manager.getMemberList().size());
+
+    standbyRequest = 0;
+#ifdef SIGUSR1
+    void (*previousUsr1)(int) = std::signal(SIGUSR1, promoteStandby);
+#endif
+    void (*previousInt)(int) = std::signal(SIGINT, stopStandby);
+    void (*previousTerm)(int) = std::signal(SIGTERM, stopStandby);
+    while (standbyRequest == 0 && !follower.failed()) {
+        if (follower.poll() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    // 提升前把主库已写入日志的记录全部重放
+    while (standbyRequest == 1 && follower.poll() > 0) {
+    }
+#ifdef SIGUSR1
+    std::signal(SIGUSR1, previousUsr1);
+#endif
+    std::signal(SIGINT, previousInt);
+    std::signal(SIGTERM, previousTerm);
+
+    if (follower.failed()) {
+        presenter.serverFailed(follower.error());
+        return STANDBY_FAILED;
+    }
+    if (standbyRequest == 2) {
+        presenter.standbyStopped(follower.lastSequence(), follower.reloads());
+        return STANDBY_STOPPED;
+    }
+    presenter.standbyPromoted(follower.lastSequence(), manager.getMemberList().size());
+    return STANDBY_PROMOTED;
+}
 
 /**
  * @brief 系统主运行函数
@@ -23,6 +165,11 @@ void System::run() {
     std::cout << "║                    欢迎使用会员管理系统                          ║" << std::endl;
     std::cout << "║                        Member Management System                  ║" << std::endl;
     std::cout << "╚══════════════════════════════════════════════════════════════════╝" << std::endl;
+
+    // 已结束年度的消费记录归档到 history 目录，查看消费明细时按需读取
+    if (manager.enableHistoryArchive("history") != MemberManager::STATUS_OK) {
+        std::cout << "警告：无法打开消费历史归档目录 history，往年消费记录将保留在内存中。" << std::endl;
+    }
     
     while (true) {
         showMainMenu();
@@ -56,6 +203,18 @@ void System::showMainMenu() const {
     std::cout << "│  [4] 系统设置查询  - 积分规则设置、数据保存加载                  │" << std::endl;
     std::cout << "│  [0] 退出系统      - 安全退出会员管理系统                        │" << std::endl;
     std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
+
+    // 概览数据来自物化统计，无需扫描会员
+    const MemberManager::LevelStats& stats = manager.getLevelStats();
+    std::cout << " 会员 " << stats.totalMembers() << " 人（普通 " << stats.memberCount[Member::NORMAL]
+              << " / 白银 " << stats.memberCount[Member::SILVER]
+              << " / 黄金 " << stats.memberCount[Member::GOLD]
+              << " / 钻石 " << stats.memberCount[Member::DIAMOND]
+              << "） 积分余额 " << stats.totalPoints()
+              << " 本年消费 " << std::fixed << std::setprecision(2) << stats.totalAnnualRevenue() << "元" << std::endl;
+    if (manager.getColdMemberCount() > 0) {
+        std::cout << " （以上仅统计内存中会员，另有 " << manager.getColdMemberCount() << " 位休眠会员在磁盘上）" << std::endl;
+    }
     std::cout << "请输入选项 [0-4]: ";
 }
 
@@ -77,6 +236,7 @@ void System::handleMemberInfo() {
         case 3: handleFindMember(); break;    // 查询会员
         case 4: handleUpdatePhone(); break;   // 修改会员信息
         case 5: handleDeleteMember(); break;  // 删除会员
+        case 6: handleFindByName(); break;    // 按姓名搜索会员
         default: std::cout << "无效选项！请重新选择。" << std::endl;
         }
     }
@@ -96,9 +256,10 @@ void System::showMemberInfoMenu() const {
     std::cout << "│  [3] 根据电话查询    - 通过电话号码查找会员                      │" << std::endl;
     std::cout << "│  [4] 修改会员信息    - 更新会员电话号码等基本信息                │" << std::endl;
     std::cout << "│  [5] 删除会员        - 删除指定会员（需确认）                    │" << std::endl;
+    std::cout << "│  [6] 按姓名搜索      - 输入姓名中的一个或几个字查找会员          │" << std::endl;
     std::cout << "│  [0] 返回主菜单      - 返回系统主菜单                            │" << std::endl;
     std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
-    std::cout << "请输入选项 [0-5]: ";
+    std::cout << "请输入选项 [0-6]: ";
 }
 
 /**
@@ -117,6 +278,7 @@ void System::handlePoints() {
         case 1: handleAddSpending(); break;      // 添加消费并计算积分
         case 2: handleRedeemPoints(); break;     // 积分兑换
         case 3: handleShowPointsHistory(); break; // 查看积分历史
+        case 4: handleBirthdayBonus(); break;    // 生日积分奖励
         default: std::cout << "无效选项！请重新选择。" << std::endl;
         }
     }
@@ -134,9 +296,10 @@ void System::showPointsMenu() const {
     std::cout << "│  [1] 添加消费记录    - 记录消费并自动计算积分                    │" << std::endl;
     std::cout << "│  [2] 积分兑换        - 使用积分兑换商品或服务                    │" << std::endl;
     std::cout << "│  [3] 查看积分历史    - 显示会员积分变化记录                      │" << std::endl;
+    std::cout << "│  [4] 生日积分奖励    - 为近期过生日的会员发放奖励积分            │" << std::endl;
     std::cout << "│  [0] 返回主菜单      - 返回系统主菜单                            │" << std::endl;
     std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
-    std::cout << "请输入选项 [0-3]: ";
+    std::cout << "请输入选项 [0-4]: ";
 }
 
 /**
@@ -203,6 +366,30 @@ void System::handleSystemSettings() {
             case 4:
                 handleLevelPrediction();
                 break;
+            case 5:
+                handleBatchLevelPrediction();
+                break;
+            case 6:
+                handleLeaderboard();
+                break;
+            case 7:
+                handleFilterMembers();
+                break;
+            case 8:
+                handleSpendingTrend();
+                break;
+            case 9:
+                handleEvictDormant();
+                break;
+            case 10:
+                handlePerfStats();
+                break;
+            case 11:
+                handleExportTrace();
+                break;
+            case 12:
+                handleMemoryReport();
+                break;
             case 0:
                 return;
             default:
@@ -226,9 +413,17 @@ void System::showSystemMenu() const {
     std::cout << "│  [2] 保存数据到文件                                              │" << std::endl;
     std::cout << "│  [3] 从文件加载数据                                              │" << std::endl;
     std::cout << "│  [4] 会员等级预测器                                              │" << std::endl;
+    std::cout << "│  [5] 全体会员批量等级预测                                        │" << std::endl;
+    std::cout << "│  [6] 会员消费排行榜                                              │" << std::endl;
+    std::cout << "│  [7] 条件筛选会员                                                │" << std::endl;
+    std::cout << "│  [8] 消费趋势报表                                                │" << std::endl;
+    std::cout << "│  [9] 休眠会员转存                                                │" << std::endl;
+    std::cout << "│  [10] 性能统计                                                   │" << std::endl;
+    std::cout << "│  [11] 导出时间线                                                 │" << std::endl;
+    std::cout << "│  [12] 内存占用报告                                               │" << std::endl;
     std::cout << "│  [0] 返回主菜单                                                  │" << std::endl;
     std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
-    std::cout << "请输入选项 [0-4]: ";
+    std::cout << "请输入选项 [0-12]: ";
 }
 
 // ==================== 会员信息管理功能实现 ====================
@@ -274,7 +469,9 @@ void System::handleAddMember() {
     }
     
     std::cout << "\n";
-    manager.addMember(name, phone, birthday);
+    int id = manager.addMember(name, phone, birthday);
+    bool logged = !manager.getReplicationLog().failed();
+    presenter.memberAdded(logged ? MemberManager::STATUS_OK : MemberManager::STATUS_IO_ERROR, name, id);
 }
 
 /**
@@ -283,12 +480,57 @@ void System::handleAddMember() {
  */
 void System::handleListMembers() {
     std::cout << "\n";
-    manager.listAllMembers();
+    int format = Utils::getIntInput("请选择显示格式（1=表格, 2=CSV, 3=JSON Lines）: ", 1, 3);
+    int sort = Utils::getIntInput("请选择排序方式（1=会员ID, 2=姓名拼音, 3=本年消费, 4=等级+本年消费）: ", 1, 4);
+    std::vector<size_t> order;
+    manager.sortMembers(static_cast<MemberManager::SortOrder>(sort - 1), order);
+
+    if (format != 1) {
+        // 机读格式：输出到文件或屏幕，一次输出全部
+        std::cout << "请输入导出文件名（直接回车输出到屏幕）: ";
+        std::string filename;
+        getline(std::cin, filename);
+        auto outputFormat = (format == 2) ? OutputRenderer::FORMAT_CSV : OutputRenderer::FORMAT_JSONL;
+        OutputRenderer::Cursor cursor;
+        if (filename.empty()) {
+            OutputRenderer renderer(std::cout, outputFormat);
+            Presenter::memberList(manager, renderer, cursor, &order);
+            return;
+        }
+        std::ofstream file(filename, std::ios::binary);
+        if (!file) {
+            Utils::showError("无法打开文件: " + filename);
+            return;
+        }
+        {
+            OutputRenderer renderer(file, outputFormat, 1 << 20);
+            Presenter::memberList(manager, renderer, cursor, &order);
+        }
+        Utils::showSuccess("会员列表已导出到文件: " + filename);
+        return;
+    }
+
+    int pageSize = Utils::getIntInput("请输入每页显示人数（0=全部）: ", 0, 100000);
+    OutputRenderer renderer(std::cout);
+    OutputRenderer::Cursor cursor;
+    cursor.pageSize = pageSize;
+    while (true) {
+        Presenter::memberList(manager, renderer, cursor, &order);
+        renderer.flush();
+        if (cursor.done) {
+            break;
+        }
+        std::string command = Utils::getStringInput("n=下一页, q=退出: ", 10);
+        if (command == "q" || command == "Q") {
+            break;
+        }
+    }
 }
 
 /**
  * @brief 处理根据电话查询会员操作
- * @details 根据用户输入的电话号码查找并显示会员信息
+ * @details 支持完整号码、号码前缀（如 138*）和后四位（如 *1234）三种查询方式，
+ *          前缀和后四位查询列出候选会员，只有一个候选时直接显示会员信息
  */
 void System::handleFindMember() {
     std::cout << "\n";
@@ -296,17 +538,50 @@ void System::handleFindMember() {
     std::cout << "│                          查询会员                                │" << std::endl;
     std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
     
+    const size_t CANDIDATE_LIMIT = 20;  // 候选列表最多显示的人数
     std::string phone;
     while (true) {
-        phone = Utils::getStringInput("请输入要查询的电话号码: ", 15);
-        if (Utils::isValidPhoneNumber(phone)) {
+        phone = Utils::getStringInput("请输入电话号码（完整号码、前缀如 138*、后四位如 *1234）: ", 16);
+        bool digitsOnly = phone.size() > 1 && PhoneIndex::indexable(phone.substr(phone[0] == '*' ? 1 : 0, phone.size() - 1));
+        if (Utils::isValidPhoneNumber(phone) ||
+            (phone.size() == 5 && phone[0] == '*' && digitsOnly) ||
+            (phone.back() == '*' && phone[0] != '*' && digitsOnly)) {
             break;
         }
-        Utils::showError("电话号码格式无效！请输入7-8位座机号或11位手机号（仅数字）。");
+        Utils::showError("电话号码格式无效！请输入完整号码、号码前缀加 * 或 * 加后四位。");
     }
     
     std::cout << "\n";
-    manager.findMemberByPhone(phone);
+    if (phone[0] == '*') {
+        const std::vector<int>& ids = manager.findMembersByPhoneSuffix(phone.substr(1));
+        std::vector<int> shown(ids.begin(), ids.begin() + std::min(ids.size(), CANDIDATE_LIMIT));
+        presenter.memberCandidates(manager, shown, ids.size(), "未找到该电话的会员！");
+    } else if (phone.back() == '*') {
+        std::vector<int> ids;
+        size_t total = manager.findMembersByPhonePrefix(phone.substr(0, phone.size() - 1), CANDIDATE_LIMIT, ids);
+        presenter.memberCandidates(manager, ids, total, "未找到该电话的会员！");
+    } else {
+        presenter.memberCard(manager.getMemberByPhone(phone));
+    }
+}
+
+/**
+ * @brief 处理按姓名搜索会员操作
+ * @details 输入姓名中的一个或几个连续的字，列出姓名包含这些字的会员，按本年度消费从高到低排列
+ */
+void System::handleFindByName() {
+    std::cout << "\n";
+    std::cout << "┌──────────────────────────────────────────────────────────────────┐" << std::endl;
+    std::cout << "│                        按姓名搜索会员                            │" << std::endl;
+    std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
+
+    const size_t CANDIDATE_LIMIT = 20;  // 候选列表最多显示的人数
+    std::string query = Utils::getStringInput("请输入姓名或姓名中的部分字: ", 30);
+
+    std::cout << "\n";
+    std::vector<int> ids;
+    size_t total = manager.findMembersByName(query, CANDIDATE_LIMIT, ids);
+    presenter.memberCandidates(manager, ids, total, "未找到姓名包含该内容的会员！");
 }
 
 /**
@@ -331,7 +606,7 @@ void System::handleUpdatePhone() {
     }
     
     std::cout << "\n";
-    manager.updateMemberPhone(id, newPhone);
+    presenter.phoneUpdated(manager.updateMemberPhone(id, newPhone), id, newPhone);
 }
 
 /**
@@ -352,7 +627,9 @@ void System::handleDeleteMember() {
     
     std::cout << "\n";
     if (confirm == "y" || confirm == "Y") {
-        manager.deleteMember(id);
+        const Member* member = manager.getMemberById(id);
+        std::string name = member ? member->getName() : "";
+        presenter.memberDeleted(manager.deleteMember(id), name, id);
     } else {
         Utils::showSuccess("删除操作已取消。");
     }
@@ -383,14 +660,7 @@ void System::handleAddSpending() {
                 return;
             }
             // 验证ID是否存在
-            bool found = false;
-            for (const auto& member : manager.getMembers()) {
-                if (member.getId() == id) {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) {
+            if (!manager.getMemberById(id)) {
                 Utils::showError("未找到该ID的会员！");
                 return;
             }
@@ -417,7 +687,7 @@ void System::handleAddSpending() {
     double amount = Utils::getDoubleInput("请输入消费金额: ", 0.01, 1000000.0);
     
     std::cout << "\n";
-    manager.addSpending(id, amount);
+    presenter.spendingAdded(manager.addSpending(id, amount));
 }
 
 /**
@@ -434,7 +704,7 @@ void System::handleRedeemPoints() {
     int points = Utils::getIntInput("请输入要兑换的积分数量: ", 1, 1000000);
     
     std::cout << "\n";
-    manager.redeemPoints(id, points);
+    presenter.pointsRedeemed(manager.redeemPoints(id, points));
 }
 
 /**
@@ -451,7 +721,33 @@ void System::handleShowPointsHistory() {
     int n = Utils::getIntInput("请输入要查看的最近消费记录数量: ", 1, 1000);
     
     std::cout << "\n";
-    manager.showMemberSpendingHistory(id, n);
+    presenter.spendingHistory(manager, manager.getMemberById(id), n);
+}
+
+/**
+ * @brief 处理生日积分奖励操作
+ * @details 以今天为起点，为之后若干天（含今天）内过生日的会员各发放一笔奖励积分
+ */
+void System::handleBirthdayBonus() {
+    std::cout << "\n";
+    std::cout << "┌──────────────────────────────────────────────────────────────────┐" << std::endl;
+    std::cout << "│                        生日积分奖励                              │" << std::endl;
+    std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
+
+    int days = Utils::getIntInput("请输入天数（从今天起，含今天）: ", 1, 31);
+    int bonus = Utils::getIntInput("请输入每位会员奖励的积分: ", 1, 100000);
+
+    time_t now = time(0);
+    tm timeInfo;
+#ifdef _WIN32
+    localtime_s(&timeInfo, &now);
+#else
+    localtime_r(&now, &timeInfo);
+#endif
+    int today = BirthdayIndex::dayKey(timeInfo.tm_mon + 1, timeInfo.tm_mday);
+
+    std::cout << "\n";
+    presenter.birthdayBonusGranted(manager.grantBirthdayBonus(today, BirthdayIndex::addDays(today, days - 1), bonus));
 }
 
 // ==================== 消费记录管理功能实现 ====================
@@ -469,7 +765,7 @@ void System::handleShowConsumption() {
     int id = Utils::getIntInput("请输入会员ID: ", 1, 999999);
     
     std::cout << "\n";
-    manager.showMemberSpendingHistory(id, -1); // -1表示显示全部记录
+    presenter.spendingHistory(manager, manager.getMemberById(id), -1); // -1表示显示全部记录
 }
 
 /**
@@ -513,7 +809,7 @@ void System::handleRecentConsumption() {
     int n = Utils::getIntInput("请输入要查看的最近消费记录数量: ", 1, 1000);
     
     std::cout << "\n";
-    manager.showMemberSpendingHistory(id, n);
+    presenter.spendingHistory(manager, manager.getMemberById(id), n);
 }
 
 // ==================== 系统设置与查询功能实现 ====================
@@ -531,7 +827,7 @@ void System::handleSetPointsRule() {
     int rule = Utils::getIntInput("请输入新的积分规则（1元 = ?积分）: ", 1, 100);
     
     std::cout << "\n";
-    manager.setPointsRule(rule);
+    presenter.pointsRuleChanged(manager.setPointsRule(rule), rule);
 }
 
 /**
@@ -551,9 +847,18 @@ void System::handleSaveData() {
     if (filename.empty()) {
         filename = "members.dat";
     }
+
+    // 选择文件编码，便于与其他平台共用数据文件
+    int encodingChoice = Utils::getIntInput("请选择文件编码（0=本机默认, 1=UTF-8, 2=GBK）: ", 0, 2);
+    TextEncoding::Encoding encoding = TextEncoding::nativeEncoding();
+    if (encodingChoice == 1) {
+        encoding = TextEncoding::ENCODING_UTF8;
+    } else if (encodingChoice == 2) {
+        encoding = TextEncoding::ENCODING_GBK;
+    }
     
     std::cout << "\n";
-    manager.saveToFile(filename);
+    presenter.dataSaved(manager.saveToFile(filename, encoding), filename);
 }
 
 /**
@@ -575,7 +880,105 @@ void System::handleLoadData() {
     }
     
     std::cout << "\n";
-    manager.loadFromFile(filename);
+    presenter.dataLoaded(manager.loadFromFile(filename), filename);
+}
+
+/**
+ * @brief 处理休眠会员转存操作
+ * @details 最近一次消费距今达到指定年数的会员转存到 members.cold 段文件
+ */
+void System::handleEvictDormant() {
+    std::cout << "\n";
+    std::cout << "┌──────────────────────────────────────────────────────────────────┐" << std::endl;
+    std::cout << "│                        休眠会员转存                              │" << std::endl;
+    std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
+
+    int years = Utils::getIntInput("请输入休眠年限（最近一次消费距今达到该年数）: ", 1, 100);
+
+    std::cout << "\n";
+    MemberManager::Status status = manager.enableTiering("members.cold", years);
+    size_t evicted = (status == MemberManager::STATUS_OK) ? manager.evictDormant() : 0;
+    presenter.dormantEvicted(status, evicted, manager.getColdMemberCount());
+}
+
+/**
+ * @brief 处理性能统计操作
+ * @details 显示各操作的耗时分位数，可导出为 Prometheus 文本格式供监控系统采集
+ */
+void System::handlePerfStats() {
+    std::cout << "\n";
+    std::cout << "┌──────────────────────────────────────────────────────────────────┐" << std::endl;
+    std::cout << "│                          性能统计                                │" << std::endl;
+    std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
+
+    if (!PerfStats::enabled()) {
+        std::cout << "本程序编译时未启用性能统计（CMake 选项 MEMBER_PERF_STATS=OFF）。" << std::endl;
+        return;
+    }
+    presenter.perfStats();
+
+    // 硬件计数器用于调优，默认关闭
+    std::cout << "\n";
+    presenter.hardwareCounting(PerfStats::hardwareCounting());
+    std::cout << (PerfStats::hardwareCounting() ? "关闭" : "开启") << "硬件计数器请输入 y（直接回车跳过）: ";
+    std::string answer;
+    getline(std::cin, answer);
+    if (answer == "y" || answer == "Y") {
+        if (PerfStats::setHardwareCounting(!PerfStats::hardwareCounting())) {
+            presenter.hardwareCounting(PerfStats::hardwareCounting());
+        } else {
+            presenter.hardwareCountersUnavailable(PerfStats::hardwareUnavailableReason());
+        }
+    }
+
+    std::cout << "\n导出为 Prometheus 文本格式的文件名（直接回车跳过）: ";
+    std::string filename;
+    getline(std::cin, filename);
+    if (filename.empty()) {
+        return;
+    }
+    std::ofstream file(filename);
+    PerfStats::writePrometheus(file);
+    file.close();
+    presenter.perfStatsExported(static_cast<bool>(file), filename);
+}
+
+/**
+ * @brief 处理导出时间线操作
+ * @details 把加载、保存、排序等批量任务最近记录的各阶段导出为 Chrome trace_event JSON
+ */
+void System::handleExportTrace() {
+    std::cout << "\n";
+    std::cout << "┌──────────────────────────────────────────────────────────────────┐" << std::endl;
+    std::cout << "│                         导出时间线                               │" << std::endl;
+    std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
+
+    if (!TraceRecorder::enabled()) {
+        std::cout << "本程序编译时未启用时间线记录（CMake 选项 MEMBER_TRACE=OFF）。" << std::endl;
+        return;
+    }
+    std::cout << "请输入导出文件名（默认为member_trace.json）: ";
+    std::string filename;
+    getline(std::cin, filename);
+    if (filename.empty()) {
+        filename = "member_trace.json";
+    }
+    std::ofstream file(filename);
+    size_t events = TraceRecorder::writeChromeTrace(file);
+    file.close();
+    presenter.traceExported(static_cast<bool>(file), events, filename);
+}
+
+/**
+ * @brief 处理内存占用报告操作
+ * @details 按子系统显示会员数据和各索引占用的内存
+ */
+void System::handleMemoryReport() {
+    std::cout << "\n";
+    std::cout << "┌──────────────────────────────────────────────────────────────────┐" << std::endl;
+    std::cout << "│                        内存占用报告                              │" << std::endl;
+    std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
+    presenter.memoryReport(manager.getMemoryReport());
 }
 
 /**
@@ -692,8 +1095,34 @@ void System::handleLevelPrediction() {
     }
     int remainingMonths = 12 - currentMonth;
 
-    // 计算月均消费
+    // 计算月均消费：消费汇总覆盖本年全部消费时，用近几个月的指数加权平均反映趋势，
+    // 否则（如数据从文件加载、汇总不完整）按年度消费平均到已过月份
+    int32_t today, thisMonth;
+    rollupKeys(now, today, thisMonth);
+    int32_t january = thisMonth - (currentMonth - 1);
+    const MemberSpendingRollup& rollup = foundMember->getSpendingRollup();
+    double rollupSpent = 0.0;
+    for (int32_t month = january; month <= thisMonth; ++month) {
+        rollupSpent += rollup.monthTotal(month);
+    }
+    bool useRollup = !rollup.empty() && currentSpent > 0
+                  && std::fabs(rollupSpent - currentSpent) <= 0.01 + currentSpent * 1e-4;
+
     double monthlyAverage = (currentMonth > 0) ? (currentSpent / currentMonth) : 0.0;
+    double monthlySlope = 0.0;
+    if (useRollup) {
+        // 当月尚未结束：按已过天数折算当月消费，作为加权平均的最后一期；回归只用完整月份
+        int year = ltm.tm_year + 1900;
+        int daysInMonth[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        if ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0) {
+            daysInMonth[1] = 29;
+        }
+        double currentPace = rollup.monthTotal(thisMonth) * daysInMonth[currentMonth - 1] / ltm.tm_mday;
+        monthlyAverage = (currentMonth > 1)
+            ? 0.5 * currentPace + 0.5 * rollup.ewma(january, thisMonth - 1, 0.5)
+            : currentPace;
+        monthlySlope = rollup.slope(january, thisMonth - 1);
+    }
     double predictedSpent = currentSpent + (monthlyAverage * remainingMonths);
 
     // 显示当前状态
@@ -701,7 +1130,8 @@ void System::handleLevelPrediction() {
     std::cout << "┌──────────────────────────────────────────────────────────────────┐" << std::endl;
     std::cout << "│ 当前消费额：" << std::fixed << std::setprecision(2) << currentSpent << "元" << std::endl;
     std::cout << "│ 当前等级：" << levelStr << std::endl;
-    std::cout << "│ 月均消费：" << std::fixed << std::setprecision(2) << monthlyAverage << "元" << std::endl;
+    std::cout << "│ 月均消费：" << std::fixed << std::setprecision(2) << monthlyAverage << "元"
+              << (useRollup ? "（近月加权）" : "") << std::endl;
     std::cout << "│ 剩余月份：" << remainingMonths << "个月" << std::endl;
     std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
 
@@ -786,5 +1216,270 @@ void System::handleLevelPrediction() {
     else {
         std::cout << "│ 建议适当增加消费频率，以获得更多会员权益" << std::endl;
     }
+    if (useRollup && currentMonth > 2) {
+        std::cout << "│ 近月消费趋势：" << (monthlySlope > 50 ? "上升" : monthlySlope < -50 ? "下降" : "平稳")
+                  << "（" << std::fixed << std::setprecision(2) << monthlySlope << "元/月）" << std::endl;
+    }
+    std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
+}
+
+/**
+ * @brief 处理全体会员批量等级预测操作
+ * @details 对所有会员并行执行年末等级预测，按预测等级和升级差额分桶汇总，
+ *          并将逐会员预测结果输出为CSV或二进制文件
+ */
+void System::handleBatchLevelPrediction() {
+    std::cout << "\n";
+    std::cout << "┌──────────────────────────────────────────────────────────────────┐" << std::endl;
+    std::cout << "│                      全体会员批量等级预测                        │" << std::endl;
+    std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
+
+    int format = Utils::getIntInput("请选择输出格式（1=CSV, 2=二进制）: ", 1, 2);
+    std::string defaultName = (format == 1) ? "predictions.csv" : "predictions.bin";
+    std::cout << "请输入输出文件名（默认为" << defaultName << "）: ";
+    std::string filename;
+    getline(std::cin, filename);
+    if (filename.empty()) {
+        filename = defaultName;
+    }
+
+    // 获取当前月份
+    time_t now = time(0);
+    struct tm ltm;
+#ifdef _WIN32
+    localtime_s(&ltm, &now);
+#else
+    localtime_r(&now, &ltm);
+#endif
+
+    LevelPredictor predictor(ltm.tm_mon + 1);
+    LevelPredictor::Summary summary = predictor.predictAll(manager.getMemberList());
+
+    const char* levelNames[LevelPredictor::LEVEL_COUNT] = { "普通会员", "银卡会员", "金卡会员", "钻石会员" };
+    std::cout << "\n预测汇总（共 " << summary.total << " 人，预计升级 " << summary.upgradeCount << " 人）：" << std::endl;
+    std::cout << "┌──────────────────────────────────────────────────────────────────┐" << std::endl;
+    for (int level = 0; level < LevelPredictor::LEVEL_COUNT; ++level) {
+        std::cout << "│ " << levelNames[level] << "：" << summary.levelCount[level] << " 人" << std::endl;
+        for (int bucket = 0; bucket < LevelPredictor::GAP_BUCKET_COUNT; ++bucket) {
+            size_t count = summary.bucketCount[level][bucket];
+            if (count == 0) continue;
+            std::cout << "│     " << LevelPredictor::bucketName(static_cast<LevelPredictor::GapBucket>(bucket))
+                      << "：" << count << " 人" << std::endl;
+        }
+    }
+    std::cout << "│ 预测年末总消费：" << std::fixed << std::setprecision(2) << summary.predictedTotal << "元" << std::endl;
+    std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
+
+    auto outputFormat = (format == 1) ? LevelPredictor::FORMAT_CSV : LevelPredictor::FORMAT_BINARY;
+    if (predictor.writeResults(filename, outputFormat)) {
+        Utils::showSuccess("预测结果已保存到文件: " + filename);
+    } else {
+        Utils::showError("无法写入文件: " + filename);
+    }
+}
+
+/**
+ * @brief 处理会员排行榜操作
+ * @details 按年度消费、总消费或积分查询前N名会员，或查询指定会员的名次
+ */
+void System::handleLeaderboard() {
+    std::cout << "\n";
+    std::cout << "┌──────────────────────────────────────────────────────────────────┐" << std::endl;
+    std::cout << "│                          会员消费排行榜                          │" << std::endl;
+    std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
+
+    int keyChoice = Utils::getIntInput("请选择排序依据（1=年度消费, 2=总消费, 3=积分）: ", 1, 3);
+    auto key = static_cast<MemberManager::RankKey>(keyChoice - 1);
+    int mode = Utils::getIntInput("请选择查询方式（1=前N名, 2=查询会员名次）: ", 1, 2);
+
+    if (mode == 2) {
+        int id = Utils::getIntInput("请输入会员ID: ", 1, 999999);
+        int rank = manager.getMemberRank(key, id);
+        if (rank < 0) {
+            Utils::showError("未找到该ID的会员！");
+            return;
+        }
+        std::cout << "\n会员 " << id << " 当前排名：第 " << rank << " 名" << std::endl;
+        return;
+    }
+
+    int n = Utils::getIntInput("请输入要查看的名次数量: ", 1, 1000);
+    std::vector<int> top = manager.getTopMembers(key, n);
+    if (top.empty()) {
+        Utils::showError("当前没有会员记录！");
+        return;
+    }
+
+    std::cout << "\n";
+    std::cout << "┌────────┬──────────┬────────────────┬────────────────┬────────────┐" << std::endl;
+    std::cout << "│  名次  │  会员ID  │    年度消费    │     总消费     │    积分    │" << std::endl;
+    std::cout << "├────────┼──────────┼────────────────┼────────────────┼────────────┤" << std::endl;
+    for (size_t i = 0; i < top.size(); ++i) {
+        const Member* member = manager.getMemberById(top[i]);
+        if (!member) continue;
+        std::cout << "│ " << std::left << std::setw(6) << (i + 1)
+                  << " │ " << std::left << std::setw(8) << member->getId()
+                  << " │ " << std::right << std::setw(14) << std::fixed << std::setprecision(2) << member->getAnnualSpent()
+                  << " │ " << std::right << std::setw(14) << std::fixed << std::setprecision(2) << member->getTotalSpent()
+                  << " │ " << std::right << std::setw(10) << member->getPoints()
+                  << " │" << std::endl;
+    }
+    std::cout << "└────────┴──────────┴────────────────┴────────────────┴────────────┘" << std::endl;
+    if (manager.getColdMemberCount() > 0) {
+        std::cout << "（排行仅含内存中会员，" << manager.getColdMemberCount() << " 位休眠会员未参与）" << std::endl;
+    }
+}
+
+/**
+ * @brief 处理条件筛选会员操作
+ * @details 输入过滤表达式（如 level = GOLD and annualSpent > 8000 and lastYear = 2025），
+ *          编译后在会员列式快照上扫描，结果可分页显示或导出为CSV文件
+ */
+void System::handleFilterMembers() {
+    std::cout << "\n";
+    std::cout << "┌──────────────────────────────────────────────────────────────────┐" << std::endl;
+    std::cout << "│                          条件筛选会员                            │" << std::endl;
+    std::cout << "├──────────────────────────────────────────────────────────────────┤" << std::endl;
+    std::cout << "│ 字段：id level annualSpent totalSpent points lastYear rule       │" << std::endl;
+    std::cout << "│ 运算：= != < <= > >=，组合：and or not ()                        │" << std::endl;
+    std::cout << "│ 等级：NORMAL SILVER GOLD DIAMOND                                 │" << std::endl;
+    std::cout << "│ 示例：level = GOLD and annualSpent > 8000 and lastYear = 2025    │" << std::endl;
     std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
-}
\ No newline at end of file
+
+    std::string expression = Utils::getStringInput("请输入筛选条件: ", 500);
+    MemberFilter filter;
+    std::string error;
+    if (!filter.compile(expression, error)) {
+        Utils::showError("筛选条件有误：" + error);
+        return;
+    }
+
+    // 列式快照由管理器缓存，只在会员有修改后重建；耗时只统计扫描本身
+    const std::vector<Member>& members = manager.getMemberList();
+    const MemberColumns& columns = manager.getMemberColumns();
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint32_t> rows = filter.select(columns);
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "\n条件：" << filter.describe() << std::endl;
+    std::cout << "命中 " << rows.size() << " / " << members.size() << " 人，耗时 "
+              << std::fixed << std::setprecision(3) << elapsedMs << " 毫秒" << std::endl;
+    if (manager.getColdMemberCount() > 0) {
+        std::cout << "（仅筛选内存中会员，" << manager.getColdMemberCount() << " 位休眠会员未参与）" << std::endl;
+    }
+    if (rows.empty()) {
+        return;
+    }
+
+    int mode = Utils::getIntInput("请选择输出方式（1=分页显示, 2=导出CSV）: ", 1, 2);
+    if (mode == 2) {
+        std::cout << "请输入导出文件名（默认为filter_result.csv）: ";
+        std::string filename;
+        getline(std::cin, filename);
+        if (filename.empty()) {
+            filename = "filter_result.csv";
+        }
+        std::ofstream file(filename, std::ios::binary);
+        if (!file) {
+            Utils::showError("无法打开文件: " + filename);
+            return;
+        }
+        {
+            // 与会员列表导出使用同一 CSV 格式，金额按定点输出而不是流的默认 6 位有效数字
+            OutputRenderer renderer(file, OutputRenderer::FORMAT_CSV, 1 << 20);
+            renderer.memberHeader();
+            for (uint32_t row : rows) {
+                renderer.member(members[row]);
+            }
+        }
+        Utils::showSuccess("筛选结果已导出到文件: " + filename);
+        return;
+    }
+
+    const size_t pageSize = 20;
+    size_t pageCount = (rows.size() + pageSize - 1) / pageSize;
+    size_t page = 0;
+    while (true) {
+        std::cout << "\n";
+        std::cout << "┌──────────┬──────────────┬──────────────┬──────┬──────────────┬──────────┬──────────┐" << std::endl;
+        std::cout << "│  会员ID  │     姓名     │     电话     │ 等级 │   年度消费   │   积分   │ 消费年份 │" << std::endl;
+        std::cout << "├──────────┼──────────────┼──────────────┼──────┼──────────────┼──────────┼──────────┤" << std::endl;
+        for (size_t i = page * pageSize; i < std::min(rows.size(), (page + 1) * pageSize); ++i) {
+            const Member& member = members[rows[i]];
+            std::cout << "│ " << std::left << std::setw(8) << member.getId()
+                      << " │ " << std::left << std::setw(12) << member.getName()
+                      << " │ " << std::left << std::setw(12) << member.getPhone()
+                      << " │ " << std::left << std::setw(4) << static_cast<int>(member.getCurrentLevel())
+                      << " │ " << std::right << std::setw(12) << std::fixed << std::setprecision(2) << member.getAnnualSpent()
+                      << " │ " << std::right << std::setw(8) << member.getPoints()
+                      << " │ " << std::right << std::setw(8) << member.getLastYear()
+                      << " │" << std::endl;
+        }
+        std::cout << "└──────────┴──────────────┴──────────────┴──────┴──────────────┴──────────┴──────────┘" << std::endl;
+        std::cout << "第 " << (page + 1) << " / " << pageCount << " 页" << std::endl;
+        if (pageCount == 1) {
+            break;
+        }
+
+        std::string command = Utils::getStringInput("n=下一页, p=上一页, q=退出: ", 10);
+        if (command == "n" || command == "N") {
+            if (page + 1 < pageCount) ++page;
+        } else if (command == "p" || command == "P") {
+            if (page > 0) --page;
+        } else if (command == "q" || command == "Q") {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 处理消费趋势报表操作
+ * @details 基于全体会员的按日、按月消费汇总显示最近12个月和最近7天的消费额，
+ *          以及近月加权平均和线性趋势，无需扫描会员或消费明细
+ */
+void System::handleSpendingTrend() {
+    std::cout << "\n";
+    std::cout << "┌──────────────────────────────────────────────────────────────────┐" << std::endl;
+    std::cout << "│                          消费趋势报表                            │" << std::endl;
+    std::cout << "└──────────────────────────────────────────────────────────────────┘" << std::endl;
+
+    const GlobalSpendingRollup& rollup = manager.getSpendingRollup();
+    if (rollup.empty()) {
+        Utils::showError("本次运行尚无消费记录！");
+        return;
+    }
+
+    int32_t today, thisMonth;
+    rollupKeys(time(0), today, thisMonth);
+    int32_t firstMonth = thisMonth - (GlobalSpendingRollup::MONTH_BUCKETS - 1);
+
+    std::cout << "\n最近12个月：" << std::endl;
+    std::cout << "┌──────────┬────────────────┐" << std::endl;
+    for (int32_t month = firstMonth; month <= thisMonth; ++month) {
+        std::cout << "│ " << (month / 12) << "-" << std::setw(2) << std::setfill('0') << (month % 12 + 1) << std::setfill(' ')
+                  << "  │ " << std::right << std::setw(14) << std::fixed << std::setprecision(2) << rollup.monthTotal(month)
+                  << " │" << std::endl;
+    }
+    std::cout << "└──────────┴────────────────┘" << std::endl;
+
+    std::cout << "\n最近7天：" << std::endl;
+    std::cout << "┌──────────┬────────────────┐" << std::endl;
+    for (int32_t day = today - 6; day <= today; ++day) {
+        std::string label = "今天";
+        if (day != today) {
+            label = "-";
+            label += std::to_string(today - day);
+            label += "天";
+        }
+        std::cout << "│ " << std::left << std::setw(8) << label
+                  << " │ " << std::right << std::setw(14) << std::fixed << std::setprecision(2) << rollup.dayTotal(day)
+                  << " │" << std::endl;
+    }
+    std::cout << "└──────────┴────────────────┘" << std::endl;
+
+    // 趋势只看已完整的月份
+    std::cout << "\n近6个月加权月均消费：" << std::fixed << std::setprecision(2)
+              << rollup.ewma(thisMonth - 6, thisMonth - 1, 0.5) << "元" << std::endl;
+    std::cout << "近6个月线性趋势：" << std::fixed << std::setprecision(2)
+              << rollup.slope(thisMonth - 6, thisMonth - 1) << "元/月" << std::endl;
+}
@@ -0,0 +1,275 @@
+/**
+ * @file TextEncoding.cpp
+ * @brief GBK 与 UTF-8 编码检测与转换实现文件
+ * @details 实现 ASCII 快速路径、UTF-8 校验、查表转换以及反向映射表的生成
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "TextEncoding.h"
+#include <bit>
+#include <cstring>
+#include <vector>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+/**
+ * @brief 追加一个码位的 UTF-8 编码（限基本多文种平面）
+ * @param out 输出字符串
+ * @param codePoint 码位
+ */
+void appendUtf8(std::string& out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+/**
+ * @brief 解码一个 UTF-8 字符
+ * @param p 当前位置
+ * @param end 结束位置
+ * @param length 输出：该字符占用的字节数（非法时为 1）
+ * @return 码位，非法序列返回 -1
+ * @details 拒绝过长编码、代理区码位和超出 U+10FFFF 的码位
+ */
+long decodeUtf8(const unsigned char* p, const unsigned char* end, size_t& length) {
+    length = 1;
+    unsigned char lead = p[0];
+    size_t need;
+    uint32_t codePoint;
+    uint32_t minimum;
+    if (lead < 0x80) {
+        return lead;
+    } else if ((lead & 0xE0) == 0xC0) {
+        need = 1; codePoint = lead & 0x1F; minimum = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+        need = 2; codePoint = lead & 0x0F; minimum = 0x800;
+    } else if ((lead & 0xF8) == 0xF0) {
+        need = 3; codePoint = lead & 0x07; minimum = 0x10000;
+    } else {
+        return -1;
+    }
+    if (static_cast<size_t>(end - p) <= need) {
+        return -1;
+    }
+    for (size_t i = 1; i <= need; ++i) {
+        if ((p[i] & 0xC0) != 0x80) {
+            return -1;
+        }
+        codePoint = (codePoint << 6) | (p[i] & 0x3F);
+    }
+    if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+        return -1;
+    }
+    length = need + 1;
+    return static_cast<long>(codePoint);
+}
+
+}  // namespace
+
+/**
+ * @brief 获取本平台内存中使用的编码
+ * @return Windows 为 GBK，其他平台为 UTF-8
+ */
+TextEncoding::Encoding TextEncoding::nativeEncoding() {
+#ifdef _WIN32
+    return ENCODING_GBK;
+#else
+    return ENCODING_UTF8;
+#endif
+}
+
+/**
+ * @brief 获取编码名称
+ * @param encoding 编码
+ * @return 编码名称
+ */
+const char* TextEncoding::name(Encoding encoding) {
+    return encoding == ENCODING_GBK ? "GBK" : "UTF-8";
+}
+
+/**
+ * @brief 计算开头连续 ASCII 字节的长度
+ * @param data 数据首地址
+ * @param size 数据长度
+ * @return 第一个非 ASCII 字节的下标
+ * @details 支持 SSE2 时每次检查16字节的最高位，否则按8字节一组检查
+ */
+size_t TextEncoding::asciiPrefix(const char* data, size_t size) {
+    size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+    for (; i + 16 <= size; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        int mask = _mm_movemask_epi8(bytes);
+        if (mask != 0) {
+            return i + std::countr_zero(static_cast<unsigned>(mask));
+        }
+    }
+#else
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        if (word & 0x8080808080808080ULL) {
+            break;
+        }
+    }
+#endif
+    while (i < size && static_cast<unsigned char>(data[i]) < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+/**
+ * @brief 判断文本是否为合法 UTF-8
+ * @param text 文本内容
+ * @return true 合法
+ */
+bool TextEncoding::isValidUtf8(std::string_view text) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text.data());
+    const unsigned char* end = p + text.size();
+    while (p < end) {
+        p += asciiPrefix(reinterpret_cast<const char*>(p), end - p);
+        if (p == end) {
+            break;
+        }
+        size_t length;
+        if (decodeUtf8(p, end, length) < 0) {
+            return false;
+        }
+        p += length;
+    }
+    return true;
+}
+
+/**
+ * @brief 检测文本编码
+ * @param text 文本内容
+ * @return 检测到的编码
+ * @details GBK 中文文本几乎不可能恰好构成合法的 UTF-8 多字节序列，因此以 UTF-8 合法性区分
+ */
+TextEncoding::Encoding TextEncoding::detect(std::string_view text) {
+    return isValidUtf8(text) ? ENCODING_UTF8 : ENCODING_GBK;
+}
+
+/**
+ * @brief GBK 转 UTF-8
+ * @param in GBK 文本
+ * @param out 输出：转换结果追加到末尾
+ * @return true 全部转换成功
+ */
+bool TextEncoding::gbkToUtf8(std::string_view in, std::string& out) {
+    bool ok = true;
+    out.reserve(out.size() + in.size() + in.size() / 2);
+    const char* p = in.data();
+    const char* end = p + in.size();
+    while (p < end) {
+        size_t ascii = asciiPrefix(p, end - p);
+        out.append(p, ascii);
+        p += ascii;
+        if (p == end) {
+            break;
+        }
+        unsigned char lead = static_cast<unsigned char>(p[0]);
+        int trail = (p + 1 < end) ? gbkTrailIndex(static_cast<unsigned char>(p[1])) : -1;
+        uint16_t codePoint = 0;
+        if (lead >= 0x81 && lead <= 0xFE && trail >= 0) {
+            codePoint = GBK_TO_UNICODE[(lead - 0x81) * GBK_TRAIL_COUNT + trail];
+        }
+        if (codePoint == 0) {
+            appendUtf8(out, 0xFFFD);
+            ok = false;
+            p += 1;
+            continue;
+        }
+        appendUtf8(out, codePoint);
+        p += 2;
+    }
+    return ok;
+}
+
+/**
+ * @brief UTF-8 转 GBK
+ * @param in UTF-8 文本
+ * @param out 输出：转换结果追加到末尾
+ * @return true 全部转换成功
+ */
+bool TextEncoding::utf8ToGbk(std::string_view in, std::string& out) {
+    const uint16_t* table = unicodeToGbk();
+    bool ok = true;
+    out.reserve(out.size() + in.size());
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(in.data());
+    const unsigned char* end = p + in.size();
+    while (p < end) {
+        size_t ascii = asciiPrefix(reinterpret_cast<const char*>(p), end - p);
+        out.append(reinterpret_cast<const char*>(p), ascii);
+        p += ascii;
+        if (p == end) {
+            break;
+        }
+        size_t length;
+        long codePoint = decodeUtf8(p, end, length);
+        uint16_t gbk = (codePoint >= 0 && codePoint <= 0xFFFF) ? table[codePoint] : 0;
+        if (gbk == 0) {
+            out.push_back('?');
+            ok = false;
+        } else {
+            out.push_back(static_cast<char>(gbk >> 8));
+            out.push_back(static_cast<char>(gbk & 0xFF));
+        }
+        p += length;
+    }
+    return ok;
+}
+
+/**
+ * @brief 在两种编码之间转换
+ * @param in 输入文本
+ * @param from 输入编码
+ * @param to 输出编码
+ * @param out 输出：转换结果追加到末尾
+ * @return true 全部转换成功
+ */
+bool TextEncoding::convert(std::string_view in, Encoding from, Encoding to, std::string& out) {
+    if (from == to) {
+        out.append(in);
+        return true;
+    }
+    return (from == ENCODING_GBK) ? gbkToUtf8(in, out) : utf8ToGbk(in, out);
+}
+
+/**
+ * @brief 获取 Unicode → GBK 反向映射表
+ * @return 以码位为下标的 65536 项表
+ * @details 静态局部变量保证只生成一次且线程安全
+ */
+const uint16_t* TextEncoding::unicodeToGbk() {
+    static const std::vector<uint16_t> table = [] {
+        std::vector<uint16_t> reverse(0x10000, 0);
+        for (int lead = 0; lead < GBK_LEAD_COUNT; ++lead) {
+            for (int trail = 0x40; trail <= 0xFE; ++trail) {
+                int index = gbkTrailIndex(static_cast<unsigned char>(trail));
+                if (index < 0) {
+                    continue;
+                }
+                uint16_t codePoint = GBK_TO_UNICODE[lead * GBK_TRAIL_COUNT + index];
+                if (codePoint != 0 && reverse[codePoint] == 0) {
+                    reverse[codePoint] = static_cast<uint16_t>(((lead + 0x81) << 8) | trail);
+                }
+            }
+        }
+        return reverse;
+    }();
+    return table.data();
+}
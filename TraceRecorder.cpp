@@ -0,0 +1,249 @@
+/**
+ * @file TraceRecorder.cpp
+ * @brief 阶段时间线记录实现文件
+ * @details 实现每线程环形缓冲区的分配、无锁写入、导出时的一致性校验以及 Chrome trace_event JSON 输出
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+/**
+ * @struct TraceEvent
+ * @brief 环形缓冲区中的一个阶段
+ * @details 所属线程写入、导出线程读取，字段用原子变量避免数据竞争，读写都是 relaxed
+ */
+struct TraceEvent {
+    std::atomic<const char*> name{ nullptr };
+    std::atomic<uint64_t> start{ 0 };
+    std::atomic<uint64_t> end{ 0 };
+};
+
+/**
+ * @struct TraceRing
+ * @brief 一个线程的环形缓冲区
+ * @details head 是写入的事件总数，先写事件字段再以 release 发布 head；
+ *          读取方复制后再读一次 head，下标不大于 head - RING_CAPACITY 的事件可能已被覆盖，丢弃
+ *          （写入方在发布 head + 1 之前正在写的槽位，原先存放的是下标 head - RING_CAPACITY 的事件）
+ */
+struct TraceRing {
+    TraceEvent events[TraceRecorder::RING_CAPACITY];
+    std::atomic<uint64_t> head{ 0 };
+    int lane = 0;  ///< 导出时的线程轨道编号
+};
+
+/**
+ * @struct Registry
+ * @brief 全部环形缓冲区的登记处
+ */
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<TraceRing>> all;  ///< 所有分配过的缓冲区（不释放，保证导出时有效）
+    std::vector<TraceRing*> idle;                 ///< 线程已退出、可复用的缓冲区
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+/**
+ * @struct RingSlot
+ * @brief 线程持有的缓冲区，线程退出时交还登记处（事件保留，供导出）
+ */
+struct RingSlot {
+    TraceRing* ring = nullptr;
+    ~RingSlot() {
+        if (ring) {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            reg.idle.push_back(ring);
+        }
+    }
+};
+
+/**
+ * @brief 获取当前线程的缓冲区，第一次调用时分配或复用一个
+ * @details 复用时沿用原来的轨道：上一个使用者已经退出，两者的事件在时间上不会重叠
+ */
+TraceRing& localRing() {
+    thread_local RingSlot slot;
+    if (!slot.ring) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        if (!reg.idle.empty()) {
+            slot.ring = reg.idle.back();
+            reg.idle.pop_back();
+        } else {
+            reg.all.push_back(std::make_unique<TraceRing>());
+            reg.all.back()->lane = static_cast<int>(reg.all.size());
+            slot.ring = reg.all.back().get();
+        }
+    }
+    return *slot.ring;
+}
+
+/**
+ * @struct CopiedEvent
+ * @brief 导出时复制出的事件
+ */
+struct CopiedEvent {
+    const char* name;
+    uint64_t start;
+    uint64_t end;
+};
+
+/**
+ * @brief 复制一个缓冲区中仍然有效的事件
+ * @param ring 缓冲区
+ * @param out 输出：事件，按写入先后
+ */
+void copyRing(const TraceRing& ring, std::vector<CopiedEvent>& out) {
+    out.clear();
+    const uint64_t capacity = TraceRecorder::RING_CAPACITY;
+    uint64_t head = ring.head.load(std::memory_order_acquire);
+    uint64_t first = head > capacity ? head - capacity : 0;
+    for (uint64_t i = first; i < head; ++i) {
+        const TraceEvent& event = ring.events[i % capacity];
+        out.push_back({ event.name.load(std::memory_order_relaxed), event.start.load(std::memory_order_relaxed),
+                        event.end.load(std::memory_order_relaxed) });
+    }
+    // 复制期间写入方可能已绕回覆盖了最早的几项，且可能正在写下标 after 的槽位
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t after = ring.head.load(std::memory_order_relaxed);
+    uint64_t valid = after >= capacity ? after - capacity + 1 : 0;
+    if (valid > first) {
+        out.erase(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(std::min<uint64_t>(valid - first, out.size())));
+    }
+}
+
+/**
+ * @brief 输出 JSON 字符串（含引号），转义引号、反斜杠和控制字符
+ * @param out 输出流
+ * @param text 文本
+ */
+void writeJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* p = text; *p; ++p) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\') {
+            out << '\\' << *p;
+        } else if (c < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out << escaped;
+        } else {
+            out << *p;
+        }
+    }
+    out << '"';
+}
+
+/**
+ * @brief 以微秒（保留3位小数）输出纳秒数，不改变输出流的格式设置
+ * @param out 输出流
+ * @param nanoseconds 纳秒数
+ */
+void writeMicroseconds(std::ostream& out, uint64_t nanoseconds) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%llu.%03u", static_cast<unsigned long long>(nanoseconds / 1000),
+                  static_cast<unsigned>(nanoseconds % 1000));
+    out << text;
+}
+
+} // namespace
+
+/**
+ * @brief 获取当前时间（自进程内首次调用起的纳秒数）
+ */
+uint64_t TraceRecorder::now() {
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+/**
+ * @brief 记录一个已结束的阶段
+ * @param name 阶段名称
+ * @param start 开始时间
+ * @param end 结束时间
+ */
+void TraceRecorder::record(const char* name, uint64_t start, uint64_t end) {
+    TraceRing& ring = localRing();
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    TraceEvent& event = ring.events[head % RING_CAPACITY];
+    event.name.store(name, std::memory_order_relaxed);
+    event.start.store(start, std::memory_order_relaxed);
+    event.end.store(end, std::memory_order_relaxed);
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+/**
+ * @brief 获取当前保留的事件总数
+ */
+size_t TraceRecorder::eventCount() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    size_t count = 0;
+    for (const auto& ring : reg.all) {
+        count += static_cast<size_t>(std::min<uint64_t>(ring->head.load(std::memory_order_acquire), RING_CAPACITY));
+    }
+    return count;
+}
+
+/**
+ * @brief 清空全部缓冲区
+ */
+void TraceRecorder::clear() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& ring : reg.all) {
+        ring->head.store(0, std::memory_order_release);
+    }
+}
+
+/**
+ * @brief 以 Chrome trace_event JSON 格式输出全部事件
+ * @param out 输出流
+ * @return 输出的事件数
+ * @details 阶段输出为完整事件（ph = "X"），时间单位为微秒；每个缓冲区另输出一个 thread_name 元数据事件
+ */
+size_t TraceRecorder::writeChromeTrace(std::ostream& out) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    size_t written = 0;
+    std::vector<CopiedEvent> events;
+    for (const auto& ring : reg.all) {
+        copyRing(*ring, events);
+        if (events.empty()) {
+            continue;
+        }
+        out << (first ? "\n" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->lane
+            << ",\"args\":{\"name\":\"thread " << ring->lane << "\"}}";
+        first = false;
+        for (const CopiedEvent& event : events) {
+            out << ",\n{\"name\":";
+            writeJsonString(out, event.name ? event.name : "");
+            out << ",\"cat\":\"member\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring->lane << ",\"ts\":";
+            writeMicroseconds(out, event.start);
+            out << ",\"dur\":";
+            writeMicroseconds(out, event.end >= event.start ? event.end - event.start : 0);
+            out << "}";
+            ++written;
+        }
+    }
+    out << "\n]}\n";
+    return written;
+}
@@ -9,98 +9,100 @@
 
 #include "Utils.h"
 #include <iostream>
-#include <regex>
 #include <limits>
 #include <ctime>
-#include <sstream>
-#include <iomanip>
+#include <cstdint>
+#include <cstring>
+
+namespace {
 
 /**
- * @brief 验证中文姓名
- * @param name 待验证的姓名
- * @return true 如果是有效的中文姓名，false 否则
- * @details 支持Windows GBK编码和Linux/macOS UTF-8编码的中文姓名验证
+ * @brief 判断一个机器字中的每个字节是否都是ASCII数字
+ * @param word 按字节打包的字符
+ * @return true 全部为 '0'-'9'
+ * @details 高半字节必须为 3，且低半字节加 6 不能进位（即低半字节 <= 9）
  */
-bool Utils::isValidChineseName(const std::string& name) {
-    #ifdef _WIN32
-    // Windows GBK编码中文字符范围验证
-    for (size_t i = 0; i < name.length(); i++) {
-        unsigned char c = name[i];
-        if (c >= 0x81 && c <= 0xFE) {
-            if (++i >= name.length()) return false;
-        }
-        else {
-            return false;
-        }
-    }
-    #else
-    // Linux/macOS UTF-8编码中文验证
-    std::regex re("^[\u4e00-\u9fa5]+$");
-    if (!std::regex_match(name, re)) {
-        return false;
-    }
-    #endif
-    return true;
+template <typename Word>
+inline bool wordIsDigits(Word word) {
+    const Word ones = static_cast<Word>(~Word(0)) / 0xFF;  // 0x0101...01
+    Word high = word & (ones * 0xF0);
+    Word low = word & (ones * 0x0F);
+    return high == ones * 0x30 && ((low + ones * 0x06) & (ones * 0xF0)) == 0;
 }
 
 /**
- * @brief 验证电话号码
- * @param phone 待验证的电话号码
- * @return true 如果是有效的电话号码，false 否则
- * @details 支持手机号（11位，1开头）和固定电话（7-8位）格式验证
+ * @brief 判断字符串是否全部为ASCII数字
+ * @param data 字符串首地址
+ * @param length 字符串长度
+ * @return true 全部为 '0'-'9'
+ * @details 按 8 字节（不足时 4 字节）一组并行判断，末尾一组与前一组重叠，
+ *          不需要逐字节循环，也不需要拷贝到填充缓冲区
  */
-bool Utils::isValidPhoneNumber(const std::string& phone) {
-    if (phone.empty()) {
-        return false;
-    }
-
-    // 验证是否只包含数字
-    for (char c : phone) {
-        if (!std::isdigit(c)) {
-            return false;
+bool allDigits(const char* data, size_t length) {
+    if (length >= 8) {
+        uint64_t word;
+        for (size_t offset = 0; offset + 8 < length; offset += 8) {
+            std::memcpy(&word, data + offset, 8);
+            if (!wordIsDigits(word)) return false;
         }
+        std::memcpy(&word, data + length - 8, 8);
+        return wordIsDigits(word);
     }
-
-    // 验证长度：手机号11位，固定电话7-8位
-    if (phone.length() != 11 && phone.length() != 7 && phone.length() != 8) {
-        return false;
+    if (length >= 4) {
+        uint32_t head, tail;
+        std::memcpy(&head, data, 4);
+        std::memcpy(&tail, data + length - 4, 4);
+        return wordIsDigits(head) && wordIsDigits(tail);
     }
-
-    // 手机号以1开头
-    if (phone.length() == 11 && phone[0] != '1') {
-        return false;
+    for (size_t i = 0; i < length; ++i) {
+        if (data[i] < '0' || data[i] > '9') return false;
     }
-
     return true;
 }
 
 /**
- * @brief 验证生日格式
- * @param birthday 待验证的生日字符串（YYYY-MM-DD格式）
- * @return true 如果是有效的生日格式，false 否则
- * @details 验证日期格式、日期有效性和不能是未来日期
+ * @brief 解析两位数字
  */
-bool Utils::isValidBirthday(const std::string& birthday) {
-    if (birthday.empty()) {
-        return false;
-    }
+inline int twoDigits(const char* p) {
+    return (p[0] - '0') * 10 + (p[1] - '0');
+}
 
+/**
+ * @brief 获取今天的日期编号（年 × 10000 + 月 × 100 + 日）
+ */
+int todayKey() {
+    std::time_t now = std::time(nullptr);
+    std::tm currentTime;
+
+    // 平台兼容：使用线程安全函数
+#if defined(_WIN32)
+    localtime_s(&currentTime, &now);  // Windows
+#else
+    localtime_r(&now, &currentTime);  // Linux/macOS
+#endif
+    return (currentTime.tm_year + 1900) * 10000 + (currentTime.tm_mon + 1) * 100 + currentTime.tm_mday;
+}
+
+/**
+ * @brief 按固定格式 YYYY-MM-DD 验证生日
+ * @param birthday 待验证的生日字符串
+ * @param today 今天的日期编号，见 todayKey()
+ * @return true 日期有效且不晚于今天
+ */
+bool birthdayValidOn(std::string_view birthday, int today) {
     // 验证格式：YYYY-MM-DD
-    std::regex datePattern(R"(^\d{4}-\d{2}-\d{2}$)");
-    if (!std::regex_match(birthday, datePattern)) {
+    if (birthday.size() != 10 || birthday[4] != '-' || birthday[7] != '-') {
         return false;
     }
-
-    // 解析日期
-    std::istringstream iss(birthday);
-    int year, month, day;
-    char dash1, dash2;
-
-    if (!(iss >> year >> dash1 >> month >> dash2 >> day) ||
-        dash1 != '-' || dash2 != '-') {
+    const char* p = birthday.data();
+    if (!allDigits(p, 4) || !allDigits(p + 5, 2) || !allDigits(p + 8, 2)) {
         return false;
     }
 
+    int year = twoDigits(p) * 100 + twoDigits(p + 2);
+    int month = twoDigits(p + 5);
+    int day = twoDigits(p + 8);
+
     // 验证年份范围
     if (year < 1900 || year > 2100) {
         return false;
@@ -111,40 +113,97 @@ bool Utils::isValidBirthday(const std::string& birthday) {
     }
 
     // 验证日期
-    int daysInMonth[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    static const unsigned char daysInMonth[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    int maxDay = daysInMonth[month - 1];
 
     // 处理闰年
     if (month == 2 && ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0)) {
-        daysInMonth[1] = 29;
+        maxDay = 29;
     }
 
-    if (day < 1 || day > daysInMonth[month - 1]) {
+    if (day < 1 || day > maxDay) {
         return false;
     }
 
     // 验证不能是未来日期
-    std::time_t now = std::time(nullptr);
-    std::tm currentTime;
+    return year * 10000 + month * 100 + day <= today;
+}
 
-    // 平台兼容：使用线程安全函数
-#if defined(_WIN32)
-    localtime_s(&currentTime, &now);  // Windows
-#else
-    localtime_r(&now, &currentTime);  // Linux/macOS
-#endif
+}  // namespace
 
-    // 日期比较逻辑
-    if (year > currentTime.tm_year + 1900) {
+/**
+ * @brief 验证中文姓名
+ * @param name 待验证的姓名
+ * @return true 如果是有效的中文姓名，false 否则
+ * @details 支持Windows GBK编码和Linux/macOS UTF-8编码的中文姓名验证。
+ *          UTF-8 下逐个解码字符，要求全部为 CJK 基本汉字（U+4E00-U+9FA5），
+ *          这些字符都编码为3字节，因此长度不是3的倍数可直接判定无效
+ */
+bool Utils::isValidChineseName(std::string_view name) {
+    if (name.empty()) {
         return false;
     }
-    if (year == currentTime.tm_year + 1900 && month > currentTime.tm_mon + 1) {
+    #ifdef _WIN32
+    // Windows GBK编码中文字符范围验证
+    for (size_t i = 0; i < name.length(); i++) {
+        unsigned char c = name[i];
+        if (c >= 0x81 && c <= 0xFE) {
+            if (++i >= name.length()) return false;
+        }
+        else {
+            return false;
+        }
+    }
+    #else
+    // Linux/macOS UTF-8编码中文验证
+    if (name.size() % 3 != 0) {
         return false;
     }
-    if (year == currentTime.tm_year + 1900 && month == currentTime.tm_mon + 1 && day > currentTime.tm_mday) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(name.data());
+    const unsigned char* end = p + name.size();
+    for (; p < end; p += 3) {
+        // 首字节 1110xxxx，两个续字节 10xxxxxx
+        if ((p[0] & 0xF0) != 0xE0 || (p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80) {
+            return false;
+        }
+        unsigned codePoint = ((p[0] & 0x0Fu) << 12) | ((p[1] & 0x3Fu) << 6) | (p[2] & 0x3Fu);
+        if (codePoint < 0x4E00 || codePoint > 0x9FA5) {
+            return false;
+        }
+    }
+    #endif
+    return true;
+}
+
+/**
+ * @brief 验证电话号码
+ * @param phone 待验证的电话号码
+ * @return true 如果是有效的电话号码，false 否则
+ * @details 支持手机号（11位，1开头）和固定电话（7-8位）格式验证
+ */
+bool Utils::isValidPhoneNumber(std::string_view phone) {
+    // 验证长度：手机号11位，固定电话7-8位
+    if (phone.length() != 11 && phone.length() != 7 && phone.length() != 8) {
         return false;
     }
 
-    return true;
+    // 手机号以1开头
+    if (phone.length() == 11 && phone[0] != '1') {
+        return false;
+    }
+
+    // 验证是否只包含数字
+    return allDigits(phone.data(), phone.length());
+}
+
+/**
+ * @brief 验证生日格式
+ * @param birthday 待验证的生日字符串（YYYY-MM-DD格式）
+ * @return true 如果是有效的生日格式，false 否则
+ * @details 验证日期格式、日期有效性和不能是未来日期
+ */
+bool Utils::isValidBirthday(std::string_view birthday) {
+    return birthdayValidOn(birthday, todayKey());
 }
 
 /**
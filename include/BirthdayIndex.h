@@ -0,0 +1,94 @@
+#pragma once
+#include "MemoryUsage.h"
+#include <vector>
+#include <string_view>
+#include <cstddef>
+
+/**
+ * @class BirthdayIndex
+ * @brief 会员生日日历索引
+ * @details 按生日的“月-日”分为 366 个桶（按闰年日历编号，2月29日独占一个桶），
+ *          每个桶是一个紧凑的会员ID数组。查询某段日期内过生日的会员只需依次读取相应的桶，
+ *          耗时与结果数量成正比，不再逐个解析会员的生日字符串。
+ *          生日无法解析（非 YYYY-MM-DD 格式）的会员不进入索引。
+ */
+class BirthdayIndex {
+public:
+    static constexpr int DAY_COUNT = 366;  ///< 桶数量（闰年日历的天数）
+
+    BirthdayIndex();
+
+    /**
+     * @brief 计算“月-日”对应的桶编号
+     * @param month 月（1-12）
+     * @param day 日（1-31）
+     * @return 桶编号 0-365，日期无效时返回 -1
+     */
+    static int dayKey(int month, int day);
+
+    /**
+     * @brief 计算生日字符串对应的桶编号
+     * @param birthday 生日（YYYY-MM-DD）
+     * @return 桶编号 0-365，无法解析时返回 -1
+     */
+    static int dayKey(std::string_view birthday);
+
+    /**
+     * @brief 计算若干天之后的桶编号
+     * @param key 起始桶编号
+     * @param days 天数（可为负数）
+     * @return 按闰年日历循环推算的桶编号，跨越年末时回到 1月1日
+     */
+    static int addDays(int key, int days);
+
+    /**
+     * @brief 加入一个会员
+     * @param birthday 生日
+     * @param id 会员ID
+     */
+    void insert(std::string_view birthday, int id);
+
+    /**
+     * @brief 移除一个会员
+     * @param birthday 加入时使用的生日
+     * @param id 会员ID
+     * @return true 移除成功，false 记录不存在
+     */
+    bool erase(std::string_view birthday, int id);
+
+    /**
+     * @brief 获取某一天过生日的会员
+     * @param key 桶编号
+     * @return 会员ID（无固定顺序），编号无效时返回空列表
+     */
+    const std::vector<int>& bucket(int key) const;
+
+    /**
+     * @brief 查询一段日期内过生日的会员
+     * @param fromKey 起始桶编号（含）
+     * @param toKey 结束桶编号（含），小于起始编号时表示跨年，如 12月28日 - 1月3日
+     * @param out 输出：会员ID（追加），按日期先后排列
+     * @return 本次输出的数量
+     */
+    size_t range(int fromKey, int toKey, std::vector<int>& out) const;
+
+    /**
+     * @brief 获取已索引的会员数量
+     */
+    size_t size() const;
+
+    /**
+     * @brief 统计索引占用的内存
+     * @return 内存占用，对象数为已索引的会员数
+     */
+    MemoryUsage memoryUsage() const;
+
+    /**
+     * @brief 清空索引
+     */
+    void clear();
+
+private:
+    std::vector<std::vector<int>> buckets;  ///< 桶编号 -> 会员ID
+    size_t count = 0;                       ///< 已索引的会员数量
+};
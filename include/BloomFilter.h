@@ -0,0 +1,71 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class BloomFilter
+ * @brief 布隆过滤器
+ * @details 用于快速判断某个键“一定不存在”。按每个键约 10 位分配位数组，
+ *          取 7 个哈希位置（由一个 64 位哈希值拆成两半做双重哈希），误判率约 1%。
+ *          不支持删除，键被移除后由持有者在适当时机整体重建。
+ */
+class BloomFilter {
+public:
+    static constexpr int HASH_COUNT = 7;        ///< 每个键设置的位数
+    static constexpr size_t BITS_PER_KEY = 10;  ///< 每个键分配的位数
+
+    /**
+     * @brief 按预计容量重置过滤器
+     * @param capacity 预计键数量
+     */
+    void reset(size_t capacity) {
+        size_t words = (std::max<size_t>(capacity, 64) * BITS_PER_KEY + 63) / 64;
+        bits.assign(words, 0);
+    }
+
+    /**
+     * @brief 加入一个键
+     * @param hash 键的 64 位哈希值
+     */
+    void add(uint64_t hash) {
+        if (bits.empty()) {
+            reset(0);
+        }
+        uint64_t size = bits.size() * 64;
+        uint64_t h1 = hash, h2 = (hash >> 32) | 1;
+        for (int i = 0; i < HASH_COUNT; ++i) {
+            uint64_t bit = (h1 + i * h2) % size;
+            bits[bit >> 6] |= uint64_t(1) << (bit & 63);
+        }
+    }
+
+    /**
+     * @brief 判断键是否可能存在
+     * @param hash 键的 64 位哈希值
+     * @return false 一定不存在，true 可能存在
+     */
+    bool mightContain(uint64_t hash) const {
+        if (bits.empty()) {
+            return false;
+        }
+        uint64_t size = bits.size() * 64;
+        uint64_t h1 = hash, h2 = (hash >> 32) | 1;
+        for (int i = 0; i < HASH_COUNT; ++i) {
+            uint64_t bit = (h1 + i * h2) % size;
+            if (!(bits[bit >> 6] & (uint64_t(1) << (bit & 63)))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 获取位数组占用的字节数
+     */
+    size_t bytes() const { return bits.size() * sizeof(uint64_t); }
+
+private:
+    std::vector<uint64_t> bits;  ///< 位数组
+};
@@ -0,0 +1,149 @@
+#pragma once
+#include "Member.h"
+#include "BloomFilter.h"
+#include "MemoryUsage.h"
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class ColdStore
+ * @brief 休眠会员的磁盘存储（冷数据层）
+ * @details 会员的完整状态序列化后追加写入一个段文件，内存中每人只保留 24 字节的存根
+ *          （会员ID、记录位置、长度、电话哈希），存根按会员ID排序，用二分查找定位。
+ *          另有一个按（电话哈希, 会员ID）排序的存根下标数组（每人 4 字节），按电话查找时二分定位；
+ *          电话号码还建有布隆过滤器：会员不在磁盘上时，绝大多数情况连二分查找也不需要。
+ *          会员被取回或删除后其记录成为空洞，空洞超过有效数据时整体重写段文件。
+ *          段文件是运行期的转存文件，关闭时删除；会员数据的持久化仍由数据文件负责。
+ */
+class ColdStore {
+public:
+    ColdStore() = default;
+    ColdStore(const ColdStore&) = delete;
+    ColdStore& operator=(const ColdStore&) = delete;
+    ~ColdStore();
+
+    /**
+     * @brief 创建（或清空）段文件
+     * @param path 段文件路径
+     * @return true 成功，false 无法创建文件
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief 关闭并删除段文件，丢弃全部存根
+     */
+    void close();
+
+    /**
+     * @brief 是否已打开
+     */
+    bool isOpen() const { return file.is_open(); }
+
+    /**
+     * @brief 转存一批会员
+     * @param batch 要转存的会员（会员ID不得已在存储中）
+     * @return true 成功，false 写入失败（此时存储内容不变）
+     */
+    bool put(const std::vector<const Member*>& batch);
+
+    /**
+     * @brief 判断会员是否在磁盘上
+     * @param id 会员ID
+     */
+    bool contains(int id) const;
+
+    /**
+     * @brief 读取会员（不移除）
+     * @param id 会员ID
+     * @param member 输出：会员完整状态
+     * @return true 成功，false 不在磁盘上或读取失败
+     */
+    bool fetch(int id, Member& member) const;
+
+    /**
+     * @brief 移除会员（会员被取回内存或被删除时调用）
+     * @param id 会员ID
+     * @return true 成功，false 不在磁盘上
+     */
+    bool erase(int id);
+
+    /**
+     * @brief 按电话号码查找会员
+     * @param phone 完整电话号码
+     * @return 电话相同的会员中ID最小的一个，不存在时返回 -1
+     */
+    int findByPhone(std::string_view phone) const;
+
+    /**
+     * @brief 获取磁盘上全部会员的ID
+     * @param ids 输出：会员ID，升序
+     */
+    void ids(std::vector<int>& ids) const;
+
+    /**
+     * @brief 获取磁盘上的会员数量
+     */
+    size_t size() const { return liveCount; }
+
+    /**
+     * @brief 获取段文件大小（字节，含空洞）
+     */
+    uint64_t segmentBytes() const { return fileSize; }
+
+    /**
+     * @brief 获取内存中存根和布隆过滤器占用的字节数
+     */
+    size_t residentBytes() const {
+        return stubs.capacity() * sizeof(Stub) + phoneOrder.capacity() * sizeof(uint32_t) + phoneFilter.bytes();
+    }
+
+    /**
+     * @brief 统计内存中存根和布隆过滤器的占用
+     * @return 内存占用，对象数为磁盘上的会员数
+     */
+    MemoryUsage memoryUsage() const {
+        MemoryUsage usage;
+        usage.addVector(stubs);
+        usage.addVector(phoneOrder);
+        usage.addBlock(phoneFilter.bytes());
+        usage.objects = liveCount;
+        return usage;
+    }
+
+private:
+    /**
+     * @struct Stub
+     * @brief 会员在段文件中的存根
+     */
+    struct Stub {
+        uint64_t offset;     ///< 记录在段文件中的位置，DEAD 表示已移除
+        uint64_t phoneHash;  ///< 电话号码哈希
+        int32_t id;          ///< 会员ID
+        uint32_t length;     ///< 记录长度
+    };
+    static_assert(sizeof(Stub) == 24, "存根应保持紧凑");
+
+    static constexpr uint64_t DEAD = ~uint64_t(0);
+    static constexpr uint64_t COMPACT_MIN_BYTES = 1 << 20;  ///< 空洞达到该大小才考虑重写
+
+    static uint64_t phoneHash(std::string_view phone);
+    const Stub* findStub(int id) const;
+    bool readRecord(const Stub& stub, std::string& record) const;
+    void rebuildFilter();
+    void rebuildPhoneOrder();
+    bool compact();
+
+    std::string path;                  ///< 段文件路径
+    mutable std::fstream file;         ///< 段文件
+    uint64_t fileSize = 0;             ///< 段文件大小
+    uint64_t deadBytes = 0;            ///< 空洞字节数
+    std::vector<Stub> stubs;           ///< 存根，按会员ID升序（含已移除的）
+    std::vector<uint32_t> phoneOrder;  ///< 存根下标，按（电话哈希, 会员ID）升序
+    size_t liveCount = 0;              ///< 有效会员数
+    BloomFilter phoneFilter;           ///< 电话号码布隆过滤器
+    size_t filterCapacity = 0;         ///< 布隆过滤器按此容量分配
+};
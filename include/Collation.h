@@ -0,0 +1,34 @@
+#pragma once
+#include <string_view>
+#include <cstdint>
+
+/**
+ * @class Collation
+ * @brief 会员姓名排序键
+ * @details GB2312 一级汉字（GBK 0xB0A1-0xD7F9）按拼音排列，
+ *          因此以字符在 GBK 中的位置作为权重即可得到近似拼音序：
+ *          ASCII 字符最前，一级汉字按拼音居中，其余 GBK 字符按编码排在最后。
+ *          排序键是固定宽度的 64 位整数，依次放入前 4 个字的 16 位权重，
+ *          不足 4 个字时以 0 补齐（较短的姓名排在前面），
+ *          前 4 个字相同的姓名排序键相同，由调用方按其它依据区分。
+ *          多音字按 GB2312 收录的读音排序。
+ */
+class Collation {
+public:
+    static constexpr int KEY_CHARACTERS = 4;  ///< 排序键包含的字数
+
+    /**
+     * @brief 计算姓名的排序键
+     * @param name 姓名（本机编码）
+     * @return 64 位排序键，按无符号整数比较即为姓名顺序
+     */
+    static uint64_t nameKey(std::string_view name);
+
+private:
+    /**
+     * @brief 获取 GBK 编码到排序权重的映射表
+     * @return 以单字节 ASCII 值或双字节 GBK 编码为下标的 65536 项表
+     * @details 首次使用时生成
+     */
+    static const uint16_t* weights();
+};
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * @class HardwareCounters
+ * @brief 调用线程的 CPU 硬件计数器（Linux perf_event_open）
+ * @details 构造时为调用线程打开一组计数器：周期数、指令数、缓存未命中数和分支预测失败数。
+ *          同组计数器由内核同时调度；PMU 被其它进程占用而分时复用时，按实际运行时间的比例折算。
+ *          只统计用户态，也只统计调用线程，之后创建的工作线程不计入。
+ *          容器、虚拟机或 perf_event_paranoid 的限制下打不开时 available() 为 false，
+ *          调用方应只报告耗时；非 Linux 平台始终不可用。
+ */
+class HardwareCounters {
+public:
+    /**
+     * @enum Counter
+     * @brief 计数的事件
+     */
+    enum Counter {
+        CYCLES,          ///< CPU 周期
+        INSTRUCTIONS,    ///< 退休的指令
+        CACHE_MISSES,    ///< 缓存未命中（通常为末级缓存）
+        BRANCH_MISSES,   ///< 分支预测失败
+        COUNTER_COUNT
+    };
+
+    /**
+     * @struct Reading
+     * @brief 一次读数（自打开起的累计值）
+     */
+    struct Reading {
+        uint64_t values[COUNTER_COUNT] = {};  ///< 各事件的累计值，未打开的事件为0
+
+        /// 两次读数相减得到区间内的事件数
+        Reading& operator-=(const Reading& earlier) {
+            for (int i = 0; i < COUNTER_COUNT; ++i) {
+                values[i] -= earlier.values[i];
+            }
+            return *this;
+        }
+    };
+
+    /**
+     * @brief 为调用线程打开计数器
+     * @details 打开失败的事件跳过，其余照常计数
+     */
+    HardwareCounters();
+    ~HardwareCounters();
+    HardwareCounters(const HardwareCounters&) = delete;
+    HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+    /**
+     * @brief 是否至少打开了一个事件
+     */
+    bool available() const { return leader >= 0; }
+
+    /**
+     * @brief 指定事件是否在计数
+     * @param counter 事件
+     */
+    bool has(Counter counter) const { return fds[counter] >= 0; }
+
+    /**
+     * @brief 读取当前累计值
+     * @param out 输出：读数
+     * @return true 读取成功，false 不可用或读取失败
+     */
+    bool read(Reading& out) const;
+
+    /**
+     * @brief 获取不可用的原因
+     * @return 原因说明，可用时返回空字符串
+     */
+    const char* unavailableReason() const;
+
+    /**
+     * @brief 获取事件名称（与 perf 工具一致，如 "cycles"）
+     * @param counter 事件
+     */
+    static const char* counterName(Counter counter);
+
+private:
+    int fds[COUNTER_COUNT];        ///< 各事件的文件描述符，未打开为 -1
+    int order[COUNTER_COUNT];      ///< 分组读取时第 i 个值对应的事件
+    int opened = 0;                ///< 已打开的事件数
+    int leader = -1;               ///< 组长的文件描述符
+    int error = 0;                 ///< 组长打开失败时的 errno
+};
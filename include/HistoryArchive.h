@@ -0,0 +1,139 @@
+#pragma once
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class HistoryArchive
+ * @brief 消费历史的年度归档
+ * @details 每个已结束的年度写成一个只读的段文件（目录下的 history-YYYY.seg），
+ *          段文件由文件头、按会员ID升序排列的压缩记录块和末尾的索引组成，
+ *          索引每人一项（会员ID、记录条数、记录块位置），查询时在磁盘上二分查找，
+ *          因此归档只占用磁盘空间，内存中每个段只保留文件头信息。
+ *          记录按“分 + 折扣档位”合成一个变长整数，常见记录只需 2-4 字节，
+ *          无法精确表示的金额或折扣率按原始 double 保存，解码结果与写入时完全一致。
+ */
+class HistoryArchive {
+public:
+    using Record = std::pair<double, double>;  ///< 消费记录 <原价, 折扣率>，与会员的消费历史一致
+
+    /**
+     * @struct Batch
+     * @brief 一个会员待归档的消费记录
+     */
+    struct Batch {
+        int id;                  ///< 会员ID
+        const Record* records;   ///< 记录（最早的在前）
+        size_t count;            ///< 记录条数
+    };
+
+    HistoryArchive() = default;
+    HistoryArchive(const HistoryArchive&) = delete;
+    HistoryArchive& operator=(const HistoryArchive&) = delete;
+
+    /**
+     * @brief 打开归档目录并读取已有段文件的文件头
+     * @param directory 归档目录，不存在时在第一次写入时创建
+     * @return true 成功，false 路径不是目录或段文件损坏
+     */
+    bool open(const std::string& directory);
+
+    /**
+     * @brief 关闭归档（段文件保留在磁盘上）
+     */
+    void close();
+
+    /**
+     * @brief 是否已打开
+     */
+    bool isOpen() const { return opened; }
+
+    /**
+     * @brief 写入一个年度的段文件
+     * @param year 年度
+     * @param batches 各会员的记录，按会员ID严格升序，条数均大于0
+     * @return true 成功，false 该年度已归档或写入失败（此时不留下任何文件）
+     */
+    bool writeYear(int year, const std::vector<Batch>& batches);
+
+    /**
+     * @brief 获取已归档的年度数
+     */
+    size_t yearCount() const { return segments.size(); }
+
+    /**
+     * @brief 获取第 segment 个年度（按年份升序）
+     * @param segment 段序号
+     */
+    int year(size_t segment) const { return segments[segment].year; }
+
+    /**
+     * @brief 获取最近归档的年度
+     * @return 年份，没有任何归档时返回0
+     */
+    int latestYear() const { return segments.empty() ? 0 : segments.back().year; }
+
+    /**
+     * @brief 获取归档中出现过的最大会员ID
+     * @return 会员ID，没有任何归档记录时返回0
+     * @details 归档按会员ID保存，新会员的ID必须大于该值，否则会继承已删除会员的历史
+     */
+    int maxMemberId() const;
+
+    /**
+     * @brief 获取会员在某年度归档中的记录条数
+     * @param segment 段序号
+     * @param id 会员ID
+     * @return 记录条数，没有记录或读取失败时返回0
+     */
+    size_t recordCount(size_t segment, int id) const;
+
+    /**
+     * @brief 读取会员在某年度归档中的记录
+     * @param segment 段序号
+     * @param id 会员ID
+     * @param out 输出：记录（最早的在前）
+     * @return true 成功（没有记录时输出为空），false 读取失败
+     */
+    bool read(size_t segment, int id, std::vector<Record>& out) const;
+
+    /**
+     * @brief 获取全部段文件的总大小（字节）
+     */
+    uint64_t diskBytes() const;
+
+private:
+    /**
+     * @struct Segment
+     * @brief 一个年度段文件的文件头信息
+     */
+    struct Segment {
+        int year;              ///< 年度
+        std::string path;      ///< 段文件路径
+        uint32_t memberCount;  ///< 索引项数
+        uint64_t indexOffset;  ///< 索引在文件中的位置
+        uint64_t fileSize;     ///< 文件大小
+        int maxId = 0;         ///< 索引中最大的会员ID（最后一项）
+    };
+
+    /**
+     * @struct Location
+     * @brief 会员记录块的位置
+     */
+    struct Location {
+        uint64_t offset = 0;  ///< 记录块位置
+        uint64_t length = 0;  ///< 记录块长度
+        uint32_t count = 0;   ///< 记录条数
+    };
+
+    bool locate(const Segment& segment, std::ifstream& file, int id, Location& location) const;
+    static bool readHeader(const std::string& path, Segment& segment);
+    std::string segmentPath(int year) const;
+
+    std::string directory;          ///< 归档目录
+    bool opened = false;            ///< 是否已打开
+    std::vector<Segment> segments;  ///< 各年度段文件，按年份升序
+};
@@ -0,0 +1,250 @@
+#pragma once
+#include "HardwareCounters.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/**
+ * @class LatencyHistogram
+ * @brief HDR 风格的对数-线性耗时直方图
+ * @details 以纳秒为单位：128 纳秒以下每纳秒一个桶；此后每个 2 的幂区间等分为 64 个桶，
+ *          相对误差不超过 1/64（约 1.6%），最大可记录约 2^41 纳秒（约 36 分钟），更长的计入最后一个桶。
+ *          共 2304 个桶，直方图之间可直接按桶相加合并。
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 7;                          ///< 每个区间的精度位数
+    static constexpr int HALF_BUCKETS = 1 << (SUB_BUCKET_BITS - 1);   ///< 每个 2 的幂区间的桶数
+    static constexpr int MAX_SHIFT = 34;                               ///< 最大区间的右移位数
+    static constexpr int BUCKET_COUNT = (MAX_SHIFT + 2) * HALF_BUCKETS;  ///< 桶总数
+
+    LatencyHistogram();
+
+    /**
+     * @brief 计算耗时所在的桶
+     * @param nanoseconds 耗时（纳秒）
+     * @return 桶下标
+     */
+    static int bucketOf(uint64_t nanoseconds);
+
+    /**
+     * @brief 获取桶的下界（纳秒，含）
+     * @param bucket 桶下标
+     */
+    static uint64_t bucketLow(int bucket);
+
+    /**
+     * @brief 获取桶的上界（纳秒，含）
+     * @param bucket 桶下标
+     */
+    static uint64_t bucketHigh(int bucket);
+
+    /**
+     * @brief 记录一次耗时
+     * @param nanoseconds 耗时（纳秒）
+     */
+    void record(uint64_t nanoseconds);
+
+    /**
+     * @brief 合并一批计数
+     * @param bucket 桶下标
+     * @param count 次数
+     */
+    void add(int bucket, uint64_t count) { counts[bucket] += count; total += count; }
+
+    /**
+     * @brief 清空
+     */
+    void clear();
+
+    /**
+     * @brief 获取分位数
+     * @param quantile 分位（0-1）
+     * @return 耗时（纳秒），取所在桶的中点且不超过最大值；没有记录时返回0
+     */
+    uint64_t percentile(double quantile) const;
+
+    uint64_t count() const { return total; }  ///< 记录次数
+    uint64_t sum() const { return sumNs; }    ///< 耗时总和（纳秒）
+    uint64_t max() const { return maxNs; }    ///< 最大耗时（纳秒）
+
+    void setSum(uint64_t nanoseconds) { sumNs = nanoseconds; }  ///< 设置耗时总和（合并时使用）
+    void setMax(uint64_t nanoseconds) { maxNs = nanoseconds; }  ///< 设置最大耗时（合并时使用）
+
+private:
+    std::vector<uint64_t> counts;  ///< 各桶次数
+    uint64_t total = 0;            ///< 记录次数
+    uint64_t sumNs = 0;            ///< 耗时总和
+    uint64_t maxNs = 0;            ///< 最大耗时
+};
+
+/**
+ * @class PerfStats
+ * @brief MemberManager 各入口的耗时统计
+ * @details 每个线程第一次记录时分配一组私有的计数器，此后记录只写本线程的计数器，
+ *          不加锁也没有原子读改写；读取时把所有线程的计数器相加。线程退出后其计数器保留并可被新线程复用。
+ *          开启硬件计数后，每次操作另外记录所在线程的 CPU 周期、指令、缓存未命中和分支预测失败数。
+ *          编译时未定义 MEMBER_PERF_STATS 时 MEMBER_PERF_SCOPE 展开为空，各入口不产生任何计时代码。
+ */
+class PerfStats {
+public:
+    /**
+     * @enum Operation
+     * @brief 被统计的操作
+     */
+    enum Operation {
+        OP_ADD_MEMBER,
+        OP_DELETE_MEMBER,
+        OP_UPDATE_PHONE,
+        OP_GET_BY_ID,
+        OP_GET_BY_PHONE,
+        OP_FIND_BY_PHONE_PREFIX,
+        OP_FIND_BY_NAME,
+        OP_FIND_BY_BIRTHDAY,
+        OP_ADD_SPENDING,
+        OP_REDEEM_POINTS,
+        OP_BIRTHDAY_BONUS,
+        OP_SAVE,
+        OP_LOAD,
+        OP_TOP_MEMBERS,
+        OP_MEMBER_RANK,
+        OP_SORT_MEMBERS,
+        OP_EVICT_DORMANT,
+        OP_ARCHIVE_HISTORY,
+        OP_COUNT
+    };
+
+    /**
+     * @struct HardwareTotals
+     * @brief 一个操作在开启硬件计数期间累计的事件数
+     */
+    struct HardwareTotals {
+        uint64_t samples[HardwareCounters::COUNTER_COUNT] = {};  ///< 计入该事件的操作次数
+        uint64_t events[HardwareCounters::COUNTER_COUNT] = {};   ///< 事件总数
+    };
+
+    /**
+     * @brief 是否编译了计时代码
+     */
+    static constexpr bool enabled() {
+#ifdef MEMBER_PERF_STATS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 获取操作名称（与 MemberManager 的方法名一致）
+     * @param operation 操作
+     */
+    static const char* operationName(Operation operation);
+
+    /**
+     * @brief 记录一次耗时（只写当前线程的计数器）
+     * @param operation 操作
+     * @param nanoseconds 耗时（纳秒）
+     */
+    static void record(Operation operation, uint64_t nanoseconds);
+
+    /**
+     * @brief 合并所有线程的计数器
+     * @param operation 操作
+     * @param out 输出：合并后的直方图
+     */
+    static void snapshot(Operation operation, LatencyHistogram& out);
+
+    /**
+     * @brief 清零全部计数器
+     * @details 与正在进行的记录并发时，个别记录可能丢失
+     */
+    static void reset();
+
+    /**
+     * @brief 以 Prometheus 文本格式输出全部操作的统计
+     * @param out 输出流
+     * @details 每个操作输出 0.5、0.99、0.999 分位以及 _sum、_count（单位：秒）
+     */
+    static void writePrometheus(std::ostream& out);
+
+    /**
+     * @brief 开启或关闭各操作的硬件计数
+     * @param on true 开启
+     * @return 开启时返回当前线程能否打开硬件计数器，打不开时保持关闭；关闭时总是返回 true
+     * @details 开启后每次操作前后各读一次所在线程的计数器（两次系统调用），只在调优时开启
+     */
+    static bool setHardwareCounting(bool on);
+
+    /**
+     * @brief 是否开启了硬件计数
+     */
+    static bool hardwareCounting() { return hardwareOn.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 获取当前线程的硬件计数器打不开的原因
+     * @return 原因说明，可用时返回空字符串
+     */
+    static const char* hardwareUnavailableReason();
+
+    /**
+     * @brief 读取当前线程的硬件计数器（第一次调用时打开）
+     * @param out 输出：读数
+     * @return true 读取成功
+     */
+    static bool readHardware(HardwareCounters::Reading& out);
+
+    /**
+     * @brief 记录一次操作期间的硬件事件（只写当前线程的计数器）
+     * @param operation 操作
+     * @param start 操作开始时 readHardware 的读数
+     */
+    static void recordHardware(Operation operation, const HardwareCounters::Reading& start);
+
+    /**
+     * @brief 合并所有线程的硬件事件
+     * @param operation 操作
+     * @param out 输出：合并后的事件数
+     */
+    static void hardwareSnapshot(Operation operation, HardwareTotals& out);
+
+private:
+    inline static std::atomic<bool> hardwareOn{ false };  ///< 是否开启硬件计数
+};
+
+/**
+ * @class ScopedLatency
+ * @brief 作用域计时器：构造时取时间，析构时把耗时记入 PerfStats
+ * @details 开启了硬件计数时，在计时区间之外再读一次计数器，读取本身的耗时不计入耗时统计
+ */
+class ScopedLatency {
+public:
+    explicit ScopedLatency(PerfStats::Operation operation)
+        : operation(operation), counting(PerfStats::hardwareCounting() && PerfStats::readHardware(hardwareStart)),
+          start(std::chrono::steady_clock::now()) {}
+    ~ScopedLatency() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        PerfStats::record(operation, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        if (counting) {
+            PerfStats::recordHardware(operation, hardwareStart);
+        }
+    }
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    PerfStats::Operation operation;
+    HardwareCounters::Reading hardwareStart;  ///< 操作开始时的硬件读数（须先于 counting 构造）
+    bool counting;                            ///< 本次操作是否记录硬件事件
+    std::chrono::steady_clock::time_point start;
+};
+
+#ifdef MEMBER_PERF_STATS
+#define MEMBER_PERF_CONCAT_INNER(a, b) a##b
+#define MEMBER_PERF_CONCAT(a, b) MEMBER_PERF_CONCAT_INNER(a, b)
+/// 统计所在作用域的耗时，operation 为 PerfStats::Operation 的枚举名（如 OP_ADD_MEMBER）
+#define MEMBER_PERF_SCOPE(operation) ScopedLatency MEMBER_PERF_CONCAT(perfScope, __LINE__)(PerfStats::operation)
+#else
+#define MEMBER_PERF_SCOPE(operation) ((void)0)
+#endif
@@ -0,0 +1,112 @@
+#pragma once
+#include "Member.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class LevelPredictor
+ * @brief 批量会员等级预测引擎
+ * @details 将全部会员的年度消费抽取为列式数组，按月均消费外推年末消费，
+ *          多线程分块计算预测等级与距下一等级的差额，并按等级和差额分桶统计。
+ *          预测结果可流式输出为 CSV 或二进制文件，供营销升级活动使用。
+ */
+class LevelPredictor {
+public:
+    /**
+     * @enum GapBucket
+     * @brief 距下一等级差额分桶
+     * @details 分档与单会员等级预测中的升级建议保持一致
+     */
+    enum GapBucket {
+        GAP_WITHIN_2000,   ///< 差额 <= 2000元
+        GAP_WITHIN_5000,   ///< 差额 <= 5000元
+        GAP_WITHIN_10000,  ///< 差额 <= 10000元
+        GAP_OVER_10000,    ///< 差额 > 10000元
+        GAP_TOP_LEVEL,     ///< 已预测为最高等级，无需升级
+        GAP_BUCKET_COUNT
+    };
+
+    /**
+     * @enum OutputFormat
+     * @brief 预测结果输出格式
+     */
+    enum OutputFormat {
+        FORMAT_CSV,     ///< 逗号分隔文本
+        FORMAT_BINARY   ///< 定长二进制记录
+    };
+
+    static constexpr int LEVEL_COUNT = 4;  ///< 会员等级数量（NORMAL-DIAMOND）
+
+    /**
+     * @struct Summary
+     * @brief 批量预测汇总结果
+     */
+    struct Summary {
+        size_t total = 0;                                        ///< 参与预测的会员数
+        size_t levelCount[LEVEL_COUNT] = {};                     ///< 各预测等级人数
+        size_t upgradeCount = 0;                                 ///< 预测等级高于当前等级的人数
+        size_t bucketCount[LEVEL_COUNT][GAP_BUCKET_COUNT] = {};  ///< [预测等级][差额分桶] 人数
+        double predictedTotal = 0.0;                             ///< 预测年末总消费
+    };
+
+    /**
+     * @brief 构造函数
+     * @param currentMonth 当前月份（1-12），用于计算月均消费
+     * @param threads 工作线程数，0 表示使用硬件并发数
+     */
+    explicit LevelPredictor(int currentMonth, unsigned threads = 0);
+
+    /**
+     * @brief 对所有会员执行批量预测
+     * @param members 会员列表
+     * @return 预测汇总结果
+     * @details 先并行抽取列数据，再并行执行预测内核，最后合并各线程的分桶统计
+     */
+    Summary predictAll(const std::vector<Member>& members);
+
+    /**
+     * @brief 将最近一次预测结果写入文件
+     * @param filename 输出文件名
+     * @param format 输出格式
+     * @return true 写入成功，false 无法打开或写入失败
+     * @details 使用大块缓冲区分块写出，避免逐行刷新
+     */
+    bool writeResults(const std::string& filename, OutputFormat format) const;
+
+    /**
+     * @brief 获取差额分桶的显示名称
+     * @param bucket 分桶编号
+     * @return 分桶名称
+     */
+    static const char* bucketName(GapBucket bucket);
+
+    /**
+     * @brief 获取最近一次预测的会员数量
+     * @return 预测结果行数
+     */
+    size_t size() const;
+
+private:
+    /**
+     * @brief 预测内核
+     * @param begin 起始行（含）
+     * @param end 结束行（不含）
+     * @param summary 本线程的局部汇总
+     * @details 只访问连续的列数组，循环体无分支，便于编译器向量化
+     */
+    void predictRange(size_t begin, size_t end, Summary& summary);
+
+    int currentMonth;                      ///< 当前月份
+    unsigned threads;                      ///< 工作线程数
+
+    // ==================== 列式数据 ====================
+    std::vector<int32_t> ids;              ///< 会员ID
+    std::vector<double> annualSpent;       ///< 当前年度消费
+    std::vector<uint8_t> currentLevels;    ///< 当前等级
+    std::vector<double> predictedSpent;    ///< 预测年末消费
+    std::vector<uint8_t> predictedLevels;  ///< 预测年末等级
+    std::vector<double> gapToNext;         ///< 距下一等级差额（最高等级为0）
+    std::vector<uint8_t> gapBuckets;       ///< 差额分桶
+};
@@ -1,7 +1,9 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <string_view>
 #include <ctime>
+#include "SpendingRollup.h"
 
 /**
  * @class Member
@@ -23,6 +25,23 @@ public:
         DIAMOND   ///< 钻石会员，8折优惠
     };
 
+    static constexpr double SILVER_THRESHOLD = 5000.0;    ///< 白银会员年度消费门槛
+    static constexpr double GOLD_THRESHOLD = 10000.0;     ///< 黄金会员年度消费门槛
+    static constexpr double DIAMOND_THRESHOLD = 20000.0;  ///< 钻石会员年度消费门槛
+
+    /**
+     * @struct SpendingReceipt
+     * @brief 一次消费的结算结果
+     */
+    struct SpendingReceipt {
+        double amount = 0.0;        ///< 消费金额（原价）
+        double discountRate = 1.0;  ///< 享受的折扣率
+        double actualAmount = 0.0;  ///< 实际支付金额
+        int earnedPoints = 0;       ///< 本次获得积分
+        int totalPoints = 0;        ///< 消费后累计积分
+        Level level = NORMAL;       ///< 消费后会员等级
+    };
+
     /**
      * @brief 构造函数
      * @param id 会员ID
@@ -106,36 +125,90 @@ public:
     /**
      * @brief 设置积分规则
      * @param rule 新的积分规则（1元=多少积分）
+     * @return true 设置成功，false 规则无效（必须大于0）
      * @details 更新积分计算规则，影响后续消费的积分计算
      */
-    void setPointsRule(int rule);
+    bool setPointsRule(int rule);
+
+    /**
+     * @brief 恢复数据文件中保存的累计数据
+     * @param totalSpent 总消费金额
+     * @param points 当前积分
+     * @param level 会员等级
+     * @details 构造函数按年度消费推算这三项，从数据文件加载时用保存的值覆盖，保证保存→加载不丢失数据
+     */
+    void restoreTotals(double totalSpent, int points, Level level);
     
     /**
      * @brief 添加消费记录
      * @param amount 消费金额
+     * @return 本次消费的结算结果
      * @details 记录消费并自动计算积分、更新等级、应用折扣优惠
      */
-    void addSpending(double amount);
+    SpendingReceipt addSpending(double amount);
+
+    /**
+     * @brief 按指定时间添加消费记录
+     * @param amount 消费金额
+     * @param when 消费发生的时间，用于跨年判断和分桶汇总
+     * @return 本次消费的结算结果
+     */
+    SpendingReceipt addSpending(double amount, std::time_t when);
+
+    /**
+     * @brief 获取按日、按月分桶的消费汇总
+     * @return 消费汇总环形缓冲区，用于趋势分析和等级预测
+     */
+    const MemberSpendingRollup& getSpendingRollup() const;
     
     /**
      * @brief 积分兑换
      * @param pointsToRedeem 要兑换的积分数量
+     * @return true 兑换成功，false 积分不足或兑换数量无效
      * @details 使用积分进行兑换，减少当前积分余额
      */
-    void redeemPoints(int pointsToRedeem);
-    
+    bool redeemPoints(int pointsToRedeem);
+
+    /**
+     * @brief 赠送奖励积分
+     * @param bonus 奖励的积分数量
+     * @return true 赠送成功，false 数量无效或积分将溢出
+     * @details 用于生日奖励等活动，不产生消费记录，也不影响会员等级
+     */
+    bool addBonusPoints(int bonus);
+
+    /**
+     * @brief 获取消费历史记录
+     * @return 消费历史 <原价, 折扣率> 列表
+     */
+    const std::vector<std::pair<double, double>>& getConsumptionHistory() const;
+
+    /**
+     * @brief 获取指定年份之前的消费记录条数
+     * @param year 年份
+     * @return 消费历史开头属于 year 之前各年度的记录条数
+     * @details 跨年时记下新年度第一条记录的位置，之前的记录都属于已结束的年度
+     */
+    size_t closedHistoryCount(int year) const;
+
     /**
-     * @brief 显示消费历史记录
-     * @param n 显示最近N次消费记录，-1表示显示全部
-     * @details 显示会员的消费历史，包括原价、折扣和实际支付金额
+     * @brief 移除最早的若干条消费记录
+     * @param count 记录条数（已写入年度归档的部分）
      */
-    void showConsumptionHistory(int n) const;
+    void dropOldestHistory(size_t count);
 
     /**
      * @brief 确定会员等级
      * @details 根据年度消费金额自动确定会员等级
      */
     void determineLevel();
+
+    /**
+     * @brief 根据年度消费金额计算对应等级
+     * @param amount 年度消费金额
+     * @return 对应的会员等级（不修改任何会员状态）
+     */
+    static Level levelForAmount(double amount);
     
     /**
      * @brief 获取折扣率
@@ -144,6 +217,29 @@ public:
      */
     double getDiscountRate() const;
 
+    /**
+     * @brief 获取指定等级的折扣率
+     * @param level 会员等级
+     * @return 折扣率（0.8-1.0）
+     */
+    static double discountRateFor(Level level);
+
+    /**
+     * @brief 将会员的全部状态序列化为二进制记录
+     * @param out 输出：记录追加到末尾
+     * @details 包含消费历史和消费汇总，用于把休眠会员转存到磁盘；
+     *          记录按本机字节序保存，只在同一台机器上读回
+     */
+    void serialize(std::string& out) const;
+
+    /**
+     * @brief 从二进制记录恢复会员
+     * @param record 由 serialize 生成的记录
+     * @param member 输出：恢复的会员
+     * @return true 恢复成功，false 记录不完整
+     */
+    static bool deserialize(std::string_view record, Member& member);
+
 private:
     int id;                                    ///< 会员唯一标识ID
     std::string name;                          ///< 会员姓名
@@ -153,7 +249,9 @@ private:
     int points;                                ///< 累计积分
     int pointsPerDollar;                       ///< 积分规则（1元 = ?积分）
     std::vector<std::pair<double, double>> consumptionHistory;  ///< 消费历史记录 <原价, 折扣率>
+    size_t yearStart = 0;                      ///< 上次消费年度的第一条记录在消费历史中的下标
     double annualSpent;                        ///< 年度累计消费（原价）
     Level currentLevel;                        ///< 当前会员等级
     int lastYear;                              ///< 上次消费的年份（用于判断是否跨年）
+    MemberSpendingRollup spendingRollup;       ///< 最近31天/12个月的消费分桶汇总
 };
\ No newline at end of file
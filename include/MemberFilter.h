@@ -0,0 +1,108 @@
+#pragma once
+#include "Member.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @struct MemberColumns
+ * @brief 会员数据的列式快照
+ * @details 每个字段一个连续数组，供过滤表达式按列扫描
+ */
+struct MemberColumns {
+    std::vector<int32_t> id;           ///< 会员ID
+    std::vector<int32_t> level;        ///< 会员等级（0-3）
+    std::vector<double> annualSpent;   ///< 年度累计消费
+    std::vector<double> totalSpent;    ///< 总消费
+    std::vector<int32_t> points;       ///< 当前积分
+    std::vector<int32_t> lastYear;     ///< 上次消费年份
+    std::vector<int32_t> rule;         ///< 积分规则
+
+    /**
+     * @brief 从会员列表构建列式快照
+     * @param members 会员列表
+     */
+    void build(const std::vector<Member>& members);
+
+    /**
+     * @brief 获取行数
+     * @return 会员数量
+     */
+    size_t size() const { return id.size(); }
+};
+
+/**
+ * @class MemberFilter
+ * @brief 会员过滤表达式
+ * @details 支持形如 "level = GOLD and annualSpent > 8000 and lastYear = 2025" 的查询。
+ *          表达式先解析为语法树，再编译为按列执行的谓词流水线：
+ *          每个比较条件对应一个类型化扫描内核，AND 依次收窄选择向量并在为空时提前结束，
+ *          OR 只对尚未命中的行继续求值，整体按块处理以保持选择向量常驻缓存。
+ *
+ * 语法：
+ *   expr       := andExpr ( (OR | "||") andExpr )*
+ *   andExpr    := notExpr ( (AND | "&&") notExpr )*
+ *   notExpr    := (NOT | "!") notExpr | "(" expr ")" | comparison
+ *   comparison := field op value
+ *   field      := id | level | annualSpent | totalSpent | points | lastYear | rule
+ *   op         := = | == | != | <> | < | <= | > | >=
+ *   value      := 数字 | NORMAL | SILVER | GOLD | DIAMOND
+ */
+class MemberFilter {
+public:
+    /**
+     * @enum Field
+     * @brief 可过滤的会员字段
+     */
+    enum Field { FIELD_ID, FIELD_LEVEL, FIELD_ANNUAL_SPENT, FIELD_TOTAL_SPENT, FIELD_POINTS, FIELD_LAST_YEAR, FIELD_RULE };
+
+    /**
+     * @enum Op
+     * @brief 比较运算符
+     */
+    enum Op { OP_EQ, OP_NE, OP_LT, OP_LE, OP_GT, OP_GE };
+
+    MemberFilter();
+    ~MemberFilter();
+    MemberFilter(MemberFilter&&) noexcept;
+    MemberFilter& operator=(MemberFilter&&) noexcept;
+
+    /**
+     * @brief 解析并编译过滤表达式
+     * @param text 表达式文本
+     * @param error 输出：解析失败时的错误信息
+     * @return true 编译成功，false 表达式有误
+     */
+    bool compile(const std::string& text, std::string& error);
+
+    /**
+     * @brief 在列式快照上执行过滤
+     * @param columns 会员列式快照
+     * @param limit 最多返回的行数，0 表示不限
+     * @return 命中行的下标（升序），与快照及原会员列表下标一致
+     * @details 达到 limit 后立即停止扫描
+     */
+    std::vector<uint32_t> select(const MemberColumns& columns, size_t limit = 0) const;
+
+    /**
+     * @brief 统计命中行数
+     * @param columns 会员列式快照
+     * @return 命中行数
+     */
+    size_t count(const MemberColumns& columns) const;
+
+    /**
+     * @brief 获取编译后的表达式（规范化形式）
+     * @return 表达式文本，便于确认解析结果
+     */
+    std::string describe() const;
+
+    struct Node;
+    struct Plan;
+
+private:
+    std::unique_ptr<Node> root;  ///< 语法树
+    std::unique_ptr<Plan> plan;  ///< 编译后的执行计划
+};
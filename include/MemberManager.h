@@ -1,8 +1,20 @@
 // MemberManager.h
 #pragma once
 #include "Member.h"
+#include "RankIndex.h"
+#include "PhoneIndex.h"
+#include "NameIndex.h"
+#include "BirthdayIndex.h"
+#include "ColdStore.h"
+#include "HistoryArchive.h"
+#include "TextEncoding.h"
+#include "MemoryUsage.h"
+#include "MemberFilter.h"
+#include "ReplicationLog.h"
+#include <ctime>
 #include <vector>
 #include <string>
+#include <unordered_map>
 
 /**
  * @class MemberManager
@@ -11,11 +23,190 @@
  *          积分管理、消费记录管理和数据持久化等功能
  */
 class MemberManager {
+public:
+    /**
+     * @enum RankKey
+     * @brief 排行榜排序依据
+     */
+    enum RankKey {
+        RANK_ANNUAL_SPENT,  ///< 本年度消费
+        RANK_TOTAL_SPENT,   ///< 累计总消费
+        RANK_POINTS,        ///< 当前积分
+        RANK_KEY_COUNT
+    };
+
+    /**
+     * @enum SortOrder
+     * @brief 会员列表排序方式
+     */
+    enum SortOrder {
+        SORT_BY_ID,           ///< 会员ID升序
+        SORT_BY_NAME,         ///< 姓名拼音
+        SORT_BY_ANNUAL_SPENT, ///< 本年度消费从高到低
+        SORT_BY_LEVEL_SPENT,  ///< 等级从高到低，同等级按本年度消费从高到低
+        SORT_ORDER_COUNT
+    };
+
+    static constexpr int LEVEL_COUNT = 4;  ///< 会员等级数量（NORMAL-DIAMOND）
+
+    /**
+     * @enum Status
+     * @brief 操作结果码
+     * @details 核心接口不直接输出任何提示，由调用方（如 System 的展示层）根据结果码决定如何呈现
+     */
+    enum Status {
+        STATUS_OK,                   ///< 操作成功
+        STATUS_NOT_FOUND,            ///< 会员不存在
+        STATUS_INVALID_ARGUMENT,     ///< 参数无效
+        STATUS_INSUFFICIENT_POINTS,  ///< 积分不足
+        STATUS_IO_ERROR              ///< 文件读写失败
+    };
+
+    /**
+     * @struct SpendingResult
+     * @brief 添加消费的结果
+     */
+    struct SpendingResult {
+        Status status = STATUS_OK;        ///< 结果码
+        Member::SpendingReceipt receipt;  ///< 结算结果，仅 STATUS_OK 时有效
+    };
+
+    /**
+     * @struct RedeemResult
+     * @brief 积分兑换的结果
+     */
+    struct RedeemResult {
+        Status status = STATUS_OK;  ///< 结果码
+        int redeemed = 0;           ///< 本次兑换的积分
+        int remaining = 0;          ///< 兑换后剩余积分
+    };
+
+    /**
+     * @struct BonusResult
+     * @brief 批量赠送奖励积分的结果
+     */
+    struct BonusResult {
+        Status status = STATUS_OK;    ///< 结果码
+        size_t members = 0;           ///< 获得奖励的会员数
+        long long pointsGranted = 0;  ///< 赠送的积分总数
+    };
+
+    /**
+     * @struct ArchiveResult
+     * @brief 年度消费历史归档的结果
+     */
+    struct ArchiveResult {
+        Status status = STATUS_OK;  ///< 结果码
+        size_t members = 0;         ///< 有记录被归档的会员数
+        size_t records = 0;         ///< 归档的记录条数
+    };
+
+    /**
+     * @enum MemorySubsystem
+     * @brief 内存占用报告中的子系统
+     */
+    enum MemorySubsystem {
+        MEMORY_MEMBERS,         ///< 会员对象本身（含对象内的短字符串和消费分桶汇总）
+        MEMORY_STRINGS,         ///< 姓名、电话、生日在堆上的存储（对象数为字符串数）
+        MEMORY_HISTORY,         ///< 消费历史（对象数为记录条数）
+        MEMORY_ID_INDEX,        ///< 会员ID索引
+        MEMORY_PHONE_INDEX,     ///< 电话号码索引
+        MEMORY_NAME_INDEX,      ///< 姓名倒排索引
+        MEMORY_BIRTHDAY_INDEX,  ///< 生日索引
+        MEMORY_RANK_INDEX,      ///< 各排行榜的顺序统计索引
+        MEMORY_SORT_KEYS,       ///< 姓名排序键
+        MEMORY_COLD_STORE,      ///< 休眠会员的存根和布隆过滤器
+        MEMORY_FILTER_COLUMNS,  ///< 条件筛选的列式快照（未筛选过时为 0）
+        MEMORY_SUBSYSTEM_COUNT
+    };
+
+    /**
+     * @struct MemoryReport
+     * @brief 按子系统统计的内存占用
+     * @details 各子系统遍历自己的容器得到，按容量计字节数；
+     *          heap 为同一时刻的进程堆状态，可与统计结果对照估计外部碎片
+     */
+    struct MemoryReport {
+        MemoryUsage subsystems[MEMORY_SUBSYSTEM_COUNT];  ///< 各子系统的占用
+        size_t members = 0;            ///< 内存中的会员数
+        size_t historyRecords = 0;     ///< 内存中的消费记录条数
+        size_t longestHistory = 0;     ///< 最长的消费历史条数
+        uint64_t coldDiskBytes = 0;    ///< 休眠会员段文件大小
+        uint64_t archiveDiskBytes = 0; ///< 消费历史归档总大小
+        HeapStats heap;                ///< 进程堆状态
+
+        /**
+         * @brief 获取全部子系统的合计
+         */
+        MemoryUsage total() const;
+
+        /**
+         * @brief 获取平均每位会员的消费记录条数（内存中）
+         */
+        double averageHistoryLength() const;
+
+        /**
+         * @brief 获取子系统的标识名（英文，用于机器可读的输出）
+         * @param subsystem 子系统
+         */
+        static const char* subsystemName(MemorySubsystem subsystem);
+    };
+
+    /**
+     * @struct LevelStats
+     * @brief 按等级汇总的物化统计
+     * @details 随每次会员变更按增量维护，读取为 O(1)；金额以分为单位累计，避免浮点误差
+     */
+    struct LevelStats {
+        long long memberCount[LEVEL_COUNT] = {};        ///< 各等级会员人数
+        long long pointsOutstanding[LEVEL_COUNT] = {};  ///< 各等级未兑换积分总额
+        long long annualRevenueCents[LEVEL_COUNT] = {}; ///< 各等级本年度消费总额（分）
+
+        /**
+         * @brief 获取全部会员人数
+         */
+        long long totalMembers() const;
+
+        /**
+         * @brief 获取全部未兑换积分
+         */
+        long long totalPoints() const;
+
+        /**
+         * @brief 获取本年度消费总额（元）
+         */
+        double totalAnnualRevenue() const;
+
+        /**
+         * @brief 获取指定等级本年度消费总额（元）
+         * @param level 会员等级
+         */
+        double annualRevenue(int level) const;
+    };
+
 private:
     std::vector<Member> members;  ///< 存储所有会员的向量
     int nextId = 1;               ///< 下一个可用的会员ID
     int pointsRule = 1;           ///< 积分规则（1元=多少积分）
 
+    std::unordered_map<int, size_t> idIndex;  ///< 会员ID -> members 下标
+    PhoneIndex phoneIndex;                    ///< 电话号码前缀 / 后四位索引
+    NameIndex nameIndex;                      ///< 姓名 n-gram 倒排索引（含磁盘上的会员）
+    BirthdayIndex birthdayIndex;              ///< 生日“月-日”日历索引（含磁盘上的会员）
+    std::vector<uint64_t> nameKeys;           ///< 姓名排序键，与 members 下标一一对应
+    ColdStore coldStore;                      ///< 休眠会员的磁盘存储
+    std::string coldPath;                     ///< 段文件路径
+    int dormantYears = 0;                     ///< 休眠阈值（年），0 表示未启用冷热分层
+    HistoryArchive historyArchive;            ///< 消费历史的年度归档
+    int archivedYear = 0;                     ///< 最近归档的年度
+    RankIndex rankIndexes[RANK_KEY_COUNT];    ///< 各排序依据的顺序统计索引（仅内存中会员）
+    int rankYear = 0;                         ///< 年度消费排行对应的年份
+    LevelStats levelStats;                    ///< 按等级汇总的物化统计（仅内存中会员）
+    MemberColumns columns;                    ///< 供条件筛选扫描的列式快照
+    bool columnsStale = true;                 ///< 会员有修改，列式快照需要重建
+    GlobalSpendingRollup spendingRollup;      ///< 全体会员按日、按月的消费汇总
+    ReplicationLog replicationLog;            ///< 主备复制日志
+
 public:
     // ==================== 基础数据访问 ====================
     
@@ -25,6 +216,12 @@ public:
      */
     std::vector<Member> getMembers() const;
 
+    /**
+     * @brief 获取所有会员列表的只读引用
+     * @return 会员向量常量引用，供批量计算避免整体复制
+     */
+    const std::vector<Member>& getMemberList() const;
+
     // ==================== 会员信息管理 ====================
     
     /**
@@ -32,37 +229,27 @@ public:
      * @param name 会员姓名
      * @param phone 会员电话
      * @param birthday 会员生日
-     * @details 创建新会员对象并添加到会员列表中，自动分配唯一ID
+     * @return 新会员的ID
+     * @details 创建新会员对象并添加到会员列表中，自动分配唯一ID。
+     *          启用复制时调用方须检查 getReplicationLog().failed()：为 true 时记录没有进入日志，不能确认
      */
-    void addMember(const std::string& name, const std::string& phone, const std::string& birthday);
+    int addMember(const std::string& name, const std::string& phone, const std::string& birthday);
     
     /**
      * @brief 删除指定会员
      * @param memberid 要删除的会员ID
-     * @details 根据会员ID查找并删除会员，包含用户友好的提示信息
+     * @return STATUS_OK、STATUS_NOT_FOUND 或 STATUS_IO_ERROR（复制日志写入失败，见 enableReplication）
      */
-    void deleteMember(int memberid);
-    
-    /**
-     * @brief 显示所有会员列表
-     * @details 遍历所有会员并显示其基本信息，如果没有会员则显示提示信息
-     */
-    void listAllMembers() const;
-    
-    /**
-     * @brief 根据电话号码查找会员
-     * @param phone 要查找的电话号码
-     * @details 遍历会员列表查找匹配的电话号码并显示会员信息
-     */
-    void findMemberByPhone(const std::string& phone) const;
+    Status deleteMember(int memberid);
     
     /**
      * @brief 更新会员电话号码
      * @param id 会员ID
      * @param newPhone 新的电话号码
+     * @return STATUS_OK、STATUS_NOT_FOUND 或 STATUS_IO_ERROR（复制日志写入失败）
      * @details 根据会员ID查找会员并更新其电话号码
      */
-    void updateMemberPhone(int id, const std::string& newPhone);
+    Status updateMemberPhone(int id, const std::string& newPhone);
     
     /**
      * @brief 根据电话号码获取会员ID
@@ -71,55 +258,378 @@ public:
      */
     int getMemberIdByPhone(const std::string& phone) const;
 
+    /**
+     * @brief 根据会员ID获取会员
+     * @param id 会员ID
+     * @return 会员指针，如果未找到则返回nullptr
+     * @details 通过ID索引 O(1) 定位，指针在下一次增删会员前有效。
+     *          只查找内存中的会员，不会调回已转存到磁盘的休眠会员
+     */
+    const Member* getMemberById(int id) const;
+
+    /**
+     * @brief 根据会员ID获取会员，必要时从磁盘调回
+     * @param id 会员ID
+     * @return 会员指针，如果未找到则返回nullptr
+     */
+    const Member* getMemberById(int id);
+
+    /**
+     * @brief 根据电话号码获取会员
+     * @param phone 电话号码
+     * @return 会员指针，如果未找到则返回nullptr
+     * @details 通过电话号码索引定位，不再逐个比较。只查找内存中的会员
+     */
+    const Member* getMemberByPhone(const std::string& phone) const;
+
+    /**
+     * @brief 根据电话号码获取会员，必要时从磁盘调回
+     * @param phone 电话号码
+     * @return 会员指针，如果未找到则返回nullptr
+     */
+    const Member* getMemberByPhone(const std::string& phone);
+
+    /**
+     * @brief 按电话号码前缀查找会员
+     * @param prefix 号码前缀（数字）
+     * @param limit 最多返回的数量，0 表示不限
+     * @param ids 输出：匹配的会员ID，按号码升序
+     * @return 匹配的会员总数（不受 limit 限制）
+     */
+    size_t findMembersByPhonePrefix(const std::string& prefix, size_t limit, std::vector<int>& ids) const;
+
+    /**
+     * @brief 按电话号码后四位查找会员
+     * @param lastFour 号码后四位（4位数字）
+     * @return 后四位相同的会员ID，引用在下一次增删改会员前有效
+     */
+    const std::vector<int>& findMembersByPhoneSuffix(const std::string& lastFour) const;
+
+    /**
+     * @brief 按姓名片段查找会员
+     * @param query 姓名片段（一个或多个字）
+     * @param limit 最多返回的数量，0 表示不限
+     * @param ids 输出：姓名包含该片段的会员ID，按本年度消费降序
+     * @return 匹配的会员总数（不受 limit 限制）
+     * @details 包含休眠在磁盘上的会员（从段文件读出核对，不调回）
+     */
+    size_t findMembersByName(const std::string& query, size_t limit, std::vector<int>& ids) const;
+
+    /**
+     * @brief 按姓名片段查找会员，返回的休眠会员从磁盘调回
+     * @param query 姓名片段（一个或多个字）
+     * @param limit 最多返回的数量，0 表示不限
+     * @param ids 输出：姓名包含该片段的会员ID，按本年度消费降序
+     * @return 匹配的会员总数（不受 limit 限制）
+     */
+    size_t findMembersByName(const std::string& query, size_t limit, std::vector<int>& ids);
+
+    /**
+     * @brief 查找一段日期内过生日的会员
+     * @param fromKey 起始日期的桶编号（含），由 BirthdayIndex::dayKey 计算
+     * @param toKey 结束日期的桶编号（含），小于起始编号时表示跨年
+     * @param ids 输出：会员ID，按日期先后排列；含休眠在磁盘上的会员，需用非常量的 getMemberById 取得
+     * @return 会员数量
+     */
+    size_t findMembersByBirthday(int fromKey, int toKey, std::vector<int>& ids) const;
+
     // ==================== 会员积分管理 ====================
     
     /**
      * @brief 添加消费记录并计算积分
      * @param id 会员ID
      * @param amount 消费金额
+     * @return 结果码及本次消费的结算结果
      * @details 为指定会员添加消费记录并自动计算积分
      */
-    void addSpending(int id, double amount);
+    SpendingResult addSpending(int id, double amount);
     
     /**
      * @brief 积分兑换
      * @param id 会员ID
      * @param pointsToRedeem 要兑换的积分数量
+     * @return 结果码及兑换后的积分余额
      * @details 为指定会员进行积分兑换操作
      */
-    void redeemPoints(int id, int pointsToRedeem);
+    RedeemResult redeemPoints(int id, int pointsToRedeem);
 
-    // ==================== 消费记录管理 ====================
-    
     /**
-     * @brief 显示会员消费历史
-     * @param id 会员ID
-     * @param n 显示最近N次消费记录，-1表示显示全部
-     * @details 显示指定会员的消费历史记录
+     * @brief 为一段日期内过生日的会员赠送奖励积分
+     * @param fromKey 起始日期的桶编号（含）
+     * @param toKey 结束日期的桶编号（含），小于起始编号时表示跨年
+     * @param bonus 每位会员奖励的积分
+     * @return 结果码、获得奖励的会员数及赠送的积分总数
+     * @details 只遍历生日索引中相应的桶，每位会员处理一次。
+     *          同一区间重复执行会重复发放，由调用方保证每天只处理新进入区间的日期
      */
-    void showMemberSpendingHistory(int id, int n) const;
+    BonusResult grantBirthdayBonus(int fromKey, int toKey, int bonus);
 
     // ==================== 系统设置与查询 ====================
     
     /**
      * @brief 设置积分规则
      * @param rule 新的积分规则（1元=多少积分）
+     * @return STATUS_OK、STATUS_INVALID_ARGUMENT 或 STATUS_IO_ERROR（复制日志写入失败）
      * @details 更新系统积分规则并应用到所有现有会员
      */
-    void setPointsRule(int rule);
+    Status setPointsRule(int rule);
     
     /**
      * @brief 保存数据到文件
      * @param filename 文件名
+     * @param encoding 文件编码，默认为本机编码（Windows 为 GBK，其他平台为 UTF-8）
+     * @return STATUS_OK 或 STATUS_IO_ERROR
      * @details 将所有会员数据以CSV格式保存到指定文件
      */
-    void saveToFile(const std::string& filename) const;
+    Status saveToFile(const std::string& filename,
+                      TextEncoding::Encoding encoding = TextEncoding::nativeEncoding()) const;
     
     /**
      * @brief 从文件加载数据
      * @param filename 文件名
-     * @details 从指定CSV文件加载会员数据到系统
+     * @return STATUS_OK 或 STATUS_IO_ERROR
+     * @details 从指定CSV文件加载会员数据到系统，自动识别 GBK / UTF-8 编码。
+     *          已启用归档时，下一个会员ID同时大于归档中出现过的全部ID
+     */
+    Status loadFromFile(const std::string& filename);
+
+    // ==================== 会员排行榜 ====================
+
+    /**
+     * @brief 获取排行榜前N名
+     * @param key 排序依据
+     * @param n 需要的名次数量
+     * @return 按名次排列的会员ID，复杂度 O(N + log 总人数)
+     * @details 排行榜只包含内存中的会员，休眠在磁盘上的会员调回后才参与排名
+     */
+    std::vector<int> getTopMembers(RankKey key, size_t n);
+
+    /**
+     * @brief 获取会员在排行榜中的名次
+     * @param key 排序依据
+     * @param id 会员ID
+     * @return 从1开始的名次，如果未找到会员则返回-1
+     * @details 休眠在磁盘上的会员先调回，再按内存中的会员排名
+     */
+    int getMemberRank(RankKey key, int id);
+
+    /**
+     * @brief 执行年度切换
+     * @param year 当前年份
+     * @details 年度消费排行只统计当年消费，跨年时把上一年度的会员分值归零；
+     *          启用了年度归档时，同时把上一年度及更早的消费记录写入归档
      */
-    void loadFromFile(const std::string& filename);
+    void applyYearRollover(int year);
 
+    /**
+     * @brief 按指定方式排序会员列表
+     * @param order 排序方式
+     * @param positions 输出：排序后的会员在 getMemberList() 中的下标
+     * @param threads 工作线程数，0 表示使用硬件并发数
+     * @details 每个会员生成一个 64 位排序键后做并行基数排序，排序键相同时按会员ID升序。
+     *          姓名排序键在会员加入时计算一次，按姓名排序不需要重新处理姓名
+     */
+    void sortMembers(SortOrder order, std::vector<size_t>& positions, unsigned threads = 0) const;
+
+    // ==================== 冷热分层 ====================
+
+    /**
+     * @brief 启用冷热分层
+     * @param segmentPath 段文件路径
+     * @param inactiveYears 最近一次消费距今达到该年数的会员视为休眠
+     * @return STATUS_OK、STATUS_INVALID_ARGUMENT 或 STATUS_IO_ERROR
+     * @details 启用后由 evictDormant 把休眠会员的完整状态写入段文件，内存中只保留存根，
+     *          这些会员不再出现在列表、搜索、排行和统计中，按ID或电话访问时自动调回内存。
+     *          加载数据时休眠会员直接写入段文件；保存数据时磁盘上的会员一并写出
+     */
+    Status enableTiering(const std::string& segmentPath, int inactiveYears);
+
+    /**
+     * @brief 把内存中的休眠会员转存到磁盘
+     * @return 本次转存的会员数，未启用冷热分层时返回0
+     */
+    size_t evictDormant();
+
+    /**
+     * @brief 获取已转存到磁盘的会员数量
+     */
+    size_t getColdMemberCount() const;
+
+    /**
+     * @brief 获取休眠会员磁盘存储（只读）
+     */
+    const ColdStore& getColdStore() const;
+
+    // ==================== 消费历史归档 ====================
+
+    /**
+     * @brief 启用消费历史的年度归档
+     * @param directory 归档目录
+     * @return STATUS_OK 或 STATUS_IO_ERROR
+     * @details 启用时若上一年度尚未归档则立即归档一次，之后每次跨年自动归档。
+     *          归档后的记录只保存在磁盘上，内存中的消费历史只保留本年度的记录。
+     *          归档按会员ID保存，此后分配的会员ID总是大于归档中出现过的ID
+     */
+    Status enableHistoryArchive(const std::string& directory);
+
+    /**
+     * @brief 把指定年度及更早的消费记录写入该年度的归档
+     * @param closedYear 已结束的年度
+     * @return 结果码及归档数量；未启用归档或该年度不晚于最近归档的年度时为 STATUS_INVALID_ARGUMENT
+     * @details 只处理内存中的会员，已转存到磁盘的休眠会员在调回后随下一次归档写出
+     */
+    ArchiveResult archiveHistory(int closedYear);
+
+    /**
+     * @brief 获取消费历史归档（只读）
+     */
+    const HistoryArchive& getHistoryArchive() const;
+
+    // ==================== 汇总统计 ====================
+
+    /**
+     * @brief 获取按等级汇总的统计数据
+     * @return 物化统计的常量引用，读取无需扫描会员
+     * @details 只统计内存中的会员，休眠在磁盘上的会员见 getColdMemberCount()
+     */
+    const LevelStats& getLevelStats() const;
+
+    /**
+     * @brief 获取全体会员按日、按月分桶的消费汇总
+     * @return 消费汇总环形缓冲区，每次消费 O(1) 更新
+     */
+    const GlobalSpendingRollup& getSpendingRollup() const;
+
+    /**
+     * @brief 获取会员列式快照，行号与 getMemberList() 的下标一致
+     * @return 列式快照的常量引用，在下一次修改会员前有效
+     * @details 只在会员有修改后的第一次调用时重建，连续筛选不再重复 O(N) 构建
+     */
+    const MemberColumns& getMemberColumns();
+
+    // ==================== 内存统计 ====================
+
+    /**
+     * @brief 统计各子系统的内存占用
+     * @return 内存占用报告
+     * @details 遍历全部会员和索引，耗时与会员数成正比，适合按需查看而非频繁调用
+     */
+    MemoryReport getMemoryReport() const;
+
+    // ==================== 主备复制 ====================
+
+    /**
+     * @brief 启用复制：开始向共享目录记录每次成功的修改
+     * @param directory 复制目录，不存在时创建
+     * @return STATUS_OK 或 STATUS_IO_ERROR
+     * @details 先把全部会员保存为新纪元的快照，再开始新的日志；备库加载快照后按序重放日志。
+     *          之后重新加载数据文件时自动开始新的纪元。
+     *          非批量模式下记录写入失败时，修改方法返回 STATUS_IO_ERROR（addMember 见 getReplicationLog().failed()）：
+     *          修改已在本机生效但没有进入日志，不能向客户确认；日志出错后的修改都这样返回
+     */
+    Status enableReplication(const std::string& directory);
+
+    /**
+     * @brief 设置复制日志的批量模式
+     * @param batching true 时记录留在内存中，由 flushReplication 一次写出（组提交）
+     */
+    void setReplicationBatching(bool batching);
+
+    /**
+     * @brief 把缓冲的复制记录写入日志文件
+     * @return true 成功或未启用复制；false 时本批修改没有进入日志，不能确认
+     */
+    bool flushReplication();
+
+    /**
+     * @brief 获取复制日志（只读）
+     */
+    const ReplicationLog& getReplicationLog() const;
+
+    /**
+     * @brief 在备库上重放一条复制记录
+     * @param record 主库记录的变更
+     * @return 重放结果；主库只记录成功的修改，非 STATUS_OK 说明备库与主库已不一致
+     * @details 新会员的ID必须等于备库的下一个会员ID，消费按记录中的时间入账
+     */
+    Status applyReplicationRecord(const ReplicationRecord& record);
+
+    /**
+     * @brief 恢复快照之外的状态（备库加载快照后调用）
+     * @param nextIdValue 下一个会员ID
+     * @param rule 积分规则
+     * @details 快照中没有已删除会员占用过的ID和积分规则，需从日志文件头恢复
+     */
+    void restoreReplicationState(int nextIdValue, int rule);
+
+private:
+    /**
+     * @brief 按指定时间添加消费记录
+     * @param id 会员ID
+     * @param amount 消费金额
+     * @param now 消费时间
+     * @return 结果码及本次消费的结算结果
+     */
+    SpendingResult addSpendingAt(int id, double amount, time_t now);
+
+    /**
+     * @brief 根据会员ID查找可修改的会员
+     * @param id 会员ID
+     * @return 会员指针，如果未找到则返回nullptr
+     */
+    Member* findMember(int id);
+
+    /**
+     * @brief 从磁盘调回一个休眠会员
+     * @param id 会员ID
+     * @return 调回后的会员指针，会员不在磁盘上时返回nullptr
+     * @details 追加到会员列表末尾并加入各项索引
+     */
+    Member* faultIn(int id);
+
+    /**
+     * @brief 获取按会员ID升序的会员下标
+     * @param positions 输出：会员下标
+     */
+    void idOrder(std::vector<size_t>& positions) const;
+
+    /**
+     * @brief 判断会员是否休眠
+     * @param member 会员对象
+     * @param year 当前年份
+     * @return true 有过消费且最近一次消费距今达到休眠阈值
+     */
+    bool isDormant(const Member& member, int year) const;
+
+    /**
+     * @brief 将会员加入各项索引
+     * @param member 会员对象
+     * @details 同时标记列式快照需要重建（会员的每次修改都经过这里或 unindexMember）
+     */
+    void indexMember(const Member& member);
+
+    /**
+     * @brief 将会员从各项索引中移除
+     * @param member 会员对象（须与加入索引时的状态一致）
+     */
+    void unindexMember(const Member& member);
+
+    /**
+     * @brief 计算会员在指定排行中的分值
+     * @param member 会员对象
+     * @param key 排序依据
+     * @return 排名分值
+     */
+    double rankScore(const Member& member, RankKey key) const;
+
+    /**
+     * @brief 重建全部索引
+     * @details 加载数据或批量删除后调用
+     */
+    void rebuildIndexes();
+
+    /**
+     * @brief 检查系统时间是否已进入新的年度
+     */
+    void checkYearRollover();
 };
\ No newline at end of file
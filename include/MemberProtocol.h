@@ -0,0 +1,236 @@
+#pragma once
+#include "Member.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class ProtocolWriter
+ * @brief 按协议格式向缓冲区追加帧
+ * @details 整数和浮点数一律按小端写出；字符串为 u16 长度 + 字节（超过 65535 字节的部分截断）
+ */
+class ProtocolWriter {
+public:
+    /**
+     * @brief 构造写入器
+     * @param out 输出缓冲区，帧追加到末尾
+     */
+    explicit ProtocolWriter(std::string& out) : out(out) {}
+
+    /**
+     * @brief 开始一帧：预留 4 字节长度
+     */
+    void beginFrame();
+
+    /**
+     * @brief 结束当前帧：回填长度
+     */
+    void endFrame();
+
+    ProtocolWriter& u8(uint8_t value);
+    ProtocolWriter& u16(uint16_t value);
+    ProtocolWriter& u32(uint32_t value);
+    ProtocolWriter& i32(int32_t value);
+    ProtocolWriter& u64(uint64_t value);
+    ProtocolWriter& i64(int64_t value);
+    ProtocolWriter& f64(double value);
+    ProtocolWriter& str(std::string_view value);
+
+private:
+    std::string& out;        ///< 输出缓冲区
+    size_t frameStart = 0;   ///< 当前帧长度字段的位置
+};
+
+/**
+ * @class ProtocolReader
+ * @brief 从一帧的负载中按顺序读取字段
+ * @details 读取越界时返回零值并把 ok() 置为 false，调用方读完全部字段后检查一次即可
+ */
+class ProtocolReader {
+public:
+    /**
+     * @brief 构造读取器
+     * @param data 负载起始位置
+     * @param size 负载字节数
+     */
+    ProtocolReader(const char* data, size_t size) : cursor(data), end(data + size) {}
+
+    uint8_t u8();
+    uint16_t u16();
+    uint32_t u32();
+    int32_t i32();
+    uint64_t u64();
+    int64_t i64();
+    double f64();
+    std::string_view str();
+
+    bool ok() const { return valid; }                       ///< 是否没有越界
+    bool atEnd() const { return valid && cursor == end; }   ///< 是否恰好读完
+
+private:
+    /**
+     * @brief 取出接下来的 size 个字节
+     * @return 起始位置，越界时返回空指针
+     */
+    const unsigned char* take(size_t size);
+
+    const char* cursor;   ///< 读取位置
+    const char* end;      ///< 负载末尾
+    bool valid = true;    ///< 是否没有越界
+};
+
+/**
+ * @class MemberProtocol
+ * @brief 会员服务的二进制请求协议
+ * @details 每个消息是一帧：4 字节小端负载长度 + 负载。
+ *          请求负载：操作码(u8) 请求号(u32) 参数；
+ *          响应负载：操作码(u8) 请求号(u32) 结果码(u8) 结果（仅结果码为 STATUS_OK 时有结果）。
+ *          结果码取 MemberManager::Status 的值，请求无法解析时为 STATUS_BAD_REQUEST。
+ *          客户端可以连续发送多个请求而不等待响应（流水线），服务端按收到的顺序逐个响应，请求号原样带回。
+ *          请求帧超过 MAX_REQUEST_SIZE 时服务端关闭连接。
+ */
+class MemberProtocol {
+public:
+    static constexpr uint32_t MAX_REQUEST_SIZE = 64 * 1024;  ///< 请求负载的最大字节数
+    static constexpr uint16_t MAX_RESULTS = 1000;            ///< 列表类查询最多返回的会员数
+    static constexpr uint8_t STATUS_BAD_REQUEST = 100;       ///< 操作码未知或参数无法解析
+
+    /**
+     * @brief 列表类查询实际使用的上限
+     * @param requested 请求中的上限（人数）
+     * @return 为 0（不限）或超过 MAX_RESULTS 时取 MAX_RESULTS，否则原样返回
+     * @details 管理器把上限 0 当作不限，服务端不能照传，否则一个请求可能返回全部会员
+     */
+    static uint16_t resultLimit(uint16_t requested) {
+        return (requested == 0 || requested > MAX_RESULTS) ? MAX_RESULTS : requested;
+    }
+
+    /**
+     * @enum Opcode
+     * @brief 操作码（参数 → 结果）
+     */
+    enum Opcode : uint8_t {
+        OP_PING = 0,                  ///< 无 → 无
+        OP_GET_BY_ID = 1,             ///< 会员ID(i32) → 会员记录
+        OP_GET_BY_PHONE = 2,          ///< 电话(str) → 会员记录
+        OP_ADD_SPENDING = 3,          ///< 会员ID(i32) 金额(f64) → 实付(f64) 折扣率(f64) 本次积分(i32) 累计积分(i32) 等级(u8)
+        OP_REDEEM_POINTS = 4,         ///< 会员ID(i32) 积分(i32) → 兑换积分(i32) 剩余积分(i32)
+        OP_FIND_BY_PHONE_PREFIX = 5,  ///< 上限(u16，0 按 MAX_RESULTS) 前缀(str) → 数量(u32) 会员ID(i32)×数量
+        OP_FIND_BY_NAME = 6,          ///< 上限(u16，0 按 MAX_RESULTS) 关键字(str) → 数量(u32) 会员ID(i32)×数量
+        OP_MEMBER_RANK = 7,           ///< 排序依据(u8) 会员ID(i32) → 名次(i32)
+        OP_TOP_MEMBERS = 8            ///< 排序依据(u8) 人数(u16，0 按 MAX_RESULTS) → 数量(u32) 会员ID(i32)×数量
+    };
+
+    /**
+     * @enum FrameState
+     * @brief 缓冲区开头的帧是否完整
+     */
+    enum FrameState {
+        FRAME_INCOMPLETE,  ///< 数据不足一帧
+        FRAME_READY,       ///< 有一帧完整的数据
+        FRAME_TOO_LARGE    ///< 帧长度超过上限
+    };
+
+    /**
+     * @struct MemberRecord
+     * @brief 响应中的会员记录
+     * @details 字段顺序：ID(i32) 姓名(str) 电话(str) 生日(str) 总消费(f64) 积分(i32)
+     *          积分规则(i32) 年度消费(f64) 等级(u8) 上次消费年份(i32)
+     */
+    struct MemberRecord {
+        int id = 0;
+        std::string name;
+        std::string phone;
+        std::string birthday;
+        double totalSpent = 0.0;
+        int points = 0;
+        int pointsPerDollar = 1;
+        double annualSpent = 0.0;
+        int level = 0;
+        int lastYear = 0;
+    };
+
+    /**
+     * @struct ResponseHeader
+     * @brief 响应负载的头部
+     */
+    struct ResponseHeader {
+        uint8_t opcode = 0;      ///< 操作码
+        uint32_t requestId = 0;  ///< 请求号
+        uint8_t status = 0;      ///< 结果码
+    };
+
+    /**
+     * @brief 检查缓冲区开头的帧
+     * @param data 缓冲区
+     * @param size 缓冲区字节数
+     * @param maxSize 负载的最大字节数
+     * @param payloadSize 输出：负载字节数（FRAME_READY 时有效）
+     * @return 帧状态
+     */
+    static FrameState peekFrame(const char* data, size_t size, uint32_t maxSize, uint32_t& payloadSize);
+
+    // ==================== 请求编码（客户端） ====================
+    // 以下函数各向 out 追加一个完整的请求帧，参数含义见 Opcode
+
+    static void requestPing(std::string& out, uint32_t requestId);
+    static void requestGetById(std::string& out, uint32_t requestId, int memberId);
+    static void requestGetByPhone(std::string& out, uint32_t requestId, std::string_view phone);
+    static void requestAddSpending(std::string& out, uint32_t requestId, int memberId, double amount);
+    static void requestRedeemPoints(std::string& out, uint32_t requestId, int memberId, int points);
+    static void requestFindByPhonePrefix(std::string& out, uint32_t requestId, std::string_view prefix, uint16_t limit);
+    static void requestFindByName(std::string& out, uint32_t requestId, std::string_view query, uint16_t limit);
+    static void requestMemberRank(std::string& out, uint32_t requestId, uint8_t key, int memberId);
+    static void requestTopMembers(std::string& out, uint32_t requestId, uint8_t key, uint16_t n);
+
+    // ==================== 响应编码与解码 ====================
+
+    /**
+     * @brief 写出响应头部（调用方已开始一帧）
+     * @param writer 写入器
+     * @param opcode 操作码
+     * @param requestId 请求号
+     * @param status 结果码
+     */
+    static void writeResponseHeader(ProtocolWriter& writer, uint8_t opcode, uint32_t requestId, uint8_t status);
+
+    /**
+     * @brief 写出会员记录
+     * @param writer 写入器
+     * @param member 会员
+     */
+    static void writeMember(ProtocolWriter& writer, const Member& member);
+
+    /**
+     * @brief 写出会员ID列表
+     * @param writer 写入器
+     * @param ids 会员ID
+     */
+    static void writeIds(ProtocolWriter& writer, const std::vector<int>& ids);
+
+    /**
+     * @brief 读取响应头部
+     * @param reader 读取器（位于负载开头）
+     * @param header 输出：响应头部
+     * @return true 读取成功
+     */
+    static bool readResponseHeader(ProtocolReader& reader, ResponseHeader& header);
+
+    /**
+     * @brief 读取会员记录
+     * @param reader 读取器
+     * @param record 输出：会员记录
+     * @return true 读取成功
+     */
+    static bool readMember(ProtocolReader& reader, MemberRecord& record);
+
+    /**
+     * @brief 读取会员ID列表
+     * @param reader 读取器
+     * @param ids 输出：会员ID
+     * @return true 读取成功
+     */
+    static bool readIds(ProtocolReader& reader, std::vector<int>& ids);
+};
@@ -0,0 +1,173 @@
+#pragma once
+#include "MemberManager.h"
+#include "MemberProtocol.h"
+#include "SharedMemoryTransport.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class MemberServer
+ * @brief 通过 Unix 域套接字或共享内存提供会员查询、消费和积分兑换的服务端
+ * @details 单线程 epoll 事件循环，独占一个 MemberManager，不需要加锁。
+ *          每轮事件循环先读完所有就绪连接的数据，再把收到的完整请求作为一批依次交给 MemberManager 执行，
+ *          最后把各连接的响应一次写出；客户端可以流水线发送请求，响应按请求顺序返回。
+ *          某个连接积压的响应过多时暂停读取它的请求，直到响应写出。
+ *          同机客户端还可以经共享内存环（SharedMemoryRegion）收发同样的帧：事件循环每轮轮询各槽位的请求环，
+ *          请求在环内原地解析，响应直接写入响应环；刚处理过共享内存请求时先自旋一小段时间再进入 epoll 等待，
+ *          等待期间客户端通过 futex 门铃唤醒（由一个只负责转发门铃的线程写 eventfd），不访问 MemberManager。
+ *          协议见 MemberProtocol。仅支持 Linux，其它平台 listen 返回 false。
+ */
+class MemberServer {
+public:
+    /**
+     * @struct Stats
+     * @brief 服务运行统计
+     */
+    struct Stats {
+        uint64_t connections = 0;   ///< 累计接受的连接数
+        uint64_t requests = 0;      ///< 累计处理的请求数
+        uint64_t batches = 0;       ///< 处理过请求的事件循环轮数
+        uint64_t largestBatch = 0;  ///< 单轮处理的最多请求数
+        uint64_t saves = 0;         ///< 自动保存次数
+        uint64_t sharedClients = 0; ///< 累计接入的共享内存客户端数
+    };
+
+    /**
+     * @brief 构造服务端
+     * @param manager 会员管理器，服务运行期间只能由服务线程访问
+     */
+    explicit MemberServer(MemberManager& manager);
+    ~MemberServer();
+    MemberServer(const MemberServer&) = delete;
+    MemberServer& operator=(const MemberServer&) = delete;
+
+    /**
+     * @brief 在指定路径上监听
+     * @param socketPath 套接字路径，已存在的同名套接字文件会被替换
+     * @return true 成功，false 失败（原因见 error()）
+     */
+    bool listen(const std::string& socketPath);
+
+    /**
+     * @brief 创建共享内存区，接受同机客户端
+     * @param name shm_open 名称，如 "/member_pos"；已存在的同名区域被替换
+     * @return true 成功，false 失败（原因见 error()）
+     * @details 可以和 listen 同时使用，也可以单独使用
+     */
+    bool listenSharedMemory(const std::string& name);
+
+    /**
+     * @brief 设置自动保存
+     * @param filename 数据文件
+     * @param intervalSeconds 有修改时的保存间隔（秒），0 表示不自动保存
+     */
+    void setAutosave(const std::string& filename, int intervalSeconds);
+
+    /**
+     * @brief 运行事件循环，直到 stop() 被调用或复制日志写入失败
+     * @details 复制日志写入失败时未确认的请求不再响应，返回后 error() 给出原因
+     */
+    void run();
+
+    /**
+     * @brief 请求停止事件循环
+     * @details 只写一次 eventfd，可在信号处理函数或其它线程中调用
+     */
+    void stop();
+
+    /**
+     * @brief 获取失败原因
+     */
+    const std::string& error() const { return lastError; }
+
+    /**
+     * @brief 获取运行统计
+     */
+    const Stats& stats() const { return counters; }
+
+    /**
+     * @brief 是否有上次保存之后的修改
+     */
+    bool modified() const { return dirty; }
+
+private:
+    /**
+     * @struct Connection
+     * @brief 一个客户端连接
+     */
+    struct Connection {
+        int fd = -1;
+        std::string input;        ///< 已收到、尚未处理的数据
+        std::string output;       ///< 待写出的响应
+        size_t outputSent = 0;    ///< output 中已写出的字节数
+        uint32_t events = 0;      ///< 当前在 epoll 中登记的事件
+        bool pending = false;     ///< 是否已在本轮的待处理列表中
+        bool peerClosed = false;  ///< 对端已关闭写方向，响应写完后关闭
+        bool closing = false;     ///< 出错，本轮结束时关闭
+    };
+
+    void acceptConnections();
+    void readConnection(Connection& connection);
+    size_t processRequests(Connection& connection);
+    void execute(ProtocolReader& request, uint8_t opcode, uint32_t requestId, std::string& out);
+    void flushConnection(Connection& connection);
+    void updateEvents(Connection& connection);
+    void markPending(Connection& connection);
+    bool finished(const Connection& connection) const;
+    void closeConnection(Connection& connection);
+    void autosave();
+    bool commitReplication();
+
+    /**
+     * @struct SharedClient
+     * @brief 服务端对一个共享内存槽位的记录
+     */
+    struct SharedClient {
+        SharedRing requests;    ///< 请求环
+        SharedRing responses;   ///< 响应环
+        std::string output;     ///< 响应环已满时暂存的一个响应帧
+        bool active = false;    ///< 是否已接入
+        bool broken = false;    ///< 请求环已损坏，不再处理该客户端的请求
+    };
+
+    bool openLoop();
+    size_t processSharedClients();
+    size_t processSharedClient(uint32_t index);
+    bool flushSharedClient(uint32_t index);
+    bool sharedWorkAvailable() const;
+    bool spinForSharedWork() const;
+    void reapSharedClients();
+    void releaseSharedClient(uint32_t index);
+    void doorbellLoop();
+
+    MemberManager& manager;                                            ///< 会员管理器
+    int listenFd = -1;                                                 ///< 监听套接字
+    int epollFd = -1;                                                  ///< epoll 实例
+    int wakeFd = -1;                                                   ///< 用于 stop() 的 eventfd
+    std::string socketPath;                                            ///< 套接字路径（退出时删除）
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;  ///< 按文件描述符索引的连接
+    std::vector<Connection*> pendingConnections;                       ///< 本轮需要处理的连接
+    std::vector<char> readBuffer;                                      ///< read 的缓冲区
+    std::vector<int> ids;                                              ///< 列表查询的结果缓冲
+    std::string lastError;                                             ///< 失败原因
+    Stats counters;                                                    ///< 运行统计
+    bool dirty = false;                                                ///< 是否有未保存的修改
+    bool replicationFailed = false;                                    ///< 复制日志写入失败，不再确认任何请求
+    std::string autosaveFile;                                          ///< 自动保存的数据文件
+    int autosaveSeconds = 0;                                           ///< 自动保存间隔
+    std::chrono::steady_clock::time_point lastSave;                    ///< 上次保存时间
+    std::unique_ptr<SharedMemoryRegion> region;                        ///< 共享内存区（未启用时为空）
+    std::vector<SharedClient> sharedClients;                           ///< 按槽位索引的共享内存客户端
+    size_t activeSharedClients = 0;                                    ///< 当前接入的共享内存客户端数
+    int doorbellFd = -1;                                               ///< 门铃线程唤醒事件循环的 eventfd
+    std::thread doorbellThread;                                        ///< 把 futex 门铃转发为 eventfd 的线程
+    std::atomic<bool> doorbellStop{false};                             ///< 通知门铃线程退出
+    std::chrono::steady_clock::time_point lastSharedActivity;          ///< 上次处理共享内存请求的时间
+    std::chrono::steady_clock::time_point lastReap;                    ///< 上次检查客户端进程是否存活的时间
+};
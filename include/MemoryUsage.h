@@ -0,0 +1,103 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @struct MemoryUsage
+ * @brief 一个子系统的内存占用
+ * @details 由各子系统遍历自己的容器统计得到：bytes 按容量计（实际向分配器申请的大小），
+ *          usedBytes 按元素数计，两者之差是已申请但未使用的预留空间，是内部碎片的主要来源。
+ *          哈希表的节点大小按 libstdc++ 的布局估算。
+ */
+struct MemoryUsage {
+    size_t bytes = 0;        ///< 占用字节（按容量计）
+    size_t usedBytes = 0;    ///< 其中实际使用的字节（按元素数计）
+    size_t objects = 0;      ///< 对象数量（会员数、记录数、索引项数等，含义由子系统决定）
+    size_t allocations = 0;  ///< 堆分配块数
+
+    MemoryUsage& operator+=(const MemoryUsage& other) {
+        bytes += other.bytes;
+        usedBytes += other.usedBytes;
+        objects += other.objects;
+        allocations += other.allocations;
+        return *this;
+    }
+
+    /**
+     * @brief 计入一块固定大小的内存（整块都在使用）
+     * @param size 字节数
+     */
+    void addBlock(size_t size) {
+        bytes += size;
+        usedBytes += size;
+        if (size > 0) {
+            ++allocations;
+        }
+    }
+
+    /**
+     * @brief 计入 vector 的元素存储（不含元素自身再分配的内存）
+     * @param vector 向量
+     */
+    template <typename T>
+    void addVector(const std::vector<T>& vector) {
+        if (vector.capacity() > 0) {
+            bytes += vector.capacity() * sizeof(T);
+            usedBytes += vector.size() * sizeof(T);
+            ++allocations;
+        }
+    }
+
+    /**
+     * @brief 计入字符串在堆上的存储
+     * @param text 字符串
+     * @details 短字符串存放在对象内部（SSO），不占堆内存，其大小已计入所在对象
+     */
+    void addString(const std::string& text) {
+        const char* data = text.data();
+        const char* self = reinterpret_cast<const char*>(&text);
+        if (data >= self && data < self + sizeof(text)) {
+            return;
+        }
+        bytes += text.capacity() + 1;
+        usedBytes += text.size() + 1;
+        ++allocations;
+    }
+
+    /**
+     * @brief 计入 unordered_map 的桶数组和节点（不含值自身再分配的内存）
+     * @param map 哈希表
+     * @details 每个节点按“后继指针 + 键值对”估算，每个节点是一次分配
+     */
+    template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+    void addUnorderedMap(const std::unordered_map<Key, Value, Hash, Equal, Allocator>& map) {
+        using Pair = typename std::unordered_map<Key, Value, Hash, Equal, Allocator>::value_type;
+        const size_t align = alignof(Pair) > alignof(void*) ? alignof(Pair) : alignof(void*);
+        const size_t node = (sizeof(void*) + sizeof(Pair) + align - 1) / align * align;
+        bytes += map.bucket_count() * sizeof(void*) + map.size() * node;
+        // 空桶视为预留未用
+        usedBytes += map.size() * node + (map.size() < map.bucket_count() ? map.size() : map.bucket_count()) * sizeof(void*);
+        allocations += map.size() + (map.bucket_count() > 1 ? 1 : 0);
+    }
+};
+
+/**
+ * @struct HeapStats
+ * @brief 进程堆的整体状态（来自 glibc 的 mallinfo2）
+ * @details 堆中空闲字节占比反映外部碎片：已释放但无法归还操作系统的内存
+ */
+struct HeapStats {
+    bool available = false;  ///< 当前平台是否支持
+    size_t heapBytes = 0;    ///< 主堆及其它 arena 向系统申请的字节数
+    size_t mmapBytes = 0;    ///< 大块直接 mmap 的字节数
+    size_t inUseBytes = 0;   ///< 已分配（在用）的字节数
+    size_t freeBytes = 0;    ///< 堆中空闲的字节数
+
+    /**
+     * @brief 读取当前进程的堆状态
+     * @return 堆状态，不支持的平台 available 为 false
+     */
+    static HeapStats read();
+};
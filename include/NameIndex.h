@@ -0,0 +1,127 @@
+#pragma once
+#include "Member.h"
+#include "MemoryUsage.h"
+#include <vector>
+#include <string>
+#include <utility>
+#include <string_view>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class NameIndex
+ * @brief 会员姓名倒排索引
+ * @details 以姓名中的单字（unigram）和相邻两字（bigram）为词项，
+ *          每个词项的会员ID列表升序存储，并以“差值 + 变长整数”压缩。
+ *          查询一个字时直接取单字列表；查询多个字时对所有相邻两字列表求交集得到候选，
+ *          再由调用方核对姓名中是否确实包含查询串。
+ *          新会员ID总是递增，因此新增会员只需在列表末尾追加；
+ *          较小的ID在字节流中原地拼接，不必整表重新编码。
+ *          词项按哈希分为若干分片，加载时各线程先分别抽取词项，再按分片并行构建。
+ */
+class NameIndex {
+public:
+    /**
+     * @brief 从会员列表整体构建索引
+     * @param members 会员列表
+     * @param threads 工作线程数，0 表示使用硬件并发数
+     */
+    void build(const std::vector<Member>& members, unsigned threads = 0) { build(members, {}, threads); }
+
+    /**
+     * @brief 从会员列表和另外一组姓名整体构建索引
+     * @param members 会员列表
+     * @param extra 不在会员列表中的（姓名, 会员ID），如休眠在磁盘上的会员
+     * @param threads 工作线程数，0 表示使用硬件并发数
+     */
+    void build(const std::vector<Member>& members, const std::vector<std::pair<std::string, int>>& extra,
+               unsigned threads = 0);
+
+    /**
+     * @brief 加入一个会员姓名
+     * @param name 姓名（本机编码）
+     * @param id 会员ID
+     */
+    void insert(std::string_view name, int id);
+
+    /**
+     * @brief 移除一个会员姓名
+     * @param name 加入时使用的姓名
+     * @param id 会员ID
+     */
+    void erase(std::string_view name, int id);
+
+    /**
+     * @brief 查询候选会员
+     * @param query 查询串（本机编码）
+     * @param out 输出：候选会员ID（升序），包含全部真正匹配的会员，多于两个字时可能含误报
+     */
+    void candidates(std::string_view query, std::vector<int>& out) const;
+
+    /**
+     * @brief 判断姓名是否包含查询串（按字比较）
+     * @param name 姓名
+     * @param query 查询串
+     * @return true 包含
+     */
+    static bool contains(std::string_view name, std::string_view query);
+
+    /**
+     * @brief 把文本按本机编码拆分为字
+     * @param text 文本
+     * @param out 输出：每个字的原始字节打包成的整数
+     */
+    static void splitCharacters(std::string_view text, std::vector<uint32_t>& out);
+
+    /**
+     * @brief 获取词项数量
+     */
+    size_t termCount() const;
+
+    /**
+     * @brief 获取压缩后的倒排列表总字节数
+     */
+    size_t postingBytes() const;
+
+    /**
+     * @brief 统计索引占用的内存
+     * @return 内存占用，对象数为词项数
+     */
+    MemoryUsage memoryUsage() const;
+
+    /**
+     * @brief 清空索引
+     */
+    void clear();
+
+private:
+    static constexpr int SHARD_BITS = 6;
+    static constexpr int SHARD_COUNT = 1 << SHARD_BITS;  ///< 分片数量
+
+    /**
+     * @struct Posting
+     * @brief 一个词项的压缩会员ID列表
+     */
+    struct Posting {
+        std::vector<uint8_t> bytes;  ///< 差值变长编码
+        uint32_t count = 0;          ///< 会员数量
+        int lastId = 0;              ///< 最后一个（最大的）会员ID，用于追加
+    };
+
+    using Shard = std::unordered_map<uint64_t, Posting>;
+
+    static int shardOf(uint64_t term) {
+        return static_cast<int>((term * 0x9E3779B97F4A7C15ULL) >> (64 - SHARD_BITS));
+    }
+    static void collectTerms(std::string_view name, std::vector<uint32_t>& characters, std::vector<uint64_t>& terms);
+    static void append(Posting& posting, int id);
+    static void encode(Posting& posting, const std::vector<int>& ids);
+    static void decode(const Posting& posting, std::vector<int>& out);
+    static size_t putVarint(uint32_t value, uint8_t* out);
+    static bool insertId(Posting& posting, int id);
+    static bool eraseId(Posting& posting, int id);
+    const Posting* find(uint64_t term) const;
+
+    Shard shards[SHARD_COUNT];  ///< 按词项哈希分片的倒排表
+};
@@ -0,0 +1,183 @@
+#pragma once
+#include "Member.h"
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @class OutputRenderer
+ * @brief 带缓冲的流式输出渲染器
+ * @details 所有行先格式化到一块可复用的大缓冲区，攒满后整块写出，
+ *          避免逐行 std::endl 造成的频繁刷新和系统调用。
+ *          支持人读的表格格式和机读的 CSV、JSON Lines 格式，并支持游标分页。
+ */
+class OutputRenderer {
+public:
+    /**
+     * @enum Format
+     * @brief 输出格式
+     */
+    enum Format {
+        FORMAT_TABLE,  ///< 表格（控制台显示）
+        FORMAT_CSV,    ///< 逗号分隔，首行为表头
+        FORMAT_JSONL   ///< 每行一个 JSON 对象
+    };
+
+    /**
+     * @struct Cursor
+     * @brief 分页游标
+     */
+    struct Cursor {
+        size_t offset = 0;    ///< 下一条记录的位置
+        size_t pageSize = 0;  ///< 每页条数，0 表示不分页
+        bool done = false;    ///< 是否已输出到末尾
+    };
+
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;  ///< 默认缓冲区大小
+
+    /**
+     * @brief 构造函数
+     * @param out 输出流
+     * @param format 输出格式
+     * @param bufferSize 缓冲区大小，攒满后整块写出
+     */
+    explicit OutputRenderer(std::ostream& out, Format format = FORMAT_TABLE,
+                            size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    /**
+     * @brief 析构函数，写出剩余内容
+     */
+    ~OutputRenderer();
+
+    OutputRenderer(const OutputRenderer&) = delete;
+    OutputRenderer& operator=(const OutputRenderer&) = delete;
+
+    // ==================== 基础写入 ====================
+
+    /**
+     * @brief 追加文本
+     * @param text 文本内容
+     * @return 渲染器自身，便于链式调用
+     */
+    OutputRenderer& text(std::string_view text);
+
+    /**
+     * @brief 追加整数
+     * @param value 整数值
+     * @return 渲染器自身
+     */
+    OutputRenderer& number(long long value);
+
+    /**
+     * @brief 追加定点小数
+     * @param value 数值
+     * @param precision 小数位数
+     * @return 渲染器自身
+     */
+    OutputRenderer& number(double value, int precision);
+
+    /**
+     * @brief 把自某位置起追加的内容左对齐补齐到指定字节宽度
+     * @param start 起始位置（由 mark() 返回）
+     * @param width 字节宽度，与 std::left << std::setw 行为一致
+     * @return 渲染器自身
+     */
+    OutputRenderer& padFrom(size_t start, size_t width);
+
+    /**
+     * @brief 获取当前缓冲区写入位置，配合 padFrom 使用
+     */
+    size_t mark() const;
+
+    /**
+     * @brief 结束一行
+     * @return 渲染器自身
+     * @details 只写换行符，不刷新；缓冲区满时整块写出
+     */
+    OutputRenderer& endLine();
+
+    /**
+     * @brief 写出缓冲区内容并刷新输出流
+     */
+    void flush();
+
+    /**
+     * @brief 是否为表格（人读）格式
+     */
+    bool isTable() const { return format == FORMAT_TABLE; }
+
+    // ==================== 会员渲染 ====================
+
+    /**
+     * @brief 输出表头（仅 CSV 格式有表头）
+     */
+    void memberHeader();
+
+    /**
+     * @brief 输出一个会员的完整信息
+     * @param member 会员对象
+     */
+    void member(const Member& member);
+
+    /**
+     * @brief 按游标分页输出会员列表
+     * @param members 会员列表
+     * @param cursor 分页游标，输出后前移
+     * @param order 输出顺序（会员下标），为空指针时按列表原有顺序
+     * @return 本页输出的会员数量
+     */
+    size_t members(const std::vector<Member>& members, Cursor& cursor, const std::vector<size_t>* order = nullptr);
+
+    /**
+     * @brief 输出会员的消费历史
+     * @param member 会员对象
+     * @param n 显示最近N次消费记录，-1表示显示全部
+     */
+    void consumptionHistory(const Member& member, int n);
+
+    /**
+     * @brief 输出消费记录的表头（CSV 表头，或表格标题与表头；没有记录时输出提示）
+     * @param count 将要输出的记录总条数
+     */
+    void historyBegin(size_t count);
+
+    /**
+     * @brief 输出一段消费记录
+     * @param records 消费记录 <原价, 折扣率>
+     * @param begin 从第几条开始输出
+     * @param firstNumber 第一条输出记录的序号
+     */
+    void historyRows(const std::vector<std::pair<double, double>>& records, size_t begin, size_t firstNumber);
+
+    /**
+     * @brief 输出消费记录的表尾
+     * @param count 已输出的记录总条数
+     */
+    void historyEnd(size_t count);
+
+    /**
+     * @brief 获取等级名称
+     * @param level 会员等级
+     * @return 等级中文名称
+     */
+    static const char* levelName(Member::Level level);
+
+private:
+    /**
+     * @brief 追加 JSON 字符串（含引号与转义）
+     * @param value 字符串内容
+     */
+    void jsonString(std::string_view value);
+
+    /**
+     * @brief 缓冲区超过阈值时整块写出
+     */
+    void maybeFlush();
+
+    std::ostream& out;    ///< 输出流
+    Format format;        ///< 输出格式
+    size_t bufferSize;    ///< 写出阈值
+    std::string buffer;   ///< 格式化缓冲区
+};
@@ -0,0 +1,38 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 获取默认工作线程数
+ * @return 硬件并发数，至少为1
+ */
+inline unsigned defaultThreadCount() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief 按范围把任务分给多个线程执行
+ * @param count 总数量
+ * @param threads 线程数
+ * @param task 任务函数，参数为 (线程序号, 起始下标, 结束下标)
+ * @param grain 数量少于该值时直接在当前线程执行，避免线程开销
+ */
+template <typename Task>
+void parallelFor(size_t count, unsigned threads, Task task, size_t grain = 4096) {
+    if (threads <= 1 || count < grain) {
+        task(0u, size_t(0), count);
+        return;
+    }
+    std::vector<std::thread> workers;
+    size_t chunk = (count + threads - 1) / threads;
+    for (unsigned t = 0; t < threads; ++t) {
+        size_t begin = std::min(count, t * chunk);
+        size_t end = std::min(count, begin + chunk);
+        workers.emplace_back(task, t, begin, end);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
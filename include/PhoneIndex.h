@@ -0,0 +1,124 @@
+#pragma once
+#include "MemoryUsage.h"
+#include <vector>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class PhoneIndex
+ * @brief 电话号码索引（前缀查询 + 后四位查询）
+ * @details 前缀查询使用路径压缩的十叉基数树：每条边最多保存16位数字，
+ *          按4位一位压缩在一个64位整数中，只在号码分叉处建立节点，节点数不超过号码数的两倍。
+ *          每个节点记录子树中的会员数，前缀查询为 O(号码长度 + 返回数量)。
+ *          后四位查询使用以后四位数字为下标的 10000 个桶。
+ *          节点和会员ID链表都存放在连续数组中并复用空闲槽位。
+ *          只索引由 1-16 位数字组成的号码，其它号码不进入索引。
+ */
+class PhoneIndex {
+public:
+    static constexpr size_t MAX_DIGITS = 16;        ///< 可索引的最大号码长度
+    static constexpr int SUFFIX_BUCKETS = 10000;    ///< 后四位桶数量
+
+    PhoneIndex();
+
+    /**
+     * @brief 加入一个号码
+     * @param phone 电话号码
+     * @param id 会员ID
+     */
+    void insert(std::string_view phone, int id);
+
+    /**
+     * @brief 移除一个号码
+     * @param phone 加入时使用的电话号码
+     * @param id 会员ID
+     * @return true 移除成功，false 记录不存在
+     */
+    bool erase(std::string_view phone, int id);
+
+    /**
+     * @brief 精确查询
+     * @param phone 完整电话号码
+     * @param out 输出：号码完全相同的会员ID（追加）
+     */
+    void exact(std::string_view phone, std::vector<int>& out) const;
+
+    /**
+     * @brief 前缀查询
+     * @param prefix 号码前缀（数字）
+     * @param limit 最多输出的数量，0 表示不限
+     * @param out 输出：匹配的会员ID，按号码升序（追加）
+     * @return 匹配的会员总数（不受 limit 限制）
+     */
+    size_t prefix(std::string_view prefix, size_t limit, std::vector<int>& out) const;
+
+    /**
+     * @brief 后四位查询
+     * @param lastFour 号码后四位（4位数字）
+     * @return 后四位相同的会员ID，参数无效时返回空列表
+     */
+    const std::vector<int>& suffix(std::string_view lastFour) const;
+
+    /**
+     * @brief 获取已索引的号码数量
+     */
+    size_t size() const;
+
+    /**
+     * @brief 统计索引占用的内存
+     * @return 内存占用，对象数为已索引的号码数
+     */
+    MemoryUsage memoryUsage() const;
+
+    /**
+     * @brief 清空索引
+     */
+    void clear();
+
+    /**
+     * @brief 判断号码能否被索引
+     * @param phone 电话号码
+     * @return true 由 1-16 位数字组成
+     */
+    static bool indexable(std::string_view phone);
+
+private:
+    /**
+     * @struct Node
+     * @brief 基数树节点
+     */
+    struct Node {
+        uint64_t label;       ///< 从父节点到本节点的数字，第 i 位数字存放在第 4i 位起的4位中
+        uint8_t length;       ///< 边上的数字个数
+        int32_t firstChild;   ///< 第一个子节点（子节点按首位数字升序），-1 表示无
+        int32_t nextSibling;  ///< 下一个兄弟节点，-1 表示无
+        int32_t ids;          ///< 号码恰好在此结束的会员ID链表头，-1 表示无
+        uint32_t count;       ///< 子树中的会员数
+    };
+
+    /**
+     * @struct IdEntry
+     * @brief 会员ID链表项
+     */
+    struct IdEntry {
+        int id;        ///< 会员ID
+        int32_t next;  ///< 下一项，-1 表示结束
+    };
+
+    static int digitAt(uint64_t label, size_t i) { return static_cast<int>((label >> (4 * i)) & 0xF); }
+    static uint64_t pack(std::string_view digits);
+    static int suffixKey(std::string_view phone);
+
+    int32_t allocateNode(uint64_t label, uint8_t length);
+    void freeNode(int32_t node);
+    int32_t findChild(int32_t node, int digit, int32_t* previous) const;
+    int32_t locate(std::string_view digits, bool exactNode) const;
+    void mergeWithChild(int32_t node);
+
+    std::vector<Node> nodes;                     ///< 节点池，下标0为根
+    std::vector<int32_t> freeNodes;              ///< 可复用的空闲节点下标
+    std::vector<IdEntry> entries;                ///< ID链表项池
+    std::vector<int32_t> freeEntries;            ///< 可复用的空闲链表项下标
+    std::vector<std::vector<int>> suffixBuckets; ///< 后四位 -> 会员ID
+};
@@ -0,0 +1,244 @@
+#pragma once
+#include "MemberManager.h"
+#include "MemberServer.h"
+#include "OutputRenderer.h"
+#include <ostream>
+#include <string>
+
+/**
+ * @class Presenter
+ * @brief 控制台展示层
+ * @details 把 MemberManager 返回的结果码和结算结果转换为面向用户的中文提示，
+ *          核心接口本身不输出任何内容，可在批量导入或嵌入其它进程时直接调用。
+ */
+class Presenter {
+public:
+    /**
+     * @brief 构造函数
+     * @param out 输出流
+     */
+    explicit Presenter(std::ostream& out);
+
+    // ==================== 操作结果提示 ====================
+
+    /**
+     * @brief 提示会员添加结果
+     * @param status 结果码（STATUS_IO_ERROR 表示复制日志写入失败）
+     * @param name 会员姓名
+     * @param id 新会员ID
+     */
+    void memberAdded(MemberManager::Status status, const std::string& name, int id);
+
+    /**
+     * @brief 提示会员删除结果
+     * @param status 结果码
+     * @param name 会员姓名（删除前获取）
+     * @param id 会员ID
+     */
+    void memberDeleted(MemberManager::Status status, const std::string& name, int id);
+
+    /**
+     * @brief 提示电话修改结果
+     * @param status 结果码
+     * @param id 会员ID
+     * @param newPhone 新的电话号码
+     */
+    void phoneUpdated(MemberManager::Status status, int id, const std::string& newPhone);
+
+    /**
+     * @brief 提示消费结算结果
+     * @param result 添加消费的结果
+     */
+    void spendingAdded(const MemberManager::SpendingResult& result);
+
+    /**
+     * @brief 提示积分兑换结果
+     * @param result 积分兑换的结果
+     */
+    void pointsRedeemed(const MemberManager::RedeemResult& result);
+
+    /**
+     * @brief 提示休眠会员转存结果
+     * @param status 启用冷热分层的结果码
+     * @param evicted 本次转存的会员数
+     * @param coldTotal 磁盘上的会员总数
+     */
+    void dormantEvicted(MemberManager::Status status, size_t evicted, size_t coldTotal);
+
+    /**
+     * @brief 提示生日积分奖励的发放结果
+     * @param result 批量赠送的结果
+     */
+    void birthdayBonusGranted(const MemberManager::BonusResult& result);
+
+    /**
+     * @brief 提示积分规则设置结果
+     * @param status 结果码
+     * @param rule 新的积分规则
+     */
+    void pointsRuleChanged(MemberManager::Status status, int rule);
+
+    /**
+     * @brief 提示数据保存结果
+     * @param status 结果码
+     * @param filename 文件名
+     */
+    void dataSaved(MemberManager::Status status, const std::string& filename);
+
+    /**
+     * @brief 提示数据加载结果
+     * @param status 结果码
+     * @param filename 文件名
+     */
+    void dataLoaded(MemberManager::Status status, const std::string& filename);
+
+    // ==================== 会员信息展示 ====================
+
+    /**
+     * @brief 按游标分页输出会员列表
+     * @param manager 会员管理器
+     * @param renderer 输出渲染器（决定输出格式和目标）
+     * @param cursor 分页游标，输出后前移
+     * @param order 输出顺序（由 MemberManager::sortMembers 得到），为空指针时按会员ID
+     * @details 表格格式在第一页前输出标题和总人数，CSV 格式在第一页前输出表头
+     */
+    static void memberList(const MemberManager& manager, OutputRenderer& renderer, OutputRenderer::Cursor& cursor,
+                           const std::vector<size_t>* order = nullptr);
+
+    /**
+     * @brief 显示会员完整信息
+     * @param member 会员指针，为空时提示未找到
+     */
+    void memberCard(const Member* member);
+
+    /**
+     * @brief 显示电话号码或姓名查询的候选会员
+     * @param manager 会员管理器
+     * @param ids 要显示的候选会员ID
+     * @param total 候选总数（可能多于显示的数量）
+     * @param notFoundMessage 没有候选时的提示
+     * @details 只有一个候选时直接显示会员完整信息
+     */
+    void memberCandidates(const MemberManager& manager, const std::vector<int>& ids, size_t total,
+                          const char* notFoundMessage);
+
+    /**
+     * @brief 显示会员消费历史
+     * @param manager 会员管理器，用于读取已归档年度的记录
+     * @param member 会员指针，为空时提示未找到
+     * @param n 显示最近N次消费记录，-1表示显示全部
+     * @details 内存中的记录不足时按年度从新到旧读取归档补足，逐年读出、逐年输出
+     */
+    void spendingHistory(const MemberManager& manager, const Member* member, int n);
+
+    // ==================== 性能统计 ====================
+
+    /**
+     * @brief 显示各操作的耗时统计
+     * @details 只列出有记录的操作：次数、p50、p99、p99.9 及最大耗时；
+     *          开启过硬件计数的操作另列每次操作的平均周期、指令、IPC、缓存未命中和分支预测失败
+     */
+    void perfStats();
+
+    /**
+     * @brief 显示硬件计数的开启状态
+     * @param on 是否开启
+     */
+    void hardwareCounting(bool on);
+
+    /**
+     * @brief 提示硬件计数器不可用
+     * @param reason 不可用的原因
+     */
+    void hardwareCountersUnavailable(const char* reason);
+
+    /**
+     * @brief 提示性能统计导出结果
+     * @param success 是否写入成功
+     * @param filename 文件名
+     */
+    void perfStatsExported(bool success, const std::string& filename);
+
+    /**
+     * @brief 提示时间线导出结果
+     * @param success 是否写入成功
+     * @param events 导出的阶段数
+     * @param filename 文件名
+     */
+    void traceExported(bool success, size_t events, const std::string& filename);
+
+    /**
+     * @brief 显示内存占用报告
+     * @param report 由 MemberManager::getMemoryReport 得到的报告
+     * @details 按子系统列出字节数、每会员字节数、对象数和预留未用比例，再给出消费历史长度、磁盘占用和进程堆状态
+     */
+    void memoryReport(const MemberManager::MemoryReport& report);
+
+    // ==================== 服务模式 ====================
+
+    /**
+     * @brief 提示服务已启动
+     * @param socketPath 套接字路径，为空表示未监听套接字
+     * @param shmName 共享内存区名称，为空表示未启用
+     * @param members 已加载的会员数
+     */
+    void serverStarted(const std::string& socketPath, const std::string& shmName, size_t members);
+
+    /**
+     * @brief 提示服务无法启动
+     * @param reason 原因
+     */
+    void serverFailed(const std::string& reason);
+
+    /**
+     * @brief 提示服务因错误停止
+     * @param reason 原因
+     */
+    void serverAborted(const std::string& reason);
+
+    /**
+     * @brief 提示服务已停止
+     * @param stats 运行统计
+     * @param dataFile 数据文件，为空表示未指定
+     * @param saved 退出时的保存是否成功（没有修改时为 true）
+     */
+    void serverStopped(const MemberServer::Stats& stats, const std::string& dataFile, bool saved);
+
+    /**
+     * @brief 提示备库已开始跟随主库
+     * @param directory 复制目录
+     * @param members 快照中的会员数
+     */
+    void standbyStarted(const std::string& directory, size_t members);
+
+    /**
+     * @brief 提示备库已提升为主库
+     * @param sequence 已重放的最后一条记录的序号
+     * @param members 会员数
+     */
+    void standbyPromoted(uint32_t sequence, size_t members);
+
+    /**
+     * @brief 提示备库已停止
+     * @param sequence 已重放的最后一条记录的序号
+     * @param reloads 因主库开始新纪元而重新加载快照的次数
+     */
+    void standbyStopped(uint32_t sequence, uint64_t reloads);
+
+    /**
+     * @brief 获取结果码对应的通用提示
+     * @param status 结果码
+     * @return 中文提示信息
+     */
+    static const char* statusMessage(MemberManager::Status status);
+
+private:
+    /**
+     * @brief 获取修改操作失败时的提示
+     * @param status 结果码
+     * @return 中文提示信息；STATUS_IO_ERROR 表示修改已在本机生效但复制日志写入失败
+     */
+    static const char* mutationMessage(MemberManager::Status status);
+
+    std::ostream& out;  ///< 输出流
+};
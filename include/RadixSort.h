@@ -0,0 +1,32 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+/**
+ * @class RadixSort
+ * @brief 64 位排序键的并行基数排序
+ * @details 以 11 位为一个数位，从低到高最多做 6 趟稳定的计数排序（LSD），
+ *          每趟 2048 个桶，直方图仍能放进一级缓存。
+ *          开始前遍历一次找出所有元素取值都相同的数位，这些数位直接跳过，
+ *          例如金额类排序键的高位通常全部为 0。
+ *          每一趟先由各线程统计自己那一段的直方图，再按（数位值, 线程序号）求前缀和，
+ *          最后各线程把自己那一段写到目标位置，整个过程无需加锁且保持稳定。
+ */
+class RadixSort {
+public:
+    /**
+     * @struct Entry
+     * @brief 待排序的元素
+     */
+    struct Entry {
+        uint64_t key;       ///< 排序键，按无符号整数升序
+        uint32_t position;  ///< 元素在原列表中的下标
+    };
+
+    /**
+     * @brief 按排序键升序排序（稳定）
+     * @param entries 待排序元素，排序键相同时保持原有顺序
+     * @param threads 工作线程数，0 表示使用硬件并发数
+     */
+    static void sort(std::vector<Entry>& entries, unsigned threads = 0);
+};
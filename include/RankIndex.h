@@ -0,0 +1,95 @@
+#pragma once
+#include "MemoryUsage.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class RankIndex
+ * @brief 顺序统计索引（带子树规模的 Treap）
+ * @details 以 (分值降序, 会员ID升序) 为键维护全部会员，
+ *          插入、删除、名次查询均为 O(log N)，前 K 名查询为 O(K + log N)。
+ *          节点存放在连续数组中并复用空闲槽位，避免频繁的小块分配。
+ */
+class RankIndex {
+public:
+    /**
+     * @brief 插入一条记录
+     * @param score 排名分值（越大越靠前）
+     * @param id 会员ID（分值相同时ID小者靠前）
+     */
+    void insert(double score, int id);
+
+    /**
+     * @brief 删除一条记录
+     * @param score 插入时使用的分值
+     * @param id 会员ID
+     * @return true 删除成功，false 记录不存在
+     */
+    bool erase(double score, int id);
+
+    /**
+     * @brief 查询记录的名次
+     * @param score 记录的分值
+     * @param id 会员ID
+     * @return 从1开始的名次，记录不存在时返回0
+     */
+    size_t rankOf(double score, int id) const;
+
+    /**
+     * @brief 获取前K名
+     * @param k 需要的数量
+     * @param out 输出的会员ID（按名次排列）
+     */
+    void topK(size_t k, std::vector<int>& out) const;
+
+    /**
+     * @brief 获取记录总数
+     * @return 记录数量
+     */
+    size_t size() const;
+
+    /**
+     * @brief 统计索引占用的内存
+     * @return 内存占用，对象数为记录数
+     */
+    MemoryUsage memoryUsage() const;
+
+    /**
+     * @brief 清空索引
+     */
+    void clear();
+
+private:
+    /**
+     * @struct Node
+     * @brief Treap 节点
+     */
+    struct Node {
+        double score;       ///< 排名分值
+        int id;             ///< 会员ID
+        uint32_t priority;  ///< 堆优先级（随机）
+        int32_t left;       ///< 左子节点下标，-1 表示空
+        int32_t right;      ///< 右子节点下标，-1 表示空
+        uint32_t size;      ///< 子树节点数
+    };
+
+    /**
+     * @brief 判断键 (s1, id1) 是否排在 (s2, id2) 之前
+     */
+    static bool before(double s1, int id1, double s2, int id2) {
+        return s1 > s2 || (s1 == s2 && id1 < id2);
+    }
+
+    uint32_t sizeOf(int32_t t) const { return t < 0 ? 0 : nodes[t].size; }
+    void update(int32_t t) { nodes[t].size = 1 + sizeOf(nodes[t].left) + sizeOf(nodes[t].right); }
+    uint32_t nextPriority();
+    int32_t allocate(double score, int id);
+    void split(int32_t t, double score, int id, int32_t& l, int32_t& r);
+    int32_t merge(int32_t l, int32_t r);
+
+    std::vector<Node> nodes;         ///< 节点池
+    std::vector<int32_t> freeSlots;  ///< 可复用的空闲节点下标
+    int32_t root = -1;               ///< 根节点下标
+    uint32_t seed = 0x9E3779B9u;     ///< 优先级随机数状态
+};
@@ -0,0 +1,215 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+class MemberManager;
+
+/**
+ * @struct ReplicationRecord
+ * @brief 复制日志中的一条变更记录
+ * @details 只记录成功的修改，备库按序号依次重放即可得到与主库相同的状态。
+ *          消费记录带上主库的消费时间，重放结果不受备库时钟影响；
+ *          生日奖励按实际获奖的会员逐条记录，不依赖备库的生日索引和冷热分层状态
+ */
+struct ReplicationRecord {
+    /**
+     * @enum Type
+     * @brief 变更类型（使用的字段）
+     */
+    enum Type : uint8_t {
+        ADD_MEMBER = 1,       ///< id name phone birthday
+        DELETE_MEMBER = 2,    ///< id
+        UPDATE_PHONE = 3,     ///< id phone
+        ADD_SPENDING = 4,     ///< id amount time
+        REDEEM_POINTS = 5,    ///< id value（兑换的积分）
+        SET_POINTS_RULE = 6,  ///< value（积分规则）
+        ADD_BONUS = 8         ///< id value（奖励的积分）；7 为旧版按生日范围记录的奖励，已不再使用
+    };
+
+    uint32_t sequence = 0;    ///< 序号，从1开始连续递增
+    Type type = ADD_MEMBER;   ///< 变更类型
+    int id = 0;               ///< 会员ID
+    std::string name;         ///< 姓名
+    std::string phone;        ///< 电话
+    std::string birthday;     ///< 生日
+    double amount = 0.0;      ///< 消费金额
+    int64_t time = 0;         ///< 消费时间（time_t）
+    int value = 0;            ///< 积分、积分规则或奖励积分
+};
+
+/**
+ * @class ReplicationLog
+ * @brief 主库的复制日志：把每次修改追加到共享目录中的日志文件
+ * @details 目录中的文件：
+ *          - snapshot-<纪元>.dat：开始记录时的全部会员（与 members.dat 格式相同）；
+ *          - mutations.log：文件头（纪元、下一个会员ID、积分规则）+ 按序号排列的变更记录。
+ *          每条记录是一帧（4 字节小端长度 + 负载，与 MemberProtocol 相同）。
+ *          开始新纪元时先写快照，再以临时文件改名的方式替换日志，备库发现纪元变化后重新加载快照。
+ *          默认每条记录立即写入文件（进入内核，进程崩溃不丢失）；批量模式下由调用方在一批修改后 flush 一次
+ */
+class ReplicationLog {
+public:
+    static constexpr uint32_t MAGIC = 0x4C52424D;        ///< 文件头标识 "MBRL"
+    static constexpr uint32_t VERSION = 2;               ///< 格式版本（2：生日奖励改为逐会员记录）
+    static constexpr uint32_t MAX_RECORD_SIZE = 1 << 20; ///< 单条记录负载的上限
+
+    /**
+     * @struct Header
+     * @brief 日志文件头
+     */
+    struct Header {
+        uint64_t epoch = 0;   ///< 纪元：每次开始记录时生成，对应同名快照
+        int nextId = 1;       ///< 快照时的下一个会员ID
+        int pointsRule = 1;   ///< 快照时的积分规则
+    };
+
+    ReplicationLog() = default;
+    ReplicationLog(const ReplicationLog&) = delete;
+    ReplicationLog& operator=(const ReplicationLog&) = delete;
+
+    /**
+     * @brief 开始新的日志（调用方已写好该纪元的快照）
+     * @param directory 复制目录（须已存在）
+     * @param header 文件头
+     * @return true 成功
+     * @details 删除更早纪元的快照，只保留本纪元和上一纪元的（正在加载上一纪元快照的备库不受影响）
+     */
+    bool open(const std::string& directory, const Header& header);
+
+    /**
+     * @brief 停止记录（文件保留）
+     */
+    void close();
+
+    bool isOpen() const { return file.is_open(); }
+    bool isBatching() const { return batching; }
+    bool failed() const { return file.is_open() && !file; }
+    const std::string& directory() const { return dir; }
+    uint32_t lastSequence() const { return sequence; }
+
+    /**
+     * @brief 追加一条记录（序号由日志分配）
+     * @param record 变更记录
+     * @return false 非批量模式下写入文件失败（批量模式下总是 true，由 flush 报告）
+     */
+    bool append(ReplicationRecord record);
+
+    /**
+     * @brief 把缓冲的记录写入文件
+     * @return true 成功
+     * @details 写入失败后日志停在出错的位置（见 failed()），之后的记录都被丢弃、flush 都返回 false，
+     *          直到下次 open 开始新纪元
+     */
+    bool flush();
+
+    /**
+     * @brief 设置批量模式
+     * @param batching true 时记录留在缓冲区，直到 flush
+     */
+    void setBatching(bool batching);
+
+    /**
+     * @brief 生成新的纪元
+     */
+    static uint64_t newEpoch();
+
+    /**
+     * @brief 获取日志文件路径
+     */
+    static std::string logPath(const std::string& directory);
+
+    /**
+     * @brief 获取指定纪元的快照路径
+     */
+    static std::string snapshotPath(const std::string& directory, uint64_t epoch);
+
+    /**
+     * @brief 编码一条记录（一帧）并追加到 out
+     */
+    static void encode(const ReplicationRecord& record, std::string& out);
+
+    /**
+     * @brief 解码一条记录的负载
+     * @return true 格式正确
+     */
+    static bool decode(const char* payload, size_t size, ReplicationRecord& record);
+
+    /**
+     * @brief 编码文件头（一帧）并追加到 out
+     */
+    static void encodeHeader(const Header& header, std::string& out);
+
+    /**
+     * @brief 解码文件头的负载
+     * @return true 格式正确
+     */
+    static bool decodeHeader(const char* payload, size_t size, Header& header);
+
+private:
+    std::ofstream file;       ///< 日志文件
+    std::string dir;          ///< 复制目录
+    std::string buffer;       ///< 尚未写入文件的记录
+    uint32_t sequence = 0;    ///< 最近一条记录的序号
+    bool batching = false;    ///< 是否批量写入
+};
+
+/**
+ * @class ReplicationFollower
+ * @brief 备库：从复制目录加载快照并持续重放主库追加的记录
+ * @details 每次 poll 读取日志新增的部分，只重放完整的记录（主库写到一半的记录留到下次）。
+ *          发现日志已换成新纪元（主库重新开始记录）时重新加载新快照。
+ *          提升为主库时不需要重新加载：内存中的 MemberManager 已是最新状态
+ */
+class ReplicationFollower {
+public:
+    /**
+     * @brief 构造备库
+     * @param manager 会员管理器，其内容会被快照替换
+     */
+    explicit ReplicationFollower(MemberManager& manager) : manager(manager) {}
+
+    /**
+     * @brief 打开复制目录：读取日志文件头并加载对应纪元的快照
+     * @param directory 复制目录
+     * @return true 成功，false 失败（原因见 error()）
+     */
+    bool open(const std::string& directory);
+
+    /**
+     * @brief 重放日志新增的记录
+     * @return 本次重放的记录数
+     * @details 没有新数据时检查日志是否已换成新纪元；出错后不再重放（见 failed()）
+     */
+    size_t poll();
+
+    bool failed() const { return !lastError.empty(); }
+    const std::string& error() const { return lastError; }
+    uint64_t epoch() const { return header.epoch; }
+    uint32_t lastSequence() const { return sequence; }
+    uint64_t reloads() const { return reloadCount; }
+
+private:
+    /**
+     * @brief 检查日志是否已换成新纪元，是则重新加载
+     * @return true 已重新加载
+     */
+    bool checkNewEpoch();
+
+    /**
+     * @brief 把日志文件中新增的数据读入缓冲区
+     * @return 读到的字节数
+     */
+    size_t readAvailable();
+
+    MemberManager& manager;             ///< 会员管理器
+    std::string dir;                    ///< 复制目录
+    std::ifstream file;                 ///< 日志文件
+    std::string buffer;                 ///< 已读取、尚未重放的数据
+    ReplicationLog::Header header;      ///< 当前纪元的文件头
+    uint32_t sequence = 0;              ///< 已重放的最后一条记录的序号
+    uint64_t reloadCount = 0;           ///< 因新纪元重新加载快照的次数
+    std::chrono::steady_clock::time_point lastEpochCheck;  ///< 上次检查纪元的时间
+    std::string lastError;              ///< 失败原因
+};
@@ -0,0 +1,267 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @struct SharedRingHeader
+ * @brief 共享内存中一个环形缓冲区的控制字段
+ * @details 生产者、消费者各写一个计数器，分处不同缓存行，避免互相失效
+ */
+struct SharedRingHeader {
+    alignas(64) std::atomic<uint32_t> head{0};     ///< 生产者已写入的字节总数（模 2^32），也是消费者等待的 futex 字
+    alignas(64) std::atomic<uint32_t> tail{0};     ///< 消费者已释放的字节总数（模 2^32）
+    alignas(64) std::atomic<uint32_t> waiting{0};  ///< 消费者正在 futex 上等待，生产者写入后需要唤醒
+};
+
+/**
+ * @class SharedRing
+ * @brief 放在共享内存中的单生产者单消费者字节环，记录为 MemberProtocol 帧
+ * @details 每帧（4 字节长度 + 负载）按 4 字节对齐连续存放；环尾放不下时写一个回绕标记从头开始，
+ *          因此消费者总能在环内直接解析一帧，不需要拷贝。
+ *          快速路径只有原子读写，没有系统调用；只有消费者已登记等待时生产者才调用 futex 唤醒。
+ *          本类只是共享内存的视图，不拥有内存，复制无妨
+ */
+class SharedRing {
+public:
+    SharedRing() = default;
+
+    /**
+     * @brief 绑定到共享内存
+     * @param header 控制字段
+     * @param data 数据区
+     * @param capacity 数据区字节数，必须是 2 的幂且不小于 4
+     */
+    SharedRing(SharedRingHeader* header, char* data, uint32_t capacity)
+        : header(header), data(data), capacity(capacity) {}
+
+    /**
+     * @brief 清空（只能在生产者和消费者都不访问时调用）
+     */
+    void reset();
+
+    /**
+     * @brief 写入一帧（生产者）
+     * @param frame 完整的帧
+     * @return false 剩余空间不足，未写入
+     */
+    bool push(std::string_view frame);
+
+    /**
+     * @brief 查看下一帧（消费者）
+     * @param size 输出：负载字节数
+     * @return 负载起始位置（位于共享内存中，pop 之前有效），没有数据或环已损坏时返回空指针
+     */
+    const char* front(uint32_t& size);
+
+    /**
+     * @brief 是否发现帧长度越界（对端写坏了环）
+     */
+    bool corrupt() const { return corrupted; }
+
+    /**
+     * @brief 释放 front 返回的帧（消费者）
+     */
+    void pop();
+
+    /**
+     * @brief 是否没有可读的帧
+     */
+    bool empty() const;
+
+    /**
+     * @brief 消费者已登记等待时唤醒它（生产者写入一批帧后调用一次）
+     */
+    void wakeConsumer();
+
+    /**
+     * @brief 等待可读的帧（消费者）
+     * @param timeoutMs 超时（毫秒），-1 表示一直等待
+     * @return true 有可读的帧
+     * @details 多核时先自旋一小段时间，仍为空才登记等待并在 futex 上睡眠
+     */
+    bool waitForData(int timeoutMs);
+
+    /**
+     * @brief 自旋等待对端是否有意义（至少两个 CPU）
+     */
+    static bool spinUseful();
+
+    /**
+     * @brief 在 futex 字上等待，直到它不等于 expected、被唤醒或超时
+     * @param word futex 字（位于共享内存中）
+     * @param expected 期望值
+     * @param timeoutMs 超时（毫秒），-1 表示一直等待
+     */
+    static void futexWait(std::atomic<uint32_t>& word, uint32_t expected, int timeoutMs);
+
+    /**
+     * @brief 唤醒在 futex 字上等待的全部线程（跨进程）
+     * @param word futex 字
+     */
+    static void futexWake(std::atomic<uint32_t>& word);
+
+private:
+    SharedRingHeader* header = nullptr;  ///< 控制字段
+    char* data = nullptr;                ///< 数据区
+    uint32_t capacity = 0;               ///< 数据区字节数
+    uint32_t frontSize = 0;              ///< front 返回的帧占用的字节数（含对齐）
+    bool corrupted = false;              ///< 是否发现帧长度越界
+};
+
+/**
+ * @class SharedMemoryRegion
+ * @brief 会员服务的共享内存区：若干客户端槽位，每个槽位一对请求环 / 响应环
+ * @details 布局：区头 | 槽位控制字段 × 槽位数 | (请求环数据, 响应环数据) × 槽位数。
+ *          服务端用 create 创建（shm_open），客户端用 open 映射同名区域并认领一个空闲槽位。
+ *          槽位状态：FREE → CLAIMING（客户端清空环）→ ACTIVE → CLOSING（客户端退出）→ FREE（服务端回收）。
+ *          客户端进程异常退出时，服务端按记录的进程号发现并回收其槽位。仅支持 Linux
+ */
+class SharedMemoryRegion {
+public:
+    static constexpr uint32_t MAGIC = 0x4D424D53;          ///< 区头标识 "SMBM"
+    static constexpr uint32_t VERSION = 1;                 ///< 布局版本
+    static constexpr uint32_t DEFAULT_SLOTS = 16;          ///< 默认槽位数
+    static constexpr uint32_t RING_CAPACITY = 256 * 1024;  ///< 每个环的字节数，放得下最大的请求帧和响应帧
+
+    /**
+     * @enum SlotState
+     * @brief 槽位状态
+     */
+    enum SlotState : uint32_t {
+        SLOT_FREE = 0,      ///< 空闲
+        SLOT_CLAIMING = 1,  ///< 客户端已认领，正在初始化
+        SLOT_ACTIVE = 2,    ///< 使用中
+        SLOT_CLOSING = 3    ///< 客户端已退出，等待服务端回收
+    };
+
+    /**
+     * @struct Header
+     * @brief 区头
+     */
+    struct Header {
+        std::atomic<uint32_t> magic;                      ///< MAGIC，初始化完成后最后写入
+        uint32_t version;                                 ///< VERSION
+        uint32_t slotCount;                               ///< 槽位数
+        uint32_t ringCapacity;                            ///< 每个环的字节数
+        alignas(64) std::atomic<uint32_t> doorbell;       ///< 服务端等待时客户端递增并唤醒
+        alignas(64) std::atomic<uint32_t> serverWaiting;  ///< 服务端正在等待，客户端写入请求后需要按门铃
+        std::atomic<uint32_t> serverClosed;               ///< 服务端已退出
+    };
+
+    /**
+     * @struct Slot
+     * @brief 槽位控制字段
+     */
+    struct Slot {
+        alignas(64) std::atomic<uint32_t> state;  ///< SlotState
+        std::atomic<int32_t> ownerPid;            ///< 认领槽位的客户端进程号
+        std::atomic<uint32_t> responsesFull;      ///< 响应环已满、服务端暂停处理，客户端读出响应后需要按门铃
+        SharedRingHeader requests;                ///< 请求环（客户端写，服务端读）
+        SharedRingHeader responses;               ///< 响应环（服务端写，客户端读）
+    };
+
+    SharedMemoryRegion() = default;
+    ~SharedMemoryRegion();
+    SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+    SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+
+    /**
+     * @brief 创建共享内存区（服务端），已存在的同名区域被替换
+     * @param name shm_open 名称，如 "/member_pos"
+     * @param slotCount 槽位数
+     * @return true 成功，false 失败（原因见 error()）
+     * @details 析构时删除该名称，已映射的客户端不受影响，但会看到 serverClosed
+     */
+    bool create(const std::string& name, uint32_t slotCount = DEFAULT_SLOTS);
+
+    /**
+     * @brief 映射已存在的共享内存区（客户端）
+     * @param name shm_open 名称
+     * @return true 成功
+     */
+    bool open(const std::string& name);
+
+    /**
+     * @brief 通知客户端服务端已退出，唤醒所有等待响应的客户端
+     */
+    void close();
+
+    bool mapped() const { return header != nullptr; }
+    const std::string& error() const { return lastError; }
+    Header& control() const { return *header; }
+    uint32_t slotCount() const { return header->slotCount; }
+    Slot& slot(uint32_t index) const { return slots[index]; }
+    SharedRing requestRing(uint32_t index) const;
+    SharedRing responseRing(uint32_t index) const;
+
+    /**
+     * @brief 服务端在等待时按门铃（客户端写入请求后调用）
+     */
+    void ringDoorbell();
+
+private:
+    bool map(int fd, size_t size);
+
+    Header* header = nullptr;  ///< 区头
+    Slot* slots = nullptr;     ///< 槽位控制字段
+    char* rings = nullptr;     ///< 环数据区
+    size_t size = 0;           ///< 映射的字节数
+    std::string name;          ///< 名称（仅创建者记录，析构时删除）
+    std::string lastError;     ///< 失败原因
+};
+
+/**
+ * @class SharedMemoryClient
+ * @brief 与服务端同机的客户端：通过共享内存环发送请求、读取响应
+ * @details 请求与响应仍是 MemberProtocol 帧，可以流水线发送。
+ *          快速路径（服务端正在处理、响应已到）没有系统调用；响应在共享内存中原地读取，release 后才释放。
+ *          一个客户端对象只能由一个线程使用
+ */
+class SharedMemoryClient {
+public:
+    SharedMemoryClient() = default;
+    ~SharedMemoryClient();
+    SharedMemoryClient(const SharedMemoryClient&) = delete;
+    SharedMemoryClient& operator=(const SharedMemoryClient&) = delete;
+
+    /**
+     * @brief 映射共享内存区并认领一个空闲槽位
+     * @param name shm_open 名称
+     * @return true 成功，false 失败（原因见 error()）
+     */
+    bool connect(const std::string& name);
+
+    /**
+     * @brief 发送一个请求帧
+     * @param frame 完整的请求帧（MemberProtocol::request* 生成）
+     * @return false 请求环已满（先读取响应再重试）或服务端已退出
+     */
+    bool send(std::string_view frame);
+
+    /**
+     * @brief 等待下一个响应
+     * @param size 输出：负载字节数
+     * @param timeoutMs 超时（毫秒），-1 表示一直等待
+     * @return 负载起始位置（位于共享内存中，release 之前有效），超时或服务端已退出时返回空指针
+     * @details 每次至多睡眠 100 毫秒后复查服务端是否已退出
+     */
+    const char* receive(uint32_t& size, int timeoutMs = -1);
+
+    /**
+     * @brief 释放 receive 返回的响应
+     * @details 服务端因响应环已满而暂停时通知它继续
+     */
+    void release();
+
+    const std::string& error() const { return lastError; }
+
+private:
+    SharedMemoryRegion region;  ///< 共享内存区
+    SharedRing requests;        ///< 本客户端的请求环
+    SharedRing responses;       ///< 本客户端的响应环
+    int slotIndex = -1;         ///< 认领的槽位
+    std::string lastError;      ///< 失败原因
+};
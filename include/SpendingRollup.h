@@ -0,0 +1,160 @@
+#pragma once
+#include <ctime>
+#include <cstdint>
+#include <algorithm>
+
+/**
+ * @brief 计算本地日期对应的日、月编号
+ * @param when 时间戳
+ * @param dayKey 输出：自1970-01-01起的天数（按本地日期）
+ * @param monthKey 输出：年份 × 12 + 月份（0-11）
+ */
+inline void rollupKeys(std::time_t when, int32_t& dayKey, int32_t& monthKey) {
+    std::tm timeInfo;
+#ifdef _WIN32
+    localtime_s(&timeInfo, &when);
+#else
+    localtime_r(&when, &timeInfo);
+#endif
+    // 公历日期转天数（days_from_civil 算法）
+    int year = timeInfo.tm_year + 1900;
+    int month = timeInfo.tm_mon + 1;
+    int day = timeInfo.tm_mday;
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yoe = year - era * 400;
+    int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    dayKey = era * 146097 + doe - 719468;
+    monthKey = (timeInfo.tm_year + 1900) * 12 + timeInfo.tm_mon;
+}
+
+/**
+ * @class SpendingRollup
+ * @brief 按日、按月分桶的消费汇总环形缓冲区
+ * @tparam T 桶的数值类型：单个会员使用 float 以节省内存，全局汇总使用 double
+ * @details 保留最近 DAY_BUCKETS 天和 MONTH_BUCKETS 个月的消费额。
+ *          新的一天/月到来时只清理被覆盖的桶（最多一圈），因此每次记账为 O(1)。
+ *          早于窗口的记录会被忽略。
+ */
+template <typename T>
+class SpendingRollup {
+public:
+    static constexpr int DAY_BUCKETS = 31;    ///< 日桶数量
+    static constexpr int MONTH_BUCKETS = 12;  ///< 月桶数量
+
+    /**
+     * @brief 记录一笔消费
+     * @param amount 消费金额
+     * @param dayKey 消费日期编号（见 rollupKeys）
+     * @param monthKey 消费月份编号（见 rollupKeys）
+     */
+    void add(double amount, int32_t dayKey, int32_t monthKey) {
+        if (advance(daily, DAY_BUCKETS, lastDay, dayKey)) {
+            daily[slot(dayKey, DAY_BUCKETS)] += static_cast<T>(amount);
+        }
+        if (advance(monthly, MONTH_BUCKETS, lastMonth, monthKey)) {
+            monthly[slot(monthKey, MONTH_BUCKETS)] += static_cast<T>(amount);
+        }
+    }
+
+    /**
+     * @brief 查询某一天的消费额
+     * @param dayKey 日期编号
+     * @return 消费额，超出窗口时返回0
+     */
+    double dayTotal(int32_t dayKey) const {
+        return inWindow(lastDay, dayKey, DAY_BUCKETS) ? daily[slot(dayKey, DAY_BUCKETS)] : 0.0;
+    }
+
+    /**
+     * @brief 查询某个月的消费额
+     * @param monthKey 月份编号
+     * @return 消费额，超出窗口时返回0
+     */
+    double monthTotal(int32_t monthKey) const {
+        return inWindow(lastMonth, monthKey, MONTH_BUCKETS) ? monthly[slot(monthKey, MONTH_BUCKETS)] : 0.0;
+    }
+
+    /**
+     * @brief 计算若干个月消费额的指数加权移动平均
+     * @param firstMonth 起始月份编号（含）
+     * @param lastMonthKey 结束月份编号（含）
+     * @param alpha 平滑系数（0-1），越大越偏重近期
+     * @return EWMA 月消费额
+     */
+    double ewma(int32_t firstMonth, int32_t lastMonthKey, double alpha) const {
+        double average = monthTotal(firstMonth);
+        for (int32_t month = firstMonth + 1; month <= lastMonthKey; ++month) {
+            average = alpha * monthTotal(month) + (1.0 - alpha) * average;
+        }
+        return average;
+    }
+
+    /**
+     * @brief 对若干个月的消费额做最小二乘线性回归
+     * @param firstMonth 起始月份编号（含）
+     * @param lastMonthKey 结束月份编号（含）
+     * @return 斜率（元/月），月份不足两个时返回0
+     */
+    double slope(int32_t firstMonth, int32_t lastMonthKey) const {
+        int n = lastMonthKey - firstMonth + 1;
+        if (n < 2) {
+            return 0.0;
+        }
+        double sumX = 0, sumY = 0, sumXY = 0, sumXX = 0;
+        for (int i = 0; i < n; ++i) {
+            double y = monthTotal(firstMonth + i);
+            sumX += i;
+            sumY += y;
+            sumXY += i * y;
+            sumXX += static_cast<double>(i) * i;
+        }
+        double denominator = n * sumXX - sumX * sumX;
+        return denominator == 0 ? 0.0 : (n * sumXY - sumX * sumY) / denominator;
+    }
+
+    /**
+     * @brief 判断是否尚无任何记录
+     */
+    bool empty() const {
+        return lastMonth == NO_KEY;
+    }
+
+private:
+    static constexpr int32_t NO_KEY = INT32_MIN;
+
+    static int slot(int32_t key, int buckets) {
+        int r = key % buckets;
+        return r < 0 ? r + buckets : r;
+    }
+
+    static bool inWindow(int32_t latest, int32_t key, int buckets) {
+        return latest != NO_KEY && key <= latest && latest - key < buckets;
+    }
+
+    /**
+     * @brief 把环推进到 key 所在的桶，清理被覆盖的旧桶
+     * @return true 该 key 落在窗口内可以记账
+     */
+    static bool advance(T* buckets, int count, int32_t& latest, int32_t key) {
+        if (latest == NO_KEY || key - latest >= count) {
+            std::fill(buckets, buckets + count, T(0));
+            latest = key;
+            return true;
+        }
+        for (int32_t k = latest + 1; k <= key; ++k) {
+            buckets[slot(k, count)] = T(0);
+        }
+        latest = std::max(latest, key);
+        return latest - key < count;
+    }
+
+    T daily[DAY_BUCKETS] = {};      ///< 日桶
+    T monthly[MONTH_BUCKETS] = {};  ///< 月桶
+    int32_t lastDay = NO_KEY;       ///< 最新日桶的日期编号
+    int32_t lastMonth = NO_KEY;     ///< 最新月桶的月份编号
+};
+
+using MemberSpendingRollup = SpendingRollup<float>;   ///< 单个会员的消费汇总
+using GlobalSpendingRollup = SpendingRollup<double>;  ///< 全体会员的消费汇总
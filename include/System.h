@@ -1,5 +1,6 @@
 #pragma once
 #include "MemberManager.h"
+#include "Presenter.h"
 #include "Utils.h"
 
 /**
@@ -11,15 +12,55 @@
 class System {
 private:
     MemberManager manager;  ///< 会员管理器对象，负责具体的业务逻辑处理
+    Presenter presenter{std::cout};  ///< 展示层，把操作结果输出到控制台
 
 public:
+    /**
+     * @struct ServeOptions
+     * @brief 服务模式的参数
+     */
+    struct ServeOptions {
+        std::string socketPath;    ///< Unix 域套接字路径，为空表示不监听套接字
+        std::string shmName;       ///< 共享内存区名称（如 /member_pos），为空表示不启用共享内存传输
+        std::string dataFile;      ///< 数据文件，为空表示从空数据开始且不保存
+        int saveInterval = 60;     ///< 有修改时的自动保存间隔（秒），0 表示只在退出时保存
+        std::string replicateDir;  ///< 复制目录，非空时把每次修改记录到该目录供备库重放
+        std::string standbyDir;    ///< 非空时先作为备库跟随该复制目录，收到 SIGUSR1 后提升为主库再提供服务
+    };
+
     /**
      * @brief 系统主运行函数
      * @details 启动系统并进入主控制循环
      */
     void run();
 
+    /**
+     * @brief 以服务模式运行
+     * @param options 服务参数
+     * @return 进程退出码：0 正常，1 启动失败或退出时保存失败
+     * @details 加载数据（备库为跟随主库直到提升）后通过 MemberServer 提供服务，直到收到 SIGINT / SIGTERM
+     */
+    int serve(const ServeOptions& options);
+
 private:
+    /**
+     * @enum StandbyResult
+     * @brief 备库跟随结束的原因
+     */
+    enum StandbyResult {
+        STANDBY_PROMOTED,  ///< 收到 SIGUSR1，已重放完日志，提升为主库
+        STANDBY_STOPPED,   ///< 收到 SIGINT / SIGTERM
+        STANDBY_FAILED     ///< 无法加载快照或重放失败
+    };
+
+    /**
+     * @brief 作为备库跟随主库的复制目录
+     * @param directory 复制目录
+     * @return 结束的原因
+     * @details 每 10 毫秒重放一次日志新增的记录，备库期间不提供服务
+     */
+    StandbyResult followPrimary(const std::string& directory);
+
     // ==================== 菜单显示函数 ====================
     
     /**
@@ -97,6 +138,12 @@ private:
      * @details 根据用户输入的电话号码查找并显示会员信息
      */
     void handleFindMember();
+
+    /**
+     * @brief 处理按姓名搜索会员操作
+     * @details 根据姓名片段列出匹配的会员
+     */
+    void handleFindByName();
     
     /**
      * @brief 处理修改会员电话操作
@@ -130,6 +177,12 @@ private:
      */
     void handleShowPointsHistory();
 
+    /**
+     * @brief 处理生日积分奖励操作
+     * @details 为今天起若干天内过生日的会员发放奖励积分
+     */
+    void handleBirthdayBonus();
+
     // ==================== 消费记录管理功能 ====================
     
     /**
@@ -157,6 +210,54 @@ private:
      * @details 根据会员当前消费情况预测年度可能达到的等级
      */
     void handleLevelPrediction();
+
+    /**
+     * @brief 处理全体会员批量等级预测操作
+     * @details 并行预测所有会员的年末等级，分桶汇总并输出结果文件
+     */
+    void handleBatchLevelPrediction();
+
+    /**
+     * @brief 处理会员排行榜操作
+     * @details 查询前N名会员或指定会员的名次
+     */
+    void handleLeaderboard();
+
+    /**
+     * @brief 处理条件筛选会员操作
+     * @details 按过滤表达式筛选会员，分页显示或导出结果
+     */
+    void handleFilterMembers();
+
+    /**
+     * @brief 处理消费趋势报表操作
+     * @details 显示全体会员按月、按日的消费汇总及趋势
+     */
+    void handleSpendingTrend();
+
+    /**
+     * @brief 处理休眠会员转存操作
+     * @details 把长期未消费的会员转存到磁盘，释放内存
+     */
+    void handleEvictDormant();
+
+    /**
+     * @brief 处理性能统计操作
+     * @details 显示各操作的耗时分位数，可开关硬件计数器，并可导出到文件
+     */
+    void handlePerfStats();
+
+    /**
+     * @brief 处理导出时间线操作
+     * @details 把批量任务各阶段的耗时导出为 Chrome trace 文件
+     */
+    void handleExportTrace();
+
+    /**
+     * @brief 处理内存占用报告操作
+     * @details 显示各子系统的内存占用
+     */
+    void handleMemoryReport();
     
     /**
      * @brief 处理设置积分规则操作
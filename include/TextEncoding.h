@@ -0,0 +1,108 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class TextEncoding
+ * @brief GBK 与 UTF-8 之间的编码检测与转换
+ * @details Windows 版本以 GBK 保存中文姓名，Linux/macOS 版本使用 UTF-8，
+ *          数据文件在读写时按需转换，使不同平台可以共用同一份数据文件。
+ *          转换基于查表，ASCII 连续段按 16 字节一组整块复制。
+ */
+class TextEncoding {
+public:
+    /**
+     * @enum Encoding
+     * @brief 文本编码
+     */
+    enum Encoding {
+        ENCODING_UTF8,  ///< UTF-8
+        ENCODING_GBK    ///< GBK（CP936）
+    };
+
+    static constexpr int GBK_LEAD_COUNT = 126;   ///< 首字节 0x81-0xFE
+    static constexpr int GBK_TRAIL_COUNT = 190;  ///< 尾字节 0x40-0xFE，不含 0x7F
+
+    /**
+     * @brief 获取本平台内存中使用的编码
+     * @return Windows 为 GBK，其他平台为 UTF-8
+     */
+    static Encoding nativeEncoding();
+
+    /**
+     * @brief 获取编码名称
+     * @param encoding 编码
+     * @return "UTF-8" 或 "GBK"
+     */
+    static const char* name(Encoding encoding);
+
+    /**
+     * @brief 检测文本编码
+     * @param text 文本内容
+     * @return 整段为合法 UTF-8（含纯 ASCII）时返回 UTF-8，否则返回 GBK
+     */
+    static Encoding detect(std::string_view text);
+
+    /**
+     * @brief 判断文本是否为合法 UTF-8
+     * @param text 文本内容
+     * @return true 合法
+     */
+    static bool isValidUtf8(std::string_view text);
+
+    /**
+     * @brief GBK 转 UTF-8
+     * @param in GBK 文本
+     * @param out 输出：转换结果追加到末尾
+     * @return true 全部转换成功，false 存在无法识别的字节（以 U+FFFD 代替）
+     */
+    static bool gbkToUtf8(std::string_view in, std::string& out);
+
+    /**
+     * @brief UTF-8 转 GBK
+     * @param in UTF-8 文本
+     * @param out 输出：转换结果追加到末尾
+     * @return true 全部转换成功，false 存在非法序列或 GBK 中没有的字符（以 '?' 代替）
+     */
+    static bool utf8ToGbk(std::string_view in, std::string& out);
+
+    /**
+     * @brief 在两种编码之间转换
+     * @param in 输入文本
+     * @param from 输入编码
+     * @param to 输出编码
+     * @param out 输出：转换结果追加到末尾，编码相同时原样复制
+     * @return true 全部转换成功
+     */
+    static bool convert(std::string_view in, Encoding from, Encoding to, std::string& out);
+
+    /**
+     * @brief 计算开头连续 ASCII 字节的长度
+     * @param data 数据首地址
+     * @param size 数据长度
+     * @return 第一个非 ASCII 字节的下标，全部为 ASCII 时返回 size
+     */
+    static size_t asciiPrefix(const char* data, size_t size);
+
+    /**
+     * @brief 计算 GBK 尾字节在映射表中的序号
+     * @param trail 尾字节
+     * @return 序号（0-189），非法尾字节返回 -1
+     */
+    static int gbkTrailIndex(unsigned char trail) {
+        if (trail < 0x40 || trail == 0x7F || trail == 0xFF) return -1;
+        return trail - 0x40 - (trail > 0x7F);
+    }
+
+private:
+    static const uint16_t GBK_TO_UNICODE[GBK_LEAD_COUNT * GBK_TRAIL_COUNT];  ///< GBK → Unicode 映射表（见 GbkTable.cpp）
+
+    /**
+     * @brief 获取 Unicode → GBK 反向映射表
+     * @return 以码位为下标的 65536 项表，0 表示 GBK 中没有该字符
+     * @details 首次使用时由正向表生成
+     */
+    static const uint16_t* unicodeToGbk();
+};
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @class TraceRecorder
+ * @brief 分阶段耗时的时间线记录，可导出为 Chrome trace_event JSON
+ * @details 每个线程第一次记录时分配一个环形缓冲区，只保留最近 RING_CAPACITY 个阶段，
+ *          记录只写本线程的缓冲区，不加锁；导出时逐个复制各缓冲区，复制期间被覆盖的事件丢弃。
+ *          导出的文件可在 chrome://tracing 或 Perfetto 中打开，每个缓冲区显示为一条线程轨道。
+ *          编译时未定义 MEMBER_TRACE 时 MEMBER_TRACE_SCOPE 展开为空，不产生任何记录代码。
+ */
+class TraceRecorder {
+public:
+    static constexpr size_t RING_CAPACITY = 8192;  ///< 每个线程保留的事件数
+
+    /**
+     * @brief 是否编译了记录代码
+     */
+    static constexpr bool enabled() {
+#ifdef MEMBER_TRACE
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief 获取当前时间（自进程内首次记录起的纳秒数）
+     */
+    static uint64_t now();
+
+    /**
+     * @brief 记录一个已结束的阶段
+     * @param name 阶段名称，必须是字符串字面量（只保存指针）
+     * @param start 开始时间（now() 的返回值）
+     * @param end 结束时间（now() 的返回值）
+     */
+    static void record(const char* name, uint64_t start, uint64_t end);
+
+    /**
+     * @brief 获取当前保留的事件总数
+     */
+    static size_t eventCount();
+
+    /**
+     * @brief 清空全部缓冲区
+     * @details 与正在进行的记录并发时，个别事件可能保留
+     */
+    static void clear();
+
+    /**
+     * @brief 以 Chrome trace_event JSON 格式输出全部事件
+     * @param out 输出流
+     * @return 输出的事件数
+     */
+    static size_t writeChromeTrace(std::ostream& out);
+};
+
+/**
+ * @class TraceSpan
+ * @brief 作用域阶段：构造时取时间，析构时把阶段记入 TraceRecorder
+ */
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name) : name(name), start(TraceRecorder::now()) {}
+    ~TraceSpan() { TraceRecorder::record(name, start, TraceRecorder::now()); }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name;  ///< 阶段名称
+    uint64_t start;    ///< 开始时间
+};
+
+#ifdef MEMBER_TRACE
+#define MEMBER_TRACE_CONCAT_INNER(a, b) a##b
+#define MEMBER_TRACE_CONCAT(a, b) MEMBER_TRACE_CONCAT_INNER(a, b)
+/// 把所在作用域记为一个阶段，name 为字符串字面量（如 "load.parse"）
+#define MEMBER_TRACE_SCOPE(name) TraceSpan MEMBER_TRACE_CONCAT(traceSpan, __LINE__)(name)
+#else
+#define MEMBER_TRACE_SCOPE(name) ((void)0)
+#endif
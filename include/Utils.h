@@ -2,9 +2,10 @@
 #define UTILS_H
 
 #include <string>
-#include <regex>
+#include <string_view>
 #include <iostream>
 #include <limits>
+#include <climits>
 #include <ctime>
 
 /**
@@ -18,22 +19,22 @@ public:
      * @param name 待验证的姓名
      * @return true 如果是有效的中文姓名，false 否则
      */
-    static bool isValidChineseName(const std::string& name);
+    static bool isValidChineseName(std::string_view name);
     
     /**
      * @brief 验证电话号码
      * @param phone 待验证的电话号码
      * @return true 如果是有效的电话号码，false 否则
      */
-    static bool isValidPhoneNumber(const std::string& phone);
+    static bool isValidPhoneNumber(std::string_view phone);
     
     /**
      * @brief 验证生日格式
      * @param birthday 待验证的生日字符串（YYYY-MM-DD格式）
      * @return true 如果是有效的生日格式，false 否则
      */
-    static bool isValidBirthday(const std::string& birthday);
-    
+    static bool isValidBirthday(std::string_view birthday);
+
     /**
      * @brief 验证数值范围
      * @param value 待验证的数值
@@ -1,12 +1,52 @@
 ﻿#include "include/System.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
 
 /**
  * @brief 程序主函数
- * @details 创建系统对象并启动会员管理系统
+ * @details 不带参数时启动交互式会员管理系统；
+ *          带 --serve / --shm 时以服务模式运行：
+ *          MemberSystem [--serve 套接字路径] [--shm 共享内存名称] [--data 数据文件] [--save-interval 秒]
+ *                       [--replicate-to 复制目录] [--standby 复制目录]，
+ *          --serve 与 --shm 至少指定一个。--replicate-to 把修改记录到复制目录；
+ *          --standby 先作为备库跟随复制目录（不加载 --data），收到 SIGUSR1 后提升为主库并开始服务
  * @return 程序退出码，0表示正常退出
  */
-int main() {
+int main(int argc, char* argv[]) {
     System system;  ///< 创建系统对象
-    system.run();   ///< 启动系统主循环
-    return 0;       ///< 正常退出
+    if (argc == 1) {
+        system.run();   ///< 启动系统主循环
+        return 0;       ///< 正常退出
+    }
+
+    System::ServeOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--serve" && i + 1 < argc) {
+            options.socketPath = argv[++i];
+        } else if (arg == "--shm" && i + 1 < argc) {
+            options.shmName = argv[++i];
+        } else if (arg == "--data" && i + 1 < argc) {
+            options.dataFile = argv[++i];
+        } else if (arg == "--save-interval" && i + 1 < argc && std::atoi(argv[i + 1]) >= 0) {
+            options.saveInterval = std::atoi(argv[++i]);
+        } else if (arg == "--replicate-to" && i + 1 < argc) {
+            options.replicateDir = argv[++i];
+        } else if (arg == "--standby" && i + 1 < argc) {
+            options.standbyDir = argv[++i];
+        } else {
+            options.socketPath.clear();
+            options.shmName.clear();
+            break;
+        }
+    }
+    if (options.socketPath.empty() && options.shmName.empty()) {
+        std::fprintf(stderr,
+                     "用法: %s [--serve 套接字路径] [--shm 共享内存名称] [--data 数据文件] [--save-interval 秒]"
+                     " [--replicate-to 复制目录] [--standby 复制目录]\n",
+                     argv[0]);
+        return 1;
+    }
+    return system.serve(options);
 }
\ No newline at end of file
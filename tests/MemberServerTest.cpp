@@ -0,0 +1,559 @@
+/**
+ * @file MemberServerTest.cpp
+ * @brief 会员服务端测试
+ * @details 在后台线程运行 MemberServer，通过 Unix 域套接字检查：
+ *          一次写入的流水线请求按顺序得到响应且内容正确；请求帧分多次到达；
+ *          多个连接同时存在；客户端半关闭后仍收到响应；参数无法解析时返回 STATUS_BAD_REQUEST；
+ *          请求帧超长时连接被关闭；共享内存客户端的流水线请求、环满时的背压与回绕、槽位用尽与回收。
+ *          停止服务后检查会员数据与响应一致。另起一个启用复制的服务，检查复制日志写入失败时修改不被确认。
+ *          任一检查失败时返回非零，由 CTest 运行。
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "MemberServer.h"
+#include "TestSupport.h"
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <memory>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+/**
+ * @struct Response
+ * @brief 收到的一个响应
+ */
+struct Response {
+    MemberProtocol::ResponseHeader header;
+    std::string payload;  ///< 完整负载（含头部）
+};
+
+/**
+ * @class Client
+ * @brief 阻塞式测试客户端，读取设有超时，服务端无响应时测试失败而不是挂起
+ */
+class Client {
+public:
+    explicit Client(const std::string& path) {
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            close(fd);
+            fd = -1;
+            return;
+        }
+        timeval timeout{5, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    }
+
+    ~Client() {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+    bool connected() const { return fd >= 0; }
+
+    /**
+     * @brief 写出全部数据
+     */
+    bool send(const std::string& data) {
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) {
+                return false;
+            }
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    /**
+     * @brief 读取一个响应
+     * @return false 连接已关闭、超时或响应无法解析
+     */
+    bool receive(Response& response) {
+        uint32_t size = 0;
+        while (MemberProtocol::peekFrame(buffer.data(), buffer.size(), UINT32_MAX, size) !=
+               MemberProtocol::FRAME_READY) {
+            char chunk[4096];
+            ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) {
+                return false;
+            }
+            buffer.append(chunk, static_cast<size_t>(n));
+        }
+        response.payload.assign(buffer, 4, size);
+        buffer.erase(0, 4 + size);
+        ProtocolReader reader(response.payload.data(), response.payload.size());
+        return MemberProtocol::readResponseHeader(reader, response.header);
+    }
+
+    /**
+     * @brief 连接是否已被服务端关闭（读到 EOF）
+     */
+    bool closedByServer() {
+        char byte;
+        return buffer.empty() && recv(fd, &byte, 1, 0) == 0;
+    }
+
+    void shutdownWrite() { shutdown(fd, SHUT_WR); }
+
+private:
+    int fd = -1;
+    std::string buffer;  ///< 已收到、尚未解析的数据
+};
+
+/**
+ * @brief 跳过响应头部，返回位于结果开头的读取器
+ */
+ProtocolReader resultReader(const Response& response) {
+    ProtocolReader reader(response.payload.data(), response.payload.size());
+    MemberProtocol::ResponseHeader header;
+    MemberProtocol::readResponseHeader(reader, header);
+    return reader;
+}
+
+/**
+ * @brief 检查响应头部
+ */
+bool expectHeader(const Response& response, uint8_t opcode, uint32_t requestId, uint8_t status) {
+    return response.header.opcode == opcode && response.header.requestId == requestId &&
+           response.header.status == status;
+}
+
+/**
+ * @brief 一次写入多个请求，检查响应按顺序返回且内容正确
+ */
+void testPipeline(const std::string& path, int zhang, int li, int& zhangPoints) {
+    Client client(path);
+    CHECK(client.connected());
+
+    std::string requests;
+    MemberProtocol::requestPing(requests, 1);
+    MemberProtocol::requestGetById(requests, 2, zhang);
+    MemberProtocol::requestGetByPhone(requests, 3, "13800000002");
+    MemberProtocol::requestAddSpending(requests, 4, zhang, 1200.0);
+    MemberProtocol::requestRedeemPoints(requests, 5, zhang, 100);
+    MemberProtocol::requestGetById(requests, 6, 99999);
+    MemberProtocol::requestFindByPhonePrefix(requests, 7, "138000000", 10);
+    MemberProtocol::requestFindByName(requests, 8, "李四", 10);
+    MemberProtocol::requestMemberRank(requests, 9, MemberManager::RANK_TOTAL_SPENT, zhang);
+    MemberProtocol::requestTopMembers(requests, 10, MemberManager::RANK_TOTAL_SPENT, 2);
+    MemberProtocol::requestRedeemPoints(requests, 11, li, 1000000);
+    MemberProtocol::requestAddSpending(requests, 12, zhang, -5.0);
+    CHECK(client.send(requests));
+
+    Response response;
+    CHECK(client.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_PING, 1, MemberManager::STATUS_OK));
+
+    CHECK(client.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_GET_BY_ID, 2, MemberManager::STATUS_OK));
+    MemberProtocol::MemberRecord record;
+    ProtocolReader reader = resultReader(response);
+    CHECK(MemberProtocol::readMember(reader, record) && reader.atEnd());
+    CHECK(record.id == zhang && record.name == "张三" && record.phone == "13800000001");
+    CHECK(record.birthday == "1990-01-15" && record.totalSpent == 0.0 && record.points == 0);
+
+    CHECK(client.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_GET_BY_PHONE, 3, MemberManager::STATUS_OK));
+    reader = resultReader(response);
+    CHECK(MemberProtocol::readMember(reader, record) && record.id == li && record.name == "李四光");
+
+    CHECK(client.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_ADD_SPENDING, 4, MemberManager::STATUS_OK));
+    reader = resultReader(response);
+    double actualAmount = reader.f64();
+    double discountRate = reader.f64();
+    int earnedPoints = reader.i32();
+    int totalPoints = reader.i32();
+    reader.u8();
+    CHECK(reader.atEnd());
+    CHECK(actualAmount > 0.0 && actualAmount <= 1200.0 && discountRate > 0.0 && discountRate <= 1.0);
+    CHECK(earnedPoints > 100 && totalPoints == earnedPoints);
+
+    CHECK(client.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_REDEEM_POINTS, 5, MemberManager::STATUS_OK));
+    reader = resultReader(response);
+    int redeemed = reader.i32();
+    int remaining = reader.i32();
+    CHECK(reader.atEnd() && redeemed == 100 && remaining == totalPoints - 100);
+    zhangPoints = remaining;
+
+    CHECK(client.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_GET_BY_ID, 6, MemberManager::STATUS_NOT_FOUND));
+    CHECK(resultReader(response).atEnd());
+
+    std::vector<int> ids;
+    CHECK(client.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_FIND_BY_PHONE_PREFIX, 7, MemberManager::STATUS_OK));
+    reader = resultReader(response);
+    CHECK(MemberProtocol::readIds(reader, ids) && ids.size() == 3);
+
+    CHECK(client.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_FIND_BY_NAME, 8, MemberManager::STATUS_OK));
+    reader = resultReader(response);
+    CHECK(MemberProtocol::readIds(reader, ids) && ids.size() == 1 && ids[0] == li);
+
+    CHECK(client.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_MEMBER_RANK, 9, MemberManager::STATUS_OK));
+    reader = resultReader(response);
+    CHECK(reader.i32() == 1 && reader.atEnd());
+
+    CHECK(client.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_TOP_MEMBERS, 10, MemberManager::STATUS_OK));
+    reader = resultReader(response);
+    CHECK(MemberProtocol::readIds(reader, ids) && ids.size() == 2 && ids[0] == zhang);
+
+    CHECK(client.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_REDEEM_POINTS, 11, MemberManager::STATUS_INSUFFICIENT_POINTS));
+
+    CHECK(client.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_ADD_SPENDING, 12, MemberManager::STATUS_INVALID_ARGUMENT));
+}
+
+/**
+ * @brief 请求逐字节到达、参数无法解析、操作码未知，以及另一个连接同时存在
+ */
+void testFramingAndErrors(const std::string& path) {
+    Client idle(path);
+    Client client(path);
+    CHECK(idle.connected() && client.connected());
+
+    std::string request;
+    MemberProtocol::requestPing(request, 20);
+    for (char byte : request) {
+        CHECK(client.send(std::string(1, byte)));
+    }
+    Response response;
+    CHECK(client.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_PING, 20, MemberManager::STATUS_OK));
+
+    // 缺少参数的 GET_BY_ID、未知操作码、越界的排序依据，之后连接仍可用
+    std::string malformed;
+    ProtocolWriter writer(malformed);
+    writer.beginFrame();
+    writer.u8(MemberProtocol::OP_GET_BY_ID).u32(21);
+    writer.endFrame();
+    writer.beginFrame();
+    writer.u8(200).u32(22);
+    writer.endFrame();
+    MemberProtocol::requestTopMembers(malformed, 23, MemberManager::RANK_KEY_COUNT, 5);
+    MemberProtocol::requestPing(malformed, 24);
+    CHECK(client.send(malformed));
+    CHECK(client.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_GET_BY_ID, 21, MemberProtocol::STATUS_BAD_REQUEST));
+    CHECK(client.receive(response));
+    CHECK(expectHeader(response, 200, 22, MemberProtocol::STATUS_BAD_REQUEST));
+    CHECK(client.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_TOP_MEMBERS, 23, MemberProtocol::STATUS_BAD_REQUEST));
+    CHECK(client.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_PING, 24, MemberManager::STATUS_OK));
+
+    // 空闲连接不影响其它连接，之后同样可用
+    request.clear();
+    MemberProtocol::requestPing(request, 25);
+    CHECK(idle.send(request));
+    CHECK(idle.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_PING, 25, MemberManager::STATUS_OK));
+}
+
+/**
+ * @brief 上限为 0 的列表类查询按 MAX_RESULTS 返回，而不是返回全部会员
+ * @details 调用前已加入 MAX_RESULTS + 100 位电话以 137 开头、姓孙的会员
+ */
+void testResultLimits(const std::string& path) {
+    Client client(path);
+    std::string requests;
+    MemberProtocol::requestFindByPhonePrefix(requests, 30, "137", 0);
+    MemberProtocol::requestFindByName(requests, 31, "孙", 0);
+    MemberProtocol::requestTopMembers(requests, 32, MemberManager::RANK_POINTS, 0);
+    MemberProtocol::requestFindByPhonePrefix(requests, 33, "137", 5);
+    CHECK(client.send(requests));
+
+    Response response;
+    std::vector<int> ids;
+    const uint8_t opcodes[] = { MemberProtocol::OP_FIND_BY_PHONE_PREFIX, MemberProtocol::OP_FIND_BY_NAME,
+                                MemberProtocol::OP_TOP_MEMBERS, MemberProtocol::OP_FIND_BY_PHONE_PREFIX };
+    const size_t expected[] = { MemberProtocol::MAX_RESULTS, MemberProtocol::MAX_RESULTS,
+                                MemberProtocol::MAX_RESULTS, 5 };
+    for (uint32_t i = 0; i < 4; ++i) {
+        CHECK(client.receive(response));
+        CHECK(expectHeader(response, opcodes[i], 30 + i, MemberManager::STATUS_OK));
+        ProtocolReader reader = resultReader(response);
+        CHECK(MemberProtocol::readIds(reader, ids) && ids.size() == expected[i]);
+    }
+}
+
+/**
+ * @brief 客户端发完请求后半关闭：先收到全部响应，再读到 EOF
+ */
+void testHalfClose(const std::string& path) {
+    Client client(path);
+    std::string requests;
+    for (uint32_t i = 0; i < 100; ++i) {
+        MemberProtocol::requestPing(requests, 30 + i);
+    }
+    CHECK(client.send(requests));
+    client.shutdownWrite();
+    Response response;
+    for (uint32_t i = 0; i < 100; ++i) {
+        CHECK(client.receive(response));
+        CHECK(expectHeader(response, MemberProtocol::OP_PING, 30 + i, MemberManager::STATUS_OK));
+    }
+    CHECK(client.closedByServer());
+}
+
+/**
+ * @brief 请求帧长度超过上限时连接被关闭，不返回响应
+ */
+void testOversizedFrame(const std::string& path) {
+    Client client(path);
+    std::string header;
+    ProtocolWriter(header).u32(MemberProtocol::MAX_REQUEST_SIZE + 1);
+    CHECK(client.send(header));
+    CHECK(client.closedByServer());
+}
+
+/**
+ * @brief 从共享内存客户端读取一个响应并复制出来（随即释放环中的空间）
+ */
+bool receiveShared(SharedMemoryClient& client, Response& response) {
+    uint32_t size = 0;
+    const char* payload = client.receive(size, 5000);
+    if (!payload) {
+        return false;
+    }
+    response.payload.assign(payload, size);
+    client.release();
+    ProtocolReader reader(response.payload.data(), response.payload.size());
+    return MemberProtocol::readResponseHeader(reader, response.header);
+}
+
+/**
+ * @brief 共享内存客户端：流水线请求与响应内容
+ * @return 本测试发送的请求数
+ */
+size_t testSharedMemory(const std::string& name, int zhang, int& zhangPoints) {
+    SharedMemoryClient client;
+    CHECK(client.connect(name));
+
+    std::string frame;
+    MemberProtocol::requestPing(frame, 100);
+    CHECK(client.send(frame));
+    frame.clear();
+    MemberProtocol::requestAddSpending(frame, 101, zhang, 100.0);
+    CHECK(client.send(frame));
+    frame.clear();
+    MemberProtocol::requestGetById(frame, 102, zhang);
+    CHECK(client.send(frame));
+
+    Response response;
+    CHECK(receiveShared(client, response));
+    CHECK(expectHeader(response, MemberProtocol::OP_PING, 100, MemberManager::STATUS_OK));
+    CHECK(receiveShared(client, response));
+    CHECK(expectHeader(response, MemberProtocol::OP_ADD_SPENDING, 101, MemberManager::STATUS_OK));
+    ProtocolReader reader = resultReader(response);
+    reader.f64();
+    reader.f64();
+    int earnedPoints = reader.i32();
+    int totalPoints = reader.i32();
+    CHECK(reader.ok() && totalPoints == zhangPoints + earnedPoints);
+    zhangPoints = totalPoints;
+    CHECK(receiveShared(client, response));
+    CHECK(expectHeader(response, MemberProtocol::OP_GET_BY_ID, 102, MemberManager::STATUS_OK));
+    MemberProtocol::MemberRecord record;
+    reader = resultReader(response);
+    CHECK(MemberProtocol::readMember(reader, record) && record.points == zhangPoints && record.totalSpent == 1300.0);
+    return 3;
+}
+
+/**
+ * @brief 不读响应一直发送直到请求环满，再按顺序读出全部响应；重复几轮使两个环都回绕
+ * @return 本测试发送的请求数
+ */
+size_t testSharedBackpressure(const std::string& name) {
+    SharedMemoryClient client;
+    CHECK(client.connect(name));
+    size_t total = 0;
+    uint32_t nextId = 0;
+    for (int round = 0; round < 3; ++round) {
+        uint32_t firstId = nextId;
+        std::string frame;
+        while (true) {
+            frame.clear();
+            MemberProtocol::requestPing(frame, nextId);
+            if (!client.send(frame)) {
+                break;
+            }
+            ++nextId;
+        }
+        CHECK(nextId - firstId > 1000);
+        Response response;
+        for (uint32_t id = firstId; id < nextId; ++id) {
+            bool inOrder = receiveShared(client, response) &&
+                           expectHeader(response, MemberProtocol::OP_PING, id, MemberManager::STATUS_OK);
+            CHECK(inOrder);
+            if (!inOrder) {
+                break;
+            }
+        }
+        total += nextId - firstId;
+    }
+    return total;
+}
+
+/**
+ * @brief 槽位用尽后连接失败；一个客户端退出后槽位被回收，可以再次连接
+ * @return 本测试发送的请求数
+ */
+size_t testSharedSlots(const std::string& name) {
+    std::vector<std::unique_ptr<SharedMemoryClient>> clients;
+    for (uint32_t i = 0; i < SharedMemoryRegion::DEFAULT_SLOTS; ++i) {
+        clients.push_back(std::make_unique<SharedMemoryClient>());
+        CHECK(clients.back()->connect(name));
+    }
+    size_t sent = 0;
+    for (auto& client : clients) {
+        std::string frame;
+        MemberProtocol::requestPing(frame, 200);
+        Response response;
+        CHECK(client->send(frame) && receiveShared(*client, response));
+        ++sent;
+    }
+    SharedMemoryClient extra;
+    CHECK(!extra.connect(name));
+
+    clients.pop_back();
+    SharedMemoryClient late;
+    CHECK(late.connect(name));
+    std::string frame;
+    MemberProtocol::requestPing(frame, 201);
+    Response response;
+    CHECK(late.send(frame) && receiveShared(late, response));
+    CHECK(expectHeader(response, MemberProtocol::OP_PING, 201, MemberManager::STATUS_OK));
+    return sent + 1;
+}
+
+/**
+ * @brief 复制日志写入失败（文件大小超过 RLIMIT_FSIZE）时不确认本轮的修改：连接被关闭，run 返回并给出原因
+ */
+void testReplicationFailure(const std::string& path) {
+    std::string dir = tempPath("member_server_test_replication");
+    std::filesystem::remove_all(dir);
+    MemberManager manager;
+    int id = manager.addMember("张三", "13800000001", "1990-01-15");
+    CHECK(manager.enableReplication(dir) == MemberManager::STATUS_OK);
+    MemberServer server(manager);
+    if (!server.listen(path)) {
+        std::fprintf(stderr, "无法监听 %s: %s\n", path.c_str(), server.error().c_str());
+        ++failures;
+        return;
+    }
+    std::thread worker([&server] { server.run(); });
+
+    Client client(path);
+    std::string requests;
+    MemberProtocol::requestAddSpending(requests, 1, id, 100.0);
+    Response response;
+    CHECK(client.send(requests) && client.receive(response));
+    CHECK(expectHeader(response, MemberProtocol::OP_ADD_SPENDING, 1, MemberManager::STATUS_OK));
+
+    // 超过限制的写入得到 EFBIG 而不是 SIGXFSZ
+    void (*previousHandler)(int) = std::signal(SIGXFSZ, SIG_IGN);
+    rlimit previous;
+    getrlimit(RLIMIT_FSIZE, &previous);
+    rlimit limit = previous;
+    limit.rlim_cur = static_cast<rlim_t>(std::filesystem::file_size(ReplicationLog::logPath(dir)));
+    setrlimit(RLIMIT_FSIZE, &limit);
+    requests.clear();
+    MemberProtocol::requestAddSpending(requests, 2, id, 200.0);
+    MemberProtocol::requestPing(requests, 3);
+    CHECK(client.send(requests));
+    CHECK(!client.receive(response));
+    server.stop();
+    worker.join();
+    setrlimit(RLIMIT_FSIZE, &previous);
+    std::signal(SIGXFSZ, previousHandler);
+
+    CHECK(!server.error().empty());
+    CHECK(manager.getReplicationLog().failed());
+    std::filesystem::remove_all(dir);
+}
+
+} // namespace
+
+int main() {
+    std::string path = (std::filesystem::temp_directory_path() /
+                        ("member_server_test_" + std::to_string(getpid()) + ".sock")).string();
+    std::string shmName = "/member_server_test_" + std::to_string(getpid());
+
+    MemberManager manager;
+    int zhang = manager.addMember("张三", "13800000001", "1990-01-15");
+    int li = manager.addMember("李四光", "13800000002", "1985-12-31");
+    manager.addMember("王五", "13800000003", "2000-02-29");
+    manager.addMember("赵六", "13900000004", "1978-07-07");
+    for (int i = 0; i < MemberProtocol::MAX_RESULTS + 100; ++i) {
+        char phone[32];
+        std::snprintf(phone, sizeof(phone), "137%08d", i);
+        manager.addMember("孙小", phone, "1990-06-01");
+    }
+
+    MemberServer::Stats stats;
+    bool modified = false;
+    int zhangPoints = 0;
+    size_t sharedRequests = 0;
+    {
+        MemberServer server(manager);
+        if (!server.listen(path) || !server.listenSharedMemory(shmName)) {
+            std::fprintf(stderr, "无法监听 %s: %s\n", path.c_str(), server.error().c_str());
+            return 1;
+        }
+        std::thread worker([&server] { server.run(); });
+
+        testPipeline(path, zhang, li, zhangPoints);
+        testFramingAndErrors(path);
+        testResultLimits(path);
+        testHalfClose(path);
+        testOversizedFrame(path);
+        sharedRequests += testSharedMemory(shmName, zhang, zhangPoints);
+        sharedRequests += testSharedBackpressure(shmName);
+        sharedRequests += testSharedSlots(shmName);
+
+        server.stop();
+        worker.join();
+        stats = server.stats();
+        modified = server.modified();
+    }
+
+    // 服务线程已退出，可以直接检查会员数据
+    const Member* member = manager.getMemberById(zhang);
+    CHECK(member && member->getTotalSpent() == 1300.0 && member->getPoints() == zhangPoints);
+    CHECK(modified);
+    CHECK(stats.connections == 6);
+    CHECK(stats.requests == 12 + 6 + 4 + 100 + sharedRequests);
+    CHECK(stats.sharedClients == 2 + SharedMemoryRegion::DEFAULT_SLOTS + 1);
+    CHECK(stats.largestBatch >= 12);
+    CHECK(!std::filesystem::exists(path));
+    SharedMemoryClient orphan;
+    CHECK(!orphan.connect(shmName));
+
+    testReplicationFailure(path);
+
+    return finishTests();
+}
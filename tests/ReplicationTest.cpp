@@ -0,0 +1,324 @@
+/**
+ * @file ReplicationTest.cpp
+ * @brief 主备复制测试
+ * @details 主库启用复制后执行各类修改，备库加载快照并重放日志，两边保存的数据文件应逐字节相同；
+ *          另外覆盖批量写入（组提交）、写到一半的记录、序号不连续、日志写入失败、主库启用冷热分层
+ *          以及主库重新加载数据后开始新纪元的情况。
+ *          主库和备库是同一进程中的两个 MemberManager，通过临时目录中的文件交换数据。
+ *          任一检查失败时返回非零，由 CTest 运行。
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "MemberManager.h"
+#include "ReplicationLog.h"
+#include "BirthdayIndex.h"
+#include "TestSupport.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <csignal>
+#include <string>
+#include <sys/resource.h>
+#include <thread>
+
+namespace {
+
+/**
+ * @brief 建立一个空的复制目录
+ * @param name 目录名
+ */
+std::string freshDirectory(const char* name) {
+    std::string dir = tempPath(name);
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+/**
+ * @brief 比较两个管理器保存出的数据文件
+ * @param primary 主库
+ * @param standby 备库
+ * @return true 逐字节相同
+ */
+bool sameData(const MemberManager& primary, const MemberManager& standby) {
+    std::string primaryPath = tempPath("member_replication_primary.dat");
+    std::string standbyPath = tempPath("member_replication_standby.dat");
+    bool saved = primary.saveToFile(primaryPath, TextEncoding::ENCODING_UTF8) == MemberManager::STATUS_OK &&
+                 standby.saveToFile(standbyPath, TextEncoding::ENCODING_UTF8) == MemberManager::STATUS_OK;
+    bool same = saved && readFile(primaryPath) == readFile(standbyPath);
+    std::remove(primaryPath.c_str());
+    std::remove(standbyPath.c_str());
+    return same;
+}
+
+/**
+ * @brief 快照之前和之后的各类修改，备库重放后与主库一致
+ */
+void testReplay() {
+    std::string dir = freshDirectory("member_replication_replay");
+    MemberManager primary;
+    int zhang = primary.addMember("张三", "13800000001", "1990-01-15");
+    int li = primary.addMember("李四", "13800000002", "1985-03-08");
+    int wang = primary.addMember("王五", "13800000003", "2000-03-08");
+    primary.addSpending(zhang, 1234.56);
+    int removed = primary.addMember("赵六", "13800000004", "1978-07-07");
+    primary.deleteMember(removed);
+    primary.setPointsRule(2);
+    CHECK(primary.enableReplication(dir) == MemberManager::STATUS_OK);
+
+    // 备库从快照开始：已删除会员占用过的ID和积分规则来自日志文件头
+    MemberManager standby;
+    ReplicationFollower follower(standby);
+    CHECK(follower.open(dir));
+    CHECK(follower.poll() == 0);
+    CHECK(sameData(primary, standby));
+
+    primary.addSpending(li, 30000.01);
+    primary.addSpending(wang, 0.1);
+    CHECK(primary.redeemPoints(zhang, 100).status == MemberManager::STATUS_OK);
+    CHECK(primary.redeemPoints(zhang, 100000000).status == MemberManager::STATUS_INSUFFICIENT_POINTS);
+    CHECK(primary.updateMemberPhone(li, "13900000002") == MemberManager::STATUS_OK);
+    int sun = primary.addMember("孙七", "13800000005", "1995-05-05");
+    primary.addSpending(sun, 88.8);
+    CHECK(primary.deleteMember(zhang) == MemberManager::STATUS_OK);
+    CHECK(primary.deleteMember(zhang) == MemberManager::STATUS_NOT_FOUND);
+    int march8 = BirthdayIndex::dayKey(3, 8);
+    CHECK(primary.grantBirthdayBonus(march8, march8, 50).members == 2);
+    CHECK(primary.setPointsRule(3) == MemberManager::STATUS_OK);
+
+    // 失败的修改不记录；生日奖励每位获奖会员一条
+    CHECK(primary.getReplicationLog().lastSequence() == 10);
+    CHECK(follower.poll() == 10);
+    CHECK(!follower.failed());
+    CHECK(follower.lastSequence() == 10);
+    CHECK(sameData(primary, standby));
+    CHECK(standby.getMemberIdByPhone("13900000002") == li);
+
+    // 提升后新会员的ID与主库继续分配的一致
+    int next = primary.addMember("周八", "13800000006", "1992-02-02");
+    CHECK(standby.addMember("周八", "13800000006", "1992-02-02") == next);
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief 批量模式下记录留在内存中，flush 后备库才能看到
+ */
+void testBatching() {
+    std::string dir = freshDirectory("member_replication_batch");
+    MemberManager primary;
+    CHECK(primary.enableReplication(dir) == MemberManager::STATUS_OK);
+    MemberManager standby;
+    ReplicationFollower follower(standby);
+    CHECK(follower.open(dir));
+
+    primary.setReplicationBatching(true);
+    int id = primary.addMember("张三", "13800000001", "1990-01-15");
+    primary.addSpending(id, 500.0);
+    CHECK(follower.poll() == 0);
+    CHECK(primary.flushReplication());
+    CHECK(follower.poll() == 2);
+    CHECK(sameData(primary, standby));
+
+    // 关闭批量模式时写出缓冲的记录
+    primary.addSpending(id, 600.0);
+    primary.setReplicationBatching(false);
+    CHECK(follower.poll() == 1);
+    CHECK(sameData(primary, standby));
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief 写到一半的记录留到下次；序号不连续时停止重放
+ */
+void testPartialAndGap() {
+    std::string dir = freshDirectory("member_replication_partial");
+    MemberManager primary;
+    CHECK(primary.enableReplication(dir) == MemberManager::STATUS_OK);
+    MemberManager standby;
+    ReplicationFollower follower(standby);
+    CHECK(follower.open(dir));
+
+    ReplicationRecord record;
+    record.sequence = 1;
+    record.type = ReplicationRecord::ADD_MEMBER;
+    record.id = 1;
+    record.name = "张三";
+    record.phone = "13800000001";
+    record.birthday = "1990-01-15";
+    std::string frame;
+    ReplicationLog::encode(record, frame);
+    std::ofstream log(ReplicationLog::logPath(dir), std::ios::binary | std::ios::app);
+    log.write(frame.data(), 7);
+    log.flush();
+    CHECK(follower.poll() == 0);
+    CHECK(!follower.failed());
+    log.write(frame.data() + 7, static_cast<std::streamsize>(frame.size() - 7));
+    log.flush();
+    CHECK(follower.poll() == 1);
+    CHECK(standby.getMemberIdByPhone("13800000001") == 1);
+
+    std::string gap;
+    record.sequence = 3;
+    record.type = ReplicationRecord::DELETE_MEMBER;
+    ReplicationLog::encode(record, gap);
+    log.write(gap.data(), static_cast<std::streamsize>(gap.size()));
+    log.flush();
+    CHECK(follower.poll() == 0);
+    CHECK(follower.failed());
+    CHECK(standby.getMemberById(1) != nullptr);
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief 日志写入失败（文件大小超过 RLIMIT_FSIZE）时修改返回 STATUS_IO_ERROR，之后的记录都不再写入
+ */
+void testWriteFailure() {
+    std::string dir = freshDirectory("member_replication_failure");
+    MemberManager primary;
+    int id = primary.addMember("张三", "13800000001", "1990-01-15");
+    CHECK(primary.enableReplication(dir) == MemberManager::STATUS_OK);
+    CHECK(primary.addSpending(id, 100.0).status == MemberManager::STATUS_OK);
+    MemberManager standby;
+    ReplicationFollower follower(standby);
+    CHECK(follower.open(dir));
+    CHECK(follower.poll() == 1);
+
+    // 超过限制的写入得到 EFBIG 而不是 SIGXFSZ
+    void (*previousHandler)(int) = std::signal(SIGXFSZ, SIG_IGN);
+    rlimit previous;
+    getrlimit(RLIMIT_FSIZE, &previous);
+    rlimit limit = previous;
+    limit.rlim_cur = static_cast<rlim_t>(std::filesystem::file_size(ReplicationLog::logPath(dir)));
+    setrlimit(RLIMIT_FSIZE, &limit);
+    CHECK(primary.addSpending(id, 200.0).status == MemberManager::STATUS_IO_ERROR);
+    setrlimit(RLIMIT_FSIZE, &previous);
+    std::signal(SIGXFSZ, previousHandler);
+
+    // 文件恢复可写后日志仍停在出错处，备库不会看到缺口之后的记录
+    CHECK(primary.getReplicationLog().failed());
+    CHECK(!primary.flushReplication());
+    CHECK(primary.setPointsRule(2) == MemberManager::STATUS_IO_ERROR);
+    CHECK(primary.redeemPoints(id, 10).status == MemberManager::STATUS_IO_ERROR);
+    // 新会员和删除都已在本机生效，只是没有进入日志
+    int added = primary.addMember("李四", "13800000002", "1985-03-08");
+    CHECK(primary.getMemberById(added) != nullptr && primary.getReplicationLog().failed());
+    CHECK(primary.deleteMember(added) == MemberManager::STATUS_IO_ERROR);
+    CHECK(primary.getMemberById(added) == nullptr);
+    CHECK(follower.poll() == 0);
+    CHECK(!follower.failed());
+
+    // 重新启用复制开始新纪元，备库重新加载后与主库一致
+    CHECK(primary.enableReplication(dir) == MemberManager::STATUS_OK);
+    CHECK(!primary.getReplicationLog().failed());
+    CHECK(primary.addSpending(id, 300.0).status == MemberManager::STATUS_OK);
+    follower.poll();
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    follower.poll();
+    CHECK(follower.reloads() == 1);
+    CHECK(follower.poll() == 1);
+    CHECK(sameData(primary, standby));
+    std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief 主库启用冷热分层：修改磁盘上的休眠会员（生日奖励、消费、删除）后备库与主库一致
+ * @details 备库不分层，全部会员都在内存中；生日奖励按获奖会员逐条重放，与备库的索引状态无关
+ */
+void testTieredPrimary() {
+    std::string dir = freshDirectory("member_replication_tiered");
+    std::string dataFile = tempPath("member_replication_tiered.dat");
+    std::string segment = tempPath("member_replication_tiered.seg");
+    // ID 为偶数的会员 2015 年后没有消费（休眠），加载时直接转存到段文件
+    std::string content;
+    char line[128];
+    for (int i = 1; i <= 200; ++i) {
+        std::snprintf(line, sizeof(line), "%d,张三,139%08d,1990-03-%02d,100,100,1,%s,0,%d\n",
+                      i, i, 1 + i % 28, i % 2 == 0 ? "0" : "100", i % 2 == 0 ? 2015 : currentYear());
+        content += line;
+    }
+    writeFile(dataFile, content);
+
+    MemberManager primary;
+    CHECK(primary.enableTiering(segment, 2) == MemberManager::STATUS_OK);
+    CHECK(primary.loadFromFile(dataFile) == MemberManager::STATUS_OK);
+    CHECK(primary.getColdMemberCount() == 100);
+    CHECK(primary.enableReplication(dir) == MemberManager::STATUS_OK);
+    MemberManager standby;
+    ReplicationFollower follower(standby);
+    CHECK(follower.open(dir));
+    CHECK(sameData(primary, standby));
+
+    // 3 月 5 日生日的会员（ID 除以 28 余 4）一半在磁盘上，奖励时调回
+    int march5 = BirthdayIndex::dayKey(3, 5);
+    MemberManager::BonusResult bonus = primary.grantBirthdayBonus(march5, march5, 50);
+    CHECK(bonus.status == MemberManager::STATUS_OK && bonus.members == 200 / 28 + 1);
+    CHECK(primary.addSpending(62, 10.0).status == MemberManager::STATUS_OK);
+    CHECK(primary.deleteMember(6) == MemberManager::STATUS_OK);
+    CHECK(primary.evictDormant() > 0);
+
+    CHECK(follower.poll() == bonus.members + 2);
+    CHECK(!follower.failed());
+    CHECK(sameData(primary, standby));
+    std::filesystem::remove_all(dir);
+    std::remove(dataFile.c_str());
+    std::remove(segment.c_str());
+}
+
+/**
+ * @brief 主库重新加载数据后开始新纪元，备库发现后重新加载新快照
+ */
+void testNewEpoch() {
+    std::string dir = freshDirectory("member_replication_epoch");
+    std::string dataFile = tempPath("member_replication_epoch.dat");
+    MemberManager primary;
+    CHECK(primary.enableReplication(dir) == MemberManager::STATUS_OK);
+    MemberManager standby;
+    ReplicationFollower follower(standby);
+    CHECK(follower.open(dir));
+    uint64_t firstEpoch = follower.epoch();
+
+    {
+        MemberManager other;
+        int id = other.addMember("张三", "13800000001", "1990-01-15");
+        other.addSpending(id, 20000.0);
+        other.addMember("李四", "13800000002", "1985-12-31");
+        CHECK(other.saveToFile(dataFile) == MemberManager::STATUS_OK);
+    }
+    primary.addMember("王五", "13800000003", "2000-02-29");
+    CHECK(primary.loadFromFile(dataFile) == MemberManager::STATUS_OK);
+    primary.addSpending(2, 300.0);
+
+    // 旧纪元的记录先被重放，之后没有新数据时才检查纪元
+    follower.poll();
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    follower.poll();
+    CHECK(follower.reloads() == 1);
+    CHECK(follower.epoch() != firstEpoch);
+    CHECK(follower.poll() == 1);
+    CHECK(!follower.failed());
+    CHECK(sameData(primary, standby));
+
+    // 新纪元的快照由主库写出，备库据此加载
+    CHECK(std::filesystem::exists(ReplicationLog::snapshotPath(dir, follower.epoch())));
+    std::filesystem::remove_all(dir);
+    std::remove(dataFile.c_str());
+}
+
+} // namespace
+
+/**
+ * @brief 测试入口
+ * @return 0 全部通过，1 有检查失败
+ */
+int main() {
+    testReplay();
+    testBatching();
+    testPartialAndGap();
+    testWriteFailure();
+    testTieredPrimary();
+    testNewEpoch();
+    return finishTests();
+}
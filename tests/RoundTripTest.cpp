@@ -0,0 +1,228 @@
+/**
+ * @file RoundTripTest.cpp
+ * @brief 数据文件保存→加载往返测试
+ * @details 验证 saveToFile 写出的每个字段都能被 loadFromFile 原样读回：
+ *          会员ID、姓名、电话、生日、总消费、积分、积分规则、年度消费、等级和上次消费年份，
+ *          分别覆盖 UTF-8 / GBK 编码以及启用冷热分层（休眠会员保存在段文件中）的情况。
+ *          删除列表开头的会员（由末尾的会员填补）后保存，其余会员按ID原样写出。
+ *          消费历史不在数据文件格式中，不参与比较；但删除ID最大的会员后重新加载，新会员不得沿用该ID，
+ *          否则会继承归档中按ID保存的旧历史。
+ *          任一检查失败时返回非零，由 CTest 运行。
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "MemberManager.h"
+#include "TestSupport.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+namespace {
+
+/**
+ * @brief 逐字段比较两个会员（数据文件中的全部字段，金额要求完全相等）
+ * @param expected 保存前的会员
+ * @param actual 加载后的会员
+ */
+void checkSameMember(const Member& expected, const Member& actual) {
+    CHECK(actual.getId() == expected.getId());
+    CHECK(actual.getName() == expected.getName());
+    CHECK(actual.getPhone() == expected.getPhone());
+    CHECK(actual.getBirthday() == expected.getBirthday());
+    CHECK(actual.getTotalSpent() == expected.getTotalSpent());
+    CHECK(actual.getPoints() == expected.getPoints());
+    CHECK(actual.getPointsPerDollar() == expected.getPointsPerDollar());
+    CHECK(actual.getAnnualSpent() == expected.getAnnualSpent());
+    CHECK(actual.getCurrentLevel() == expected.getCurrentLevel());
+    CHECK(actual.getLastYear() == expected.getLastYear());
+}
+
+/**
+ * @brief 通过管理器接口建立会员，保存后加载到新的管理器，逐个会员比较
+ * @param encoding 保存时使用的编码
+ */
+void testManagerRoundTrip(TextEncoding::Encoding encoding) {
+    MemberManager source;
+    int zhang = source.addMember("张三", "13800000001", "1990-01-15");
+    int li = source.addMember("李四光", "13800000002", "1985-12-31");
+    int wang = source.addMember("Wang Wu", "13800000003", "2000-02-29");
+    int zhao = source.addMember("赵六", "13800000004", "1978-07-07");
+    source.addMember("钱七", "13800000005", "1969-03-08");
+
+    // 非整分金额和累计后不能精确表示的金额都要原样读回
+    source.addSpending(zhang, 1234.567);
+    source.addSpending(zhang, 0.1);
+    source.addSpending(zhang, 0.2);
+    source.addSpending(li, 19999.99);
+    source.addSpending(li, 30000.01);
+    source.addSpending(wang, 88.8);
+    source.setPointsRule(3);
+    source.addSpending(wang, 123456.78);
+    source.addSpending(zhao, 5000.0);
+    source.redeemPoints(zhao, 1234);
+    source.redeemPoints(li, 100);
+
+    // 确保用例覆盖积分与年度消费不一致、以及非普通等级的会员
+    CHECK(source.getMemberById(zhao)->getPoints() != static_cast<int>(source.getMemberById(zhao)->getTotalSpent()));
+    CHECK(source.getMemberById(wang)->getCurrentLevel() == Member::DIAMOND);
+
+    std::string path = tempPath(encoding == TextEncoding::ENCODING_GBK ? "member_round_trip_gbk.dat"
+                                                                         : "member_round_trip_utf8.dat");
+    CHECK(source.saveToFile(path, encoding) == MemberManager::STATUS_OK);
+
+    MemberManager loaded;
+    CHECK(loaded.loadFromFile(path) == MemberManager::STATUS_OK);
+    CHECK(loaded.getMemberList().size() == source.getMemberList().size());
+    for (const Member& expected : source.getMemberList()) {
+        const Member* actual = loaded.getMemberById(expected.getId());
+        CHECK(actual != nullptr);
+        if (actual) {
+            checkSameMember(expected, *actual);
+        }
+        CHECK(loaded.getMemberIdByPhone(expected.getPhone()) == expected.getId());
+    }
+
+    // 加载后新加入的会员不能与已有ID冲突
+    int next = loaded.addMember("孙八", "13800000006", "1995-05-05");
+    CHECK(next > 0 && source.getMemberById(next) == nullptr);
+    std::remove(path.c_str());
+}
+
+/**
+ * @brief 手写的数据文件，加载后再保存应逐字节相同
+ * @details 包含等级与年度消费不对应（跨年后保留的等级）、多位小数的金额以及较早的上次消费年份
+ */
+const char* const HANDWRITTEN_FILE =
+    "1,张三,13900000001,1990-01-15,1234567.8912345,987654,2,0,3,2019\n"
+    "2,李四,13900000002,1985-12-31,0.1,0,1,0.1,0,2024\n"
+    "3,王五,13900000003,2000-02-29,30000.07,29001,1,12345.6,2,2021\n"
+    "5,Zhao Liu,13900000005,1978-07-07,100,100,5,100,1,2015\n"
+    "8,钱七,13900000008,1969-03-08,0,0,1,0,0,0\n";
+
+/**
+ * @brief 数据文件 → 加载 → 保存，比较文件内容
+ */
+void testFileRoundTrip() {
+    std::string input = tempPath("member_round_trip_in.dat");
+    std::string output = tempPath("member_round_trip_out.dat");
+    writeFile(input, HANDWRITTEN_FILE);
+
+    MemberManager manager;
+    CHECK(manager.loadFromFile(input) == MemberManager::STATUS_OK);
+    CHECK(manager.getMemberList().size() == 5);
+    const Member* zhang = manager.getMemberById(1);
+    CHECK(zhang != nullptr);
+    if (zhang) {
+        CHECK(zhang->getPoints() == 987654);
+        CHECK(zhang->getTotalSpent() == 1234567.8912345);
+        CHECK(zhang->getCurrentLevel() == Member::DIAMOND);
+        CHECK(zhang->getPointsPerDollar() == 2);
+    }
+
+    CHECK(manager.saveToFile(output, TextEncoding::ENCODING_UTF8) == MemberManager::STATUS_OK);
+    CHECK(readFile(output) == HANDWRITTEN_FILE);
+
+    // 末尾的会员移到被删除会员的位置，按ID、电话仍能找到，保存结果仍按ID排列
+    CHECK(manager.deleteMember(1) == MemberManager::STATUS_OK);
+    CHECK(manager.getMemberById(1) == nullptr);
+    const Member* qian = manager.getMemberById(8);
+    CHECK(qian != nullptr && qian->getName() == "钱七");
+    CHECK(manager.getMemberIdByPhone("13900000008") == 8);
+    CHECK(manager.saveToFile(output, TextEncoding::ENCODING_UTF8) == MemberManager::STATUS_OK);
+    std::string remaining = HANDWRITTEN_FILE;
+    remaining.erase(0, remaining.find('\n') + 1);
+    CHECK(readFile(output) == remaining);
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+}
+
+/**
+ * @brief 启用冷热分层时加载：休眠会员写入段文件，保存时一并写出，内容应与原文件相同
+ */
+void testTieredRoundTrip() {
+    std::string input = tempPath("member_round_trip_tier_in.dat");
+    std::string output = tempPath("member_round_trip_tier_out.dat");
+    std::string segment = tempPath("member_round_trip_tier.seg");
+    writeFile(input, HANDWRITTEN_FILE);
+    std::remove(segment.c_str());
+
+    MemberManager manager;
+    CHECK(manager.enableTiering(segment, 2) == MemberManager::STATUS_OK);
+    CHECK(manager.loadFromFile(input) == MemberManager::STATUS_OK);
+    CHECK(manager.getColdMemberCount() > 0);
+    CHECK(manager.saveToFile(output, TextEncoding::ENCODING_UTF8) == MemberManager::STATUS_OK);
+    CHECK(readFile(output) == HANDWRITTEN_FILE);
+
+    // 按ID访问时从段文件调回，各字段不变
+    const Member* cold = manager.getMemberById(5);
+    CHECK(cold != nullptr);
+    if (cold) {
+        CHECK(cold->getPoints() == 100);
+        CHECK(cold->getPointsPerDollar() == 5);
+        CHECK(cold->getCurrentLevel() == Member::SILVER);
+        CHECK(cold->getLastYear() == 2015);
+    }
+    std::remove(input.c_str());
+    std::remove(output.c_str());
+    std::remove(segment.c_str());
+}
+
+/**
+ * @brief 删除ID最大的会员 → 保存 → 重新加载 → 添加会员，新会员不能沿用该ID
+ * @details 归档按会员ID保存，沿用ID会让新会员继承已删除会员的历史；两种启用归档的先后顺序都要覆盖
+ */
+void testArchivedIdNotReused() {
+    std::string data = tempPath("member_round_trip_ids.dat");
+    std::string archive = tempPath("member_round_trip_ids_archive");
+    std::filesystem::remove_all(archive);
+
+    int removed;
+    {
+        MemberManager manager;
+        CHECK(manager.enableHistoryArchive(archive) == MemberManager::STATUS_OK);
+        manager.addMember("张三", "13900000001", "1990-01-15");
+        removed = manager.addMember("李四", "13900000002", "1985-12-31");
+        manager.addSpending(removed, 100.0);
+        // 启用时已归档到上一年度，这里把本年度也结束归档
+        int year = manager.getMemberById(removed)->getLastYear();
+        CHECK(manager.archiveHistory(year).members == 1);
+        CHECK(manager.deleteMember(removed) == MemberManager::STATUS_OK);
+        CHECK(manager.saveToFile(data) == MemberManager::STATUS_OK);
+    }
+
+    for (bool archiveFirst : { true, false }) {
+        MemberManager manager;
+        if (archiveFirst) {
+            CHECK(manager.enableHistoryArchive(archive) == MemberManager::STATUS_OK);
+        }
+        CHECK(manager.loadFromFile(data) == MemberManager::STATUS_OK);
+        if (!archiveFirst) {
+            CHECK(manager.enableHistoryArchive(archive) == MemberManager::STATUS_OK);
+        }
+        int added = manager.addMember("王五", "13900000003", "2000-02-29");
+        CHECK(added > removed);
+        const HistoryArchive& history = manager.getHistoryArchive();
+        for (size_t segment = 0; segment < history.yearCount(); ++segment) {
+            CHECK(history.recordCount(segment, added) == 0);
+        }
+    }
+    std::remove(data.c_str());
+    std::filesystem::remove_all(archive);
+}
+
+} // namespace
+
+/**
+ * @brief 测试入口
+ * @return 0 全部通过，1 有检查失败
+ */
+int main() {
+    testManagerRoundTrip(TextEncoding::ENCODING_UTF8);
+    testManagerRoundTrip(TextEncoding::ENCODING_GBK);
+    testFileRoundTrip();
+    testTieredRoundTrip();
+    testArchivedIdNotReused();
+    return finishTests();
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+// 各测试程序共用的检查宏与文件工具：
+// CHECK 失败时打印位置并计数，不中断测试；main 最后返回 finishTests() 的结果，由 CTest 判断成败
+
+inline int failures = 0;  ///< 失败的检查数
+
+#define CHECK(condition)                                                                        \
+    do {                                                                                        \
+        if (!(condition)) {                                                                     \
+            std::fprintf(stderr, "%s:%d: 检查失败: %s\n", __FILE__, __LINE__, #condition);     \
+            ++failures;                                                                         \
+        }                                                                                       \
+    } while (0)
+
+/**
+ * @brief 获取测试用的临时路径
+ * @param name 文件或目录名
+ */
+inline std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+/**
+ * @brief 读取整个文件
+ * @param path 文件路径
+ */
+inline std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+/**
+ * @brief 写出整个文件
+ * @param path 文件路径
+ * @param content 文件内容
+ */
+inline void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream file(path, std::ios::binary);
+    file << content;
+}
+
+/**
+ * @brief 当前年份
+ */
+inline int currentYear() {
+    std::time_t now = std::time(nullptr);
+    std::tm current;
+#if defined(_WIN32)
+    localtime_s(&current, &now);
+#else
+    localtime_r(&now, &current);
+#endif
+    return current.tm_year + 1900;
+}
+
+/**
+ * @brief 输出测试结果
+ * @return 进程退出码：0 全部通过，1 有检查失败
+ */
+inline int finishTests() {
+    if (failures > 0) {
+        std::fprintf(stderr, "%d 项检查失败\n", failures);
+        return 1;
+    }
+    std::printf("全部通过\n");
+    return 0;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file TieringTest.cpp
+ * @brief 冷热分层测试
+ * @details 加载一份多数会员多年未消费的数据文件，休眠会员直接转存到段文件，
+ *          再检查按电话从磁盘查找（同号取ID最小者、删除后不再命中）的结果，
+ *          以及休眠会员仍能按姓名、生日查到，生日奖励同样发给磁盘上的会员；段文件读不出时奖励跳过这些会员并报告。
+ *          任一检查失败时返回非零，由 CTest 运行。
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "MemberManager.h"
+#include "BirthdayIndex.h"
+#include "TestSupport.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int MEMBER_COUNT = 2000;  ///< 数据文件中的会员数
+
+/**
+ * @brief 第 i 位会员的电话号码
+ * @details ID 为 100 的倍数的会员与 ID 小 2 的会员同号（两人都休眠），用来检查同号时返回ID最小的会员
+ */
+std::string phoneOf(int i) {
+    int number = (i % 100 == 0) ? i - 2 : i;
+    char text[32];
+    std::snprintf(text, sizeof(text), "139%08d", number);
+    return text;
+}
+
+/**
+ * @brief 第 i 位会员的姓名
+ * @details 10（休眠）与 11 的姓名都含“欧阳”，12（休眠）的姓名独一无二，其余取自一个小名单
+ */
+std::string nameOf(int i) {
+    static const char* const COMMON[] = { "张伟", "李娜", "王芳", "刘洋" };
+    switch (i) {
+    case 10: return "欧阳修";
+    case 11: return "欧阳锋";
+    case 12: return "司马光";
+    default: return COMMON[i % 4];
+    }
+}
+
+/**
+ * @brief 写出测试数据文件：ID 为偶数的会员 2015 年后没有消费（休眠），奇数的今年仍有消费
+ * @param path 文件路径
+ * @param year 当前年份
+ */
+void writeMembers(const std::string& path, int year) {
+    std::string content;
+    char line[128];
+    for (int i = 1; i <= MEMBER_COUNT; ++i) {
+        std::snprintf(line, sizeof(line), "%d,%s,%s,1990-03-%02d,100,100,1,%s,0,%d\n",
+                      i, nameOf(i).c_str(), phoneOf(i).c_str(), 1 + i % 28, i % 2 == 0 ? "0" : "100", i % 2 == 0 ? 2015 : year);
+        content += line;
+    }
+    writeFile(path, content);
+}
+
+/**
+ * @brief 按电话查找磁盘上的会员：逐个命中、同号取最小ID、删除后查不到
+ */
+void testColdPhoneLookup(int year) {
+    std::string input = tempPath("member_tiering_phone.dat");
+    std::string segment = tempPath("member_tiering_phone.seg");
+    writeMembers(input, year);
+
+    MemberManager manager;
+    CHECK(manager.enableTiering(segment, 2) == MemberManager::STATUS_OK);
+    CHECK(manager.loadFromFile(input) == MemberManager::STATUS_OK);
+    CHECK(manager.getColdMemberCount() == MEMBER_COUNT / 2);
+
+    // 常量查找不调回，磁盘上的会员数不变
+    int misses = 0;
+    for (int i = 2; i <= MEMBER_COUNT; i += 2) {
+        int expected = (i % 100 == 0) ? i - 2 : i;
+        if (manager.getMemberIdByPhone(phoneOf(i)) != expected) {
+            ++misses;
+        }
+    }
+    CHECK(misses == 0);
+    CHECK(manager.getColdMemberCount() == MEMBER_COUNT / 2);
+    CHECK(manager.getMemberIdByPhone("13999999999") == -1);
+
+    // 删除磁盘上的会员后按电话查不到；调回的会员从磁盘移除
+    CHECK(manager.deleteMember(4) == MemberManager::STATUS_OK);
+    CHECK(manager.getMemberIdByPhone(phoneOf(4)) == -1);
+    const Member* member = manager.getMemberByPhone(phoneOf(6));
+    CHECK(member != nullptr && member->getId() == 6);
+    CHECK(manager.getColdMemberCount() == MEMBER_COUNT / 2 - 2);
+    CHECK(manager.getMemberIdByPhone(phoneOf(6)) == 6);
+
+    std::remove(input.c_str());
+}
+
+/**
+ * @brief 休眠会员仍在姓名、生日索引中：查询能命中，命中后调回，删除后不再出现
+ */
+void testColdNameAndBirthday(int year) {
+    std::string input = tempPath("member_tiering_views.dat");
+    std::string segment = tempPath("member_tiering_views.seg");
+    writeMembers(input, year);
+
+    MemberManager manager;
+    CHECK(manager.enableTiering(segment, 2) == MemberManager::STATUS_OK);
+    CHECK(manager.loadFromFile(input) == MemberManager::STATUS_OK);
+    size_t coldCount = manager.getColdMemberCount();
+
+    // 常量查找读盘核对，不调回；非常量查找调回返回的会员
+    std::vector<int> ids;
+    const MemberManager& constManager = manager;
+    CHECK(constManager.findMembersByName("欧阳", 0, ids) == 2);
+    CHECK(manager.getColdMemberCount() == coldCount);
+    CHECK(manager.findMembersByName("欧阳", 0, ids) == 2);
+    CHECK(ids.size() == 2 && (ids[0] == 10 || ids[1] == 10));
+    CHECK(manager.getColdMemberCount() == coldCount - 1);
+    CHECK(constManager.getMemberById(10) != nullptr);
+
+    // 生日在 3 月 5 日的会员：ID 除以 28 余 4，休眠与否各占一半
+    int march5 = BirthdayIndex::dayKey(3, 5);
+    size_t expected = (MEMBER_COUNT - 4) / 28 + 1;
+    CHECK(manager.findMembersByBirthday(march5, march5, ids) == expected);
+    MemberManager::BonusResult bonus = manager.grantBirthdayBonus(march5, march5, 50);
+    CHECK(bonus.members == expected);
+    const Member* cold = manager.getMemberById(32);
+    CHECK(cold != nullptr && cold->getPoints() == 150);
+
+    // 调回的会员仍然休眠，再次转存后姓名、生日索引中没有重复项
+    CHECK(manager.evictDormant() > 0);
+    CHECK(manager.getColdMemberCount() == coldCount);
+    CHECK(manager.findMembersByBirthday(march5, march5, ids) == expected);
+    CHECK(constManager.findMembersByName("欧阳", 0, ids) == 2);
+
+    // 删除磁盘上的会员，按姓名、生日都不再出现
+    CHECK(manager.deleteMember(12) == MemberManager::STATUS_OK);
+    CHECK(constManager.findMembersByName("司马光", 0, ids) == 0);
+    int march13 = BirthdayIndex::dayKey(3, 13);
+    size_t remaining = (MEMBER_COUNT - 12) / 28;  // 原有 (MEMBER_COUNT - 12) / 28 + 1 人，删去一人
+    CHECK(manager.findMembersByBirthday(march13, march13, ids) == remaining);
+    for (int id : ids) {
+        CHECK(id != 12);
+    }
+
+    std::remove(input.c_str());
+}
+
+/**
+ * @brief 段文件被截断后发放生日奖励：读不出的会员跳过，结果码为 STATUS_IO_ERROR，其余会员照常发放
+ */
+void testUnreadableSegment(int year) {
+    std::string input = tempPath("member_tiering_broken.dat");
+    std::string segment = tempPath("member_tiering_broken.seg");
+    writeMembers(input, year);
+
+    MemberManager manager;
+    CHECK(manager.enableTiering(segment, 2) == MemberManager::STATUS_OK);
+    CHECK(manager.loadFromFile(input) == MemberManager::STATUS_OK);
+    std::filesystem::resize_file(segment, 0);
+
+    // 3 月 5 日生日的会员 ID 都是偶数（休眠），3 月 6 日的都是奇数
+    MemberManager::BonusResult bonus =
+        manager.grantBirthdayBonus(BirthdayIndex::dayKey(3, 5), BirthdayIndex::dayKey(3, 6), 50);
+    CHECK(bonus.status == MemberManager::STATUS_IO_ERROR);
+    CHECK(bonus.members == (MEMBER_COUNT - 5) / 28 + 1);
+    const Member* hot = manager.getMemberById(5);
+    CHECK(hot != nullptr && hot->getPoints() == 150);
+
+    std::remove(input.c_str());
+}
+
+} // namespace
+
+/**
+ * @brief 测试入口
+ * @return 0 全部通过，1 有检查失败
+ */
+int main() {
+    int year = currentYear();
+    testColdPhoneLookup(year);
+    testColdNameAndBirthday(year);
+    testUnreadableSegment(year);
+    return finishTests();
+}
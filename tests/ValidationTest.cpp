@@ -0,0 +1,243 @@
+/**
+ * @file ValidationTest.cpp
+ * @brief 输入验证测试
+ * @details 覆盖 Utils 中姓名、电话和生日的接受规则：UTF-8 汉字逐字解码、
+ *          按 8/4 字节分组（末组与前组重叠）的数字判断、闰年与月份天数、年份范围和未来日期。
+ *          另外用随机输入与逐字节的参考实现比较 30 万次，保证快速路径与朴素规则一致。
+ *          任一检查失败时返回非零，由 CTest 运行。
+ * @author 系统开发者
+ * @date 2024
+ * @version 1.0
+ */
+
+#include "Utils.h"
+#include "TestSupport.h"
+#include <cstdio>
+#include <ctime>
+#include <random>
+#include <string>
+
+namespace {
+
+/**
+ * @brief 电话号码的参考实现：逐字节判断
+ */
+bool referencePhone(const std::string& phone) {
+    if (phone.size() != 11 && phone.size() != 7 && phone.size() != 8) return false;
+    if (phone.size() == 11 && phone[0] != '1') return false;
+    for (char c : phone) {
+        if (c < '0' || c > '9') return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 生日的参考实现：逐字段解析，today 为 年 × 10000 + 月 × 100 + 日
+ */
+bool referenceBirthday(const std::string& birthday, int today) {
+    if (birthday.size() != 10) return false;
+    for (size_t i = 0; i < birthday.size(); ++i) {
+        bool dash = i == 4 || i == 7;
+        if (dash ? birthday[i] != '-' : (birthday[i] < '0' || birthday[i] > '9')) return false;
+    }
+    int year = std::stoi(birthday.substr(0, 4));
+    int month = std::stoi(birthday.substr(5, 2));
+    int day = std::stoi(birthday.substr(8, 2));
+    if (year < 1900 || year > 2100 || month < 1 || month > 12 || day < 1) return false;
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    int days = month == 2 ? (leap ? 29 : 28) : (month == 4 || month == 6 || month == 9 || month == 11) ? 30 : 31;
+    return day <= days && year * 10000 + month * 100 + day <= today;
+}
+
+#ifndef _WIN32
+/**
+ * @brief UTF-8 姓名的参考实现：每个字符为 3 字节且码点在 U+4E00-U+9FA5
+ */
+bool referenceName(const std::string& name) {
+    if (name.empty()) return false;
+    for (size_t i = 0; i < name.size(); i += 3) {
+        if (i + 3 > name.size()) return false;
+        unsigned char a = name[i], b = name[i + 1], c = name[i + 2];
+        if (a < 0xE0 || a > 0xEF || b < 0x80 || b > 0xBF || c < 0x80 || c > 0xBF) return false;
+        unsigned codePoint = ((a & 0x0Fu) << 12) | ((b & 0x3Fu) << 6) | (c & 0x3Fu);
+        if (codePoint < 0x4E00 || codePoint > 0x9FA5) return false;
+    }
+    return true;
+}
+#endif
+
+/**
+ * @brief 今天的日期编号与 YYYY-MM-DD 字符串
+ */
+int today(std::string& text) {
+    std::time_t now = std::time(nullptr);
+    std::tm current;
+#if defined(_WIN32)
+    localtime_s(&current, &now);
+#else
+    localtime_r(&now, &current);
+#endif
+    char buffer[16];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d", &current);
+    text = buffer;
+    return (current.tm_year + 1900) * 10000 + (current.tm_mon + 1) * 100 + current.tm_mday;
+}
+
+/**
+ * @brief 手机号、固话长度，以及非数字字符落在各个分组（含重叠区）时的判断
+ */
+void testPhones() {
+    CHECK(Utils::isValidPhoneNumber("13800000001"));
+    CHECK(Utils::isValidPhoneNumber("1234567"));
+    CHECK(Utils::isValidPhoneNumber("12345678"));
+    CHECK(!Utils::isValidPhoneNumber("23800000001"));
+    CHECK(!Utils::isValidPhoneNumber(""));
+    CHECK(!Utils::isValidPhoneNumber("123456"));
+    CHECK(!Utils::isValidPhoneNumber("123456789"));
+    CHECK(!Utils::isValidPhoneNumber("138000000012"));
+
+    // '/' 与 ':' 紧邻 '0' 和 '9'，'?' 与 '9' 的低半字节相同
+    const char bad[] = { '/', ':', '?', ' ', 'a', '\0', '\x80', '\xB9' };
+    for (const char* base : { "13800000001", "1234567", "12345678" }) {
+        std::string digits = base;
+        for (size_t position = digits.size() == 11 ? 1 : 0; position < digits.size(); ++position) {
+            for (char c : bad) {
+                std::string phone = digits;
+                phone[position] = c;
+                if (Utils::isValidPhoneNumber(phone)) {
+                    std::fprintf(stderr, "误判为有效: %s 第 %zu 位 0x%02X\n", base, position, static_cast<unsigned char>(c));
+                    ++failures;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief 闰年、月份天数、年份范围、未来日期和格式错误
+ */
+void testBirthdays() {
+    CHECK(Utils::isValidBirthday("1990-01-15"));
+    CHECK(Utils::isValidBirthday("2000-02-29"));
+    CHECK(Utils::isValidBirthday("1996-02-29"));
+    CHECK(!Utils::isValidBirthday("1900-02-29"));
+    CHECK(!Utils::isValidBirthday("2001-02-29"));
+    CHECK(Utils::isValidBirthday("2001-02-28"));
+    CHECK(Utils::isValidBirthday("1990-04-30"));
+    CHECK(!Utils::isValidBirthday("1990-04-31"));
+    CHECK(Utils::isValidBirthday("1990-12-31"));
+    CHECK(!Utils::isValidBirthday("1990-13-01"));
+    CHECK(!Utils::isValidBirthday("1990-00-10"));
+    CHECK(!Utils::isValidBirthday("1990-01-00"));
+    CHECK(Utils::isValidBirthday("1900-01-01"));
+    CHECK(!Utils::isValidBirthday("1899-12-31"));
+    CHECK(!Utils::isValidBirthday("2100-01-01"));
+    CHECK(!Utils::isValidBirthday("1990/01/15"));
+    CHECK(!Utils::isValidBirthday("1990-1-15"));
+    CHECK(!Utils::isValidBirthday("1990-01-5 "));
+    CHECK(!Utils::isValidBirthday("19a0-01-15"));
+    CHECK(!Utils::isValidBirthday("1990-01-15 "));
+    CHECK(!Utils::isValidBirthday(""));
+
+    std::string todayText;
+    today(todayText);
+    CHECK(Utils::isValidBirthday(todayText));
+    CHECK(!Utils::isValidBirthday("2099-12-31"));
+}
+
+/**
+ * @brief UTF-8 姓名：只接受 CJK 基本汉字，拒绝其他字符和残缺编码
+ */
+void testNames() {
+#ifndef _WIN32
+    CHECK(Utils::isValidChineseName("张三"));
+    CHECK(Utils::isValidChineseName("李四光"));
+    CHECK(Utils::isValidChineseName("\xE4\xB8\x80"));          // U+4E00
+    CHECK(Utils::isValidChineseName("\xE9\xBE\xA5"));          // U+9FA5
+    CHECK(!Utils::isValidChineseName("\xE4\xB7\xBF"));         // U+4DFF
+    CHECK(!Utils::isValidChineseName("\xE9\xBE\xA6"));         // U+9FA6
+    CHECK(!Utils::isValidChineseName(""));
+    CHECK(!Utils::isValidChineseName("Wang"));
+    CHECK(!Utils::isValidChineseName("さくら"));                // 假名
+    CHECK(!Utils::isValidChineseName("Jos\xC3\xA9"));          // 拉丁字母带重音
+    CHECK(!Utils::isValidChineseName("张\xE4\xB8"));           // 末尾残缺
+    CHECK(!Utils::isValidChineseName("\xE5\xBC\x20"));         // 续字节错误
+    CHECK(!Utils::isValidChineseName("\xB8\xE5\xBC"));         // 以续字节开头
+    CHECK(!Utils::isValidChineseName("张 三"));
+#endif
+}
+
+/**
+ * @brief 随机输入与参考实现比较
+ * @details 字符集偏向各规则的边界（数字两侧的字符、'-'、汉字首尾附近的字节），
+ *          使随机串有相当比例是有效的
+ */
+void testRandomized() {
+    std::string todayText;
+    int todayKey = today(todayText);
+    std::mt19937 random(20240101);
+    const char phoneChars[] = "0123456789012345678901234567891/:? ";
+    const char dateChars[] = "0123456789012345678901234567890123456789-/:";
+    const unsigned char nameBytes[] = { 0xE4, 0xE5, 0xE6, 0xE9, 0xE3, 0xEF, 0xC3, 0x80, 0x88, 0xB8, 0xBE, 0xBF, 0xA5, 0xA6, 0x41 };
+    int mismatches = 0;
+
+    for (int round = 0; round < 100000; ++round) {
+        std::string phone;
+        size_t length = random() % 4 == 0 ? random() % 14 : (random() % 3 == 0 ? 11 : 7 + random() % 2);
+        for (size_t i = 0; i < length; ++i) {
+            phone += random() % 8 == 0 ? phoneChars[random() % (sizeof(phoneChars) - 1)] : char('0' + random() % 10);
+        }
+        if (Utils::isValidPhoneNumber(phone) != referencePhone(phone)) {
+            if (++mismatches <= 10) std::fprintf(stderr, "电话不一致: \"%s\"\n", phone.c_str());
+        }
+
+        std::string birthday;
+        char buffer[16];
+        std::snprintf(buffer, sizeof(buffer), "%04u-%02u-%02u",
+                      static_cast<unsigned>(1890 + random() % 220),
+                      static_cast<unsigned>(random() % 14), static_cast<unsigned>(random() % 33));
+        birthday = buffer;
+        if (random() % 4 == 0) {
+            birthday[random() % birthday.size()] = dateChars[random() % (sizeof(dateChars) - 1)];
+        }
+        if (random() % 16 == 0) {
+            birthday.resize(random() % 12, '0');
+        }
+        if (Utils::isValidBirthday(birthday) != referenceBirthday(birthday, todayKey)) {
+            if (++mismatches <= 10) std::fprintf(stderr, "生日不一致: \"%s\"\n", birthday.c_str());
+        }
+
+#ifndef _WIN32
+        std::string name;
+        size_t characters = random() % 5;
+        for (size_t i = 0; i < characters; ++i) {
+            if (random() % 4 == 0) {
+                name += static_cast<char>(nameBytes[random() % sizeof(nameBytes)]);
+            } else {
+                unsigned codePoint = 0x4D00 + random() % 0x5400;
+                name += static_cast<char>(0xE0 | (codePoint >> 12));
+                name += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                name += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+        }
+        if (Utils::isValidChineseName(name) != referenceName(name)) {
+            if (++mismatches <= 10) std::fprintf(stderr, "姓名不一致（%zu 字节）\n", name.size());
+        }
+#endif
+    }
+    CHECK(mismatches == 0);
+}
+
+} // namespace
+
+/**
+ * @brief 测试入口
+ * @return 0 全部通过，1 有检查失败
+ */
+int main() {
+    testPhones();
+    testBirthdays();
+    testNames();
+    testRandomized();
+    return finishTests();
+}